@@ -0,0 +1,206 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2023] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/*******************************************************************************************************************//**
+ * @ingroup RENESAS_INTERFACES
+ * @defgroup SPI_FLASH_API SPI Flash Interface
+ * @brief Interface for accessing external SPI flash devices.
+ *
+ * @section SPI_FLASH_API_SUMMARY Summary
+ * The SPI flash API provides an interface that configures, writes, and erases sectors in SPI flash devices. The
+ * flash is read through its memory-mapped area.
+ *
+ * Implemented by:
+ * - @ref XSPI_QSPI
+ *
+ * @{
+ **********************************************************************************************************************/
+
+#ifndef R_SPI_FLASH_API_H
+#define R_SPI_FLASH_API_H
+
+/***********************************************************************************************************************
+ * Includes
+ **********************************************************************************************************************/
+
+/* Register definitions, common services and error codes. */
+#include "bsp_api.h"
+
+/* Common macro for FSP header files. There is also a corresponding FSP_FOOTER macro at the end of this file. */
+FSP_HEADER
+
+/**********************************************************************************************************************
+ * Macro definitions
+ **********************************************************************************************************************/
+#define SPI_FLASH_API_VERSION_MAJOR         (1U) // DEPRECATED
+#define SPI_FLASH_API_VERSION_MINOR         (0U) // DEPRECATED
+
+#define SPI_FLASH_ERASE_SIZE_CHIP_ERASE     (UINT32_MAX)
+
+/**********************************************************************************************************************
+ * Typedef definitions
+ **********************************************************************************************************************/
+
+/** Protocol of the flash commands (command-address-data lines, S: single data rate). */
+typedef enum e_spi_flash_protocol
+{
+    SPI_FLASH_PROTOCOL_1S_1S_1S = 0x000, ///< Standard SPI, one line for command, address and data
+    SPI_FLASH_PROTOCOL_1S_2S_2S = 0x048, ///< Dual address and data
+    SPI_FLASH_PROTOCOL_1S_4S_4S = 0x090, ///< Quad address and data
+} spi_flash_protocol_t;
+
+/** Number of bytes in the address. */
+typedef enum e_spi_flash_address_bytes
+{
+    SPI_FLASH_ADDRESS_BYTES_3 = 2,     ///< 3 address bytes
+    SPI_FLASH_ADDRESS_BYTES_4 = 3,     ///< 4 address bytes
+} spi_flash_address_bytes_t;
+
+/** Erase command and the size it erases. */
+typedef struct st_spi_flash_erase_command
+{
+    uint16_t command;                  ///< Erase command
+    uint32_t size;                     ///< Size of the erase in bytes, or SPI_FLASH_ERASE_SIZE_CHIP_ERASE
+} spi_flash_erase_command_t;
+
+/** Structure to define a direct transfer (a command with optional address and up to 8 data bytes). */
+typedef struct st_spi_flash_direct_transfer
+{
+    uint32_t address;                  ///< Starting address
+    uint64_t data;                     ///< Data to write, or data read
+    uint16_t command;                  ///< Command
+    uint8_t  dummy_cycles;             ///< Dummy cycles before the data
+    uint8_t  command_length;           ///< Command length in bytes
+    uint8_t  address_length;           ///< Address length in bytes, 0 for no address
+    uint8_t  data_length;              ///< Data length in bytes, 0 to 8
+} spi_flash_direct_transfer_t;
+
+/** Direction of a direct transfer. */
+typedef enum e_spi_flash_direct_transfer_dir
+{
+    SPI_FLASH_DIRECT_TRANSFER_DIR_READ  = 0, ///< Read from the flash
+    SPI_FLASH_DIRECT_TRANSFER_DIR_WRITE = 1, ///< Write to the flash
+} spi_flash_direct_transfer_dir_t;
+
+/** User configuration structure used by the open function */
+typedef struct st_spi_flash_cfg
+{
+    spi_flash_protocol_t              spi_protocol;              ///< Protocol of the commands
+    spi_flash_address_bytes_t         address_bytes;             ///< Number of bytes used to represent the address
+    uint8_t                           read_command;              ///< Read command used by the memory-mapped area
+    uint8_t                           read_dummy_cycles;         ///< Dummy cycles of the read command
+    uint8_t                           page_program_command;      ///< Page program command
+    uint32_t                          page_size_bytes;           ///< Page size in bytes (maximum number of bytes for page program)
+    uint8_t                           write_enable_command;      ///< Command to enable write or erase, typically 0x06
+    uint8_t                           status_command;            ///< Command to read the write status
+    uint8_t                           write_status_bit;          ///< Which bit determines write status
+    uint8_t                           erase_command_list_length; ///< Length of erase command list
+    spi_flash_erase_command_t const * p_erase_command_list;      ///< List of all erase commands and associated sizes
+    void const                      * p_extend;                  ///< Pointer to implementation specific extended configurations
+} spi_flash_cfg_t;
+
+/** SPI flash control block.  Allocate an instance specific control block to pass into the SPI flash API calls.
+ * @par Implemented as
+ * - xspi_qspi_instance_ctrl_t
+ */
+typedef void spi_flash_ctrl_t;
+
+/** Status. */
+typedef struct st_spi_flash_status
+{
+    /** Whether or not a write is in progress.  This is determined by reading the @ref spi_flash_cfg_t::write_status_bit
+     * from the @ref spi_flash_cfg_t::status_command. */
+    bool write_in_progress;
+} spi_flash_status_t;
+
+/** SPI flash implementations follow this API. */
+typedef struct st_spi_flash_api
+{
+    /** Open the SPI flash driver module.
+     *
+     * @param[in] p_ctrl               Pointer to a driver handle
+     * @param[in] p_cfg                Pointer to a configuration structure
+     **/
+    fsp_err_t (* open)(spi_flash_ctrl_t * p_ctrl, spi_flash_cfg_t const * const p_cfg);
+
+    /** Run a command on the flash, with optional address and up to 8 data bytes.
+     *
+     * @param[in]     p_ctrl           Pointer to a driver handle
+     * @param[in,out] p_transfer       Transfer; read data is returned in p_transfer->data
+     * @param[in]     direction        Read or write
+     **/
+    fsp_err_t (* directTransfer)(spi_flash_ctrl_t * p_ctrl, spi_flash_direct_transfer_t * const p_transfer,
+                                 spi_flash_direct_transfer_dir_t direction);
+
+    /** Program a page of data to the flash.
+     *
+     * @param[in] p_ctrl               Pointer to a driver handle
+     * @param[in] p_src                The memory address of the data to write to the flash device
+     * @param[in] p_dest               The location in the flash device address space to write the data to
+     * @param[in] byte_count           The number of bytes to write
+     **/
+    fsp_err_t (* write)(spi_flash_ctrl_t * p_ctrl, uint8_t const * const p_src, uint8_t * const p_dest,
+                        uint32_t byte_count);
+
+    /** Erase a certain number of bytes of the flash.
+     *
+     * @param[in] p_ctrl               Pointer to a driver handle
+     * @param[in] p_device_address     The location in the flash device address space to start the erase from
+     * @param[in] byte_count           The number of bytes to erase. Set to SPI_FLASH_ERASE_SIZE_CHIP_ERASE to erase
+     *                                 entire chip.
+     **/
+    fsp_err_t (* erase)(spi_flash_ctrl_t * p_ctrl, uint8_t * const p_device_address, uint32_t byte_count);
+
+    /** Get the write or erase status of the flash.
+     *
+     * @param[in]  p_ctrl              Pointer to a driver handle
+     * @param[out] p_status            Current status of the SPI flash device stored here.
+     **/
+    fsp_err_t (* statusGet)(spi_flash_ctrl_t * p_ctrl, spi_flash_status_t * const p_status);
+
+    /** Close the SPI flash driver module.
+     *
+     * @param[in] p_ctrl               Pointer to a driver handle
+     **/
+    fsp_err_t (* close)(spi_flash_ctrl_t * p_ctrl);
+
+    /* DEPRECATED Get the driver version based on compile time macros.
+     *
+     * @param[out]  p_version          Code and API version stored here.
+     **/
+    fsp_err_t (* versionGet)(fsp_version_t * const p_version);
+} spi_flash_api_t;
+
+/** This structure encompasses everything that is needed to use an instance of this interface. */
+typedef struct st_spi_flash_instance
+{
+    spi_flash_ctrl_t      * p_ctrl;    ///< Pointer to the control structure for this instance
+    spi_flash_cfg_t const * p_cfg;     ///< Pointer to the configuration structure for this instance
+    spi_flash_api_t const * p_api;     ///< Pointer to the API structure for this instance
+} spi_flash_instance_t;
+
+/******************************************************************************************************************//**
+ * @} (end defgroup SPI_FLASH_API)
+ *********************************************************************************************************************/
+
+/* Common macro for FSP header files. There is also a corresponding FSP_HEADER macro at the top of this file. */
+FSP_FOOTER
+
+#endif
@@ -0,0 +1,201 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2023] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+#ifndef R_DMAC_H
+#define R_DMAC_H
+
+/*******************************************************************************************************************//**
+ * @addtogroup DMAC
+ * @{
+ **********************************************************************************************************************/
+
+/***********************************************************************************************************************
+ * Includes
+ **********************************************************************************************************************/
+#include "bsp_api.h"
+#include "r_transfer_api.h"
+#include "r_dmac_cfg.h"
+
+/* Common macro for FSP header files. There is also a corresponding FSP_FOOTER macro at the end of this file. */
+FSP_HEADER
+
+/***********************************************************************************************************************
+ * Macro definitions
+ **********************************************************************************************************************/
+#define DMAC_CODE_VERSION_MAJOR              (1U) // DEPRECATED
+#define DMAC_CODE_VERSION_MINOR              (0U) // DEPRECATED
+
+/** Max configurable number of transfer bytes in one register set. */
+#define DMAC_MAX_NORMAL_TRANSFER_LENGTH      (0xFFFFFFFFU)
+
+/** Max number of blocks (block mode) or repeats (repeat mode). */
+#define DMAC_MAX_BLOCK_TRANSFER_NUMBER       (0xFFFFU)
+
+/**********************************************************************************************************************
+ * Typedef definitions
+ **********************************************************************************************************************/
+
+/** Transfer size of the source or destination. */
+typedef enum e_dmac_transfer_size
+{
+    DMAC_TRANSFER_SIZE_1_BYTE   = 0,   ///< 1 byte
+    DMAC_TRANSFER_SIZE_2_BYTE   = 1,   ///< 2 bytes
+    DMAC_TRANSFER_SIZE_4_BYTE   = 2,   ///< 4 bytes
+    DMAC_TRANSFER_SIZE_8_BYTE   = 3,   ///< 8 bytes
+    DMAC_TRANSFER_SIZE_16_BYTE  = 4,   ///< 16 bytes
+    DMAC_TRANSFER_SIZE_32_BYTE  = 5,   ///< 32 bytes
+    DMAC_TRANSFER_SIZE_64_BYTE  = 6,   ///< 64 bytes
+    DMAC_TRANSFER_SIZE_128_BYTE = 7,   ///< 128 bytes
+} dmac_transfer_size_t;
+
+/** Detection method of the DMA request signal. */
+typedef enum e_dmac_detection
+{
+    DMAC_DETECTION_FALLING_EDGE = 1,   ///< Falling edge detection
+    DMAC_DETECTION_RISING_EDGE  = 2,   ///< Rising edge detection
+    DMAC_DETECTION_LOW_LEVEL    = 5,   ///< Low level detection
+    DMAC_DETECTION_HIGH_LEVEL   = 6,   ///< High level detection
+} dmac_detection_t;
+
+/** DMA ACK mode. */
+typedef enum e_dmac_ack_mode
+{
+    DMAC_ACK_MODE_LEVEL_MODE        = 1, ///< Level mode
+    DMAC_ACK_MODE_BUS_CYCLE_MODE    = 2, ///< Bus cycle mode
+    DMAC_ACK_MODE_MASK_DACK_OUTPUT  = 4, ///< Output is masked
+} dmac_ack_mode_t;
+
+/** Which side of the transfer issues the activation request. */
+typedef enum e_dmac_request_direction
+{
+    DMAC_REQUEST_DIRECTION_SOURCE_MODULE      = 0, ///< Requested by the source module (e.g. receive data full)
+    DMAC_REQUEST_DIRECTION_DESTINATION_MODULE = 1, ///< Requested by the destination module (e.g. transmit empty)
+} dmac_request_direction_t;
+
+/** Channel priority scheduling. */
+typedef enum e_dmac_channel_scheduling
+{
+    DMAC_CHANNEL_SCHEDULING_FIXED       = 0, ///< Fixed priority, lower channel number has priority
+    DMAC_CHANNEL_SCHEDULING_ROUND_ROBIN = 1, ///< Round robin
+} dmac_channel_scheduling_t;
+
+/** Callback function parameter data. */
+typedef struct st_dmac_callback_args
+{
+    void const * p_context;            ///< Placeholder for user data. Set in @ref transfer_api_t::open function in ::transfer_cfg_t.
+} dmac_callback_args_t;
+
+/** Driver specific transfer information, set in transfer_info_t::p_extend. */
+typedef struct st_dmac_extended_info
+{
+    dmac_transfer_size_t src_size;     ///< Source transfer size
+    dmac_transfer_size_t dest_size;    ///< Destination transfer size
+} dmac_extended_info_t;
+
+/** DMAC transfer configuration extension. This extension is required. */
+typedef struct st_dmac_extended_cfg
+{
+    uint8_t   unit;                    ///< Unit number
+    uint8_t   channel;                 ///< Channel number
+    IRQn_Type dmac_int_irq;            ///< DMAC transfer completion interrupt routine number
+    uint8_t   dmac_int_ipl;            ///< DMAC interrupt priority
+
+    /** Select which event will trigger the transfer. Select ELC_EVENT_NONE for software start. */
+    elc_event_t activation_source;
+
+    dmac_ack_mode_t           ack_mode;                         ///< DACK output mode
+    dmac_detection_t          detection_mode;                   ///< Request signal detection method
+    dmac_request_direction_t  activation_request_source_select; ///< Module that issues the request
+    dmac_channel_scheduling_t channel_scheduling;               ///< Channel priority of the unit
+
+    /** Callback for transfer end interrupt. */
+    void (* p_callback)(dmac_callback_args_t * cb_data);
+
+    /** Placeholder for user data.  Passed to the user p_callback in ::dmac_callback_args_t. */
+    void const * p_context;
+
+    /** Handler of the peripheral module that requested the transfer. It is called with the activation source as
+     * IRQ number, so the module can recover its own context (e.g. sci_uart_txi_dmac_isr). */
+    void (* p_peripheral_module_handler)(IRQn_Type irq);
+} dmac_extended_cfg_t;
+
+/** Control block used by driver. DO NOT INITIALIZE - this structure will be initialized in @ref transfer_api_t::open. */
+typedef struct st_dmac_instance_ctrl
+{
+    uint32_t open;                     // Driver ID
+
+    transfer_cfg_t const * p_cfg;      // Configuration of this instance
+    R_DMAC0_Type         * p_reg;      // Base register of the unit
+
+    /* Register set sequencing. Transfers are split into register sets (one per block, repeat or chain link) which
+     * are loaded alternately into the Next0 and Next1 registers. */
+    transfer_info_t const * p_info;    // First transfer info of the sequence
+    uint32_t sets_total;               // Number of register sets to execute, 0 for endless repeat
+    uint32_t sets_loaded;              // Number of register sets loaded so far
+    uint32_t sets_done;                // Number of register sets completed so far
+    uint8_t  software_repeat;          // Software start repeats for each register set
+
+    /* Pointer to callback and optional working memory */
+    void (* p_callback)(dmac_callback_args_t *);
+    dmac_callback_args_t * p_callback_memory;
+
+    /* Pointer to context to be passed into callback function */
+    void const * p_context;
+} dmac_instance_ctrl_t;
+
+/**********************************************************************************************************************
+ * Exported global variables
+ **********************************************************************************************************************/
+
+/** @cond INC_HEADER_DEFS_SEC */
+/** Filled in Interface API structure for this Instance. */
+extern const transfer_api_t g_transfer_on_dmac;
+
+/** @endcond */
+
+/***********************************************************************************************************************
+ * Public Function Prototypes
+ **********************************************************************************************************************/
+fsp_err_t R_DMAC_Open(transfer_ctrl_t * const p_api_ctrl, transfer_cfg_t const * const p_cfg);
+fsp_err_t R_DMAC_Reconfigure(transfer_ctrl_t * const p_api_ctrl, transfer_info_t * p_info);
+fsp_err_t R_DMAC_Reset(transfer_ctrl_t * const p_api_ctrl,
+                       void const * volatile   p_src,
+                       void * volatile         p_dest,
+                       uint16_t const          num_transfers);
+fsp_err_t R_DMAC_SoftwareStart(transfer_ctrl_t * const p_api_ctrl, transfer_start_mode_t mode);
+fsp_err_t R_DMAC_SoftwareStop(transfer_ctrl_t * const p_api_ctrl);
+fsp_err_t R_DMAC_Enable(transfer_ctrl_t * const p_api_ctrl);
+fsp_err_t R_DMAC_Disable(transfer_ctrl_t * const p_api_ctrl);
+fsp_err_t R_DMAC_InfoGet(transfer_ctrl_t * const p_api_ctrl, transfer_properties_t * const p_info);
+fsp_err_t R_DMAC_Close(transfer_ctrl_t * const p_api_ctrl);
+fsp_err_t R_DMAC_VersionGet(fsp_version_t * const p_version);
+fsp_err_t R_DMAC_CallbackSet(transfer_ctrl_t * const          p_api_ctrl,
+                             void (                         * p_callback)(dmac_callback_args_t *),
+                             void const * const               p_context,
+                             dmac_callback_args_t * const     p_callback_memory);
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup DMAC)
+ **********************************************************************************************************************/
+
+/* Common macro for FSP header files. There is also a corresponding FSP_HEADER macro at the top of this file. */
+FSP_FOOTER
+
+#endif
@@ -103,12 +103,21 @@ typedef struct st_sci_uart_instance_ctrl
 
     /* Pointer to context to be passed into callback function */
     void const * p_context;
+
+#if SCI_UART_CFG_RX_ISR_COUNT
+
+    /* Number of RXI interrupt entries since open. */
+    uint32_t rxi_count;
+#endif
 } sci_uart_instance_ctrl_t;
 
 /** Receive FIFO trigger configuration. */
 typedef enum e_sci_uart_rx_fifo_trigger
 {
     SCI_UART_RX_FIFO_TRIGGER_1   = 0x1, ///< Callback after each byte is received without buffering
+    SCI_UART_RX_FIFO_TRIGGER_4   = 0x4, ///< Interrupt when 4 bytes are in the FIFO or after 15 bit times with no data
+    SCI_UART_RX_FIFO_TRIGGER_8   = 0x8, ///< Interrupt when 8 bytes are in the FIFO or after 15 bit times with no data
+    SCI_UART_RX_FIFO_TRIGGER_12  = 0xC, ///< Interrupt when 12 bytes are in the FIFO or after 15 bit times with no data
     SCI_UART_RX_FIFO_TRIGGER_MAX = 0xF, ///< Callback when FIFO is full or after 15 bit times with no data (fewer interrupts)
 } sci_uart_rx_fifo_trigger_t;
 
@@ -187,6 +196,35 @@ typedef struct st_baud_setting_t
     };
 } baud_setting_t;
 
+/** Number of search passes recorded per mode in the baud setting table. */
+#define SCI_UART_BAUD_TABLE_PASSES    (2U)
+
+/** One precomputed result of the baud rate search. */
+typedef struct st_sci_uart_baud_table_setting
+{
+    baud_setting_t setting;            ///< Register settings found by the search
+    int32_t        error_x_1000;       ///< Absolute bit rate error of setting (percent x 1000)
+} sci_uart_baud_table_setting_t;
+
+/** Precomputed baud settings for one baud rate. */
+typedef struct st_sci_uart_baud_table_entry
+{
+    uint32_t baudrate;                 ///< Baud rate [bps]
+
+    /** Indexed by [bitrate_modulation][pass]. Pass 0 is the result of the search restricted to divisors without
+     * 16 base clock cycles per bit; pass 1 is the result after also searching the remaining divisors, which
+     * R_SCI_UART_BaudCalculate only does when pass 0 misses the requested error. */
+    sci_uart_baud_table_setting_t setting[2][SCI_UART_BAUD_TABLE_PASSES];
+} sci_uart_baud_table_entry_t;
+
+/** Baud setting table, generated for one SCI clock frequency. Entries are sorted by ascending baud rate. */
+typedef struct st_sci_uart_baud_table
+{
+    uint32_t                            clock_hz;    ///< SCI asynchronous clock the table was generated for
+    uint32_t                            num_entries; ///< Number of entries in p_entries
+    sci_uart_baud_table_entry_t const * p_entries;   ///< Table entries
+} sci_uart_baud_table_t;
+
 /** UART on SCI device Configuration */
 typedef struct st_sci_uart_extended_cfg
 {
@@ -214,6 +252,12 @@ extern const uart_api_t g_uart_on_sci;
 
 /** @endcond */
 
+#if SCI_UART_CFG_BAUD_TABLE_ENABLE
+
+/** Precomputed baud setting table (rzn_gen/sci_uart_baud_table.c). */
+extern const sci_uart_baud_table_t g_sci_uart_baud_table;
+#endif
+
 fsp_err_t R_SCI_UART_Open(uart_ctrl_t * const p_api_ctrl, uart_cfg_t const * const p_cfg);
 fsp_err_t R_SCI_UART_Read(uart_ctrl_t * const p_api_ctrl, uint8_t * const p_dest, uint32_t const bytes);
 fsp_err_t R_SCI_UART_Write(uart_ctrl_t * const p_api_ctrl, uint8_t const * const p_src, uint32_t const bytes);
@@ -226,6 +270,10 @@ fsp_err_t R_SCI_UART_BaudCalculate(uint32_t               baudrate,
                                    bool                   bitrate_modulation,
                                    uint32_t               baud_rate_error_x_1000,
                                    baud_setting_t * const p_baud_setting);
+fsp_err_t R_SCI_UART_BaudLookup(uint32_t               baudrate,
+                                bool                   bitrate_modulation,
+                                uint32_t               baud_rate_error_x_1000,
+                                baud_setting_t * const p_baud_setting);
 fsp_err_t R_SCI_UART_CallbackSet(uart_ctrl_t * const          p_api_ctrl,
                                  void (                     * p_callback)(uart_callback_args_t *),
                                  void const * const           p_context,
@@ -0,0 +1,109 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2023] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+#ifndef R_XSPI_QSPI_H
+#define R_XSPI_QSPI_H
+
+/*******************************************************************************************************************//**
+ * @addtogroup XSPI_QSPI
+ * @{
+ **********************************************************************************************************************/
+
+/***********************************************************************************************************************
+ * Includes
+ **********************************************************************************************************************/
+#include "bsp_api.h"
+#include "r_spi_flash_api.h"
+#include "r_xspi_qspi_cfg.h"
+
+/* Common macro for FSP header files. There is also a corresponding FSP_FOOTER macro at the end of this file. */
+FSP_HEADER
+
+/***********************************************************************************************************************
+ * Macro definitions
+ **********************************************************************************************************************/
+#define XSPI_QSPI_CODE_VERSION_MAJOR         (1U) // DEPRECATED
+#define XSPI_QSPI_CODE_VERSION_MINOR         (0U) // DEPRECATED
+
+/** Largest write: the bridge combines up to this many bytes into one page program command. */
+#define XSPI_QSPI_MAX_WRITE_SIZE             (64U)
+
+/**********************************************************************************************************************
+ * Typedef definitions
+ **********************************************************************************************************************/
+
+/** Chip select of the flash. */
+typedef enum e_xspi_qspi_chip_select
+{
+    XSPI_QSPI_CHIP_SELECT_0 = 0,       ///< Flash on CS0
+    XSPI_QSPI_CHIP_SELECT_1 = 1,       ///< Flash on CS1
+} xspi_qspi_chip_select_t;
+
+/** xSPI QSPI configuration extension. This extension is required. */
+typedef struct st_xspi_qspi_extended_cfg
+{
+    uint8_t                 unit;        ///< Unit number (xSPI0 or xSPI1)
+    xspi_qspi_chip_select_t chip_select; ///< Chip select of the flash
+} xspi_qspi_extended_cfg_t;
+
+/** Instance control block. DO NOT INITIALIZE.  Initialization occurs when @ref spi_flash_api_t::open is called */
+typedef struct st_xspi_qspi_instance_ctrl
+{
+    uint32_t open;                     // Driver ID
+
+    spi_flash_cfg_t const * p_cfg;     // Configuration of this instance
+    R_XSPI0_Type          * p_reg;     // Base register of the unit
+    uint8_t                 chip_select;
+} xspi_qspi_instance_ctrl_t;
+
+/**********************************************************************************************************************
+ * Exported global variables
+ **********************************************************************************************************************/
+
+/** @cond INC_HEADER_DEFS_SEC */
+/** Filled in Interface API structure for this Instance. */
+extern const spi_flash_api_t g_spi_flash_on_xspi_qspi;
+
+/** @endcond */
+
+/***********************************************************************************************************************
+ * Public Function Prototypes
+ **********************************************************************************************************************/
+fsp_err_t R_XSPI_QSPI_Open(spi_flash_ctrl_t * p_ctrl, spi_flash_cfg_t const * const p_cfg);
+fsp_err_t R_XSPI_QSPI_DirectTransfer(spi_flash_ctrl_t                    * p_ctrl,
+                                     spi_flash_direct_transfer_t * const   p_transfer,
+                                     spi_flash_direct_transfer_dir_t       direction);
+fsp_err_t R_XSPI_QSPI_Write(spi_flash_ctrl_t    * p_ctrl,
+                            uint8_t const * const p_src,
+                            uint8_t * const       p_dest,
+                            uint32_t              byte_count);
+fsp_err_t R_XSPI_QSPI_Erase(spi_flash_ctrl_t * p_ctrl, uint8_t * const p_device_address, uint32_t byte_count);
+fsp_err_t R_XSPI_QSPI_StatusGet(spi_flash_ctrl_t * p_ctrl, spi_flash_status_t * const p_status);
+fsp_err_t R_XSPI_QSPI_Close(spi_flash_ctrl_t * p_ctrl);
+fsp_err_t R_XSPI_QSPI_VersionGet(fsp_version_t * const p_version);
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup XSPI_QSPI)
+ **********************************************************************************************************************/
+
+/* Common macro for FSP header files. There is also a corresponding FSP_HEADER macro at the top of this file. */
+FSP_FOOTER
+
+#endif
@@ -0,0 +1,801 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2023] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/***********************************************************************************************************************
+ * Includes
+ **********************************************************************************************************************/
+#include "bsp_api.h"
+#include "r_dmac.h"
+
+/***********************************************************************************************************************
+ * Macro definitions
+ **********************************************************************************************************************/
+
+/** Driver ID (DMAC in ASCII), used to identify Data Transfer Controller (DMAC) configuration  */
+#define DMAC_PRV_OPEN                        (0x444D4143U)
+
+#define DMAC_PRV_UNIT1                       (1U)
+#define DMAC_PRV_REG_SET_NEXT0               (0U)
+#define DMAC_PRV_REG_SET_NEXT1               (1U)
+
+/* Channel Control Register bit masks. */
+#define DMAC_PRV_CHCTRL_SETEN                (1U << 0U)
+#define DMAC_PRV_CHCTRL_CLREN                (1U << 1U)
+#define DMAC_PRV_CHCTRL_STG                  (1U << 2U)
+#define DMAC_PRV_CHCTRL_SWRST                (1U << 3U)
+#define DMAC_PRV_CHCTRL_CLRRQ                (1U << 4U)
+#define DMAC_PRV_CHCTRL_CLREND               (1U << 5U)
+#define DMAC_PRV_CHCTRL_CLRTC                (1U << 6U)
+#define DMAC_PRV_CHCTRL_CLRINTM              (1U << 17U)
+
+/* Channel Configuration Register bit offsets and masks. */
+#define DMAC_PRV_CHCFG_SEL_OFFSET            (0U)
+#define DMAC_PRV_CHCFG_SEL_MASK              (0x07U)
+#define DMAC_PRV_CHCFG_REQD_OFFSET           (3U)
+#define DMAC_PRV_CHCFG_DETECT_OFFSET         (4U)
+#define DMAC_PRV_CHCFG_DETECT_MASK           (0x07U)
+#define DMAC_PRV_CHCFG_AM_OFFSET             (8U)
+#define DMAC_PRV_CHCFG_AM_MASK               (0x07U)
+#define DMAC_PRV_CHCFG_SDS_OFFSET            (12U)
+#define DMAC_PRV_CHCFG_DDS_OFFSET            (16U)
+#define DMAC_PRV_CHCFG_DS_MASK               (0x0FU)
+#define DMAC_PRV_CHCFG_SAD_OFFSET            (20U)
+#define DMAC_PRV_CHCFG_DAD_OFFSET            (21U)
+#define DMAC_PRV_CHCFG_TM_OFFSET             (22U)
+#define DMAC_PRV_CHCFG_RSW                   (1U << 29U)
+#define DMAC_PRV_CHCFG_REN                   (1U << 30U)
+
+/* DMAC Resource Select Register: three 10-bit fields per register. */
+#define DMAC_PRV_RSSEL_CHANNELS_PER_REG      (3U)
+#define DMAC_PRV_RSSEL_FIELD_WIDTH           (10U)
+#define DMAC_PRV_RSSEL_REQ_SEL_MASK          (0x1FFU)
+
+/* DMA Control Register bit offsets. */
+#define DMAC_PRV_DCTRL_PR_OFFSET             (0U)
+#define DMAC_PRV_DCTRL_LVINT                 (1U << 1U)
+
+/***********************************************************************************************************************
+ * Typedef definitions
+ **********************************************************************************************************************/
+
+/***********************************************************************************************************************
+ * Private function prototypes
+ **********************************************************************************************************************/
+static fsp_err_t r_dmac_prepare_transfer(dmac_instance_ctrl_t * p_ctrl, transfer_info_t const * p_info);
+static void      r_dmac_register_set_load(dmac_instance_ctrl_t * p_ctrl, uint32_t set_index, uint32_t reg_set);
+static bool      r_dmac_register_set_complete(dmac_instance_ctrl_t * p_ctrl);
+static void      r_dmac_channel_stop(dmac_instance_ctrl_t * p_ctrl);
+
+#if DMAC_CFG_PARAM_CHECKING_ENABLE
+static fsp_err_t r_dmac_open_parameter_checking(dmac_instance_ctrl_t * const p_ctrl,
+                                                transfer_cfg_t const * const p_cfg);
+static fsp_err_t r_dmac_info_parameter_checking(transfer_info_t const * const p_info);
+
+#endif
+
+void dmac_int_isr(void);
+
+/***********************************************************************************************************************
+ * Private global variables
+ **********************************************************************************************************************/
+
+/** DMAC HAL module version data structure */
+static const fsp_version_t g_module_version =
+{
+    .api_version_minor  = TRANSFER_API_VERSION_MINOR,
+    .api_version_major  = TRANSFER_API_VERSION_MAJOR,
+    .code_version_major = DMAC_CODE_VERSION_MAJOR,
+    .code_version_minor = DMAC_CODE_VERSION_MINOR
+};
+
+/***********************************************************************************************************************
+ * Global Variables
+ **********************************************************************************************************************/
+
+/** DMAC implementation of transfer API. */
+const transfer_api_t g_transfer_on_dmac =
+{
+    .open          = R_DMAC_Open,
+    .reconfigure   = R_DMAC_Reconfigure,
+    .reset         = R_DMAC_Reset,
+    .infoGet       = R_DMAC_InfoGet,
+    .softwareStart = R_DMAC_SoftwareStart,
+    .softwareStop  = R_DMAC_SoftwareStop,
+    .enable        = R_DMAC_Enable,
+    .disable       = R_DMAC_Disable,
+    .close         = R_DMAC_Close,
+    .versionGet    = R_DMAC_VersionGet,
+};
+
+/*******************************************************************************************************************//**
+ * @addtogroup DMAC
+ * @{
+ **********************************************************************************************************************/
+
+/***********************************************************************************************************************
+ * Functions
+ **********************************************************************************************************************/
+
+/*******************************************************************************************************************//**
+ * Configure a DMAC channel. The channel is reset, its activation source is selected and the transfer end interrupt
+ * is enabled. The transfer itself is set up and enabled by R_DMAC_Reconfigure or R_DMAC_Reset.
+ * Implements @ref transfer_api_t::open.
+ *
+ * @retval FSP_SUCCESS                    Successful open.
+ * @retval FSP_ERR_ASSERTION              An input parameter is invalid.
+ * @retval FSP_ERR_IP_CHANNEL_NOT_PRESENT The configured unit or channel does not exist.
+ * @retval FSP_ERR_ALREADY_OPEN           The control structure is already opened.
+ **********************************************************************************************************************/
+fsp_err_t R_DMAC_Open (transfer_ctrl_t * const p_api_ctrl, transfer_cfg_t const * const p_cfg)
+{
+    dmac_instance_ctrl_t * p_ctrl = (dmac_instance_ctrl_t *) p_api_ctrl;
+
+#if DMAC_CFG_PARAM_CHECKING_ENABLE
+    fsp_err_t err = r_dmac_open_parameter_checking(p_ctrl, p_cfg);
+    FSP_ERROR_RETURN(FSP_SUCCESS == err, err);
+#endif
+
+    dmac_extended_cfg_t const * p_extend = (dmac_extended_cfg_t const *) p_cfg->p_extend;
+
+    p_ctrl->p_cfg             = p_cfg;
+    p_ctrl->p_reg             = (DMAC_PRV_UNIT1 == p_extend->unit) ? R_DMAC1 : R_DMAC0;
+    p_ctrl->p_info            = p_cfg->p_info;
+    p_ctrl->sets_total        = 0U;
+    p_ctrl->sets_loaded       = 0U;
+    p_ctrl->sets_done         = 0U;
+    p_ctrl->software_repeat   = 0U;
+    p_ctrl->p_callback        = p_extend->p_callback;
+    p_ctrl->p_context         = p_extend->p_context;
+    p_ctrl->p_callback_memory = NULL;
+
+    r_dmac_channel_stop(p_ctrl);
+
+    /* Select the activation source of the channel. */
+    uint32_t            shift    = (p_extend->channel % DMAC_PRV_RSSEL_CHANNELS_PER_REG) * DMAC_PRV_RSSEL_FIELD_WIDTH;
+    uint32_t            reg_num  = p_extend->channel / DMAC_PRV_RSSEL_CHANNELS_PER_REG;
+    volatile uint32_t * p_rssel  = (DMAC_PRV_UNIT1 == p_extend->unit) ? &R_DMA->DMAC1_RSSEL[reg_num] :
+                                   &R_DMA->DMAC0_RSSEL[reg_num];
+    uint32_t            rssel    = *p_rssel;
+    rssel   &= ~(DMAC_PRV_RSSEL_REQ_SEL_MASK << shift);
+    rssel   |= ((uint32_t) p_extend->activation_source & DMAC_PRV_RSSEL_REQ_SEL_MASK) << shift;
+    *p_rssel = rssel;
+
+    /* Channel priority and level interrupt output for the unit. */
+    p_ctrl->p_reg->GRP[0].DCTRL = ((uint32_t) p_extend->channel_scheduling << DMAC_PRV_DCTRL_PR_OFFSET) |
+                                  DMAC_PRV_DCTRL_LVINT;
+
+    if (p_extend->dmac_int_irq >= 0)
+    {
+        R_BSP_IrqCfgEnable(p_extend->dmac_int_irq, p_extend->dmac_int_ipl, p_ctrl);
+    }
+
+    p_ctrl->open = DMAC_PRV_OPEN;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * Reconfigure the transfer with new transfer info and enable it. Implements @ref transfer_api_t::reconfigure.
+ *
+ * In repeat and block mode the transfer is executed as transfer_info_t::num_blocks register sets of
+ * transfer_info_t::length bytes each (num_blocks = 0 repeats endlessly). If transfer_info_t::chain_mode is
+ * TRANSFER_CHAIN_MODE_END, p_info is an array and the transfer continues with the next element until an element
+ * with TRANSFER_CHAIN_MODE_DISABLED has been transferred. Chained elements share the sizes and address modes of the
+ * first element.
+ *
+ * @retval FSP_SUCCESS              Transfer is configured and will start when trigger occurs.
+ * @retval FSP_ERR_ASSERTION        An input parameter is invalid.
+ * @retval FSP_ERR_NOT_OPEN         Handle is not initialized.  Call R_DMAC_Open to initialize the control block.
+ * @retval FSP_ERR_UNSUPPORTED      Address mode or chain mode is not supported by the DMAC.
+ **********************************************************************************************************************/
+fsp_err_t R_DMAC_Reconfigure (transfer_ctrl_t * const p_api_ctrl, transfer_info_t * p_info)
+{
+    dmac_instance_ctrl_t * p_ctrl = (dmac_instance_ctrl_t *) p_api_ctrl;
+
+#if DMAC_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_ctrl);
+    FSP_ERROR_RETURN(DMAC_PRV_OPEN == p_ctrl->open, FSP_ERR_NOT_OPEN);
+    fsp_err_t err = r_dmac_info_parameter_checking(p_info);
+    FSP_ERROR_RETURN(FSP_SUCCESS == err, err);
+#endif
+
+    fsp_err_t ret = r_dmac_prepare_transfer(p_ctrl, p_info);
+    FSP_ERROR_RETURN(FSP_SUCCESS == ret, ret);
+
+    return R_DMAC_Enable(p_ctrl);
+}
+
+/*******************************************************************************************************************//**
+ * Reset transfer source, destination, and number of transfers, then enable the transfer.
+ * Implements @ref transfer_api_t::reset.
+ *
+ * @retval FSP_SUCCESS              Transfer reset successfully.
+ * @retval FSP_ERR_ASSERTION        An input parameter is invalid.
+ * @retval FSP_ERR_NOT_OPEN         Handle is not initialized.  Call R_DMAC_Open to initialize the control block.
+ **********************************************************************************************************************/
+fsp_err_t R_DMAC_Reset (transfer_ctrl_t * const p_api_ctrl,
+                        void const * volatile   p_src,
+                        void * volatile         p_dest,
+                        uint16_t const          num_transfers)
+{
+    dmac_instance_ctrl_t * p_ctrl = (dmac_instance_ctrl_t *) p_api_ctrl;
+
+#if DMAC_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_ctrl);
+    FSP_ERROR_RETURN(DMAC_PRV_OPEN == p_ctrl->open, FSP_ERR_NOT_OPEN);
+    FSP_ASSERT(0U != num_transfers);
+#endif
+
+    transfer_info_t * p_info = p_ctrl->p_cfg->p_info;
+
+    if (NULL != p_src)
+    {
+        p_info->p_src = p_src;
+    }
+
+    if (NULL != p_dest)
+    {
+        p_info->p_dest = p_dest;
+    }
+
+    /* Length in normal mode, number of blocks or repeats otherwise. */
+    if (TRANSFER_MODE_NORMAL == p_info->mode)
+    {
+        p_info->length = num_transfers;
+    }
+    else
+    {
+        p_info->num_blocks = num_transfers;
+    }
+
+    fsp_err_t err = r_dmac_prepare_transfer(p_ctrl, p_info);
+    FSP_ERROR_RETURN(FSP_SUCCESS == err, err);
+
+    return R_DMAC_Enable(p_ctrl);
+}
+
+/*******************************************************************************************************************//**
+ * Start a transfer by software. Only available if the activation source is ELC_EVENT_NONE.
+ * Implements @ref transfer_api_t::softwareStart.
+ *
+ * @param[in] p_api_ctrl  Control block set in @ref transfer_api_t::open call for this transfer.
+ * @param[in] mode        TRANSFER_START_MODE_SINGLE transfers one register set (one block, repeat or chain link).
+ *                        TRANSFER_START_MODE_REPEAT continues until the whole transfer is complete.
+ *
+ * @retval FSP_SUCCESS              Transfer started successfully.
+ * @retval FSP_ERR_ASSERTION        An input parameter is invalid.
+ * @retval FSP_ERR_NOT_OPEN         Handle is not initialized.  Call R_DMAC_Open to initialize the control block.
+ * @retval FSP_ERR_UNSUPPORTED      Handle was not configured for software activation.
+ **********************************************************************************************************************/
+fsp_err_t R_DMAC_SoftwareStart (transfer_ctrl_t * const p_api_ctrl, transfer_start_mode_t mode)
+{
+    dmac_instance_ctrl_t * p_ctrl = (dmac_instance_ctrl_t *) p_api_ctrl;
+
+#if DMAC_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_ctrl);
+    FSP_ERROR_RETURN(DMAC_PRV_OPEN == p_ctrl->open, FSP_ERR_NOT_OPEN);
+#endif
+
+    dmac_extended_cfg_t const * p_extend = (dmac_extended_cfg_t const *) p_ctrl->p_cfg->p_extend;
+    FSP_ERROR_RETURN(ELC_EVENT_NONE == p_extend->activation_source, FSP_ERR_UNSUPPORTED);
+
+    p_ctrl->software_repeat = (TRANSFER_START_MODE_REPEAT == mode) ? 1U : 0U;
+
+    p_ctrl->p_reg->GRP[0].CH[p_extend->channel].CHCTRL = DMAC_PRV_CHCTRL_SETEN | DMAC_PRV_CHCTRL_STG;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * Stop a software started transfer after the current register set. Implements @ref transfer_api_t::softwareStop.
+ *
+ * @retval FSP_SUCCESS              Transfer stopped successfully.
+ * @retval FSP_ERR_ASSERTION        An input parameter is invalid.
+ * @retval FSP_ERR_NOT_OPEN         Handle is not initialized.  Call R_DMAC_Open to initialize the control block.
+ **********************************************************************************************************************/
+fsp_err_t R_DMAC_SoftwareStop (transfer_ctrl_t * const p_api_ctrl)
+{
+    dmac_instance_ctrl_t * p_ctrl = (dmac_instance_ctrl_t *) p_api_ctrl;
+
+#if DMAC_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_ctrl);
+    FSP_ERROR_RETURN(DMAC_PRV_OPEN == p_ctrl->open, FSP_ERR_NOT_OPEN);
+#endif
+
+    p_ctrl->software_repeat = 0U;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * Enable transfers for the configured activation source. Implements @ref transfer_api_t::enable.
+ *
+ * @retval FSP_SUCCESS              Counter value written successfully.
+ * @retval FSP_ERR_ASSERTION        An input parameter is invalid.
+ * @retval FSP_ERR_NOT_OPEN         Handle is not initialized.  Call R_DMAC_Open to initialize the control block.
+ **********************************************************************************************************************/
+fsp_err_t R_DMAC_Enable (transfer_ctrl_t * const p_api_ctrl)
+{
+    dmac_instance_ctrl_t * p_ctrl = (dmac_instance_ctrl_t *) p_api_ctrl;
+
+#if DMAC_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_ctrl);
+    FSP_ERROR_RETURN(DMAC_PRV_OPEN == p_ctrl->open, FSP_ERR_NOT_OPEN);
+#endif
+
+    dmac_extended_cfg_t const * p_extend = (dmac_extended_cfg_t const *) p_ctrl->p_cfg->p_extend;
+
+    /* Software started transfers are enabled by R_DMAC_SoftwareStart. */
+    if (ELC_EVENT_NONE != p_extend->activation_source)
+    {
+        p_ctrl->p_reg->GRP[0].CH[p_extend->channel].CHCTRL = DMAC_PRV_CHCTRL_SETEN;
+    }
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * Disable transfer. Implements @ref transfer_api_t::disable.
+ *
+ * @retval FSP_SUCCESS              Counter value written successfully.
+ * @retval FSP_ERR_ASSERTION        An input parameter is invalid.
+ * @retval FSP_ERR_NOT_OPEN         Handle is not initialized.  Call R_DMAC_Open to initialize the control block.
+ **********************************************************************************************************************/
+fsp_err_t R_DMAC_Disable (transfer_ctrl_t * const p_api_ctrl)
+{
+    dmac_instance_ctrl_t * p_ctrl = (dmac_instance_ctrl_t *) p_api_ctrl;
+
+#if DMAC_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_ctrl);
+    FSP_ERROR_RETURN(DMAC_PRV_OPEN == p_ctrl->open, FSP_ERR_NOT_OPEN);
+#endif
+
+    dmac_extended_cfg_t const * p_extend = (dmac_extended_cfg_t const *) p_ctrl->p_cfg->p_extend;
+
+    p_ctrl->software_repeat = 0U;
+
+    /* Clear the enable bit and wait for the transfer in progress to finish. */
+    p_ctrl->p_reg->GRP[0].CH[p_extend->channel].CHCTRL = DMAC_PRV_CHCTRL_CLREN;
+    FSP_HARDWARE_REGISTER_WAIT(p_ctrl->p_reg->GRP[0].CH[p_extend->channel].CHSTAT_b.TACT, 0U);
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * Set driver specific information in provided pointer. Implements @ref transfer_api_t::infoGet.
+ *
+ * transfer_length_remaining is the number of bytes left in the register set being transferred.
+ * block_count_remaining is the number of register sets (blocks, repeats or chain links) not yet completed, or
+ * DMAC_MAX_BLOCK_TRANSFER_NUMBER for an endless repeat.
+ *
+ * @retval FSP_SUCCESS              Information has been written to p_info.
+ * @retval FSP_ERR_NOT_OPEN         Handle is not initialized.  Call R_DMAC_Open to initialize the control block.
+ * @retval FSP_ERR_ASSERTION        An input parameter is invalid.
+ **********************************************************************************************************************/
+fsp_err_t R_DMAC_InfoGet (transfer_ctrl_t * const p_api_ctrl, transfer_properties_t * const p_info)
+{
+    dmac_instance_ctrl_t * p_ctrl = (dmac_instance_ctrl_t *) p_api_ctrl;
+
+#if DMAC_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_ctrl);
+    FSP_ERROR_RETURN(DMAC_PRV_OPEN == p_ctrl->open, FSP_ERR_NOT_OPEN);
+    FSP_ASSERT(NULL != p_info);
+#endif
+
+    dmac_extended_cfg_t const * p_extend = (dmac_extended_cfg_t const *) p_ctrl->p_cfg->p_extend;
+
+    p_info->block_count_max       = DMAC_MAX_BLOCK_TRANSFER_NUMBER;
+    p_info->block_count_remaining = (0U == p_ctrl->sets_total) ? DMAC_MAX_BLOCK_TRANSFER_NUMBER :
+                                    (p_ctrl->sets_total - p_ctrl->sets_done);
+    p_info->transfer_length_max       = DMAC_MAX_NORMAL_TRANSFER_LENGTH;
+    p_info->transfer_length_remaining = p_ctrl->p_reg->GRP[0].CH[p_extend->channel].CRTB;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * Disable transfer and clean up internal data. Implements @ref transfer_api_t::close.
+ *
+ * @retval FSP_SUCCESS              Successful close.
+ * @retval FSP_ERR_ASSERTION        An input parameter is invalid.
+ * @retval FSP_ERR_NOT_OPEN         Handle is not initialized.  Call R_DMAC_Open to initialize the control block.
+ **********************************************************************************************************************/
+fsp_err_t R_DMAC_Close (transfer_ctrl_t * const p_api_ctrl)
+{
+    dmac_instance_ctrl_t * p_ctrl = (dmac_instance_ctrl_t *) p_api_ctrl;
+
+#if DMAC_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_ctrl);
+    FSP_ERROR_RETURN(DMAC_PRV_OPEN == p_ctrl->open, FSP_ERR_NOT_OPEN);
+#endif
+
+    dmac_extended_cfg_t const * p_extend = (dmac_extended_cfg_t const *) p_ctrl->p_cfg->p_extend;
+
+    r_dmac_channel_stop(p_ctrl);
+
+    if (p_extend->dmac_int_irq >= 0)
+    {
+        R_BSP_IrqDisable(p_extend->dmac_int_irq);
+        R_FSP_IsrContextSet(p_extend->dmac_int_irq, NULL);
+    }
+
+    p_ctrl->open = 0U;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * DEPRECATED Set driver version based on compile time macros. Implements @ref transfer_api_t::versionGet.
+ *
+ * @retval FSP_SUCCESS              Successful close.
+ * @retval FSP_ERR_ASSERTION        An input parameter is invalid.
+ **********************************************************************************************************************/
+fsp_err_t R_DMAC_VersionGet (fsp_version_t * const p_version)
+{
+#if DMAC_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_version);
+#endif
+
+    p_version->version_id = g_module_version.version_id;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * Updates the user callback with the option to provide memory for the callback argument structure.
+ *
+ * @retval  FSP_SUCCESS                  Callback updated successfully.
+ * @retval  FSP_ERR_ASSERTION            A required pointer is NULL.
+ * @retval  FSP_ERR_NOT_OPEN             The control block has not been opened.
+ **********************************************************************************************************************/
+fsp_err_t R_DMAC_CallbackSet (transfer_ctrl_t * const          p_api_ctrl,
+                              void (                         * p_callback)(dmac_callback_args_t *),
+                              void const * const               p_context,
+                              dmac_callback_args_t * const     p_callback_memory)
+{
+    dmac_instance_ctrl_t * p_ctrl = (dmac_instance_ctrl_t *) p_api_ctrl;
+
+#if DMAC_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(p_ctrl);
+    FSP_ASSERT(p_callback);
+    FSP_ERROR_RETURN(DMAC_PRV_OPEN == p_ctrl->open, FSP_ERR_NOT_OPEN);
+#endif
+
+    p_ctrl->p_callback        = p_callback;
+    p_ctrl->p_context         = p_context;
+    p_ctrl->p_callback_memory = p_callback_memory;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup DMAC)
+ **********************************************************************************************************************/
+
+/***********************************************************************************************************************
+ * Private Functions
+ **********************************************************************************************************************/
+
+/*******************************************************************************************************************//**
+ * Stop the channel and reset its status.
+ *
+ * @param[in]  p_ctrl                    Pointer to control structure.
+ **********************************************************************************************************************/
+static void r_dmac_channel_stop (dmac_instance_ctrl_t * p_ctrl)
+{
+    dmac_extended_cfg_t const    * p_extend = (dmac_extended_cfg_t const *) p_ctrl->p_cfg->p_extend;
+    R_DMAC0_GRP_CH_Type volatile * p_ch     = &p_ctrl->p_reg->GRP[0].CH[p_extend->channel];
+
+    p_ch->CHCTRL = DMAC_PRV_CHCTRL_CLREN;
+    FSP_HARDWARE_REGISTER_WAIT(p_ch->CHSTAT_b.TACT, 0U);
+    p_ch->CHCTRL = DMAC_PRV_CHCTRL_SWRST | DMAC_PRV_CHCTRL_CLRRQ | DMAC_PRV_CHCTRL_CLRINTM;
+}
+
+/*******************************************************************************************************************//**
+ * Stop the channel and program the register sets and channel configuration for the transfer described by p_info.
+ * The transfer is not enabled.
+ *
+ * @param[in]  p_ctrl                    Pointer to control structure.
+ * @param[in]  p_info                    Transfer information (first element if chained).
+ *
+ * @retval FSP_SUCCESS                   Transfer is programmed.
+ * @retval FSP_ERR_UNSUPPORTED           Address mode or chain mode is not supported by the DMAC.
+ **********************************************************************************************************************/
+static fsp_err_t r_dmac_prepare_transfer (dmac_instance_ctrl_t * p_ctrl, transfer_info_t const * p_info)
+{
+    dmac_extended_cfg_t const * p_extend = (dmac_extended_cfg_t const *) p_ctrl->p_cfg->p_extend;
+
+    /* The DMAC can only increment or keep an address. */
+    FSP_ERROR_RETURN((TRANSFER_ADDR_MODE_FIXED == p_info->src_addr_mode) ||
+                     (TRANSFER_ADDR_MODE_INCREMENTED == p_info->src_addr_mode), FSP_ERR_UNSUPPORTED);
+    FSP_ERROR_RETURN((TRANSFER_ADDR_MODE_FIXED == p_info->dest_addr_mode) ||
+                     (TRANSFER_ADDR_MODE_INCREMENTED == p_info->dest_addr_mode), FSP_ERR_UNSUPPORTED);
+
+    /* Register sets are switched at the end of a set only; chaining after each transfer is not possible. */
+    FSP_ERROR_RETURN(TRANSFER_CHAIN_MODE_EACH != p_info->chain_mode, FSP_ERR_UNSUPPORTED);
+
+    uint32_t sets_total = 1U;
+    if (TRANSFER_CHAIN_MODE_END == p_info->chain_mode)
+    {
+        /* Chains are only supported in normal mode. */
+        FSP_ERROR_RETURN(TRANSFER_MODE_NORMAL == p_info->mode, FSP_ERR_UNSUPPORTED);
+
+        while (TRANSFER_CHAIN_MODE_DISABLED != p_info[sets_total - 1U].chain_mode)
+        {
+            sets_total++;
+        }
+    }
+    else if (TRANSFER_MODE_NORMAL != p_info->mode)
+    {
+        /* Repeat and block mode: one register set per repeat or block, 0 repeats endlessly. */
+        sets_total = p_info->num_blocks;
+    }
+    else
+    {
+        /* Normal mode: one register set. */
+    }
+
+    /* Transfer sizes from the extension, defaulting to the size in the transfer settings. */
+    dmac_extended_info_t const * p_info_extend = (dmac_extended_info_t const *) p_info->p_extend;
+    uint32_t                     src_size      = (uint32_t) p_info->size;
+    uint32_t                     dest_size     = (uint32_t) p_info->size;
+    if (NULL != p_info_extend)
+    {
+        src_size  = (uint32_t) p_info_extend->src_size;
+        dest_size = (uint32_t) p_info_extend->dest_size;
+    }
+
+    /* Block transfers move a whole register set per request. Software started transfers always do, since each
+     * software trigger is one request. */
+    uint32_t block_transfer = ((TRANSFER_MODE_BLOCK == p_info->mode) ||
+                               (ELC_EVENT_NONE == p_extend->activation_source)) ? 1U : 0U;
+
+    uint32_t chcfg = 0U;
+    chcfg |= ((uint32_t) p_extend->channel & DMAC_PRV_CHCFG_SEL_MASK) << DMAC_PRV_CHCFG_SEL_OFFSET;
+    chcfg |= (uint32_t) p_extend->activation_request_source_select << DMAC_PRV_CHCFG_REQD_OFFSET;
+    chcfg |= ((uint32_t) p_extend->detection_mode & DMAC_PRV_CHCFG_DETECT_MASK) << DMAC_PRV_CHCFG_DETECT_OFFSET;
+    chcfg |= ((uint32_t) p_extend->ack_mode & DMAC_PRV_CHCFG_AM_MASK) << DMAC_PRV_CHCFG_AM_OFFSET;
+    chcfg |= (src_size & DMAC_PRV_CHCFG_DS_MASK) << DMAC_PRV_CHCFG_SDS_OFFSET;
+    chcfg |= (dest_size & DMAC_PRV_CHCFG_DS_MASK) << DMAC_PRV_CHCFG_DDS_OFFSET;
+    chcfg |= ((TRANSFER_ADDR_MODE_FIXED == p_info->src_addr_mode) ? 1U : 0U) << DMAC_PRV_CHCFG_SAD_OFFSET;
+    chcfg |= ((TRANSFER_ADDR_MODE_FIXED == p_info->dest_addr_mode) ? 1U : 0U) << DMAC_PRV_CHCFG_DAD_OFFSET;
+    chcfg |= block_transfer << DMAC_PRV_CHCFG_TM_OFFSET;
+
+    /* More than one register set: continue with the other register set at the end of each set. The register set
+     * that just finished is reloaded from the transfer end interrupt. */
+    if (1U != sets_total)
+    {
+        chcfg |= DMAC_PRV_CHCFG_REN | DMAC_PRV_CHCFG_RSW;
+    }
+
+    r_dmac_channel_stop(p_ctrl);
+
+    p_ctrl->p_info          = p_info;
+    p_ctrl->sets_total      = sets_total;
+    p_ctrl->sets_done       = 0U;
+    p_ctrl->software_repeat = 0U;
+
+    r_dmac_register_set_load(p_ctrl, 0U, DMAC_PRV_REG_SET_NEXT0);
+    p_ctrl->sets_loaded = 1U;
+    if (1U != sets_total)
+    {
+        r_dmac_register_set_load(p_ctrl, 1U, DMAC_PRV_REG_SET_NEXT1);
+        p_ctrl->sets_loaded = 2U;
+    }
+
+    R_DMAC0_GRP_CH_Type volatile * p_ch = &p_ctrl->p_reg->GRP[0].CH[p_extend->channel];
+    p_ch->CHCFG  = chcfg;
+    p_ch->CHITVL = 0U;
+    p_ch->CHEXT  = 0U;
+    p_ch->NXLA   = 0U;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * Load the addresses and byte count of one register set of the transfer sequence.
+ *
+ * @param[in]  p_ctrl                    Pointer to control structure.
+ * @param[in]  set_index                 Index of the register set in the sequence.
+ * @param[in]  reg_set                   Next0 or Next1 register set.
+ **********************************************************************************************************************/
+static void r_dmac_register_set_load (dmac_instance_ctrl_t * p_ctrl, uint32_t set_index, uint32_t reg_set)
+{
+    dmac_extended_cfg_t const * p_extend = (dmac_extended_cfg_t const *) p_ctrl->p_cfg->p_extend;
+    transfer_info_t const     * p_info   = p_ctrl->p_info;
+    uint32_t                    src;
+    uint32_t                    dest;
+
+    if (TRANSFER_CHAIN_MODE_DISABLED != p_info->chain_mode)
+    {
+        /* Chain: each register set is the next element of the transfer info array. */
+        p_info = &p_info[set_index];
+        src    = (uint32_t) p_info->p_src;
+        dest   = (uint32_t) p_info->p_dest;
+    }
+    else
+    {
+        src  = (uint32_t) p_info->p_src;
+        dest = (uint32_t) p_info->p_dest;
+
+        /* Repeat and block mode: the repeat area returns to its start for every set, the other side continues. */
+        if (TRANSFER_MODE_NORMAL != p_info->mode)
+        {
+            uint32_t offset = set_index * p_info->length;
+            if (TRANSFER_REPEAT_AREA_SOURCE == p_info->repeat_area)
+            {
+                if (TRANSFER_ADDR_MODE_INCREMENTED == p_info->dest_addr_mode)
+                {
+                    dest += offset;
+                }
+            }
+            else
+            {
+                if (TRANSFER_ADDR_MODE_INCREMENTED == p_info->src_addr_mode)
+                {
+                    src += offset;
+                }
+            }
+        }
+    }
+
+    R_DMAC0_GRP_CH_N_Type volatile * p_set = &p_ctrl->p_reg->GRP[0].CH[p_extend->channel].N[reg_set];
+    p_set->SA = src;
+    p_set->DA = dest;
+    p_set->TB = p_info->length;
+}
+
+/*******************************************************************************************************************//**
+ * Advance the register set sequence after a register set completed.
+ *
+ * @param[in]  p_ctrl                    Pointer to control structure.
+ *
+ * @retval true                          The whole transfer is complete.
+ * @retval false                         More register sets follow.
+ **********************************************************************************************************************/
+static bool r_dmac_register_set_complete (dmac_instance_ctrl_t * p_ctrl)
+{
+    dmac_extended_cfg_t const    * p_extend = (dmac_extended_cfg_t const *) p_ctrl->p_cfg->p_extend;
+    R_DMAC0_GRP_CH_Type volatile * p_ch     = &p_ctrl->p_reg->GRP[0].CH[p_extend->channel];
+
+    /* Register sets alternate starting with Next0, so the set that just finished is known from the count. */
+    uint32_t finished_set = p_ctrl->sets_done & 1U;
+    p_ctrl->sets_done++;
+
+    if ((0U != p_ctrl->sets_total) && (p_ctrl->sets_done >= p_ctrl->sets_total))
+    {
+        return true;
+    }
+
+    /* Reload the finished register set with the set after the one now running. */
+    if ((0U == p_ctrl->sets_total) || (p_ctrl->sets_loaded < p_ctrl->sets_total))
+    {
+        r_dmac_register_set_load(p_ctrl, p_ctrl->sets_loaded, finished_set);
+        p_ctrl->sets_loaded++;
+    }
+
+    /* The last register set is running: do not continue after it. */
+    if ((0U != p_ctrl->sets_total) && ((p_ctrl->sets_done + 1U) == p_ctrl->sets_total))
+    {
+        p_ch->CHCFG &= ~DMAC_PRV_CHCFG_REN;
+    }
+
+    if (0U != p_ctrl->software_repeat)
+    {
+        p_ch->CHCTRL = DMAC_PRV_CHCTRL_STG;
+    }
+
+    return false;
+}
+
+#if DMAC_CFG_PARAM_CHECKING_ENABLE
+
+/*******************************************************************************************************************//**
+ * Parameter checking of R_DMAC_Open.
+ *
+ * @param[in]  p_ctrl                    Pointer to control structure.
+ * @param[in]  p_cfg                     Pointer to configuration structure. All elements of the structure must be
+ *                                       set by user.
+ *
+ * @retval FSP_SUCCESS                    Input Parameters are Valid.
+ * @retval FSP_ERR_ASSERTION              An input parameter is invalid.
+ * @retval FSP_ERR_IP_CHANNEL_NOT_PRESENT The configured unit or channel does not exist.
+ * @retval FSP_ERR_ALREADY_OPEN           The control structure is already opened.
+ **********************************************************************************************************************/
+static fsp_err_t r_dmac_open_parameter_checking (dmac_instance_ctrl_t * const p_ctrl,
+                                                 transfer_cfg_t const * const p_cfg)
+{
+    FSP_ASSERT(NULL != p_ctrl);
+    FSP_ERROR_RETURN(DMAC_PRV_OPEN != p_ctrl->open, FSP_ERR_ALREADY_OPEN);
+    FSP_ASSERT(NULL != p_cfg);
+    FSP_ASSERT(NULL != p_cfg->p_info);
+    FSP_ASSERT(NULL != p_cfg->p_extend);
+
+    dmac_extended_cfg_t const * p_extend = (dmac_extended_cfg_t const *) p_cfg->p_extend;
+    FSP_ERROR_RETURN(p_extend->unit < BSP_FEATURE_DMAC_MAX_UNIT, FSP_ERR_IP_CHANNEL_NOT_PRESENT);
+    FSP_ERROR_RETURN(p_extend->channel < BSP_FEATURE_DMAC_MAX_CHANNEL, FSP_ERR_IP_CHANNEL_NOT_PRESENT);
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * Checks for errors in the transfer info.
+ *
+ * @param[in]  p_info                    Pointer to transfer info.
+ *
+ * @retval FSP_SUCCESS                   The parameter is valid.
+ * @retval FSP_ERR_ASSERTION             An input parameter is invalid.
+ **********************************************************************************************************************/
+static fsp_err_t r_dmac_info_parameter_checking (transfer_info_t const * const p_info)
+{
+    FSP_ASSERT(NULL != p_info);
+    FSP_ASSERT(0U != p_info->length);
+    FSP_ASSERT((TRANSFER_MODE_BLOCK != p_info->mode) || (0U != p_info->num_blocks));
+
+    return FSP_SUCCESS;
+}
+
+#endif
+
+/*******************************************************************************************************************//**
+ * DMAC transfer end interrupt. Advances multi register set transfers, then calls the peripheral module handler and
+ * the user callback when the transfer is complete. In endless repeat mode, or with TRANSFER_IRQ_EACH, the user
+ * callback is called at the end of every register set.
+ **********************************************************************************************************************/
+void dmac_int_isr (void)
+{
+    /* Save context if RTOS is used */
+    FSP_CONTEXT_SAVE;
+
+    IRQn_Type irq = R_FSP_CurrentIrqGet();
+
+    /* Recover ISR context saved in open. */
+    dmac_instance_ctrl_t      * p_ctrl   = (dmac_instance_ctrl_t *) R_FSP_IsrContextGet(irq);
+    dmac_extended_cfg_t const * p_extend = (dmac_extended_cfg_t const *) p_ctrl->p_cfg->p_extend;
+
+    /* Clear the transfer end flag. */
+    p_ctrl->p_reg->GRP[0].CH[p_extend->channel].CHCTRL = DMAC_PRV_CHCTRL_CLREND;
+
+    bool complete = r_dmac_register_set_complete(p_ctrl);
+
+    if (complete && (NULL != p_extend->p_peripheral_module_handler))
+    {
+        /* The activation source number is the interrupt number of the requesting peripheral. */
+        p_extend->p_peripheral_module_handler((IRQn_Type) p_extend->activation_source);
+    }
+
+    if ((NULL != p_ctrl->p_callback) &&
+        (complete || (0U == p_ctrl->sets_total) || (TRANSFER_IRQ_EACH == p_ctrl->p_info->irq)))
+    {
+        /* Use callback memory if provided, otherwise use a local variable. */
+        dmac_callback_args_t   args;
+        dmac_callback_args_t * p_args = p_ctrl->p_callback_memory;
+        if (NULL == p_args)
+        {
+            p_args = &args;
+        }
+
+        p_args->p_context = p_ctrl->p_context;
+        p_ctrl->p_callback(p_args);
+    }
+
+    /* Restore context if RTOS is used */
+    FSP_CONTEXT_RESTORE;
+}
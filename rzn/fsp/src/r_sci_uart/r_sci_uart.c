@@ -385,6 +385,9 @@ fsp_err_t R_SCI_UART_Open (uart_ctrl_t * const p_api_ctrl, uart_cfg_t const * co
 #endif
 
     p_ctrl->fifo_depth = 0U;
+#if SCI_UART_CFG_RX_ISR_COUNT
+    p_ctrl->rxi_count = 0U;
+#endif
 #if SCI_UART_CFG_FIFO_SUPPORT
 
     /* Check if the channel supports fifo */
@@ -1175,6 +1178,83 @@ fsp_err_t R_SCI_UART_BaudCalculate (uint32_t               baudrate,
     return FSP_SUCCESS;
 }
 
+/*******************************************************************************************************************//**
+ * Looks up baud rate register settings in the precomputed table g_sci_uart_baud_table. The result is identical to
+ * R_SCI_UART_BaudCalculate; the search is only run for baud rates that are not in the table, or when the table was
+ * generated for a clock other than the SCI asynchronous clock.
+ *
+ * @param[in]  baudrate                  Baud rate [bps]. For example, 19200, 57600, 115200, etc.
+ * @param[in]  bitrate_modulation        Enable bitrate modulation
+ * @param[in]  baud_rate_error_x_1000    &lt;baud_rate_percent_error&gt; x 1000 required for module to function.
+ *                                       Absolute max baud_rate_error is 15000 (15%).
+ * @param[out] p_baud_setting            Baud setting information stored here if successful
+ *
+ * @retval     FSP_SUCCESS               Baud rate is set successfully
+ * @retval     FSP_ERR_ASSERTION         Null pointer
+ * @retval     FSP_ERR_INVALID_ARGUMENT  Baud rate is '0', or error in calculated baud rate is larger than requested.
+ **********************************************************************************************************************/
+fsp_err_t R_SCI_UART_BaudLookup (uint32_t               baudrate,
+                                 bool                   bitrate_modulation,
+                                 uint32_t               baud_rate_error_x_1000,
+                                 baud_setting_t * const p_baud_setting)
+{
+#if SCI_UART_CFG_BAUD_TABLE_ENABLE
+ #if (SCI_UART_CFG_PARAM_CHECKING_ENABLE)
+    FSP_ASSERT(p_baud_setting);
+    FSP_ERROR_RETURN(SCI_UART_MAX_BAUD_RATE_ERROR_X_1000 > baud_rate_error_x_1000, FSP_ERR_INVALID_ARGUMENT);
+    FSP_ERROR_RETURN((0U != baudrate), FSP_ERR_INVALID_ARGUMENT);
+ #endif
+
+    sci_uart_baud_table_t const * p_table = &g_sci_uart_baud_table;
+
+    if (SCI_UART_CLOCK_96MHZ == p_table->clock_hz)
+    {
+        /* Binary search for the baud rate. Entries are sorted in ascending order. */
+        uint32_t lo = 0U;
+        uint32_t hi = p_table->num_entries;
+        while (lo < hi)
+        {
+            uint32_t mid = (lo + hi) >> 1;
+            if (p_table->p_entries[mid].baudrate < baudrate)
+            {
+                lo = mid + 1U;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+
+        if ((lo < p_table->num_entries) && (baudrate == p_table->p_entries[lo].baudrate))
+        {
+            /* The search only runs its second pass if the first one misses the requested error. */
+            sci_uart_baud_table_setting_t const * p_hit = &p_table->p_entries[lo].setting[bitrate_modulation][0];
+            if (p_hit->error_x_1000 > (int32_t) baud_rate_error_x_1000)
+            {
+                p_hit = &p_table->p_entries[lo].setting[bitrate_modulation][1];
+            }
+
+            /* Only update the fields R_SCI_UART_BaudCalculate writes. */
+            p_baud_setting->baudrate_bits_b.bgdm  = p_hit->setting.baudrate_bits_b.bgdm;
+            p_baud_setting->baudrate_bits_b.abcs  = p_hit->setting.baudrate_bits_b.abcs;
+            p_baud_setting->baudrate_bits_b.abcse = p_hit->setting.baudrate_bits_b.abcse;
+            p_baud_setting->baudrate_bits_b.cks   = p_hit->setting.baudrate_bits_b.cks;
+            p_baud_setting->baudrate_bits_b.brr   = p_hit->setting.baudrate_bits_b.brr;
+            p_baud_setting->baudrate_bits_b.brme  = p_hit->setting.baudrate_bits_b.brme;
+            p_baud_setting->baudrate_bits_b.mddr  = p_hit->setting.baudrate_bits_b.mddr;
+
+            /* Return an error if the percent error is larger than the maximum percent error allowed */
+            FSP_ERROR_RETURN((p_hit->error_x_1000 <= (int32_t) baud_rate_error_x_1000), FSP_ERR_INVALID_ARGUMENT);
+
+            return FSP_SUCCESS;
+        }
+    }
+#endif
+
+    /* Not in the table: fall back to the search. */
+    return R_SCI_UART_BaudCalculate(baudrate, bitrate_modulation, baud_rate_error_x_1000, p_baud_setting);
+}
+
 /*******************************************************************************************************************//**
  * DEPRECATED Provides API and code version in the user provided pointer. Implements @ref uart_api_t::versionGet
  *
@@ -1733,6 +1813,7 @@ void sci_uart_txi_dmac_isr (IRQn_Type irq)
  *  - UART_EVENT_RX_COMPLETE: The number of data which has been read reaches to the number specified in R_SCI_UART_Read()
  *    if a transfer instance is used for reception.
  *  - UART_EVENT_RX_CHAR: Data is received asynchronously (read has not been called)
+ *  - UART_EVENT_RX_IDLE: The receive FIFO timed out (15 ETUs without data) while a read is still in progress.
  *
  * This function also calls the callback function for RTS pin control if it is registered in R_SCI_UART_Open(). This is
  * special functionality to expand SCI hardware capability and make RTS/CTS hardware flow control possible. If macro
@@ -1757,6 +1838,11 @@ static void sci_uart_rxi_common (sci_uart_instance_ctrl_t * p_ctrl)
 
         uint32_t data;
  #if SCI_UART_CFG_FIFO_SUPPORT
+
+        /* FRSR.DR is set when data below the trigger level has been left in the FIFO for 15 ETUs, i.e. the line went
+         * idle. Capture it before the FIFO is drained. */
+        uint32_t rx_idle = (p_ctrl->fifo_depth > 0U) ? p_ctrl->p_reg->FRSR_b.DR : 0U;
+
         do
         {
             if ((p_ctrl->fifo_depth > 0U))
@@ -1786,7 +1872,17 @@ static void sci_uart_rxi_common (sci_uart_instance_ctrl_t * p_ctrl)
             }
             else
             {
-                memcpy((void *) p_ctrl->p_rx_dest, &data, p_ctrl->data_bytes);
+                /* Store with the access width of the data instead of calling memcpy for every character. The
+                 * destination is 16-bit aligned in 9-bit mode (checked in R_SCI_UART_Read). */
+                if (2U == p_ctrl->data_bytes)
+                {
+                    *((uint16_t *) p_ctrl->p_rx_dest) = (uint16_t) data;
+                }
+                else
+                {
+                    *((uint8_t *) p_ctrl->p_rx_dest) = (uint8_t) data;
+                }
+
                 p_ctrl->p_rx_dest     += p_ctrl->data_bytes;
                 p_ctrl->rx_dest_bytes -= p_ctrl->data_bytes;
 
@@ -1804,6 +1900,19 @@ static void sci_uart_rxi_common (sci_uart_instance_ctrl_t * p_ctrl)
             p_ctrl->p_reg->CFCLR_b.RDRFC = 1;
         }
 
+        if (0U != rx_idle)
+        {
+            /* The FIFO has been read below the trigger level, so the receive data ready flag can be cleared. */
+            p_ctrl->p_reg->FFCLR = SCI_UART_FFCLR_ALL_FLAG_CLEAR;
+
+            /* Receive timeout during an active read: notify the application so it can end a variable length frame
+             * with R_SCI_UART_ReadStop. */
+            if (0U != p_ctrl->rx_dest_bytes)
+            {
+                r_sci_uart_call_callback(p_ctrl, 0U, UART_EVENT_RX_IDLE);
+            }
+        }
+
  #else
         }
  #endif
@@ -1843,6 +1952,10 @@ void sci_uart_rxi_isr (void)
     /* Recover ISR context saved in open. */
     sci_uart_instance_ctrl_t * p_ctrl = (sci_uart_instance_ctrl_t *) R_FSP_IsrContextGet(irq);
 
+ #if SCI_UART_CFG_RX_ISR_COUNT
+    p_ctrl->rxi_count++;
+ #endif
+
     sci_uart_rxi_common(p_ctrl);
 
     /* Restore context if RTOS is used */
@@ -0,0 +1,500 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2023] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/***********************************************************************************************************************
+ * Includes
+ **********************************************************************************************************************/
+#include "bsp_api.h"
+#include "r_xspi_qspi.h"
+
+/***********************************************************************************************************************
+ * Macro definitions
+ **********************************************************************************************************************/
+
+/** Driver ID (XSPI in ASCII), used to identify xSPI QSPI configuration  */
+#define XSPI_QSPI_PRV_OPEN                    (0x58535049U)
+
+#define XSPI_QSPI_PRV_UNIT1                   (1U)
+
+/* Offset of an address in the memory-mapped area of a chip select (64 MB each). */
+#define XSPI_QSPI_PRV_ADDRESS_MASK            (0x03FFFFFFU)
+
+/* Link I/O Configuration Register. */
+#define XSPI_QSPI_PRV_LIOCFGCS_PRTMD_MASK     (0x3FFU)
+
+/* Bridge Map Configuration Register: combine memory writes up to 64 bytes, prefetch reads. */
+#define XSPI_QSPI_PRV_BMCFG_MWRCOMB           (1U << 7U)
+#define XSPI_QSPI_PRV_BMCFG_MWRSIZE_OFFSET    (8U)
+#define XSPI_QSPI_PRV_BMCFG_MWRSIZE_64_BYTES  (0x0FU)
+#define XSPI_QSPI_PRV_BMCFG_PREEN             (1U << 16U)
+
+/* Bridge Map Control Registers. */
+#define XSPI_QSPI_PRV_BMCTL0_CS_ACC_RW        (3U)
+#define XSPI_QSPI_PRV_BMCTL0_CS_ACC_WIDTH     (2U)
+#define XSPI_QSPI_PRV_BMCTL1_MWRPUSH          (1U << 8U)
+#define XSPI_QSPI_PRV_BMCTL1_PBUFCLR          (1U << 10U)
+
+/* Command Map Configuration Registers. A one byte command goes in the upper byte of the command field. */
+#define XSPI_QSPI_PRV_CMCFG0_ADDSIZE_OFFSET   (2U)
+#define XSPI_QSPI_PRV_CMCFG_CMD_OFFSET        (8U)
+#define XSPI_QSPI_PRV_CMCFG_LATE_OFFSET       (16U)
+
+/* Command Manual Control Register 0. */
+#define XSPI_QSPI_PRV_CDCTL0_TRREQ            (1U << 0U)
+#define XSPI_QSPI_PRV_CDCTL0_CSSEL_OFFSET     (3U)
+
+/* Command Manual Type Buf. */
+#define XSPI_QSPI_PRV_CDT_CMDSIZE_OFFSET      (0U)
+#define XSPI_QSPI_PRV_CDT_ADDSIZE_OFFSET      (2U)
+#define XSPI_QSPI_PRV_CDT_DATASIZE_OFFSET     (5U)
+#define XSPI_QSPI_PRV_CDT_LATE_OFFSET         (9U)
+#define XSPI_QSPI_PRV_CDT_TRTYPE_OFFSET       (15U)
+#define XSPI_QSPI_PRV_CDT_CMD_OFFSET          (16U)
+#define XSPI_QSPI_PRV_CDT_CMD_1B_SHIFT        (8U)
+
+/* Interrupt Status and Clear Registers. */
+#define XSPI_QSPI_PRV_INTC_CMDCMPC            (1U << 0U)
+
+#define XSPI_QSPI_PRV_MAX_DIRECT_DATA         (8U)
+
+/***********************************************************************************************************************
+ * Typedef definitions
+ **********************************************************************************************************************/
+
+/***********************************************************************************************************************
+ * Private function prototypes
+ **********************************************************************************************************************/
+static void r_xspi_qspi_direct(xspi_qspi_instance_ctrl_t         * p_ctrl,
+                               spi_flash_direct_transfer_t * const p_transfer,
+                               spi_flash_direct_transfer_dir_t     direction);
+static void r_xspi_qspi_write_enable(xspi_qspi_instance_ctrl_t * p_ctrl);
+
+#if XSPI_QSPI_CFG_PARAM_CHECKING_ENABLE
+static fsp_err_t r_xspi_qspi_open_parameter_checking(xspi_qspi_instance_ctrl_t * const p_ctrl,
+                                                     spi_flash_cfg_t const * const     p_cfg);
+
+#endif
+
+/***********************************************************************************************************************
+ * Private global variables
+ **********************************************************************************************************************/
+
+/** xSPI QSPI HAL module version data structure */
+static const fsp_version_t g_module_version =
+{
+    .api_version_minor  = SPI_FLASH_API_VERSION_MINOR,
+    .api_version_major  = SPI_FLASH_API_VERSION_MAJOR,
+    .code_version_major = XSPI_QSPI_CODE_VERSION_MAJOR,
+    .code_version_minor = XSPI_QSPI_CODE_VERSION_MINOR
+};
+
+/***********************************************************************************************************************
+ * Global Variables
+ **********************************************************************************************************************/
+
+/** xSPI QSPI implementation of SPI flash API. */
+const spi_flash_api_t g_spi_flash_on_xspi_qspi =
+{
+    .open           = R_XSPI_QSPI_Open,
+    .directTransfer = R_XSPI_QSPI_DirectTransfer,
+    .write          = R_XSPI_QSPI_Write,
+    .erase          = R_XSPI_QSPI_Erase,
+    .statusGet      = R_XSPI_QSPI_StatusGet,
+    .close          = R_XSPI_QSPI_Close,
+    .versionGet     = R_XSPI_QSPI_VersionGet,
+};
+
+/*******************************************************************************************************************//**
+ * @addtogroup XSPI_QSPI
+ * @{
+ **********************************************************************************************************************/
+
+/***********************************************************************************************************************
+ * Functions
+ **********************************************************************************************************************/
+
+/*******************************************************************************************************************//**
+ * Open the xSPI unit for a serial flash on one chip select. The memory-mapped area of the chip select reads with
+ * spi_flash_cfg_t::read_command and writes with spi_flash_cfg_t::page_program_command. Implements
+ * @ref spi_flash_api_t::open.
+ *
+ * The pins are set by the IOPORT module and the xSPI clock by the BSP clock settings.
+ *
+ * @retval FSP_SUCCESS                   Configuration was successful.
+ * @retval FSP_ERR_ASSERTION             An input parameter is invalid.
+ * @retval FSP_ERR_ALREADY_OPEN          The control structure is already opened.
+ * @retval FSP_ERR_IP_CHANNEL_NOT_PRESENT The unit or chip select does not exist on this MCU.
+ **********************************************************************************************************************/
+fsp_err_t R_XSPI_QSPI_Open (spi_flash_ctrl_t * p_ctrl, spi_flash_cfg_t const * const p_cfg)
+{
+    xspi_qspi_instance_ctrl_t * p_instance_ctrl = (xspi_qspi_instance_ctrl_t *) p_ctrl;
+
+#if XSPI_QSPI_CFG_PARAM_CHECKING_ENABLE
+    fsp_err_t err = r_xspi_qspi_open_parameter_checking(p_instance_ctrl, p_cfg);
+    FSP_ERROR_RETURN(FSP_SUCCESS == err, err);
+#endif
+
+    xspi_qspi_extended_cfg_t const * p_extend = (xspi_qspi_extended_cfg_t const *) p_cfg->p_extend;
+    uint32_t cs = (uint32_t) p_extend->chip_select;
+
+    p_instance_ctrl->p_cfg       = p_cfg;
+    p_instance_ctrl->p_reg       = (XSPI_QSPI_PRV_UNIT1 == p_extend->unit) ? R_XSPI1 : R_XSPI0;
+    p_instance_ctrl->chip_select = (uint8_t) cs;
+
+    R_BSP_MODULE_START(FSP_IP_XSPI, p_extend->unit);
+
+    R_XSPI0_Type * p_reg = p_instance_ctrl->p_reg;
+
+    /* Protocol of the chip select. */
+    p_reg->LIOCFGCS[cs] = (p_reg->LIOCFGCS[cs] & ~XSPI_QSPI_PRV_LIOCFGCS_PRTMD_MASK) |
+                          ((uint32_t) p_cfg->spi_protocol & XSPI_QSPI_PRV_LIOCFGCS_PRTMD_MASK);
+
+    /* Memory-mapped writes are combined into one page program of up to 64 bytes, pushed by R_XSPI_QSPI_Write. */
+    p_reg->BMCFG = XSPI_QSPI_PRV_BMCFG_MWRCOMB |
+                   (XSPI_QSPI_PRV_BMCFG_MWRSIZE_64_BYTES << XSPI_QSPI_PRV_BMCFG_MWRSIZE_OFFSET) |
+                   XSPI_QSPI_PRV_BMCFG_PREEN;
+
+    p_reg->CSa[cs].CMCFG0 = (uint32_t) p_cfg->address_bytes << XSPI_QSPI_PRV_CMCFG0_ADDSIZE_OFFSET;
+    p_reg->CSa[cs].CMCFG1 = ((uint32_t) p_cfg->read_command << XSPI_QSPI_PRV_CMCFG_CMD_OFFSET) |
+                            ((uint32_t) p_cfg->read_dummy_cycles << XSPI_QSPI_PRV_CMCFG_LATE_OFFSET);
+    p_reg->CSa[cs].CMCFG2 = (uint32_t) p_cfg->page_program_command << XSPI_QSPI_PRV_CMCFG_CMD_OFFSET;
+
+    p_reg->BMCTL0 |= XSPI_QSPI_PRV_BMCTL0_CS_ACC_RW << (cs * XSPI_QSPI_PRV_BMCTL0_CS_ACC_WIDTH);
+
+    p_instance_ctrl->open = XSPI_QSPI_PRV_OPEN;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * Run one command in manual mode, with an optional address and up to 8 data bytes. Waits until the command is
+ * complete. Implements @ref spi_flash_api_t::directTransfer.
+ *
+ * @retval FSP_SUCCESS                   The command was run. For reads, the data is in p_transfer->data.
+ * @retval FSP_ERR_ASSERTION             An input parameter is invalid.
+ * @retval FSP_ERR_NOT_OPEN              Driver is not opened.
+ **********************************************************************************************************************/
+fsp_err_t R_XSPI_QSPI_DirectTransfer (spi_flash_ctrl_t                  * p_ctrl,
+                                      spi_flash_direct_transfer_t * const p_transfer,
+                                      spi_flash_direct_transfer_dir_t     direction)
+{
+    xspi_qspi_instance_ctrl_t * p_instance_ctrl = (xspi_qspi_instance_ctrl_t *) p_ctrl;
+
+#if XSPI_QSPI_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_instance_ctrl);
+    FSP_ASSERT(NULL != p_transfer);
+    FSP_ASSERT((1U == p_transfer->command_length) || (2U == p_transfer->command_length));
+    FSP_ASSERT(p_transfer->address_length <= 4U);
+    FSP_ASSERT(p_transfer->data_length <= XSPI_QSPI_PRV_MAX_DIRECT_DATA);
+    FSP_ERROR_RETURN(XSPI_QSPI_PRV_OPEN == p_instance_ctrl->open, FSP_ERR_NOT_OPEN);
+#endif
+
+    r_xspi_qspi_direct(p_instance_ctrl, p_transfer, direction);
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * Program up to 64 bytes through the memory-mapped area. The write is started and the function returns: poll
+ * R_XSPI_QSPI_StatusGet until the program is finished before the next write or erase. Implements
+ * @ref spi_flash_api_t::write.
+ *
+ * p_dest must be in the non-cacheable mirror of the chip select area, so the bytes reach the bridge in order.
+ *
+ * @retval FSP_SUCCESS                   The program was started.
+ * @retval FSP_ERR_ASSERTION             An input parameter is invalid, or the write crosses a page boundary.
+ * @retval FSP_ERR_NOT_OPEN              Driver is not opened.
+ * @retval FSP_ERR_INVALID_SIZE          byte_count is larger than XSPI_QSPI_MAX_WRITE_SIZE.
+ **********************************************************************************************************************/
+fsp_err_t R_XSPI_QSPI_Write (spi_flash_ctrl_t    * p_ctrl,
+                             uint8_t const * const p_src,
+                             uint8_t * const       p_dest,
+                             uint32_t              byte_count)
+{
+    xspi_qspi_instance_ctrl_t * p_instance_ctrl = (xspi_qspi_instance_ctrl_t *) p_ctrl;
+
+#if XSPI_QSPI_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_instance_ctrl);
+    FSP_ASSERT(NULL != p_src);
+    FSP_ASSERT(NULL != p_dest);
+    FSP_ASSERT(0U != byte_count);
+    FSP_ERROR_RETURN(XSPI_QSPI_PRV_OPEN == p_instance_ctrl->open, FSP_ERR_NOT_OPEN);
+    FSP_ERROR_RETURN(byte_count <= XSPI_QSPI_MAX_WRITE_SIZE, FSP_ERR_INVALID_SIZE);
+
+    uint32_t page_offset = (uint32_t) ((uintptr_t) p_dest % p_instance_ctrl->p_cfg->page_size_bytes);
+    FSP_ASSERT((page_offset + byte_count) <= p_instance_ctrl->p_cfg->page_size_bytes);
+#endif
+
+    R_XSPI0_Type * p_reg = p_instance_ctrl->p_reg;
+
+    r_xspi_qspi_write_enable(p_instance_ctrl);
+
+    volatile uint8_t * p_mapped = (volatile uint8_t *) p_dest;
+    for (uint32_t i = 0U; i < byte_count; i++)
+    {
+        p_mapped[i] = p_src[i];
+    }
+
+    /* Send the combined write now instead of waiting for more data. */
+    p_reg->BMCTL1 = XSPI_QSPI_PRV_BMCTL1_MWRPUSH;
+    FSP_HARDWARE_REGISTER_WAIT(p_reg->COMSTT_b.WRBUFNE, 0U);
+
+    /* Reads after the program must not come from the prefetch buffer. */
+    p_reg->BMCTL1 = XSPI_QSPI_PRV_BMCTL1_PBUFCLR;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * Start an erase. byte_count selects the erase command from spi_flash_cfg_t::p_erase_command_list. The function
+ * returns when the command is sent: poll R_XSPI_QSPI_StatusGet until the erase is finished. Implements
+ * @ref spi_flash_api_t::erase.
+ *
+ * @retval FSP_SUCCESS                   The erase was started.
+ * @retval FSP_ERR_ASSERTION             An input parameter is invalid.
+ * @retval FSP_ERR_NOT_OPEN              Driver is not opened.
+ * @retval FSP_ERR_INVALID_SIZE          No erase command erases byte_count bytes.
+ **********************************************************************************************************************/
+fsp_err_t R_XSPI_QSPI_Erase (spi_flash_ctrl_t * p_ctrl, uint8_t * const p_device_address, uint32_t byte_count)
+{
+    xspi_qspi_instance_ctrl_t * p_instance_ctrl = (xspi_qspi_instance_ctrl_t *) p_ctrl;
+
+#if XSPI_QSPI_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_instance_ctrl);
+    FSP_ASSERT(NULL != p_device_address);
+    FSP_ERROR_RETURN(XSPI_QSPI_PRV_OPEN == p_instance_ctrl->open, FSP_ERR_NOT_OPEN);
+#endif
+
+    spi_flash_cfg_t const           * p_cfg   = p_instance_ctrl->p_cfg;
+    spi_flash_erase_command_t const * p_erase = NULL;
+
+    for (uint32_t i = 0U; i < p_cfg->erase_command_list_length; i++)
+    {
+        if (byte_count == p_cfg->p_erase_command_list[i].size)
+        {
+            p_erase = &p_cfg->p_erase_command_list[i];
+            break;
+        }
+    }
+
+    FSP_ERROR_RETURN(NULL != p_erase, FSP_ERR_INVALID_SIZE);
+
+    spi_flash_direct_transfer_t transfer =
+    {
+        .address        = (uint32_t) ((uintptr_t) p_device_address & XSPI_QSPI_PRV_ADDRESS_MASK),
+        .data           = 0U,
+        .command        = p_erase->command,
+        .dummy_cycles   = 0U,
+        .command_length = 1U,
+        .address_length = (SPI_FLASH_ERASE_SIZE_CHIP_ERASE == byte_count) ? 0U :
+                          (uint8_t) ((uint32_t) p_cfg->address_bytes + 1U),
+        .data_length    = 0U,
+    };
+
+    r_xspi_qspi_write_enable(p_instance_ctrl);
+    r_xspi_qspi_direct(p_instance_ctrl, &transfer, SPI_FLASH_DIRECT_TRANSFER_DIR_WRITE);
+
+    p_instance_ctrl->p_reg->BMCTL1 = XSPI_QSPI_PRV_BMCTL1_PBUFCLR;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * Read the status register and report whether a program or erase is in progress. Implements
+ * @ref spi_flash_api_t::statusGet.
+ *
+ * @retval FSP_SUCCESS                   The status was read.
+ * @retval FSP_ERR_ASSERTION             An input parameter is invalid.
+ * @retval FSP_ERR_NOT_OPEN              Driver is not opened.
+ **********************************************************************************************************************/
+fsp_err_t R_XSPI_QSPI_StatusGet (spi_flash_ctrl_t * p_ctrl, spi_flash_status_t * const p_status)
+{
+    xspi_qspi_instance_ctrl_t * p_instance_ctrl = (xspi_qspi_instance_ctrl_t *) p_ctrl;
+
+#if XSPI_QSPI_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_instance_ctrl);
+    FSP_ASSERT(NULL != p_status);
+    FSP_ERROR_RETURN(XSPI_QSPI_PRV_OPEN == p_instance_ctrl->open, FSP_ERR_NOT_OPEN);
+#endif
+
+    spi_flash_direct_transfer_t transfer =
+    {
+        .address        = 0U,
+        .data           = 0U,
+        .command        = p_instance_ctrl->p_cfg->status_command,
+        .dummy_cycles   = 0U,
+        .command_length = 1U,
+        .address_length = 0U,
+        .data_length    = 1U,
+    };
+
+    r_xspi_qspi_direct(p_instance_ctrl, &transfer, SPI_FLASH_DIRECT_TRANSFER_DIR_READ);
+
+    p_status->write_in_progress = (0U != ((transfer.data >> p_instance_ctrl->p_cfg->write_status_bit) & 1U));
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * Disable the memory-mapped access of the chip select. Implements @ref spi_flash_api_t::close.
+ *
+ * @retval FSP_SUCCESS                   Successful close.
+ * @retval FSP_ERR_ASSERTION             An input parameter is invalid.
+ * @retval FSP_ERR_NOT_OPEN              Driver is not opened.
+ **********************************************************************************************************************/
+fsp_err_t R_XSPI_QSPI_Close (spi_flash_ctrl_t * p_ctrl)
+{
+    xspi_qspi_instance_ctrl_t * p_instance_ctrl = (xspi_qspi_instance_ctrl_t *) p_ctrl;
+
+#if XSPI_QSPI_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_instance_ctrl);
+    FSP_ERROR_RETURN(XSPI_QSPI_PRV_OPEN == p_instance_ctrl->open, FSP_ERR_NOT_OPEN);
+#endif
+
+    p_instance_ctrl->p_reg->BMCTL0 &= ~(XSPI_QSPI_PRV_BMCTL0_CS_ACC_RW <<
+                                        (p_instance_ctrl->chip_select * XSPI_QSPI_PRV_BMCTL0_CS_ACC_WIDTH));
+
+    p_instance_ctrl->open = 0U;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * DEPRECATED Set driver version based on compile time macros. Implements @ref spi_flash_api_t::versionGet.
+ *
+ * @retval FSP_SUCCESS                   Successful close.
+ * @retval FSP_ERR_ASSERTION             An input parameter is invalid.
+ **********************************************************************************************************************/
+fsp_err_t R_XSPI_QSPI_VersionGet (fsp_version_t * const p_version)
+{
+#if XSPI_QSPI_CFG_PARAM_CHECKING_ENABLE
+    FSP_ASSERT(NULL != p_version);
+#endif
+
+    p_version->version_id = g_module_version.version_id;
+
+    return FSP_SUCCESS;
+}
+
+/*******************************************************************************************************************//**
+ * @} (end addtogroup XSPI_QSPI)
+ **********************************************************************************************************************/
+
+/*******************************************************************************************************************//**
+ * Run one manual command on transaction buffer 0 and wait for it to complete.
+ *
+ * @param[in]     p_ctrl                 Pointer to control structure.
+ * @param[in,out] p_transfer             Command; read data is returned in p_transfer->data.
+ * @param[in]     direction              Read or write.
+ **********************************************************************************************************************/
+static void r_xspi_qspi_direct (xspi_qspi_instance_ctrl_t         * p_ctrl,
+                                spi_flash_direct_transfer_t * const p_transfer,
+                                spi_flash_direct_transfer_dir_t     direction)
+{
+    R_XSPI0_Type * p_reg   = p_ctrl->p_reg;
+    uint32_t       command = p_transfer->command;
+
+    /* The bridge must have sent all memory-mapped writes first. */
+    FSP_HARDWARE_REGISTER_WAIT(p_reg->COMSTT_b.WRBUFNE, 0U);
+
+    if (1U == p_transfer->command_length)
+    {
+        command <<= XSPI_QSPI_PRV_CDT_CMD_1B_SHIFT;
+    }
+
+    p_reg->CDCTL0 = (uint32_t) p_ctrl->chip_select << XSPI_QSPI_PRV_CDCTL0_CSSEL_OFFSET;
+
+    p_reg->BUF[0].CDT = ((uint32_t) p_transfer->command_length << XSPI_QSPI_PRV_CDT_CMDSIZE_OFFSET) |
+                        ((uint32_t) p_transfer->address_length << XSPI_QSPI_PRV_CDT_ADDSIZE_OFFSET) |
+                        ((uint32_t) p_transfer->data_length << XSPI_QSPI_PRV_CDT_DATASIZE_OFFSET) |
+                        ((uint32_t) p_transfer->dummy_cycles << XSPI_QSPI_PRV_CDT_LATE_OFFSET) |
+                        ((uint32_t) direction << XSPI_QSPI_PRV_CDT_TRTYPE_OFFSET) |
+                        (command << XSPI_QSPI_PRV_CDT_CMD_OFFSET);
+    p_reg->BUF[0].CDA = p_transfer->address;
+
+    if (SPI_FLASH_DIRECT_TRANSFER_DIR_WRITE == direction)
+    {
+        p_reg->BUF[0].CDD0 = (uint32_t) p_transfer->data;
+        p_reg->BUF[0].CDD1 = (uint32_t) (p_transfer->data >> 32);
+    }
+
+    p_reg->CDCTL0 |= XSPI_QSPI_PRV_CDCTL0_TRREQ;
+    FSP_HARDWARE_REGISTER_WAIT(p_reg->INTS_b.CMDCMP, 1U);
+    p_reg->INTC = XSPI_QSPI_PRV_INTC_CMDCMPC;
+
+    if (SPI_FLASH_DIRECT_TRANSFER_DIR_READ == direction)
+    {
+        p_transfer->data = ((uint64_t) p_reg->BUF[0].CDD1 << 32) | p_reg->BUF[0].CDD0;
+    }
+}
+
+/*******************************************************************************************************************//**
+ * Send the write enable command ahead of a program or erase.
+ *
+ * @param[in]  p_ctrl                    Pointer to control structure.
+ **********************************************************************************************************************/
+static void r_xspi_qspi_write_enable (xspi_qspi_instance_ctrl_t * p_ctrl)
+{
+    spi_flash_direct_transfer_t transfer =
+    {
+        .address        = 0U,
+        .data           = 0U,
+        .command        = p_ctrl->p_cfg->write_enable_command,
+        .dummy_cycles   = 0U,
+        .command_length = 1U,
+        .address_length = 0U,
+        .data_length    = 0U,
+    };
+
+    r_xspi_qspi_direct(p_ctrl, &transfer, SPI_FLASH_DIRECT_TRANSFER_DIR_WRITE);
+}
+
+#if XSPI_QSPI_CFG_PARAM_CHECKING_ENABLE
+
+/*******************************************************************************************************************//**
+ * Parameter checking for R_XSPI_QSPI_Open.
+ *
+ * @param[in]  p_ctrl                    Pointer to control structure.
+ * @param[in]  p_cfg                     Pointer to configuration structure.
+ *
+ * @retval FSP_SUCCESS                   All parameters are valid.
+ * @retval FSP_ERR_ASSERTION             An input parameter is invalid.
+ * @retval FSP_ERR_ALREADY_OPEN          The control structure is already opened.
+ * @retval FSP_ERR_IP_CHANNEL_NOT_PRESENT The unit or chip select does not exist on this MCU.
+ **********************************************************************************************************************/
+static fsp_err_t r_xspi_qspi_open_parameter_checking (xspi_qspi_instance_ctrl_t * const p_ctrl,
+                                                      spi_flash_cfg_t const * const     p_cfg)
+{
+    FSP_ASSERT(NULL != p_ctrl);
+    FSP_ERROR_RETURN(XSPI_QSPI_PRV_OPEN != p_ctrl->open, FSP_ERR_ALREADY_OPEN);
+    FSP_ASSERT(NULL != p_cfg);
+    FSP_ASSERT(NULL != p_cfg->p_extend);
+    FSP_ASSERT(NULL != p_cfg->p_erase_command_list);
+    FSP_ASSERT(0U != p_cfg->page_size_bytes);
+
+    xspi_qspi_extended_cfg_t const * p_extend = (xspi_qspi_extended_cfg_t const *) p_cfg->p_extend;
+    FSP_ERROR_RETURN(0U != (BSP_FEATURE_XSPI_CHANNELS & (1U << p_extend->unit)), FSP_ERR_IP_CHANNEL_NOT_PRESENT);
+    FSP_ERROR_RETURN((uint32_t) p_extend->chip_select < BSP_FEATURE_XSPI_NUM_CHIP_SELECT,
+                     FSP_ERR_IP_CHANNEL_NOT_PRESENT);
+
+    return FSP_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,5 @@
+/* generated configuration header file - do not edit */
+#ifndef R_DMAC_CFG_H_
+#define R_DMAC_CFG_H_
+#define DMAC_CFG_PARAM_CHECKING_ENABLE (BSP_CFG_PARAM_CHECKING_ENABLE)
+#endif /* R_DMAC_CFG_H_ */
@@ -2,7 +2,9 @@
 #ifndef R_SCI_UART_CFG_H_
 #define R_SCI_UART_CFG_H_
 #define SCI_UART_CFG_PARAM_CHECKING_ENABLE (BSP_CFG_PARAM_CHECKING_ENABLE)
-            #define SCI_UART_CFG_FIFO_SUPPORT (0)
-            #define SCI_UART_CFG_DMAC_SUPPORTED (0)
+            #define SCI_UART_CFG_FIFO_SUPPORT (1)
+            #define SCI_UART_CFG_DMAC_SUPPORTED (1)
             #define SCI_UART_CFG_FLOW_CONTROL_SUPPORT (0)
+            #define SCI_UART_CFG_BAUD_TABLE_ENABLE (1)
+            #define SCI_UART_CFG_RX_ISR_COUNT (1)
 #endif /* R_SCI_UART_CFG_H_ */
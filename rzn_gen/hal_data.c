@@ -1,5 +1,60 @@
 /* generated HAL source file - do not edit */
 #include "hal_data.h"
+dmac_instance_ctrl_t g_transfer0_ctrl;
+
+dmac_extended_info_t g_transfer0_info_extend =
+{
+    .src_size            = DMAC_TRANSFER_SIZE_1_BYTE,
+    .dest_size           = DMAC_TRANSFER_SIZE_1_BYTE,
+};
+
+transfer_info_t g_transfer0_info =
+{
+    .dest_addr_mode      = TRANSFER_ADDR_MODE_FIXED,
+    .repeat_area         = TRANSFER_REPEAT_AREA_SOURCE,
+    .irq                 = TRANSFER_IRQ_END,
+    .chain_mode          = TRANSFER_CHAIN_MODE_DISABLED,
+    .src_addr_mode       = TRANSFER_ADDR_MODE_INCREMENTED,
+    .size                = TRANSFER_SIZE_1_BYTE,
+    .mode                = TRANSFER_MODE_NORMAL,
+    .p_dest              = (void *) NULL,
+    .p_src               = (void const *) NULL,
+    .num_blocks          = 0,
+    .length              = 0,
+    .p_extend            = &g_transfer0_info_extend,
+};
+
+const dmac_extended_cfg_t g_transfer0_extend =
+{
+    .unit                = 0,
+    .channel             = 0,
+#if defined(VECTOR_NUMBER_DMAC0_INT0)
+    .dmac_int_irq        = VECTOR_NUMBER_DMAC0_INT0,
+#else
+    .dmac_int_irq        = FSP_INVALID_VECTOR,
+#endif
+    .dmac_int_ipl        = (12),
+    .activation_source   = ELC_EVENT_SCI0_TXI,
+    .ack_mode            = DMAC_ACK_MODE_BUS_CYCLE_MODE,
+    .detection_mode      = DMAC_DETECTION_FALLING_EDGE,
+    .activation_request_source_select = DMAC_REQUEST_DIRECTION_DESTINATION_MODULE,
+    .channel_scheduling  = DMAC_CHANNEL_SCHEDULING_FIXED,
+    .p_callback          = NULL,
+    .p_context           = NULL,
+    .p_peripheral_module_handler = sci_uart_txi_dmac_isr,
+};
+const transfer_cfg_t g_transfer0_cfg =
+{
+    .p_info              = &g_transfer0_info,
+    .p_extend            = &g_transfer0_extend,
+};
+/* Instance structure to use this module. */
+const transfer_instance_t g_transfer0 =
+{
+    .p_ctrl        = &g_transfer0_ctrl,
+    .p_cfg         = &g_transfer0_cfg,
+    .p_api         = &g_transfer_on_dmac
+};
 sci_uart_instance_ctrl_t     g_uart0_ctrl;
 
             baud_setting_t               g_uart0_baud_setting =
@@ -36,10 +91,10 @@ sci_uart_instance_ctrl_t     g_uart0_ctrl;
                 .p_context           = NULL,
                 .p_extend            = &g_uart0_cfg_extend,
 #define FSP_NOT_DEFINED (1)
-#if (FSP_NOT_DEFINED == FSP_NOT_DEFINED)
+#if (FSP_NOT_DEFINED == g_transfer0)
                 .p_transfer_tx       = NULL,
 #else
-                .p_transfer_tx       = &FSP_NOT_DEFINED,
+                .p_transfer_tx       = &g_transfer0,
 #endif
 #if (FSP_NOT_DEFINED == FSP_NOT_DEFINED)
                 .p_transfer_rx       = NULL,
@@ -80,6 +135,41 @@ const uart_instance_t g_uart0 =
     .p_cfg         = &g_uart0_cfg,
     .p_api         = &g_uart_on_sci
 };
+xspi_qspi_instance_ctrl_t g_qspi0_ctrl;
+
+static const spi_flash_erase_command_t g_qspi0_erase_command_list[] =
+{
+    {.command = 0x20, .size = 4096},
+    {.command = 0xD8, .size = 65536},
+    {.command = 0xC7, .size = SPI_FLASH_ERASE_SIZE_CHIP_ERASE},
+};
+static const xspi_qspi_extended_cfg_t g_qspi0_extended_cfg =
+{
+    .unit                = 0,
+    .chip_select         = XSPI_QSPI_CHIP_SELECT_0,
+};
+const spi_flash_cfg_t g_qspi0_cfg =
+{
+    .spi_protocol        = SPI_FLASH_PROTOCOL_1S_1S_1S,
+    .address_bytes       = SPI_FLASH_ADDRESS_BYTES_3,
+    .read_command        = 0x0B,
+    .read_dummy_cycles   = 8,
+    .page_program_command = 0x02,
+    .page_size_bytes     = 256,
+    .write_enable_command = 0x06,
+    .status_command      = 0x05,
+    .write_status_bit    = 0,
+    .erase_command_list_length = sizeof(g_qspi0_erase_command_list) / sizeof(g_qspi0_erase_command_list[0]),
+    .p_erase_command_list = &g_qspi0_erase_command_list[0],
+    .p_extend            = &g_qspi0_extended_cfg,
+};
+/** This structure encompasses everything that is needed to use an instance of this interface. */
+const spi_flash_instance_t g_qspi0 =
+{
+    .p_ctrl = &g_qspi0_ctrl,
+    .p_cfg  = &g_qspi0_cfg,
+    .p_api  = &g_spi_flash_on_xspi_qspi,
+};
 void g_hal_init(void) {
 g_common_init();
 }
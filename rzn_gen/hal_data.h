@@ -4,9 +4,23 @@
 #include <stdint.h>
 #include "bsp_api.h"
 #include "common_data.h"
+#include "r_dmac.h"
+#include "r_transfer_api.h"
 #include "r_sci_uart.h"
             #include "r_uart_api.h"
+#include "r_xspi_qspi.h"
+#include "r_spi_flash_api.h"
 FSP_HEADER
+/* Transfer on DMAC Instance. */
+extern const transfer_instance_t g_transfer0;
+
+/** Access the DMAC instance using these structures when calling API functions directly (::p_api is not used). */
+extern dmac_instance_ctrl_t g_transfer0_ctrl;
+extern const transfer_cfg_t g_transfer0_cfg;
+
+#ifndef sci_uart_txi_dmac_isr
+void sci_uart_txi_dmac_isr(IRQn_Type const irq);
+#endif
 /** UART on SCI Instance. */
             extern const uart_instance_t      g_uart0;
 
@@ -18,6 +32,12 @@ FSP_HEADER
             #ifndef sci_uart_callback
             void sci_uart_callback(uart_callback_args_t * p_args);
             #endif
+/* xSPI QSPI Instance. */
+extern const spi_flash_instance_t g_qspi0;
+
+/** Access the xSPI QSPI instance using these structures when calling API functions directly (::p_api is not used). */
+extern xspi_qspi_instance_ctrl_t g_qspi0_ctrl;
+extern const spi_flash_cfg_t g_qspi0_cfg;
 void hal_entry(void);
 void g_hal_init(void);
 FSP_FOOTER
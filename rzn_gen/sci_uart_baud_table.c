@@ -0,0 +1,435 @@
+/* generated baud setting table source file - do not edit */
+/* regenerate with tools/baud_table_gen/baud_table_gen -c 96000000 -o rzn_gen/sci_uart_baud_table.c */
+#include "r_sci_uart.h"
+#if SCI_UART_CFG_BAUD_TABLE_ENABLE
+static const sci_uart_baud_table_entry_t g_sci_uart_baud_table_entries[30] =
+{
+    {
+        .baudrate = 1200U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 155U, .brme = 0U, .cks = 2U, .mddr = 128U}}, .error_x_1000 =    160}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 155U, .brme = 0U, .cks = 2U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 140U, .brme = 1U, .cks = 2U, .mddr = 231U}}, .error_x_1000 =      7}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr = 152U, .brme = 1U, .cks = 3U, .mddr = 188U}}, .error_x_1000 =      4}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 2400U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 155U, .brme = 0U, .cks = 2U, .mddr = 128U}}, .error_x_1000 =    160}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 155U, .brme = 0U, .cks = 2U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 140U, .brme = 1U, .cks = 2U, .mddr = 231U}}, .error_x_1000 =      7}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 140U, .brme = 1U, .cks = 2U, .mddr = 231U}}, .error_x_1000 =      7}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 4800U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 155U, .brme = 0U, .cks = 1U, .mddr = 128U}}, .error_x_1000 =    160}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 155U, .brme = 0U, .cks = 1U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 140U, .brme = 1U, .cks = 1U, .mddr = 231U}}, .error_x_1000 =      7}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr = 152U, .brme = 1U, .cks = 2U, .mddr = 188U}}, .error_x_1000 =      4}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 9600U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 155U, .brme = 0U, .cks = 1U, .mddr = 128U}}, .error_x_1000 =    160}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 155U, .brme = 0U, .cks = 1U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 140U, .brme = 1U, .cks = 1U, .mddr = 231U}}, .error_x_1000 =      7}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 140U, .brme = 1U, .cks = 1U, .mddr = 231U}}, .error_x_1000 =      7}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 14400U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 207U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 207U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 152U, .brme = 1U, .cks = 0U, .mddr = 188U}}, .error_x_1000 =      4}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 152U, .brme = 1U, .cks = 0U, .mddr = 188U}}, .error_x_1000 =      4}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 19200U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 155U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 155U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 140U, .brme = 1U, .cks = 0U, .mddr = 231U}}, .error_x_1000 =      7}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr = 152U, .brme = 1U, .cks = 1U, .mddr = 188U}}, .error_x_1000 =      4}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 28800U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 207U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 207U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 152U, .brme = 1U, .cks = 0U, .mddr = 188U}}, .error_x_1000 =      4}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 152U, .brme = 1U, .cks = 0U, .mddr = 188U}}, .error_x_1000 =      4}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 38400U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 155U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 155U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 140U, .brme = 1U, .cks = 0U, .mddr = 231U}}, .error_x_1000 =      7}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 140U, .brme = 1U, .cks = 0U, .mddr = 231U}}, .error_x_1000 =      7}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 57600U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 103U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr = 103U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  93U, .brme = 1U, .cks = 0U, .mddr = 231U}}, .error_x_1000 =      7}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 1U, .abcse = 0U, .brr = 152U, .brme = 1U, .cks = 0U, .mddr = 188U}}, .error_x_1000 =      4}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 76800U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  77U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  77U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  46U, .brme = 1U, .cks = 0U, .mddr = 154U}}, .error_x_1000 =      7}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr = 152U, .brme = 1U, .cks = 0U, .mddr = 188U}}, .error_x_1000 =      4}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 115200U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  51U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  51U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  46U, .brme = 1U, .cks = 0U, .mddr = 231U}}, .error_x_1000 =      7}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr = 101U, .brme = 1U, .cks = 0U, .mddr = 188U}}, .error_x_1000 =      4}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 128000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  45U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =   1902}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr = 124U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  36U, .brme = 1U, .cks = 0U, .mddr = 202U}}, .error_x_1000 =     35}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr = 124U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 153600U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  38U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  38U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  37U, .brme = 1U, .cks = 0U, .mddr = 249U}}, .error_x_1000 =     15}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr =  93U, .brme = 1U, .cks = 0U, .mddr = 231U}}, .error_x_1000 =      7}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 230400U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  25U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  25U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  22U, .brme = 1U, .cks = 0U, .mddr = 226U}}, .error_x_1000 =     45}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr =  50U, .brme = 1U, .cks = 0U, .mddr = 188U}}, .error_x_1000 =      4}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 250000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  23U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  23U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  23U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  23U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 256000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  22U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =   1902}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr =  61U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    806}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  11U, .brme = 1U, .cks = 0U, .mddr = 131U}}, .error_x_1000 =     56}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr =  41U, .brme = 1U, .cks = 0U, .mddr = 172U}}, .error_x_1000 =     19}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 460800U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  12U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  12U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  10U, .brme = 1U, .cks = 0U, .mddr = 216U}}, .error_x_1000 =    125}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr =  26U, .brme = 1U, .cks = 0U, .mddr = 199U}}, .error_x_1000 =     34}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 500000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  11U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  11U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  11U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =  11U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 576000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   9U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =   4166}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr =  26U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =   2880}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   6U, .brme = 1U, .cks = 0U, .mddr = 172U}}, .error_x_1000 =     19}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   6U, .brme = 1U, .cks = 0U, .mddr = 172U}}, .error_x_1000 =     19}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 921600U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   5U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =   8506}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 1U, .abcse = 0U, .brr =  12U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =    160}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   3U, .brme = 1U, .cks = 0U, .mddr = 157U}}, .error_x_1000 =    183}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr =  14U, .brme = 1U, .cks = 0U, .mddr = 221U}}, .error_x_1000 =     84}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 1000000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   5U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   5U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   5U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   5U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 1152000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   4U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =   4166}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   4U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =   4166}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   4U, .brme = 1U, .cks = 0U, .mddr = 245U}}, .error_x_1000 =    310}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr =   6U, .brme = 1U, .cks = 0U, .mddr = 129U}}, .error_x_1000 =     19}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 1500000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   3U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   3U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   3U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   3U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 2000000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   2U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   2U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   2U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   2U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 2500000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   1U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =  20000}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr =   5U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =   6666}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   1U, .brme = 1U, .cks = 0U, .mddr = 213U}}, .error_x_1000 =    157}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr =   4U, .brme = 1U, .cks = 0U, .mddr = 200U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 3000000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   1U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   1U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   1U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   1U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 4000000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   0U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =  50000}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr =   3U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   0U, .brme = 1U, .cks = 0U, .mddr = 170U}}, .error_x_1000 =    391}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr =   3U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 6000000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   0U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   0U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   0U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 0U, .abcse = 0U, .brr =   0U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 8000000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 255U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 = 100000}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr =   1U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 255U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 = 100000}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 1U, .brr =   1U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+        },
+    },
+    {
+        .baudrate = 12000000U,
+        .setting  =
+        {
+            {                  /* bitrate_modulation = false */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 255U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 = 100000}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 1U, .abcse = 0U, .brr =   0U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+            {                  /* bitrate_modulation = true */
+                {.setting = {.baudrate_bits_b = {.bgdm = 0U, .abcs = 0U, .abcse = 0U, .brr = 255U, .brme = 0U, .cks = 0U, .mddr = 128U}}, .error_x_1000 = 100000}, /* pass 0 */
+                {.setting = {.baudrate_bits_b = {.bgdm = 1U, .abcs = 1U, .abcse = 0U, .brr =   0U, .brme = 1U, .cks = 0U, .mddr =   0U}}, .error_x_1000 =      0}, /* passes 0-1 */
+            },
+        },
+    },
+};
+
+const sci_uart_baud_table_t g_sci_uart_baud_table =
+{
+    .clock_hz    = 96000000U,
+    .num_entries = 30U,
+    .p_entries   = g_sci_uart_baud_table_entries,
+};
+#endif
@@ -4,7 +4,8 @@
         #if VECTOR_DATA_IRQ_COUNT > 0
         BSP_DONT_REMOVE const fsp_vector_t g_vector_table[BSP_ICU_VECTOR_MAX_ENTRIES] =
         {
-                        [288] = sci_uart_eri_isr, /* SCI0_ERI (SCI0 Receive error) */
+                        [21] = dmac_int_isr, /* DMAC0_INT0 (DMAC0 transfer completion 0) */
+            [288] = sci_uart_eri_isr, /* SCI0_ERI (SCI0 Receive error) */
             [289] = sci_uart_rxi_isr, /* SCI0_RXI (SCI0 Receive data full) */
             [290] = sci_uart_txi_isr, /* SCI0_TXI (SCI0 Transmit data empty) */
             [291] = sci_uart_tei_isr, /* SCI0_TEI (SCI0 Transmit end) */
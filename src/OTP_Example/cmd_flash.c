@@ -0,0 +1,581 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "hal_data.h"
+#include "cmd_flash.h"
+#include "common.h"
+#include "crc.h"
+#include "lz4.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Page buffers: one is programmed while the next one fills */
+#define FLASH_PAGE_BUFFERS     (2U)
+
+/* Largest program at one time (xSPI write combination) */
+#define FLASH_PROGRAM_SIZE     (64U)
+
+/* Data of one command waiting for the page buffers */
+#define FLASH_STAGE_SIZE       (FLASH_LZ4_MAX_DATA)
+
+/* Erased sectors kept ahead of the sector being received */
+#define FLASH_ERASE_AHEAD      (1U)
+
+/* End of the sector holding the byte before offset */
+#define FLASH_SECTOR_END(offset)  ((((offset) + FLASH_SECTOR_SIZE - 1U) / FLASH_SECTOR_SIZE) * FLASH_SECTOR_SIZE)
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+/* Received data of one flash page */
+typedef struct
+{
+    uint32_t   address;                         // Flash offset of the page
+    uint32_t   start;                           // First byte of the page in data[]
+    uint32_t   fill;                            // End of the received bytes
+    uint32_t   programmed;                      // End of the programmed bytes
+    uint8_t    data[FLASH_PAGE_SIZE];
+} flash_page_t;
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static spi_flash_instance_t const *s_gp_flash;              // Flash driver, NULL if not available
+static uint8_t        *s_gp_memory;                         // Memory-mapped flash (non-cacheable)
+static flash_page_t   s_g_page[FLASH_PAGE_BUFFERS];         // Page buffers, used as a ring
+static uint8_t        s_g_stage[FLASH_STAGE_SIZE];          // Data of the last command
+static uint32_t       s_g_stage_read;                       // Bytes of s_g_stage moved to the pages
+static uint32_t       s_g_stage_size;                       // Bytes in s_g_stage
+static uint32_t       s_g_page_first;                       // Oldest page buffer in use
+static uint32_t       s_g_page_count;                       // Page buffers in use
+static bool           s_g_stream;                           // A stream is open
+static uint32_t       s_g_next;                             // Flash offset the next write continues at
+static uint32_t       s_g_erased;                           // End of the sectors erased by this stream
+static uint32_t       s_g_limit;                            // End of the sectors this stream may erase
+static bool           s_g_busy;                             // Program or erase in progress
+static bool           s_g_flush;                            // Program partial pages too
+static bool           s_g_error;                            // The stream failed
+
+static uint8_t flash_stream(uint32_t address, uint32_t size);
+static void flash_fill(void);
+static void flash_start(void);
+static bool flash_area_check(uint32_t address, uint32_t size);
+
+/******************************************************************************
+ * @brief Open the flash for WRITE_FLASH and VERIFY_FLASH.
+ *
+ * The image is written as a stream: each WRITE_FLASH continues where the
+ * previous one ended, and BEGIN_FLASH or a write elsewhere starts a new
+ * stream at a sector boundary. The data of a command (copied, or decompressed from LZ4) is
+ * staged and moves on to one of two page buffers; while one page programs,
+ * the next one fills. RAM use is fixed: the stage holds one command, so a
+ * command waits in the queue until the last one has moved on. Sectors are
+ * erased before the data for them arrives, so the erase time hides behind
+ * the transfer. Only the sectors BEGIN_FLASH announced are erased ahead:
+ * a sector the host skips because it is unchanged, or the rest of the flash
+ * after the image, is never touched. A stream without BEGIN_FLASH erases
+ * each sector when its data arrives.
+ *
+ * @param[in]  p_flash        Flash driver instance
+ * @param[in]  p_memory       Non-cacheable memory-mapped area of the flash
+ ******************************************************************************/
+void cmd_flash_open (spi_flash_instance_t const *p_flash, uint8_t *p_memory)
+{
+    fsp_err_t fsp_err;
+    
+    s_gp_flash     = NULL;
+    s_gp_memory    = p_memory;
+    s_g_page_first = 0U;
+    s_g_page_count = 0U;
+    s_g_stage_read = 0U;
+    s_g_stage_size = 0U;
+    s_g_stream     = false;
+    s_g_busy       = false;
+    s_g_flush      = false;
+    s_g_error      = false;
+    
+    fsp_err = p_flash->p_api->open(p_flash->p_ctrl, p_flash->p_cfg);
+    if (FSP_SUCCESS == fsp_err)
+    {
+        s_gp_flash = p_flash;
+    }
+}
+
+/******************************************************************************
+ * @brief Advance the running program or erase, and start the next one.
+ *
+ * Does not wait: call it from the main loop.
+ ******************************************************************************/
+void cmd_flash_poll (void)
+{
+    spi_flash_status_t status;
+    fsp_err_t          fsp_err;
+    
+    if ((NULL == s_gp_flash) || (false == s_g_stream))
+    {
+        return;
+    }
+    
+    if (true == s_g_busy)
+    {
+        fsp_err = s_gp_flash->p_api->statusGet(s_gp_flash->p_ctrl, &status);
+        if (FSP_SUCCESS != fsp_err)
+        {
+            s_g_error = true;
+        }
+        else if (true == status.write_in_progress)
+        {
+            return;
+        }
+        else
+        {
+            /* Finished. */
+        }
+        s_g_busy = false;
+    }
+    
+    flash_fill();
+    flash_start();
+}
+
+/******************************************************************************
+ * @brief Check whether the flash has work for cmd_flash_poll().
+ *
+ * @retval true   A program or erase is running or about to start
+ * @retval false  Waiting for data
+ ******************************************************************************/
+bool cmd_flash_busy (void)
+{
+    return (true == s_g_busy) || ((true == s_g_flush) && (0U != s_g_page_count));
+}
+
+/******************************************************************************
+ * @brief Check whether a command can be executed now.
+ *
+ * A write that continues the stream needs the stage free. VERIFY_FLASH
+ * (size 0) and a write that starts a new stream need all received data
+ * programmed: this starts programming the partial page.
+ *
+ * @param[in]  address        Flash offset of the write or the verify
+ * @param[in]  size           Data bytes of the write, 0 for a verify
+ *
+ * @retval true   Execute the command
+ * @retval false  Try again after cmd_flash_poll()
+ ******************************************************************************/
+bool cmd_flash_ready (uint32_t address, uint32_t size)
+{
+    if ((NULL == s_gp_flash) || (false == s_g_stream) || (true == s_g_error))
+    {
+        return true;
+    }
+    
+    if ((0U == size) || (address != s_g_next))
+    {
+        if ((0U == s_g_page_count) && (false == s_g_busy) && (s_g_stage_read == s_g_stage_size))
+        {
+            s_g_flush = false;
+            return true;
+        }
+        s_g_flush = true;
+        return false;
+    }
+    
+    return (s_g_stage_read == s_g_stage_size);
+}
+
+/******************************************************************************
+ * @brief Take data for the flash.
+ *
+ * The data is buffered and programmed by cmd_flash_poll(). A program or
+ * erase that fails shows in the result of the next WRITE_FLASH and of
+ * VERIFY_FLASH. Call cmd_flash_ready() first.
+ *
+ * @param[in]  address        Flash offset
+ * @param[in]  p_data         Data
+ * @param[in]  size           Data size
+ *
+ * @retval RET_SUCCESS     Data taken
+ * @retval RET_DATA_FAIL   Outside the flash area, or a new stream not
+ *                         starting at a sector boundary
+ * @retval RET_WRITE_FAIL  The stream failed
+ * @retval RET_CMD_FAIL    No flash
+ ******************************************************************************/
+uint8_t cmd_write_flash (uint32_t address, uint8_t const *p_data, uint32_t size)
+{
+    uint8_t ret;
+    
+    if (FLASH_WRITE_MAX_DATA < size)
+    {
+        return RET_DATA_FAIL;
+    }
+    
+    ret = flash_stream(address, size);
+    if (RET_SUCCESS != ret)
+    {
+        return ret;
+    }
+    
+    memcpy(s_g_stage, p_data, size);
+    s_g_stage_read = 0U;
+    s_g_stage_size = size;
+    s_g_next      += size;
+    
+    cmd_flash_poll();
+    
+    return RET_SUCCESS;
+}
+
+/******************************************************************************
+ * @brief Take LZ4 compressed data for the flash.
+ *
+ * Like cmd_write_flash(), but p_data is one LZ4 block that decodes to size
+ * bytes. The block is decoded straight into the stage, so it needs no RAM
+ * beyond that of an uncompressed write.
+ *
+ * @param[in]  address        Flash offset
+ * @param[in]  size           Decoded size, up to FLASH_LZ4_MAX_DATA
+ * @param[in]  p_data         LZ4 block
+ * @param[in]  data_size      Block size
+ *
+ * @retval RET_SUCCESS     Data taken
+ * @retval RET_DATA_FAIL   Outside the flash area, a new stream not starting
+ *                         at a sector boundary, or a block that does not
+ *                         decode to size bytes
+ * @retval RET_WRITE_FAIL  The stream failed
+ * @retval RET_CMD_FAIL    No flash
+ ******************************************************************************/
+uint8_t cmd_write_flash_lz4 (uint32_t address, uint32_t size, uint8_t const *p_data, uint32_t data_size)
+{
+    uint8_t ret;
+    
+    if (FLASH_LZ4_MAX_DATA < size)
+    {
+        return RET_DATA_FAIL;
+    }
+    
+    ret = flash_stream(address, size);
+    if (RET_SUCCESS != ret)
+    {
+        return ret;
+    }
+    
+    if ((int32_t)size != lz4_decode(p_data, data_size, s_g_stage, size))
+    {
+        return RET_DATA_FAIL;
+    }
+    s_g_stage_read = 0U;
+    s_g_stage_size = size;
+    s_g_next      += size;
+    
+    cmd_flash_poll();
+    
+    return RET_SUCCESS;
+}
+
+/******************************************************************************
+ * @brief Check the digest of a flash range.
+ *
+ * Call cmd_flash_ready() with size 0 first, so all data is programmed.
+ *
+ * @param[in]  address        Flash offset
+ * @param[in]  size           Range size
+ * @param[in]  digest         Expected CRC-32 of the range
+ *
+ * @retval RET_SUCCESS     The flash holds the expected data
+ * @retval RET_DATA_FAIL   Outside the flash area
+ * @retval RET_WRITE_FAIL  The stream failed, or the digest differs
+ * @retval RET_CMD_FAIL    No flash
+ ******************************************************************************/
+uint8_t cmd_verify_flash (uint32_t address, uint32_t size, uint32_t digest)
+{
+    if (NULL == s_gp_flash)
+    {
+        return RET_CMD_FAIL;
+    }
+    
+    if ((0U == size) || (false == flash_area_check(address, size)))
+    {
+        return RET_DATA_FAIL;
+    }
+    
+    if ((true == s_g_error) || (digest != crc32_calc(0U, s_gp_memory + address, size)))
+    {
+        return RET_WRITE_FAIL;
+    }
+    
+    return RET_SUCCESS;
+}
+
+/******************************************************************************
+ * @brief Start a stream and announce the range it will write.
+ *
+ * The sectors of the range are erased ahead of the data. Call
+ * cmd_flash_ready() with size 0 first, so the last stream has finished.
+ *
+ * @param[in]  address        Flash offset, at a sector boundary
+ * @param[in]  size           Bytes the stream will write
+ *
+ * @retval RET_SUCCESS     Stream started
+ * @retval RET_DATA_FAIL   Outside the flash area, or not at a sector boundary
+ * @retval RET_CMD_FAIL    No flash
+ ******************************************************************************/
+uint8_t cmd_begin_flash (uint32_t address, uint32_t size)
+{
+    if (NULL == s_gp_flash)
+    {
+        return RET_CMD_FAIL;
+    }
+    
+    if ((0U == size) || (false == flash_area_check(address, size)) || (0U != (address % FLASH_SECTOR_SIZE)))
+    {
+        return RET_DATA_FAIL;
+    }
+    
+    s_g_stream = true;
+    s_g_error  = false;
+    s_g_next   = address;
+    s_g_erased = address;
+    s_g_limit  = FLASH_SECTOR_END(address + size);
+    
+    cmd_flash_poll();
+    
+    return RET_SUCCESS;
+}
+
+/******************************************************************************
+ * @brief Return the digest of each sector of a flash range.
+ *
+ * The host compares them with its image and sends only the sectors that
+ * differ. Call cmd_flash_ready() with size 0 first, so all data is
+ * programmed.
+ *
+ * @param[in]  address        Flash offset, at a sector boundary
+ * @param[in]  count          Sectors, up to FLASH_DIGEST_MAX_SECTORS
+ * @param[out] p_digest       CRC-32 of each sector (big endian)
+ *
+ * @retval RET_SUCCESS     Digests returned
+ * @retval RET_DATA_FAIL   Outside the flash area, or not at a sector boundary
+ * @retval RET_CMD_FAIL    No flash
+ ******************************************************************************/
+uint8_t cmd_digest_flash (uint32_t address, uint32_t count, uint8_t *p_digest)
+{
+    if (NULL == s_gp_flash)
+    {
+        return RET_CMD_FAIL;
+    }
+    
+    if ((0U == count) || (FLASH_DIGEST_MAX_SECTORS < count) || (0U != (address % FLASH_SECTOR_SIZE)) ||
+        (false == flash_area_check(address, count * FLASH_SECTOR_SIZE)))
+    {
+        return RET_DATA_FAIL;
+    }
+    
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        uint32_t crc = crc32_calc(0U, s_gp_memory + address + (i * FLASH_SECTOR_SIZE), FLASH_SECTOR_SIZE);
+        
+        p_digest[(i * FLASH_DIGEST_SIZE) + 0U] = (uint8_t)(crc >> 24);
+        p_digest[(i * FLASH_DIGEST_SIZE) + 1U] = (uint8_t)(crc >> 16);
+        p_digest[(i * FLASH_DIGEST_SIZE) + 2U] = (uint8_t)(crc >> 8);
+        p_digest[(i * FLASH_DIGEST_SIZE) + 3U] = (uint8_t)crc;
+    }
+    
+    return RET_SUCCESS;
+}
+
+/******************************************************************************
+ * @brief Check a write against the stream, and open a new stream if needed.
+ *
+ * @retval RET_SUCCESS     The stage is free for size bytes at address
+ * @retval RET_DATA_FAIL   Outside the flash area, or a new stream not
+ *                         starting at a sector boundary
+ * @retval RET_WRITE_FAIL  The stream failed, or the stage is in use
+ * @retval RET_CMD_FAIL    No flash
+ ******************************************************************************/
+static uint8_t flash_stream (uint32_t address, uint32_t size)
+{
+    if (NULL == s_gp_flash)
+    {
+        return RET_CMD_FAIL;
+    }
+    
+    if ((0U == size) || (false == flash_area_check(address, size)))
+    {
+        return RET_DATA_FAIL;
+    }
+    
+    /* A new stream. cmd_flash_ready() has waited for the last one. */
+    if ((false == s_g_stream) || (address != s_g_next))
+    {
+        if (0U != (address % FLASH_SECTOR_SIZE))
+        {
+            return RET_DATA_FAIL;
+        }
+        s_g_stream = true;
+        s_g_error  = false;
+        s_g_next   = address;
+        s_g_erased = address;
+        s_g_limit  = address;
+    }
+    
+    if (true == s_g_error)
+    {
+        return RET_WRITE_FAIL;
+    }
+    
+    /* Data past the announced range is erased as it arrives. */
+    if (s_g_limit < FLASH_SECTOR_END(address + size))
+    {
+        s_g_limit = FLASH_SECTOR_END(address + size);
+    }
+    
+    /* cmd_flash_ready() was not asked. */
+    if (s_g_stage_read != s_g_stage_size)
+    {
+        return RET_WRITE_FAIL;
+    }
+    
+    return RET_SUCCESS;
+}
+
+/******************************************************************************
+ * @brief Move staged data into the page buffers while they have room.
+ ******************************************************************************/
+static void flash_fill (void)
+{
+    while (s_g_stage_read != s_g_stage_size)
+    {
+        flash_page_t *p_page = &s_g_page[(s_g_page_first + s_g_page_count - 1U) % FLASH_PAGE_BUFFERS];
+        uint32_t     offset  = s_g_next - (s_g_stage_size - s_g_stage_read);
+        uint32_t     copy;
+        
+        if ((0U == s_g_page_count) || (FLASH_PAGE_SIZE == p_page->fill))
+        {
+            if (FLASH_PAGE_BUFFERS == s_g_page_count)
+            {
+                return;
+            }
+            p_page             = &s_g_page[(s_g_page_first + s_g_page_count) % FLASH_PAGE_BUFFERS];
+            p_page->address    = offset - (offset % FLASH_PAGE_SIZE);
+            p_page->start      = offset % FLASH_PAGE_SIZE;
+            p_page->fill       = p_page->start;
+            p_page->programmed = p_page->start;
+            s_g_page_count++;
+        }
+        
+        copy = FLASH_PAGE_SIZE - p_page->fill;
+        if (copy > (s_g_stage_size - s_g_stage_read))
+        {
+            copy = s_g_stage_size - s_g_stage_read;
+        }
+        memcpy(&p_page->data[p_page->fill], &s_g_stage[s_g_stage_read], copy);
+        p_page->fill   += copy;
+        s_g_stage_read += copy;
+    }
+}
+
+/******************************************************************************
+ * @brief Start the next program or erase while the flash is idle.
+ *
+ * Programming the oldest full page (or any page when flushing) comes
+ * first; its sector is erased before if needed. With nothing to program,
+ * the sectors ahead of the received data are erased.
+ ******************************************************************************/
+static void flash_start (void)
+{
+    flash_page_t *p_page = &s_g_page[s_g_page_first];
+    uint32_t     ahead   = s_g_next - (s_g_next % FLASH_SECTOR_SIZE) + ((1U + FLASH_ERASE_AHEAD) * FLASH_SECTOR_SIZE);
+    fsp_err_t    fsp_err = FSP_SUCCESS;
+    
+    if (true == s_g_error)
+    {
+        /* Drop what was not programmed. */
+        s_g_page_count = 0U;
+        s_g_stage_read = s_g_stage_size;
+        return;
+    }
+    
+    if ((0U != s_g_page_count) &&
+        ((FLASH_PAGE_SIZE == p_page->fill) || (1U < s_g_page_count) || (true == s_g_flush)))
+    {
+        if (p_page->address >= s_g_erased)
+        {
+            fsp_err     = s_gp_flash->p_api->erase(s_gp_flash->p_ctrl, s_gp_memory + s_g_erased, FLASH_SECTOR_SIZE);
+            s_g_erased += FLASH_SECTOR_SIZE;
+        }
+        else
+        {
+            /* Up to the next write combination boundary. */
+            uint32_t size = FLASH_PROGRAM_SIZE - (p_page->programmed % FLASH_PROGRAM_SIZE);
+            if (size > (p_page->fill - p_page->programmed))
+            {
+                size = p_page->fill - p_page->programmed;
+            }
+            
+            fsp_err = s_gp_flash->p_api->write(s_gp_flash->p_ctrl, &p_page->data[p_page->programmed],
+                                               s_gp_memory + p_page->address + p_page->programmed, size);
+            p_page->programmed += size;
+            
+            /* The driver has taken the data: the buffer can fill again. */
+            if (p_page->programmed == p_page->fill)
+            {
+                s_g_page_first = (s_g_page_first + 1U) % FLASH_PAGE_BUFFERS;
+                s_g_page_count--;
+            }
+        }
+    }
+    else if ((s_g_erased < ahead) && (s_g_erased < s_g_limit))
+    {
+        fsp_err     = s_gp_flash->p_api->erase(s_gp_flash->p_ctrl, s_gp_memory + s_g_erased, FLASH_SECTOR_SIZE);
+        s_g_erased += FLASH_SECTOR_SIZE;
+    }
+    else
+    {
+        /* Nothing to do. */
+        return;
+    }
+    
+    if (FSP_SUCCESS != fsp_err)
+    {
+        s_g_error      = true;
+        s_g_page_count = 0U;
+        s_g_stage_read = s_g_stage_size;
+        return;
+    }
+    
+    s_g_busy = true;
+}
+
+/******************************************************************************
+ * @brief Check that a range is inside the flash area.
+ ******************************************************************************/
+static bool flash_area_check (uint32_t address, uint32_t size)
+{
+    /* An address below the area wraps around to a large offset. */
+    uint32_t offset = address - FLASH_AREA_START;
+    
+    return (offset < FLASH_AREA_SIZE) && (size <= (FLASH_AREA_SIZE - offset));
+}
@@ -0,0 +1,59 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+#ifndef __CMD_FLASH_H__
+#define __CMD_FLASH_H__
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Flash geometry */
+#define FLASH_PAGE_SIZE        (256U)
+#define FLASH_SECTOR_SIZE      (4096U)
+
+/* Area WRITE_FLASH may write (flash offsets) */
+#define FLASH_AREA_START       (0x00000000U)
+#define FLASH_AREA_SIZE        (0x00800000U)
+
+/* Largest data of one WRITE_FLASH command */
+#define FLASH_WRITE_MAX_DATA   (FLASH_PAGE_SIZE)
+
+/* Largest decoded data of one WRITE_FLASH_LZ4 command */
+#define FLASH_LZ4_MAX_DATA     (FLASH_SECTOR_SIZE)
+
+/* Digest checked by VERIFY_FLASH and returned by DIGEST_FLASH */
+#define FLASH_DIGEST_SIZE      (4U)
+
+/* Largest number of sector digests one DIGEST_FLASH returns */
+#define FLASH_DIGEST_MAX_SECTORS  (128U)
+
+/******************************************************************************
+ * Exported global functions (to be accessed by other files)
+ ******************************************************************************/
+void    cmd_flash_open(spi_flash_instance_t const *p_flash, uint8_t *p_memory);
+void    cmd_flash_poll(void);
+bool    cmd_flash_busy(void);
+bool    cmd_flash_ready(uint32_t address, uint32_t size);
+uint8_t cmd_write_flash(uint32_t address, uint8_t const *p_data, uint32_t size);
+uint8_t cmd_write_flash_lz4(uint32_t address, uint32_t size, uint8_t const *p_data, uint32_t data_size);
+uint8_t cmd_verify_flash(uint32_t address, uint32_t size, uint32_t digest);
+uint8_t cmd_begin_flash(uint32_t address, uint32_t size);
+uint8_t cmd_digest_flash(uint32_t address, uint32_t count, uint8_t *p_digest);
+
+#endif /* __CMD_FLASH_H__ */
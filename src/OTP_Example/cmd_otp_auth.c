@@ -21,10 +21,13 @@
 /******************************************************************************
  * Includes   <System Includes> , "Project Includes"
  ******************************************************************************/
+#include <string.h>
 #include "hal_data.h"
 #include "cmd_otp_auth.h"
+#include "cmd_otp.h"
 #include "otp.h"
 #include "common.h"
+#include "sha256.h"
 
 /******************************************************************************
  * Macro definitions
@@ -39,13 +42,43 @@
 #define TYPE_PLAIN                (0U)
 #define TYPE_HASH                 (1U)
 
-/* Authentication ID size */
+/* Authentication ID size. The debugger always presents a SIZE_PLAIN_ID ID;
+ * with the hash type the OTP holds its SHA-256 instead of the ID. */
 #define SIZE_PLAIN_ID             (16U)
-#define SIZE_HASH_ID              (32U)
+#define SIZE_HASH_ID              (SHA256_DIGEST_SIZE)
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+/* Buffers of cmd_derive_jtag_auth(). Static, off the 1 KB SVC stack the
+ * command chain runs on; wiped after each use. */
+typedef struct
+{
+    sha256_hmac_work_t hmac;
+    uint8_t            uid[UID_SIZE];
+    uint8_t            mac[SHA256_DIGEST_SIZE];
+    uint8_t            value[SIZE_HASH_ID];
+} derive_work_t;
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static derive_work_t s_g_derive;
+static uint8_t jtag_auth_id_value(uint8_t mode, uint8_t type, uint8_t const *p_id,
+                                  uint16_t *p_addr, uint8_t *p_value, uint8_t *p_size);
+static uint8_t jtag_auth_program(uint8_t mode, uint8_t type, uint16_t addr, uint8_t *p_value, uint8_t size);
+static otp_err_t jtag_auth_read(uint16_t *p_mode, uint16_t *p_type);
+static bool jtag_auth_allowed(uint8_t mode, uint8_t type, uint16_t current_mode, uint16_t current_type);
+static otp_err_t jtag_auth_write_word(uint16_t addr, uint16_t value);
+static otp_err_t jtag_auth_write_id(uint16_t addr, uint8_t *p_value, uint8_t size);
 
 /******************************************************************************
  * @brief Setup JTAG authentication.
  *
+ * The type can go from plain to hash only while no authentication mode is
+ * set, since the OTP bit cannot be cleared again and the type decides which
+ * IDs the mode is checked against.
+ *
  * @param[in]  mode           Authentication mode
  * @param[in]  type           Authentication type
  *
@@ -58,7 +91,6 @@ uint8_t cmd_set_jtag_auth (uint8_t mode, uint8_t type)
     uint8_t  ret          = RET_SUCCESS;
     uint16_t current_mode = 0U;
     uint16_t current_type = 0U;
-    uint16_t set_mode     = mode;
     otp_err_t otp_err     = OTP_SUCCESS;
     bool mode_is_invalid  = false;
     
@@ -75,7 +107,7 @@ uint8_t cmd_set_jtag_auth (uint8_t mode, uint8_t type)
             mode_is_invalid = true;
     }
     
-    if ((TYPE_PLAIN != type) || (true == mode_is_invalid))
+    if (((TYPE_PLAIN != type) && (TYPE_HASH != type)) || (true == mode_is_invalid))
     {
         return RET_DATA_FAIL;
     }
@@ -90,28 +122,29 @@ uint8_t cmd_set_jtag_auth (uint8_t mode, uint8_t type)
     
     do
     {
-        /* Read the current setting value. (authentication type value) */
-        /* The authentication type must be plain. */
-        otp_err = read_otp_data(JTAG_AUTH_TYPE_ADDR, &current_type);
+        /* Read the current setting values and check if the specified ones can be set. */
+        otp_err = jtag_auth_read(&current_mode, &current_type);
         
-        if ((OTP_SUCCESS != otp_err) || (TYPE_PLAIN != current_type))
+        if ((OTP_SUCCESS != otp_err) || (false == jtag_auth_allowed(mode, type, current_mode, current_type)))
         {
             ret = RET_WRITE_FAIL;
             break;
         }
         
-        /* Read the current setting value. (authentication mode value) */
-        /* Check if the specified value can be set. */
-        otp_err = read_otp_data(JTAG_AUTH_MODE_ADDR, &current_mode);
-        
-        if ((OTP_SUCCESS != otp_err) || (current_mode >= set_mode))
+        /* Change the type from plain to hash. */
+        if (type != current_type)
         {
-            ret = RET_WRITE_FAIL;
-            break;
+            otp_err = jtag_auth_write_word(JTAG_AUTH_TYPE_ADDR, TYPE_HASH);
+            
+            if (OTP_SUCCESS != otp_err)
+            {
+                ret = RET_WRITE_FAIL;
+                break;
+            }
         }
         
-        /* Write the specified setting value. */
-        otp_err = write_otp_data(JTAG_AUTH_MODE_ADDR, set_mode);
+        /* Write the specified mode and check if the value is updated. */
+        otp_err = jtag_auth_write_word(JTAG_AUTH_MODE_ADDR, mode);
         
         if (OTP_SUCCESS != otp_err)
         {
@@ -119,15 +152,6 @@ uint8_t cmd_set_jtag_auth (uint8_t mode, uint8_t type)
             break;
         }
         
-        /* Read the current setting value and check if the value is updated. */
-        otp_err = read_otp_data(JTAG_AUTH_MODE_ADDR, &current_mode);
-        
-        if ((OTP_SUCCESS != otp_err) || (current_mode < set_mode))
-        {
-            ret = RET_WRITE_FAIL;
-            break;
-        }
-        
     } while (0);
     
     /* OTP power off. */
@@ -221,12 +245,18 @@ uint8_t cmd_get_jtag_auth (uint8_t *p_mode, uint8_t *p_type)
     return ret;
 }
 
+
 /******************************************************************************
  * @brief Setup JTAG authentication ID.
  *
+ * With the plain type the ID is written as it is. With the hash type its
+ * SHA-256 is written to the hash ID area, in the same byte order as a plain
+ * ID. Either way the area is read back and compared, so an ID that was
+ * already programmed differently fails instead of leaving the OR of both.
+ *
  * @param[in]  mode           Authentication mode
  * @param[in]  type           Authentication type
- * @param[in]  p_id           Authentication ID
+ * @param[in]  p_id           Authentication ID (SIZE_PLAIN_ID bytes)
  *
  * @retval RET_SUCCESS     Success
  * @retval RET_DATA_FAIL   Data error
@@ -234,52 +264,342 @@ uint8_t cmd_get_jtag_auth (uint8_t *p_mode, uint8_t *p_type)
  ******************************************************************************/
 uint8_t cmd_set_jtag_auth_id (uint8_t mode, uint8_t type, uint8_t * const p_id)
 {
-    uint8_t  ret         = RET_SUCCESS;
-    uint16_t addr        = 0U;
-    otp_err_t otp_err    = OTP_SUCCESS;
-    bool mode_is_invalid = false;
+    uint8_t  ret      = RET_SUCCESS;
+    uint16_t addr     = 0U;
+    uint8_t  size     = 0U;
+    otp_err_t otp_err = OTP_SUCCESS;
+    uint8_t  value[SIZE_HASH_ID];
+    
+    /* Check authentication mode and type, and get the value to program. */
+    ret = jtag_auth_id_value(mode, type, p_id, &addr, value, &size);
+    
+    if (RET_SUCCESS != ret)
+    {
+        return ret;
+    }
+    
+    /* OTP power on. */
+    otp_err = otp_power_on();
+    
+    if (OTP_SUCCESS != otp_err)
+    {
+        return RET_WRITE_FAIL;
+    }
+    
+    /* Write authentication ID and verify it. */
+    otp_err = jtag_auth_write_id(addr, value, size);
+    
+    if (OTP_SUCCESS != otp_err)
+    {
+        ret = RET_WRITE_FAIL;
+    }
+    
+    /* OTP power off. */
+    otp_power_off();
+    
+    return ret;
+}
+
+/******************************************************************************
+ * @brief Setup JTAG authentication mode, type and ID in one OTP session.
+ *
+ * See jtag_auth_program() for the order of the writes.
+ *
+ * @param[in]  mode           Authentication mode (level 1 or 2)
+ * @param[in]  type           Authentication type
+ * @param[in]  p_id           Authentication ID (SIZE_PLAIN_ID bytes)
+ *
+ * @retval RET_SUCCESS     Success
+ * @retval RET_DATA_FAIL   Data error
+ * @retval RET_WRITE_FAIL  Write error
+ ******************************************************************************/
+uint8_t cmd_setup_jtag_auth (uint8_t mode, uint8_t type, uint8_t * const p_id)
+{
+    uint8_t  ret      = RET_SUCCESS;
+    uint16_t addr     = 0U;
+    uint8_t  size     = 0U;
+    otp_err_t otp_err = OTP_SUCCESS;
+    uint8_t  value[SIZE_HASH_ID];
+    
+    /* Check authentication mode and type, and get the value to program. */
+    ret = jtag_auth_id_value(mode, type, p_id, &addr, value, &size);
+    
+    if (RET_SUCCESS != ret)
+    {
+        return ret;
+    }
+    
+    /* OTP power on. */
+    otp_err = otp_power_on();
+    
+    if (OTP_SUCCESS != otp_err)
+    {
+        return RET_WRITE_FAIL;
+    }
+    
+    ret = jtag_auth_program(mode, type, addr, value, size);
+    
+    /* OTP power off. */
+    otp_power_off();
+    
+    return ret;
+}
+
+/******************************************************************************
+ * @brief Setup JTAG authentication with an ID derived from the unique ID.
+ *
+ * The ID is the first SIZE_PLAIN_ID bytes of HMAC-SHA256(key, UID), so each
+ * board gets its own ID and the host needs only the key and the UID to work
+ * it out again. It is programmed as cmd_setup_jtag_auth() does, in the same
+ * OTP session as the UID read. The derived values are wiped before
+ * returning; the key stays with the caller. Not reentrant: the buffers are
+ * static.
+ *
+ * @param[in]  mode           Authentication mode (level 1 or 2)
+ * @param[in]  type           Authentication type
+ * @param[in]  p_key          Master key
+ * @param[in]  key_size       Master key size in bytes
+ *
+ * @retval RET_SUCCESS     Success
+ * @retval RET_DATA_FAIL   Data error
+ * @retval RET_READ_FAIL   UID read error
+ * @retval RET_WRITE_FAIL  Write error
+ ******************************************************************************/
+uint8_t cmd_derive_jtag_auth (uint8_t mode, uint8_t type, uint8_t const * const p_key, uint32_t key_size)
+{
+    uint8_t  ret      = RET_SUCCESS;
+    uint16_t addr     = 0U;
+    uint8_t  size     = 0U;
+    otp_err_t otp_err = OTP_SUCCESS;
+    derive_work_t *p_work = &s_g_derive;
+    
+    /* Check authentication mode and type before touching the OTP. */
+    memset(p_work->mac, 0, sizeof(p_work->mac));
+    ret = jtag_auth_id_value(mode, type, p_work->mac, &addr, p_work->value, &size);
+    
+    if (RET_SUCCESS != ret)
+    {
+        return ret;
+    }
+    
+    /* OTP power on. */
+    otp_err = otp_power_on();
+    
+    if (OTP_SUCCESS != otp_err)
+    {
+        return RET_WRITE_FAIL;
+    }
+    
+    /* Read unique ID and derive the authentication ID from it. */
+    otp_err = read_otp_multiple_data(UID_ADDR, p_work->uid, UID_SIZE);
+    
+    if (OTP_SUCCESS != otp_err)
+    {
+        ret = RET_READ_FAIL;
+    }
+    else
+    {
+        sha256_hmac_work(&p_work->hmac, p_key, key_size, p_work->uid, UID_SIZE, p_work->mac);
+        (void) jtag_auth_id_value(mode, type, p_work->mac, &addr, p_work->value, &size);
+        ret = jtag_auth_program(mode, type, addr, p_work->value, size);
+    }
+    
+    /* OTP power off. */
+    otp_power_off();
+    
+    sha256_wipe(p_work, sizeof(*p_work));
+    
+    return ret;
+}
+
+/******************************************************************************
+ * @brief Program an authentication ID, the type and the mode. The OTP must be
+ *        powered.
+ *
+ * The target is checked against the current mode and type once. The ID goes
+ * first, then the type, then the mode, each read back before the next: if a
+ * step fails, JTAG is left without the new mode rather than with a mode
+ * whose ID or type is wrong.
+ *
+ * @param[in]  mode           Authentication mode
+ * @param[in]  type           Authentication type
+ * @param[in]  addr           OTP address of the ID
+ * @param[in]  p_value        The ID, or its SHA-256
+ * @param[in]  size           Size of the value in bytes
+ *
+ * @retval RET_SUCCESS     Success
+ * @retval RET_WRITE_FAIL  Write error
+ ******************************************************************************/
+static uint8_t jtag_auth_program (uint8_t mode, uint8_t type, uint16_t addr, uint8_t *p_value, uint8_t size)
+{
+    uint16_t current_mode = 0U;
+    uint16_t current_type = 0U;
+    otp_err_t otp_err     = OTP_SUCCESS;
+    
+    /* Read the current setting values and check if the specified ones can be set. */
+    otp_err = jtag_auth_read(&current_mode, &current_type);
+    
+    if ((OTP_SUCCESS != otp_err) || (false == jtag_auth_allowed(mode, type, current_mode, current_type)))
+    {
+        return RET_WRITE_FAIL;
+    }
     
+    /* Write authentication ID and verify it. */
+    otp_err = jtag_auth_write_id(addr, p_value, size);
+    
+    if (OTP_SUCCESS != otp_err)
+    {
+        return RET_WRITE_FAIL;
+    }
+    
+    /* Change the type from plain to hash. */
+    if (type != current_type)
+    {
+        otp_err = jtag_auth_write_word(JTAG_AUTH_TYPE_ADDR, TYPE_HASH);
+        
+        if (OTP_SUCCESS != otp_err)
+        {
+            return RET_WRITE_FAIL;
+        }
+    }
+    
+    /* Write the mode last. */
+    otp_err = jtag_auth_write_word(JTAG_AUTH_MODE_ADDR, mode);
+    
+    if (OTP_SUCCESS != otp_err)
+    {
+        return RET_WRITE_FAIL;
+    }
+    
+    return RET_SUCCESS;
+}
+
+/******************************************************************************
+ * @brief Get the address and the value of an authentication ID.
+ *
+ * @param[in]  mode           Authentication mode (level 1 or 2)
+ * @param[in]  type           Authentication type
+ * @param[in]  p_id           Authentication ID (SIZE_PLAIN_ID bytes)
+ * @param[out] p_addr         OTP address of the ID
+ * @param[out] p_value        The ID, or its SHA-256 (SIZE_HASH_ID bytes)
+ * @param[out] p_size         Size of the value in bytes
+ *
+ * @retval RET_SUCCESS     Success
+ * @retval RET_DATA_FAIL   Data error
+ ******************************************************************************/
+static uint8_t jtag_auth_id_value (uint8_t mode, uint8_t type, uint8_t const *p_id,
+                                   uint16_t *p_addr, uint8_t *p_value, uint8_t *p_size)
+{
     /* Check where to write the authentication ID. */
     switch (mode)
     {
         case JTAG_MODE_AUTHLV1:
-            addr = JTAG_AUTH_ID1_PLAIN_ADDR;
+            *p_addr = (TYPE_HASH == type) ? JTAG_AUTH_ID1_HASH_ADDR : JTAG_AUTH_ID1_PLAIN_ADDR;
             break;
             
         case JTAG_MODE_AUTHLV2:
-            addr = JTAG_AUTH_ID4_PLAIN_ADDR;
+            *p_addr = (TYPE_HASH == type) ? JTAG_AUTH_ID4_HASH_ADDR : JTAG_AUTH_ID4_PLAIN_ADDR;
             break;
         
         /* Unknown mode. */
         default:
-            mode_is_invalid = true;
+            return RET_DATA_FAIL;
     }
     
-    /* Check authentication mode and type. */
-    if ((TYPE_PLAIN != type) || (true == mode_is_invalid))
+    if (TYPE_HASH == type)
+    {
+        sha256_calc(p_id, SIZE_PLAIN_ID, p_value);
+        *p_size = SIZE_HASH_ID;
+    }
+    else if (TYPE_PLAIN == type)
+    {
+        memcpy(p_value, p_id, SIZE_PLAIN_ID);
+        *p_size = SIZE_PLAIN_ID;
+    }
+    else
     {
         return RET_DATA_FAIL;
     }
     
-    /* OTP power on. */
-    otp_err = otp_power_on();
+    return RET_SUCCESS;
+}
+
+/******************************************************************************
+ * @brief Read the authentication mode and type. The OTP must be powered.
+ ******************************************************************************/
+static otp_err_t jtag_auth_read (uint16_t *p_mode, uint16_t *p_type)
+{
+    otp_err_t otp_err = read_otp_data(JTAG_AUTH_MODE_ADDR, p_mode);
     
-    if (OTP_SUCCESS != otp_err)
+    if (OTP_SUCCESS == otp_err)
     {
-        return RET_WRITE_FAIL;
+        otp_err = read_otp_data(JTAG_AUTH_TYPE_ADDR, p_type);
     }
     
-    /* Write authentication ID. */
-    otp_err = write_otp_multiple_data(addr, p_id, SIZE_PLAIN_ID);
+    return otp_err;
+}
+
+/******************************************************************************
+ * @brief Check whether a mode and type can be set over the current ones.
+ *
+ * The mode must be higher than the current one. The type must stay, or go
+ * from plain to hash while no mode is set.
+ ******************************************************************************/
+static bool jtag_auth_allowed (uint8_t mode, uint8_t type, uint16_t current_mode, uint16_t current_type)
+{
+    if (current_mode >= mode)
+    {
+        return false;
+    }
     
-    if (OTP_SUCCESS != otp_err)
+    if (type == current_type)
     {
-        ret = RET_WRITE_FAIL;
+        return true;
     }
     
-    /* OTP power off. */
-    otp_power_off();
+    return ((TYPE_HASH == type) && (TYPE_PLAIN == current_type) && (JTAG_MODE_NO_AUTH == current_mode));
+}
+
+/******************************************************************************
+ * @brief Write a setting word and check that its bits are set. The OTP must
+ *        be powered.
+ ******************************************************************************/
+static otp_err_t jtag_auth_write_word (uint16_t addr, uint16_t value)
+{
+    uint16_t read_value = 0U;
+    otp_err_t otp_err   = write_otp_data(addr, value);
     
-    return ret;
+    if (OTP_SUCCESS == otp_err)
+    {
+        otp_err = read_otp_data(addr, &read_value);
+    }
+    
+    if ((OTP_SUCCESS == otp_err) && (value != (read_value & value)))
+    {
+        otp_err = OTP_ERROR;
+    }
+    
+    return otp_err;
 }
 
+/******************************************************************************
+ * @brief Write an authentication ID and compare it with a read back. The OTP
+ *        must be powered.
+ ******************************************************************************/
+static otp_err_t jtag_auth_write_id (uint16_t addr, uint8_t *p_value, uint8_t size)
+{
+    uint8_t   read_value[SIZE_HASH_ID];
+    otp_err_t otp_err = write_otp_multiple_data(addr, p_value, size);
+    
+    if (OTP_SUCCESS == otp_err)
+    {
+        otp_err = read_otp_multiple_data(addr, read_value, size);
+    }
+    
+    if ((OTP_SUCCESS == otp_err) && (0 != memcmp(p_value, read_value, size)))
+    {
+        otp_err = OTP_ERROR;
+    }
+    
+    return otp_err;
+}
@@ -26,5 +26,7 @@
 uint8_t cmd_set_jtag_auth(uint8_t mode, uint8_t type);
 uint8_t cmd_get_jtag_auth(uint8_t *p_mode, uint8_t *p_type);
 uint8_t cmd_set_jtag_auth_id(uint8_t mode, uint8_t type, uint8_t * const p_id);
+uint8_t cmd_setup_jtag_auth(uint8_t mode, uint8_t type, uint8_t * const p_id);
+uint8_t cmd_derive_jtag_auth(uint8_t mode, uint8_t type, uint8_t const * const p_key, uint32_t key_size);
 
 #endif /* __CMD_OTP_AUTH_H__ */
@@ -0,0 +1,189 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <string.h>
+#include "hal_data.h"
+#include "cmd_otp.h"
+#include "cmd_otp_auth.h"
+#include "cmd_otp_plan.h"
+#include "otp.h"
+#include "common.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* SCI/USB boot mode, as cmd_otp.c */
+#define SCIUSB_BOOT_DIS_OFFSET   (1U)
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static otp_state_t s_g_state;                               // Values read for the planner
+
+static otp_err_t plan_read_state(otp_profile_t const *p_profile, otp_state_t *p_state);
+static uint8_t plan_execute(otp_profile_t const *p_profile, plan_step_t const *p_step);
+
+/******************************************************************************
+ * @brief Bring the OTP to a profile.
+ *
+ * The current values are read in one OTP session, the ID area of the
+ * profile's JTAG mode included, and otp_plan_make() works out the writes.
+ * Nothing is written when the profile cannot be reached. The steps then run
+ * as the single commands do, each with its own verify, and stop at the
+ * first that fails. The state read is static, as the command chain runs on
+ * the 1 KB SVC stack: not reentrant.
+ *
+ * @param[in]  p_profile      Target
+ * @param[in]  dry_run        Plan only
+ * @param[out] p_plan         Steps, or the conflict
+ * @param[out] p_done         Steps that were executed
+ *
+ * @retval RET_SUCCESS     Success
+ * @retval RET_DATA_FAIL   The profile cannot be reached (p_plan->err)
+ * @retval RET_READ_FAIL   Read error
+ * @retval RET_WRITE_FAIL  A step failed
+ ******************************************************************************/
+uint8_t cmd_apply_otp_profile (otp_profile_t const *p_profile, bool dry_run, otp_plan_t *p_plan, uint32_t *p_done)
+{
+    uint8_t      ret     = RET_SUCCESS;
+    otp_err_t    otp_err = OTP_SUCCESS;
+    otp_state_t *p_state = &s_g_state;
+    
+    *p_done = 0U;
+    memset(p_plan, 0, sizeof(*p_plan));
+    
+    /* OTP power on. */
+    otp_err = otp_power_on();
+    
+    if (OTP_SUCCESS == otp_err)
+    {
+        otp_err = plan_read_state(p_profile, p_state);
+        
+        /* OTP power off. */
+        otp_power_off();
+    }
+    
+    if (OTP_SUCCESS != otp_err)
+    {
+        p_plan->err = PLAN_ERR_READ;
+        return RET_READ_FAIL;
+    }
+    
+    if (PLAN_OK != otp_plan_make(p_profile, p_state, p_plan))
+    {
+        return RET_DATA_FAIL;
+    }
+    
+    for (uint32_t i = 0U; (false == dry_run) && (i < p_plan->num_steps); i++)
+    {
+        ret = plan_execute(p_profile, &p_plan->steps[i]);
+        
+        if (RET_SUCCESS != ret)
+        {
+            break;
+        }
+        
+        (*p_done)++;
+    }
+    
+    return ret;
+}
+
+/******************************************************************************
+ * @brief Read what the planner needs. The OTP must be powered.
+ ******************************************************************************/
+static otp_err_t plan_read_state (otp_profile_t const *p_profile, otp_state_t *p_state)
+{
+    uint16_t  value   = 0U;
+    uint16_t  addr    = 0U;
+    uint32_t  size    = 0U;
+    otp_err_t otp_err = OTP_SUCCESS;
+    
+    memset(p_state, 0, sizeof(*p_state));
+    
+    do
+    {
+        otp_err = read_otp_data(JTAG_AUTH_MODE_ADDR, &value);
+        p_state->jauth_mode = otp_plan_jauth_mode(value);
+        
+        if (OTP_SUCCESS != otp_err)
+        {
+            break;
+        }
+        
+        otp_err = read_otp_data(JTAG_AUTH_TYPE_ADDR, &value);
+        p_state->jauth_type = (uint8_t)((1U == value) ? 1U : 0U);
+        
+        if (OTP_SUCCESS != otp_err)
+        {
+            break;
+        }
+        
+        otp_err = read_otp_data(SCI_USB_BOOT_ADDR, &value);
+        p_state->sciusb_mode = (uint8_t)(value >> SCIUSB_BOOT_DIS_OFFSET);
+        
+        for (uint32_t i = 0U; (OTP_SUCCESS == otp_err) && (i < PLAN_COUNTER_WORDS); i++)
+        {
+            otp_err = read_otp_data(otp_plan_counter_addr(i), &p_state->counter[i]);
+        }
+        
+        for (uint32_t i = 0U; (OTP_SUCCESS == otp_err) && (i < p_profile->num_words) && (i < PLAN_MAX_WORDS); i++)
+        {
+            otp_err = read_otp_data(p_profile->words[i].addr, &p_state->words[i]);
+        }
+        
+        /* The ID area the profile's mode uses, so a conflicting ID is found before any write. */
+        if ((OTP_SUCCESS == otp_err) &&
+            (true == otp_plan_id_area(p_profile->jauth_mode, p_profile->jauth_type, &addr, &size)))
+        {
+            otp_err = read_otp_multiple_data(addr, p_state->id, (uint8_t)size);
+            p_state->id_known = (OTP_SUCCESS == otp_err);
+        }
+        
+    } while (0);
+    
+    return otp_err;
+}
+
+/******************************************************************************
+ * @brief Execute one step with the command that does it alone.
+ ******************************************************************************/
+static uint8_t plan_execute (otp_profile_t const *p_profile, plan_step_t const *p_step)
+{
+    uint8_t id[PLAN_ID_SIZE];
+    
+    switch (p_step->action)
+    {
+        case PLAN_WRITE_OTP:
+            return cmd_write_otp(p_step->addr, p_step->value);
+        case PLAN_SET_SCIUSB:
+            return cmd_set_sci_usb_boot(p_step->mode);
+        case PLAN_SET_JAUTH:
+            return cmd_set_jtag_auth(p_step->mode, p_step->type);
+        case PLAN_SETUP_JAUTH:
+            memcpy(id, p_profile->jauth_id, PLAN_ID_SIZE);
+            return cmd_setup_jtag_auth(p_step->mode, p_step->type, id);
+        default:
+            return RET_DATA_FAIL;
+    }
+}
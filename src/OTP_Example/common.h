@@ -28,5 +28,6 @@
 #define RET_DATA_FAIL      (0x11U)
 #define RET_WRITE_FAIL     (0x12U)
 #define RET_READ_FAIL      (0x13U)
+#define RET_CMD_FAIL       (0x14U)
 
 #endif /* __COMMON_H__ */
@@ -0,0 +1,254 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#if defined(_RENESAS_RZN_)
+#include "hal_data.h"
+#endif
+#include "crc.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Reflected CRC-32 polynomial */
+#define CRC32_POLYNOMIAL          (0xEDB88320UL)
+#define CRC32_XOR_VALUE           (0xFFFFFFFFUL)
+
+#if defined(_RENESAS_RZN_)
+/* CRC unit settings: CRCCR0.GPS = CRC-32, CRCCR0.LMS = LSB first */
+#define CRC_UNIT_GPS_CRC32        (4U)
+#define CRC_UNIT_LMS_LSB_FIRST    (0U)
+#define CRC_UNIT_CHANNEL          (0U)
+#endif
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+#if defined(_RENESAS_RZN_)
+static bool s_g_crc_unit_started = false;
+
+#else
+static bool     s_g_crc_table_ready = false;
+static uint32_t s_g_crc_table[8][256];
+
+static void crc32_table_init(void);
+#endif
+
+#if defined(_RENESAS_RZN_)
+/******************************************************************************
+ * @brief Calculate CRC-32 with the CRC calculator unit (CRC0).
+ *
+ * The unit runs in LSB-first mode, which is the reflected CRC-32. Aligned
+ * words are written to CRCDIR in one access; on this little-endian core the
+ * unit consumes them lowest byte first, the same order as the byte stream.
+ *
+ * @param[in]  crc            0 to start, or the previous result to continue
+ * @param[in]  p_data         Data
+ * @param[in]  size           Data size in bytes
+ *
+ * @retval CRC-32 of the data
+ ******************************************************************************/
+uint32_t crc32_calc(uint32_t crc, uint8_t const *p_data, uint32_t size)
+{
+    if (false == s_g_crc_unit_started)
+    {
+        R_BSP_MODULE_START(FSP_IP_CRC, CRC_UNIT_CHANNEL);
+        s_g_crc_unit_started = true;
+    }
+    
+    R_CRC0->CRCCR0 = (uint8_t)(CRC_UNIT_GPS_CRC32 | (CRC_UNIT_LMS_LSB_FIRST << R_CRC0_CRCCR0_LMS_Pos));
+    
+    /* Continue from the previous value (the unit holds the non-inverted remainder). */
+    R_CRC0->CRCDOR = crc ^ CRC32_XOR_VALUE;
+    
+    /* Leading bytes up to word alignment. */
+    while ((0U != size) && (0U != ((uintptr_t)p_data & 3U)))
+    {
+        R_CRC0->CRCDIR_BY = *p_data;
+        p_data++;
+        size--;
+    }
+    
+    /* Whole words. */
+    while (size >= 4U)
+    {
+        R_CRC0->CRCDIR = *(uint32_t const *)p_data;
+        p_data += 4;
+        size   -= 4U;
+    }
+    
+    /* Trailing bytes. */
+    while (0U != size)
+    {
+        R_CRC0->CRCDIR_BY = *p_data;
+        p_data++;
+        size--;
+    }
+    
+    return R_CRC0->CRCDOR ^ CRC32_XOR_VALUE;
+}
+
+#else
+/******************************************************************************
+ * @brief Build the slicing-by-8 tables.
+ *
+ * Table 0 is the classic byte-wise table. Table k gives the CRC contribution
+ * of a byte followed by k zero bytes, so eight input bytes are folded with
+ * eight independent lookups per step.
+ ******************************************************************************/
+static void crc32_table_init(void)
+{
+    for (uint32_t i = 0U; i < 256U; i++)
+    {
+        uint32_t c = i;
+        for (uint32_t bit = 0U; bit < 8U; bit++)
+        {
+            c = (c & 1U) ? ((c >> 1) ^ CRC32_POLYNOMIAL) : (c >> 1);
+        }
+        s_g_crc_table[0][i] = c;
+    }
+    
+    for (uint32_t i = 0U; i < 256U; i++)
+    {
+        for (uint32_t k = 1U; k < 8U; k++)
+        {
+            uint32_t prev = s_g_crc_table[k - 1U][i];
+            s_g_crc_table[k][i] = (prev >> 8) ^ s_g_crc_table[0][prev & 0xFFU];
+        }
+    }
+    
+    s_g_crc_table_ready = true;
+}
+
+/******************************************************************************
+ * @brief Calculate CRC-32 in software, eight bytes per step (slicing-by-8).
+ *
+ * @param[in]  crc            0 to start, or the previous result to continue
+ * @param[in]  p_data         Data
+ * @param[in]  size           Data size in bytes
+ *
+ * @retval CRC-32 of the data
+ ******************************************************************************/
+uint32_t crc32_calc(uint32_t crc, uint8_t const *p_data, uint32_t size)
+{
+    uint32_t c = crc ^ CRC32_XOR_VALUE;
+    
+    if (false == s_g_crc_table_ready)
+    {
+        crc32_table_init();
+    }
+    
+    /* Byte order independent: the words are assembled from bytes. */
+    while (size >= 8U)
+    {
+        uint32_t lo = c ^ ((uint32_t)p_data[0]         | ((uint32_t)p_data[1] << 8) |
+                           ((uint32_t)p_data[2] << 16) | ((uint32_t)p_data[3] << 24));
+        uint32_t hi = (uint32_t)p_data[4]         | ((uint32_t)p_data[5] << 8) |
+                      ((uint32_t)p_data[6] << 16) | ((uint32_t)p_data[7] << 24);
+        
+        c = s_g_crc_table[7][lo & 0xFFU]         ^ s_g_crc_table[6][(lo >> 8) & 0xFFU] ^
+            s_g_crc_table[5][(lo >> 16) & 0xFFU] ^ s_g_crc_table[4][lo >> 24]         ^
+            s_g_crc_table[3][hi & 0xFFU]         ^ s_g_crc_table[2][(hi >> 8) & 0xFFU] ^
+            s_g_crc_table[1][(hi >> 16) & 0xFFU] ^ s_g_crc_table[0][hi >> 24];
+        
+        p_data += 8;
+        size   -= 8U;
+    }
+    
+    while (0U != size)
+    {
+        c = (c >> 8) ^ s_g_crc_table[0][(c ^ *p_data) & 0xFFU];
+        p_data++;
+        size--;
+    }
+    
+    return c ^ CRC32_XOR_VALUE;
+}
+#endif
+
+/******************************************************************************
+ * @brief Build the shift table of a patch followed by a number of bytes.
+ *
+ * Word i is the CRC register, started at bit i alone and with no final XOR,
+ * after the following bytes as zeros.
+ *
+ * @param[out] p_shift        CRC32_SHIFT_WORDS words
+ * @param[in]  following      Bytes after the patch that the CRC covers
+ ******************************************************************************/
+void crc32_shift_init(uint32_t *p_shift, uint32_t following)
+{
+    static uint8_t const zeros[64] = {0U};
+    
+    for (uint32_t i = 0U; i < CRC32_SHIFT_WORDS; i++)
+    {
+        uint32_t crc  = (1UL << i) ^ CRC32_XOR_VALUE;
+        uint32_t left = following;
+        
+        while (0U != left)
+        {
+            uint32_t size = (left < sizeof(zeros)) ? left : (uint32_t)sizeof(zeros);
+            crc   = crc32_calc(crc, zeros, size);
+            left -= size;
+        }
+        p_shift[i] = crc ^ CRC32_XOR_VALUE;
+    }
+}
+
+/******************************************************************************
+ * @brief Correct a CRC-32 for bytes that change.
+ *
+ * @param[in]  crc            CRC-32 of the message with the old bytes
+ * @param[in]  p_shift        Table of crc32_shift_init() for the bytes after the patch
+ * @param[in]  p_old          Bytes in the message now
+ * @param[in]  p_new          Bytes that replace them
+ * @param[in]  size           Patch size, up to CRC32_PATCH_MAX_SIZE bytes
+ *
+ * @retval CRC-32 of the message with the new bytes
+ ******************************************************************************/
+uint32_t crc32_patch(uint32_t crc, uint32_t const *p_shift, uint8_t const *p_old, uint8_t const *p_new,
+                     uint32_t size)
+{
+    uint8_t  delta[CRC32_PATCH_MAX_SIZE];
+    uint32_t reg;
+    
+    for (uint32_t i = 0U; (i < size) && (i < CRC32_PATCH_MAX_SIZE); i++)
+    {
+        delta[i] = (uint8_t)(p_old[i] ^ p_new[i]);
+    }
+    
+    /* The register from zero over the difference; bytes before it add nothing. */
+    reg = crc32_calc(CRC32_XOR_VALUE, delta, (size < CRC32_PATCH_MAX_SIZE) ? size : CRC32_PATCH_MAX_SIZE) ^
+          CRC32_XOR_VALUE;
+    
+    for (uint32_t i = 0U; (0U != reg) && (i < CRC32_SHIFT_WORDS); i++)
+    {
+        if (0U != (reg & 1U))
+        {
+            crc ^= p_shift[i];
+        }
+        reg >>= 1;
+    }
+    
+    return crc;
+}
@@ -0,0 +1,854 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "hal_data.h"
+#include "cmd_flash.h"
+#include "cmd_otp.h"
+#include "cmd_otp_auth.h"
+#include "cmd_otp_plan.h"
+#include "common.h"
+#include "crc.h"
+#include "sha256.h"
+#include "frame.h"
+#include "log.h"
+#include "otp_audit.h"
+#include "systime.h"
+#include "transport.h"
+#include "device_setup.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Bytes taken from the transport at one time */
+#define RECEIVE_CHUNK_SIZE       (256U)
+
+/* Commands waiting for execution */
+#define COMMAND_QUEUE_SIZE       (FRAME_WINDOW_SIZE)
+
+/* Largest command held in the queue: a WRITE_FLASH_LZ4 may fill a frame */
+#define COMMAND_MAX_SIZE         (FRAME_MAX_PAYLOAD)
+
+/* Results of recent writing commands kept for replay: OTP and session
+ * commands, and flash stream commands in entries of their own, so a long
+ * flash stream does not push out the OTP results */
+#define REPLAY_OTP_SIZE          (16U)
+#define REPLAY_FLASH_SIZE        (FRAME_WINDOW_SIZE)
+#define REPLAY_CACHE_SIZE        (REPLAY_OTP_SIZE + REPLAY_FLASH_SIZE)
+
+/* Largest response data of a writing command: the APPLY_PROFILE result */
+#define REPLAY_DATA_SIZE         (PROFILE_RESULT_SIZE)
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+/* Queued command */
+typedef struct
+{
+    uint32_t   size;
+    uint8_t    data[COMMAND_MAX_SIZE];
+} command_t;
+
+/* Result of an executed writing command */
+typedef struct
+{
+    bool       valid;
+    uint8_t    tag;
+    uint8_t    ret;
+    uint8_t    data_size;
+    uint8_t    data[REPLAY_DATA_SIZE];          // Response data sent with ret
+    uint32_t   crc;                             // CRC-32 of the whole command packet
+} replay_entry_t;
+
+/* Values the cheap queries are answered from */
+typedef struct
+{
+    bool       uid_valid;
+    uint8_t    uid[UID_SIZE];
+    bool       jauth_valid;
+    uint8_t    jauth_mode;
+    uint8_t    jauth_type;
+    bool       sciusb_valid;
+    uint8_t    sciusb_mode;
+} device_cache_t;
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static transport_instance_t const *s_gp_transport;          // Line to the host
+static frame_link_t   s_g_link;                             // Link to the host
+static uint8_t        s_g_response[FRAME_MAX_PAYLOAD];      // Response packet
+static uint8_t        s_g_chunk[RECEIVE_CHUNK_SIZE];        // Bytes taken from the transport
+static command_t      s_g_queue[COMMAND_QUEUE_SIZE];        // Commands waiting for execution
+static uint32_t       s_g_queue_head;                       // Next command to execute
+static uint32_t       s_g_queue_count;                      // Commands waiting
+static device_cache_t s_g_cache;                            // Answers to cheap queries
+static replay_entry_t s_g_replay[REPLAY_CACHE_SIZE];        // Results of recent writes
+static uint32_t       s_g_replay_next_otp;                  // Entry to replace next, OTP and session commands
+static uint32_t       s_g_replay_next_flash;                // Entry to replace next, flash stream commands
+static otp_profile_t  s_g_profile;                          // APPLY_PROFILE target
+static otp_plan_t     s_g_plan;                             // APPLY_PROFILE steps
+static bool           s_g_log_held;                         // The ring holds the records of a READ_LOG
+static uint8_t        s_g_log_tag;                          // Tag of that READ_LOG
+
+static void device_setup_link_write(void *p_context, uint8_t const *p_data, uint32_t size);
+static bool device_setup_accept(void *p_context);
+static void device_setup_receive(void *p_context, uint8_t const *p_data, uint32_t size);
+static bool device_setup_answer_cached(packet_t const *p_packet);
+static bool device_setup_queued(uint8_t code);
+static bool device_setup_is_write(uint8_t code);
+static bool device_setup_replay(uint8_t const *p_data, uint32_t size);
+static bool device_setup_ready(uint8_t const *p_data, uint32_t size);
+static void device_setup_replay_store(uint8_t const *p_data, uint32_t size, uint8_t ret, uint32_t data_size);
+static void device_setup_execute(uint8_t const *p_data, uint32_t size);
+static void device_setup_respond(uint8_t code, uint8_t tag, uint8_t ret, uint32_t data_size);
+static uint8_t device_setup_check(uint8_t const *p_data, uint32_t size);
+static uint8_t device_setup_apply_profile(cmd_apply_profile_t const *p_cmd, uint8_t *p_result);
+static uint32_t get_be32(uint8_t const *p_data);
+static uint16_t get_be16(uint8_t const *p_data);
+static void put_be32(uint8_t *p_data, uint32_t value);
+
+/******************************************************************************
+ * @brief Initialize device setup.
+ *
+ * Commands arrive over a sliding-window link (frame.c): each packet is
+ * checked by CRC, resent by the host if lost and received exactly once, in
+ * the order the host sent it. The frames travel over p_transport, which is
+ * the SCI on the board and a pipe, pty or loopback on the host.
+ *
+ * Received commands go to a queue and run one per device_setup_poll() call,
+ * so the link keeps receiving and acknowledging while a command works on the
+ * OTP or the flash. Queries whose answer is cached (UID, JTAG authentication, SCI/USB
+ * boot) are answered at once, ahead of the queue, unless a queued command
+ * changes that answer.
+ *
+ * @param[in]  p_transport    Line to the host
+ ******************************************************************************/
+void device_setup(transport_instance_t const *p_transport)
+{
+    frame_cfg_t cfg;
+    
+    s_gp_transport        = p_transport;
+    s_g_queue_head        = 0U;
+    s_g_queue_count       = 0U;
+    s_g_replay_next_otp   = 0U;
+    s_g_replay_next_flash = 0U;
+    s_g_log_held          = false;
+    memset(s_g_replay, 0, sizeof(s_g_replay));
+    
+    /* Fill the cache. A value that cannot be read is read again by its query. */
+    memset(&s_g_cache, 0, sizeof(s_g_cache));
+    s_g_cache.uid_valid    = (RET_SUCCESS == cmd_get_unique_id(s_g_cache.uid));
+    s_g_cache.jauth_valid  = (RET_SUCCESS == cmd_get_jtag_auth(&s_g_cache.jauth_mode, &s_g_cache.jauth_type));
+    s_g_cache.sciusb_valid = (RET_SUCCESS == cmd_get_sci_usb_boot(&s_g_cache.sciusb_mode));
+    
+    cfg.p_write          = device_setup_link_write;
+    cfg.p_deliver        = device_setup_receive;
+    cfg.p_accept         = device_setup_accept;
+    cfg.p_context        = NULL;
+    cfg.retry_timeout_ms = FRAME_RETRY_TIMEOUT_MS;
+    frame_init(&s_g_link, &cfg);
+}
+
+/******************************************************************************
+ * @brief Receive commands, execute the next queued one, run link timers and
+ *        send pending acknowledgements.
+ *
+ * A flash command waits at the head of the queue until the flash can take
+ * it; the commands behind it wait too, so the order is kept.
+ *
+ * Does not wait: call it for every event (event.h), or after the transport's poll
+ * function. Main loop only: the receive buffer is static, to keep it off the
+ * 1 KB SVC stack the whole command chain runs on.
+ *
+ * @param[in]  now_ms         Current time in milliseconds (free running)
+ ******************************************************************************/
+void device_setup_poll(uint32_t now_ms)
+{
+    uint32_t size;
+    
+    /* Timers first, so that responses to the commands below are stamped with now_ms. */
+    frame_poll(&s_g_link, now_ms);
+    
+    do
+    {
+        size = s_gp_transport->p_api->receive(s_gp_transport->p_ctrl, s_g_chunk, sizeof(s_g_chunk));
+        frame_input(&s_g_link, s_g_chunk, size);
+    } while (sizeof(s_g_chunk) == size);
+    
+    /* Acknowledge what arrived before the command below keeps the loop busy. */
+    frame_poll(&s_g_link, now_ms);
+    
+    cmd_flash_poll();
+    
+    if ((0U != s_g_queue_count) &&
+        (true == device_setup_ready(s_g_queue[s_g_queue_head].data, s_g_queue[s_g_queue_head].size)))
+    {
+        command_t *p_cmd = &s_g_queue[s_g_queue_head];
+        
+        device_setup_execute(p_cmd->data, p_cmd->size);
+        
+        /* Do not keep a master key in the queue. */
+        if (CMD_DERIVE_JAUTH == ((packet_t const *)p_cmd->data)->head.code)
+        {
+            sha256_wipe(p_cmd->data, p_cmd->size);
+        }
+        s_g_queue_head = (s_g_queue_head + 1U) % COMMAND_QUEUE_SIZE;
+        s_g_queue_count--;
+        
+        /* Deliver what the queue held back. */
+        frame_poll(&s_g_link, now_ms);
+    }
+}
+
+/******************************************************************************
+ * @brief Check whether device_setup_poll() has work left without a new event:
+ *        a queued command, or flash programming or erasing.
+ ******************************************************************************/
+bool device_setup_busy(void)
+{
+    return (0U != s_g_queue_count) || (true == cmd_flash_busy());
+}
+
+/******************************************************************************
+ * @brief Link write function.
+ ******************************************************************************/
+static void device_setup_link_write(void *p_context, uint8_t const *p_data, uint32_t size)
+{
+    (void)p_context;
+    (void)s_gp_transport->p_api->send(s_gp_transport->p_ctrl, p_data, size);
+}
+
+/******************************************************************************
+ * @brief Check whether one more command can be taken.
+ *
+ * Every queued command will send one response, so the transmit window must
+ * keep a slot for each of them plus one for the new command.
+ ******************************************************************************/
+static bool device_setup_accept(void *p_context)
+{
+    (void)p_context;
+    
+    return (s_g_queue_count < COMMAND_QUEUE_SIZE) && (frame_send_space(&s_g_link) > s_g_queue_count);
+}
+
+/******************************************************************************
+ * @brief Take one command packet from the link.
+ *
+ * Malformed commands and cached queries are answered at once, the others are
+ * queued. A writing command the host sent again (after a timeout or a
+ * link reset) is answered with the result of its first execution.
+ *
+ * @param[in]  p_context      Not used
+ * @param[in]  p_data         Command packet
+ * @param[in]  size           Packet size
+ ******************************************************************************/
+static void device_setup_receive(void *p_context, uint8_t const *p_data, uint32_t size)
+{
+    packet_t const *p_packet = (packet_t const *)p_data;
+    uint8_t        ret;
+    
+    (void)p_context;
+    
+    ret = device_setup_check(p_data, size);
+    if (RET_SUCCESS != ret)
+    {
+        device_setup_respond((sizeof(head_t) <= size) ? p_packet->head.code : 0U,
+                             (sizeof(head_t) <= size) ? p_packet->head.tag : 0U, ret, 0U);
+        return;
+    }
+    
+    if (true == device_setup_answer_cached(p_packet))
+    {
+        return;
+    }
+    
+    if (true == device_setup_replay(p_data, size))
+    {
+        return;
+    }
+    
+    /* device_setup_accept() keeps a place free. */
+    command_t *p_cmd = &s_g_queue[(s_g_queue_head + s_g_queue_count) % COMMAND_QUEUE_SIZE];
+    p_cmd->size = size;
+    memcpy(p_cmd->data, p_data, size);
+    s_g_queue_count++;
+}
+
+/******************************************************************************
+ * @brief Check the packet header and the size of the command.
+ *
+ * @retval RET_SUCCESS     The command can be executed
+ * @retval RET_DATA_FAIL   Malformed packet or wrong size for the command
+ * @retval RET_CMD_FAIL    Unknown command, or not supported by this build
+ ******************************************************************************/
+static uint8_t device_setup_check(uint8_t const *p_data, uint32_t size)
+{
+    packet_t const *p_packet = (packet_t const *)p_data;
+    uint32_t       cmd_size;
+    uint32_t       expected;
+    
+    if (sizeof(head_t) > size)
+    {
+        return RET_DATA_FAIL;
+    }
+    
+    cmd_size = get_be32(p_packet->head.payload_size);
+    if ((PACKET_TYPE_COMMAND != p_packet->head.type) || ((size - sizeof(head_t)) != cmd_size))
+    {
+        return RET_DATA_FAIL;
+    }
+    
+    switch (p_packet->head.code)
+    {
+        case CMD_WRITE_FLASH:
+            /* Address and 1 to FLASH_WRITE_MAX_DATA bytes. */
+            return ((sizeof(cmd_write_flash_t) < cmd_size) &&
+                    (cmd_size <= (sizeof(cmd_write_flash_t) + FLASH_WRITE_MAX_DATA))) ? RET_SUCCESS : RET_DATA_FAIL;
+        case CMD_WRITE_FLASH_LZ4:
+            /* Address, decoded size and a block of at least one byte. */
+            return (sizeof(cmd_write_flash_lz4_t) < cmd_size) ? RET_SUCCESS : RET_DATA_FAIL;
+        case CMD_VERIFY_FLASH:
+            expected = sizeof(cmd_verify_flash_t);
+            break;
+        case CMD_BEGIN_FLASH:
+            expected = sizeof(cmd_begin_flash_t);
+            break;
+        case CMD_DIGEST_FLASH:
+            expected = sizeof(cmd_digest_flash_t);
+            break;
+        case CMD_OPEN_SESSION:
+            expected = sizeof(cmd_open_session_t);
+            break;
+        case CMD_WRITE_OTP:
+            expected = sizeof(cmd_write_otp_t);
+            break;
+        case CMD_READ_OTP:
+            expected = sizeof(cmd_read_otp_t);
+            break;
+        case CMD_READ_AUDIT:
+            expected = sizeof(cmd_read_audit_t);
+            break;
+        case CMD_SET_JAUTH:
+            expected = sizeof(cmd_set_jauth_t);
+            break;
+        case CMD_SET_JAUTHID:
+        case CMD_SETUP_JAUTH:
+            expected = sizeof(cmd_set_jauthid_t) + JAUTHID_ID_SIZE;
+            break;
+        case CMD_DERIVE_JAUTH:
+            expected = sizeof(cmd_derive_jauth_t);
+            break;
+        case CMD_APPLY_PROFILE:
+            expected = sizeof(cmd_apply_profile_t);
+            break;
+        case CMD_SET_SCIUSB:
+            expected = sizeof(cmd_set_sciusb_t);
+            break;
+        case CMD_GET_JAUTH:
+        case CMD_GET_SCIUSB:
+        case CMD_GET_UID:
+        case CMD_READ_LOG:
+            expected = 0U;
+            break;
+        default:
+            return RET_CMD_FAIL;
+    }
+    
+    return (expected == cmd_size) ? RET_SUCCESS : RET_DATA_FAIL;
+}
+
+/******************************************************************************
+ * @brief Answer a query from the cache, ahead of the queue.
+ *
+ * @retval true   Answered
+ * @retval false  Not a cached query, or a queued command may change the answer
+ ******************************************************************************/
+static bool device_setup_answer_cached(packet_t const *p_packet)
+{
+    response_t *p_rsp = (response_t *)s_g_response;
+    
+    switch (p_packet->head.code)
+    {
+        case CMD_GET_UID:
+            if (true == s_g_cache.uid_valid)
+            {
+                memcpy(p_rsp->data, s_g_cache.uid, UID_SIZE);
+                device_setup_respond(CMD_GET_UID, p_packet->head.tag, RET_SUCCESS, UID_SIZE);
+                return true;
+            }
+            break;
+        case CMD_GET_JAUTH:
+            if ((true == s_g_cache.jauth_valid) && (false == device_setup_queued(CMD_SET_JAUTH)) &&
+                (false == device_setup_queued(CMD_SETUP_JAUTH)) &&
+                (false == device_setup_queued(CMD_DERIVE_JAUTH)) &&
+                (false == device_setup_queued(CMD_APPLY_PROFILE)))
+            {
+                p_rsp->data[0] = s_g_cache.jauth_mode;
+                p_rsp->data[1] = s_g_cache.jauth_type;
+                device_setup_respond(CMD_GET_JAUTH, p_packet->head.tag, RET_SUCCESS, 2U);
+                return true;
+            }
+            break;
+        case CMD_GET_SCIUSB:
+            if ((true == s_g_cache.sciusb_valid) && (false == device_setup_queued(CMD_SET_SCIUSB)) &&
+                (false == device_setup_queued(CMD_APPLY_PROFILE)))
+            {
+                p_rsp->data[0] = s_g_cache.sciusb_mode;
+                device_setup_respond(CMD_GET_SCIUSB, p_packet->head.tag, RET_SUCCESS, 1U);
+                return true;
+            }
+            break;
+        default:
+            break;
+    }
+    
+    return false;
+}
+
+/******************************************************************************
+ * @brief Check whether a command with this code is waiting in the queue.
+ ******************************************************************************/
+static bool device_setup_queued(uint8_t code)
+{
+    for (uint32_t i = 0U; i < s_g_queue_count; i++)
+    {
+        packet_t const *p_packet = (packet_t const *)s_g_queue[(s_g_queue_head + i) % COMMAND_QUEUE_SIZE].data;
+        
+        if (code == p_packet->head.code)
+        {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/******************************************************************************
+ * @brief Check whether a command writes the OTP or the flash.
+ ******************************************************************************/
+static bool device_setup_is_write(uint8_t code)
+{
+    switch (code)
+    {
+        case CMD_WRITE_FLASH:
+        case CMD_WRITE_FLASH_LZ4:
+        case CMD_BEGIN_FLASH:
+        case CMD_OPEN_SESSION:
+        case CMD_WRITE_OTP:
+        case CMD_SET_JAUTH:
+        case CMD_SET_JAUTHID:
+        case CMD_SETUP_JAUTH:
+        case CMD_DERIVE_JAUTH:
+        case CMD_APPLY_PROFILE:
+        case CMD_SET_SCIUSB:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/******************************************************************************
+ * @brief Answer a writing command that was received before.
+ *
+ * The link delivers each frame once, but a host that gave up on a response
+ * sends the command again in a new frame, with the same tag. Executing it
+ * twice costs an OTP power cycle and a write, and the second write of a
+ * write-once word fails its verify; a repeated flash write would break the
+ * stream. A command is identified by its tag and
+ * the CRC of the whole packet, so a tag reused for a different command
+ * misses. The repeat gets the first response again, data included, so a
+ * retried APPLY_PROFILE still reports its plan result. The same command in a later session is new: OPEN_SESSION clears
+ * the cache, and its own entry answers a repeat of it within the session.
+ * READ_LOG has no entry, as the ring still holds the records it sent; only
+ * a copy of it still queued is dropped here.
+ *
+ * @retval true   Answered from the replay cache, or the first copy is still
+ *                queued and will answer it
+ * @retval false  Not a repeat: execute it
+ ******************************************************************************/
+static bool device_setup_replay(uint8_t const *p_data, uint32_t size)
+{
+    packet_t const *p_packet = (packet_t const *)p_data;
+    uint32_t       crc;
+    
+    if ((false == device_setup_is_write(p_packet->head.code)) && (CMD_READ_LOG != p_packet->head.code))
+    {
+        return false;
+    }
+    
+    crc = crc32_calc(0U, p_data, size);
+    for (uint32_t i = 0U; i < REPLAY_CACHE_SIZE; i++)
+    {
+        replay_entry_t const *p_entry = &s_g_replay[i];
+        
+        if ((true == p_entry->valid) && (p_entry->tag == p_packet->head.tag) && (p_entry->crc == crc))
+        {
+            memcpy(((response_t *)s_g_response)->data, p_entry->data, p_entry->data_size);
+            device_setup_respond(p_packet->head.code, p_packet->head.tag, p_entry->ret, p_entry->data_size);
+            return true;
+        }
+    }
+    
+    for (uint32_t i = 0U; i < s_g_queue_count; i++)
+    {
+        command_t const *p_cmd = &s_g_queue[(s_g_queue_head + i) % COMMAND_QUEUE_SIZE];
+        
+        if ((p_cmd->size == size) && (0 == memcmp(p_cmd->data, p_data, size)))
+        {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/******************************************************************************
+ * @brief Keep the result of an executed writing command, with the response
+ *        data in s_g_response (the APPLY_PROFILE result).
+ *
+ * The cache is two rings, the oldest entry of each is replaced: the first
+ * REPLAY_OTP_SIZE entries for OTP and session commands, the others for
+ * flash stream commands.
+ ******************************************************************************/
+static void device_setup_replay_store(uint8_t const *p_data, uint32_t size, uint8_t ret, uint32_t data_size)
+{
+    replay_entry_t *p_entry;
+    
+    switch (((packet_t const *)p_data)->head.code)
+    {
+        case CMD_WRITE_FLASH:
+        case CMD_WRITE_FLASH_LZ4:
+        case CMD_BEGIN_FLASH:
+            p_entry = &s_g_replay[REPLAY_OTP_SIZE + s_g_replay_next_flash];
+            s_g_replay_next_flash = (s_g_replay_next_flash + 1U) % REPLAY_FLASH_SIZE;
+            break;
+        default:
+            p_entry = &s_g_replay[s_g_replay_next_otp];
+            s_g_replay_next_otp = (s_g_replay_next_otp + 1U) % REPLAY_OTP_SIZE;
+            break;
+    }
+    
+    p_entry->valid     = true;
+    p_entry->tag       = ((packet_t const *)p_data)->head.tag;
+    p_entry->ret       = ret;
+    p_entry->data_size = (uint8_t)((data_size < REPLAY_DATA_SIZE) ? data_size : REPLAY_DATA_SIZE);
+    p_entry->crc       = crc32_calc(0U, p_data, size);
+    memcpy(p_entry->data, ((response_t const *)s_g_response)->data, p_entry->data_size);
+}
+
+/******************************************************************************
+ * @brief Check whether the command at the head of the queue can run now.
+ ******************************************************************************/
+static bool device_setup_ready(uint8_t const *p_data, uint32_t size)
+{
+    packet_t const *p_packet = (packet_t const *)p_data;
+    
+    switch (p_packet->head.code)
+    {
+        case CMD_WRITE_FLASH:
+            return cmd_flash_ready(get_be32(p_packet->cmd.wflash.address),
+                                   size - (uint32_t)(sizeof(head_t) + sizeof(cmd_write_flash_t)));
+        case CMD_WRITE_FLASH_LZ4:
+            return cmd_flash_ready(get_be32(p_packet->cmd.wflz4.address), get_be32(p_packet->cmd.wflz4.size));
+        case CMD_VERIFY_FLASH:
+            return cmd_flash_ready(get_be32(p_packet->cmd.vflash.address), 0U);
+        case CMD_BEGIN_FLASH:
+            return cmd_flash_ready(get_be32(p_packet->cmd.bflash.address), 0U);
+        case CMD_DIGEST_FLASH:
+            return cmd_flash_ready(get_be32(p_packet->cmd.dflash.address), 0U);
+        default:
+            return true;
+    }
+}
+
+/******************************************************************************
+ * @brief Execute one checked command and send its response.
+ *
+ * @param[in]  p_data         Command packet
+ * @param[in]  size           Packet size
+ ******************************************************************************/
+static void device_setup_execute(uint8_t const *p_data, uint32_t size)
+{
+    packet_t const *p_packet  = (packet_t const *)p_data;
+    response_t     *p_rsp     = (response_t *)s_g_response;
+    uint32_t       data_size  = 0U;
+    uint8_t        ret        = RET_DATA_FAIL;
+    
+    switch (p_packet->head.code)
+    {
+        case CMD_WRITE_FLASH:
+            ret = cmd_write_flash(get_be32(p_packet->cmd.wflash.address), p_packet->cmd.wflash.data,
+                                  size - (uint32_t)(sizeof(head_t) + sizeof(cmd_write_flash_t)));
+            break;
+        case CMD_WRITE_FLASH_LZ4:
+            ret = cmd_write_flash_lz4(get_be32(p_packet->cmd.wflz4.address), get_be32(p_packet->cmd.wflz4.size),
+                                      p_packet->cmd.wflz4.data,
+                                      size - (uint32_t)(sizeof(head_t) + sizeof(cmd_write_flash_lz4_t)));
+            break;
+        case CMD_VERIFY_FLASH:
+            ret = cmd_verify_flash(get_be32(p_packet->cmd.vflash.address), get_be32(p_packet->cmd.vflash.size),
+                                   get_be32(p_packet->cmd.vflash.digest));
+            break;
+        case CMD_BEGIN_FLASH:
+            ret = cmd_begin_flash(get_be32(p_packet->cmd.bflash.address), get_be32(p_packet->cmd.bflash.size));
+            break;
+        case CMD_DIGEST_FLASH:
+        {
+            uint32_t count = get_be16(p_packet->cmd.dflash.count);
+            ret       = cmd_digest_flash(get_be32(p_packet->cmd.dflash.address), count, p_rsp->data);
+            data_size = count * FLASH_DIGEST_SIZE;
+            break;
+        }
+        case CMD_OPEN_SESSION:
+            /* Results of the last session do not answer this one. */
+            memset(s_g_replay, 0, sizeof(s_g_replay));
+            s_g_log_held = false;
+            ret = RET_SUCCESS;
+            break;
+        case CMD_WRITE_OTP:
+            ret = cmd_write_otp(get_be16(p_packet->cmd.wotp.address), get_be16(p_packet->cmd.wotp.data));
+            break;
+        case CMD_READ_OTP:
+        {
+            uint16_t otp_data = 0U;
+            ret = cmd_read_otp(get_be16(p_packet->cmd.rotp.address), &otp_data);
+            p_rsp->data[0] = (uint8_t)(otp_data >> 8);
+            p_rsp->data[1] = (uint8_t)otp_data;
+            data_size      = 2U;
+            break;
+        }
+        case CMD_SET_JAUTH:
+            ret = cmd_set_jtag_auth(p_packet->cmd.jauth.mode, p_packet->cmd.jauth.type);
+            s_g_cache.jauth_valid = false;
+            break;
+        case CMD_GET_JAUTH:
+            ret       = cmd_get_jtag_auth(&p_rsp->data[0], &p_rsp->data[1]);
+            data_size = 2U;
+            if (RET_SUCCESS == ret)
+            {
+                s_g_cache.jauth_mode  = p_rsp->data[0];
+                s_g_cache.jauth_type  = p_rsp->data[1];
+                s_g_cache.jauth_valid = true;
+            }
+            break;
+        case CMD_SET_JAUTHID:
+        {
+            uint8_t id[JAUTHID_ID_SIZE];
+            memcpy(id, p_packet->cmd.jauthid.id, JAUTHID_ID_SIZE);
+            ret = cmd_set_jtag_auth_id(p_packet->cmd.jauthid.mode, p_packet->cmd.jauthid.type, id);
+            break;
+        }
+        case CMD_SETUP_JAUTH:
+        {
+            uint8_t id[JAUTHID_ID_SIZE];
+            memcpy(id, p_packet->cmd.jauthid.id, JAUTHID_ID_SIZE);
+            ret = cmd_setup_jtag_auth(p_packet->cmd.jauthid.mode, p_packet->cmd.jauthid.type, id);
+            s_g_cache.jauth_valid = false;
+            break;
+        }
+        case CMD_DERIVE_JAUTH:
+            ret = cmd_derive_jtag_auth(p_packet->cmd.djauth.mode, p_packet->cmd.djauth.type,
+                                       p_packet->cmd.djauth.key, JAUTH_KEY_SIZE);
+            s_g_cache.jauth_valid = false;
+            break;
+        case CMD_APPLY_PROFILE:
+            ret       = device_setup_apply_profile(&p_packet->cmd.profile, p_rsp->data);
+            data_size = PROFILE_RESULT_SIZE;
+            s_g_cache.jauth_valid  = false;
+            s_g_cache.sciusb_valid = false;
+            break;
+        case CMD_SET_SCIUSB:
+            ret = cmd_set_sci_usb_boot(p_packet->cmd.sciusb.mode);
+            s_g_cache.sciusb_valid = false;
+            break;
+        case CMD_GET_SCIUSB:
+            ret       = cmd_get_sci_usb_boot(&p_rsp->data[0]);
+            data_size = 1U;
+            if (RET_SUCCESS == ret)
+            {
+                s_g_cache.sciusb_mode  = p_rsp->data[0];
+                s_g_cache.sciusb_valid = true;
+            }
+            break;
+        case CMD_GET_UID:
+            ret       = cmd_get_unique_id(p_rsp->data);
+            data_size = UID_SIZE;
+            if (RET_SUCCESS == ret)
+            {
+                memcpy(s_g_cache.uid, p_rsp->data, UID_SIZE);
+                s_g_cache.uid_valid = true;
+            }
+            break;
+        case CMD_READ_LOG:
+        {
+            /* Queued like any command, so the records of the commands before it are all in.
+             * The ring keeps the records sent until a READ_LOG with another tag: a repeat
+             * of this one gets them again. */
+            bool again = (true == s_g_log_held) && (s_g_log_tag == p_packet->head.tag);
+            
+            data_size = LOG_RESULT_HEAD_SIZE + log_drain(&p_rsp->data[LOG_RESULT_HEAD_SIZE],
+                                                         FRAME_MAX_PAYLOAD - sizeof(response_t) -
+                                                         LOG_RESULT_HEAD_SIZE, again);
+            s_g_log_held = true;
+            s_g_log_tag  = p_packet->head.tag;
+            put_be32(&p_rsp->data[0], log_dropped());
+            put_be32(&p_rsp->data[4], log_tick_hz());
+            put_be32(&p_rsp->data[8], log_pending());
+            ret = RET_SUCCESS;
+            break;
+        }
+        case CMD_READ_AUDIT:
+        {
+            /* Queued as well: the entries of the writes before it are all in. */
+            uint32_t first = 0U;
+            uint32_t count = otp_audit_read(get_be32(p_packet->cmd.raudit.cursor),
+                                            &p_rsp->data[AUDIT_RESULT_HEAD_SIZE],
+                                            (FRAME_MAX_PAYLOAD - sizeof(response_t) - AUDIT_RESULT_HEAD_SIZE) /
+                                            OTP_AUDIT_ENTRY_SIZE, &first);
+            put_be32(&p_rsp->data[0], first);
+            put_be32(&p_rsp->data[4], otp_audit_written());
+            put_be32(&p_rsp->data[8], SYSTIME_HZ);
+            data_size = AUDIT_RESULT_HEAD_SIZE + (count * OTP_AUDIT_ENTRY_SIZE);
+            ret       = RET_SUCCESS;
+            break;
+        }
+        default:
+            /* Checked before queuing. */
+            break;
+    }
+    
+    if (CMD_READ_LOG != p_packet->head.code)
+    {
+        LOG3(LOG_CMD_DONE, p_packet->head.code, p_packet->head.tag, ret);
+    }
+    
+    /* Only return data for a successful command, and the reason an
+     * APPLY_PROFILE failed. */
+    if ((RET_SUCCESS != ret) && (CMD_APPLY_PROFILE != p_packet->head.code))
+    {
+        data_size = 0U;
+    }
+    
+    if (true == device_setup_is_write(p_packet->head.code))
+    {
+        device_setup_replay_store(p_data, size, ret, data_size);
+    }
+    
+    device_setup_respond(p_packet->head.code, p_packet->head.tag, ret, data_size);
+}
+
+/******************************************************************************
+ * @brief Run an APPLY_PROFILE command.
+ *
+ * Main loop only: the profile and the plan are static, to keep them off the
+ * 1 KB SVC stack.
+ *
+ * @param[in]  p_cmd          Command payload
+ * @param[out] p_result       Response data (PROFILE_RESULT_SIZE bytes)
+ *
+ * @return Return code of cmd_apply_otp_profile()
+ ******************************************************************************/
+static uint8_t device_setup_apply_profile(cmd_apply_profile_t const *p_cmd, uint8_t *p_result)
+{
+    otp_profile_t *p_profile = &s_g_profile;
+    otp_plan_t    *p_plan    = &s_g_plan;
+    uint32_t       done      = 0U;
+    uint8_t        ret       = RET_DATA_FAIL;
+    
+    memset(p_profile, 0, sizeof(*p_profile));
+    p_profile->jauth_mode  = p_cmd->jauth_mode;
+    p_profile->jauth_type  = p_cmd->jauth_type;
+    p_profile->sciusb_mode = p_cmd->sciusb_mode;
+    p_profile->counter_min = get_be16(p_cmd->counter_min);
+    p_profile->num_words   = p_cmd->num_words;
+    memcpy(p_profile->jauth_id, p_cmd->id, PLAN_ID_SIZE);
+    for (uint32_t i = 0U; (i < p_cmd->num_words) && (i < PROFILE_MAX_WORDS); i++)
+    {
+        p_profile->words[i].addr  = get_be16(&p_cmd->words[i][0]);
+        p_profile->words[i].value = get_be16(&p_cmd->words[i][2]);
+    }
+    
+    if (p_cmd->num_words <= PROFILE_MAX_WORDS)
+    {
+        ret = cmd_apply_otp_profile(p_profile, (0U != (p_cmd->flags & PROFILE_FLAG_DRY_RUN)), p_plan, &done);
+    }
+    else
+    {
+        p_plan->err       = PLAN_ERR_ADDRESS;
+        p_plan->err_addr  = 0U;
+        p_plan->num_steps = 0U;
+    }
+    
+    p_result[0] = (uint8_t)p_plan->err;
+    p_result[1] = (uint8_t)(p_plan->err_addr >> 8);
+    p_result[2] = (uint8_t)p_plan->err_addr;
+    p_result[3] = (uint8_t)p_plan->num_steps;
+    p_result[4] = (uint8_t)done;
+    
+    return ret;
+}
+
+/******************************************************************************
+ * @brief Send the response in s_g_response.
+ *
+ * @param[in]  code           Command code
+ * @param[in]  tag            Tag of the command
+ * @param[in]  ret            Return code
+ * @param[in]  data_size      Bytes already placed in the response data
+ ******************************************************************************/
+static void device_setup_respond(uint8_t code, uint8_t tag, uint8_t ret, uint32_t data_size)
+{
+    response_t *p_rsp = (response_t *)s_g_response;
+    
+    p_rsp->head.type = PACKET_TYPE_RESPONSE;
+    p_rsp->head.code = code;
+    p_rsp->head.tag  = tag;
+    put_be32(p_rsp->head.payload_size, 1U + data_size);
+    p_rsp->ret       = ret;
+    
+    (void)frame_send(&s_g_link, s_g_response, sizeof(response_t) + data_size);
+}
+
+/******************************************************************************
+ * @brief Big endian field access.
+ ******************************************************************************/
+static uint32_t get_be32(uint8_t const *p_data)
+{
+    return ((uint32_t)p_data[0] << 24) | ((uint32_t)p_data[1] << 16) | ((uint32_t)p_data[2] << 8) | p_data[3];
+}
+
+static uint16_t get_be16(uint8_t const *p_data)
+{
+    return (uint16_t)(((uint16_t)p_data[0] << 8) | p_data[1]);
+}
+
+static void put_be32(uint8_t *p_data, uint32_t value)
+{
+    p_data[0] = (uint8_t)(value >> 24);
+    p_data[1] = (uint8_t)(value >> 16);
+    p_data[2] = (uint8_t)(value >> 8);
+    p_data[3] = (uint8_t)value;
+}
@@ -20,6 +20,60 @@
 #ifndef __DEVICE_SETUP_H__
 #define __DEVICE_SETUP_H__
 
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdbool.h>
+#include "transport.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Packet type */
+#define PACKET_TYPE_COMMAND      (0x01U)
+#define PACKET_TYPE_RESPONSE     (0x81U)
+
+/* Command code */
+#define CMD_WRITE_FLASH          (0x01U)
+#define CMD_WRITE_OTP            (0x02U)
+#define CMD_READ_OTP             (0x03U)
+#define CMD_SET_JAUTH            (0x04U)
+#define CMD_GET_JAUTH            (0x05U)
+#define CMD_SET_JAUTHID          (0x06U)
+#define CMD_SET_SCIUSB           (0x07U)
+#define CMD_GET_SCIUSB           (0x08U)
+#define CMD_GET_UID              (0x09U)
+#define CMD_VERIFY_FLASH         (0x0AU)
+#define CMD_WRITE_FLASH_LZ4      (0x0BU)
+#define CMD_BEGIN_FLASH          (0x0CU)
+#define CMD_DIGEST_FLASH         (0x0DU)
+#define CMD_OPEN_SESSION         (0x0EU)
+#define CMD_SETUP_JAUTH          (0x0FU)
+#define CMD_DERIVE_JAUTH         (0x10U)
+#define CMD_APPLY_PROFILE        (0x11U)
+#define CMD_READ_LOG             (0x12U)
+#define CMD_READ_AUDIT           (0x13U)
+
+/* Size of the ID in the SET_JAUTHID and SETUP_JAUTH commands */
+#define JAUTHID_ID_SIZE          (16U)
+
+/* Size of the master key in the DERIVE_JAUTH command */
+#define JAUTH_KEY_SIZE           (32U)
+
+/* APPLY_PROFILE */
+#define PROFILE_MAX_WORDS        (8U)           // Write-once words in one profile
+#define PROFILE_FLAG_DRY_RUN     (0x01U)        // Plan only, write nothing
+#define PROFILE_RESULT_SIZE      (5U)           // Response data: error, address, steps, steps done
+
+/* READ_LOG response data: records dropped, time stamp rate in Hz and bytes
+ * still in the ring (big endian, 4 bytes each), then the records (log.h) */
+#define LOG_RESULT_HEAD_SIZE     (12U)
+
+/* READ_AUDIT response data: sequence number of the first entry, OTP writes
+ * recorded since reset and time stamp rate in Hz (big endian, 4 bytes
+ * each), then the entries (otp_audit.h) */
+#define AUDIT_RESULT_HEAD_SIZE   (12U)
+
 /******************************************************************************
  * Typedef definitions
  ******************************************************************************/
@@ -30,6 +84,42 @@ typedef struct
     uint8_t    data[0];
 } cmd_write_flash_t;
 
+/* Packet format, WRITE_FLASH_LZ4 Command */
+typedef struct
+{
+    uint8_t    address[4];
+    uint8_t    size[4];                         // Decoded size
+    uint8_t    data[0];                         // One LZ4 block
+} cmd_write_flash_lz4_t;
+
+/* Packet format, VERIFY_FLASH Command */
+typedef struct
+{
+    uint8_t    address[4];
+    uint8_t    size[4];
+    uint8_t    digest[4];                       // CRC-32 of the range
+} cmd_verify_flash_t;
+
+/* Packet format, BEGIN_FLASH Command */
+typedef struct
+{
+    uint8_t    address[4];
+    uint8_t    size[4];                         // Bytes the stream will write
+} cmd_begin_flash_t;
+
+/* Packet format, DIGEST_FLASH Command */
+typedef struct
+{
+    uint8_t    address[4];
+    uint8_t    count[2];                        // Sectors; the response holds a CRC-32 for each
+} cmd_digest_flash_t;
+
+/* Packet format, OPEN_SESSION Command */
+typedef struct
+{
+    uint8_t    id[4];                           // Chosen by the host, different for each session
+} cmd_open_session_t;
+
 /* Packet format, WRITE_OTP Command */
 typedef struct
 {
@@ -43,6 +133,12 @@ typedef struct
     uint8_t    address[2];
 } cmd_read_otp_t;
 
+/* Packet format, READ_AUDIT Command */
+typedef struct
+{
+    uint8_t    cursor[4];                       // Sequence number of the first OTP write wanted
+} cmd_read_audit_t;
+
 /* Packet format, SET_JAUTH Command */
 typedef struct
 {
@@ -50,7 +146,7 @@ typedef struct
     uint8_t    type;
 } cmd_set_jauth_t;
 
-/* Packet format, SET_JAUTHID Command */
+/* Packet format, SET_JAUTHID and SETUP_JAUTH Commands */
 typedef struct
 {
     uint8_t    mode;
@@ -58,30 +154,73 @@ typedef struct
     uint8_t    id[0];
 } cmd_set_jauthid_t;
 
+/* Packet format, DERIVE_JAUTH Command */
+typedef struct
+{
+    uint8_t    mode;
+    uint8_t    type;
+    uint8_t    key[JAUTH_KEY_SIZE];
+} cmd_derive_jauth_t;
+
+/* Packet format, APPLY_PROFILE Command. The board plans the writes from its
+ * OTP (otp_plan.h) and runs them; the response data gives the plan error,
+ * its OTP address, the number of steps and the steps executed. A mode or
+ * SCI/USB value of 0xFF leaves it as it is. */
+typedef struct
+{
+    uint8_t    flags;                           // PROFILE_FLAG_DRY_RUN
+    uint8_t    jauth_mode;
+    uint8_t    jauth_type;
+    uint8_t    sciusb_mode;
+    uint8_t    counter_min[2];                  // Anti-rollback counter bits that must be set
+    uint8_t    num_words;
+    uint8_t    id[JAUTHID_ID_SIZE];
+    uint8_t    words[PROFILE_MAX_WORDS][4];     // Address and value
+} cmd_apply_profile_t;
+
 /* Packet format, SET_SCIUSB Command */
 typedef struct
 {
     uint8_t    mode;
 } cmd_set_sciusb_t;
 
-/* Packet format, Command header */
+/* Packet format, Command header. The response to a command carries the
+ * command's tag: cached queries are answered ahead of queued commands, so
+ * responses may arrive out of order. */
 typedef struct
 {
     uint8_t    type;
     uint8_t    code;
     uint8_t    payload_size[4];
+    uint8_t    tag;
 } head_t;
 
-/* Packet format */
+/* Packet format, Response (multi-byte values are big endian) */
+typedef struct
+{
+    head_t     head;
+    uint8_t    ret;
+    uint8_t    data[0];
+} response_t;
+
+/* Packet format (multi-byte values are big endian) */
 typedef struct
 {
     head_t head;
     union {
         cmd_write_flash_t    wflash;
+        cmd_write_flash_lz4_t wflz4;
+        cmd_verify_flash_t   vflash;
+        cmd_begin_flash_t    bflash;
+        cmd_digest_flash_t   dflash;
+        cmd_open_session_t   session;
         cmd_write_otp_t      wotp;
         cmd_read_otp_t       rotp;
+        cmd_read_audit_t     raudit;
         cmd_set_jauth_t      jauth;
         cmd_set_jauthid_t    jauthid;
+        cmd_derive_jauth_t   djauth;
+        cmd_apply_profile_t  profile;
         cmd_set_sciusb_t     sciusb;
     } cmd;
 } packet_t;
@@ -89,6 +228,8 @@ typedef struct
 /******************************************************************************
  * Exported global functions (to be accessed by other files)
  ******************************************************************************/
-void device_setup(void);
+void device_setup(transport_instance_t const *p_transport);
+void device_setup_poll(uint32_t now_ms);
+bool device_setup_busy(void);
 
 #endif /* __DEVICE_SETUP_H__ */
@@ -0,0 +1,733 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "crc.h"
+#include "frame.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Header field offsets */
+#define FRAME_OFS_SYNC0            (0U)
+#define FRAME_OFS_SYNC1            (1U)
+#define FRAME_OFS_TYPE             (2U)
+#define FRAME_OFS_SEQ              (3U)
+#define FRAME_OFS_ACK              (4U)
+#define FRAME_OFS_SACK             (5U)
+#define FRAME_OFS_SIZE             (6U)
+
+/* Sequence numbers are 8-bit and index the window by their low bits. */
+#define FRAME_SLOT(seq)            ((uint8_t)(seq) & (uint8_t)(FRAME_WINDOW_SIZE - 1U))
+#define FRAME_RX_SLOT(seq)         ((uint8_t)(seq) & (uint8_t)(FRAME_RX_SLOTS - 1U))
+
+#if (FRAME_TEMPLATE_FOLLOWING(FRAME_HEADER_SIZE + FRAME_CRC_SIZE) != (FRAME_HEADER_SIZE - FRAME_OFS_SACK - 1U))
+#error "FRAME_TEMPLATE_FOLLOWING() does not match the header layout."
+#endif
+
+#if ((FRAME_WINDOW_SIZE & (FRAME_WINDOW_SIZE - 1U)) != 0U) || (FRAME_WINDOW_SIZE > 9U)
+#error "FRAME_WINDOW_SIZE must be a power of two, at most 8 (sack bitmap width + 1)."
+#endif
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static void frame_transmit(frame_link_t *p_link, uint8_t type, uint8_t seq, uint8_t const *p_data, uint32_t size);
+static void frame_queue(frame_link_t *p_link, frame_slot_t *p_slot);
+static void frame_transmit_data(frame_link_t *p_link, uint8_t seq);
+static void frame_transmit_template(frame_link_t *p_link, uint8_t seq, frame_template_t *p_template);
+static void frame_window_clear(frame_link_t *p_link);
+static void frame_ack_process(frame_link_t *p_link, uint8_t ack, uint8_t sack);
+static void frame_data_process(frame_link_t *p_link, uint8_t seq, uint8_t const *p_data, uint32_t size);
+static void frame_deliver(frame_link_t *p_link);
+static void frame_process(frame_link_t *p_link, uint8_t const *p_frame, uint32_t size);
+static uint32_t frame_parse(frame_link_t *p_link);
+static uint8_t frame_ack_get(frame_link_t const *p_link);
+static uint8_t frame_sack_get(frame_link_t const *p_link, uint8_t ack);
+
+/******************************************************************************
+ * @brief Initialize a link.
+ *
+ * Both ends start with sequence number 0. The host calls frame_reset() at the
+ * start of a session so that a device which kept running from a previous
+ * session starts over as well.
+ *
+ * @param[in]  p_link         Link state
+ * @param[in]  p_cfg          Link configuration
+ ******************************************************************************/
+void frame_init(frame_link_t *p_link, frame_cfg_t const *p_cfg)
+{
+    memset(p_link, 0, sizeof(frame_link_t));
+    p_link->cfg = *p_cfg;
+    
+    if (0U == p_link->cfg.retry_timeout_ms)
+    {
+        p_link->cfg.retry_timeout_ms = FRAME_RETRY_TIMEOUT_MS;
+    }
+}
+
+/******************************************************************************
+ * @brief Start a new session.
+ *
+ * Frames in flight are discarded on both ends. Frames queued with
+ * frame_send() after this call are sent once the peer has acknowledged the
+ * reset.
+ *
+ * @param[in]  p_link         Link state
+ ******************************************************************************/
+void frame_reset(frame_link_t *p_link)
+{
+    frame_window_clear(p_link);
+    
+    p_link->reset_pending = 1U;
+    p_link->reset_sent_ms = p_link->now_ms;
+    frame_transmit(p_link, FRAME_TYPE_RESET, 0U, NULL, 0U);
+}
+
+/******************************************************************************
+ * @brief Queue a payload and send it.
+ *
+ * The payload is copied into the transmit window and kept until the peer
+ * acknowledges it, so the caller may reuse its buffer at once.
+ *
+ * @param[in]  p_link         Link state
+ * @param[in]  p_data         Payload
+ * @param[in]  size           Payload size
+ *
+ * @retval FRAME_SUCCESS          Queued
+ * @retval FRAME_ERR_WINDOW_FULL  FRAME_WINDOW_SIZE frames are waiting for ack
+ * @retval FRAME_ERR_SIZE         Payload larger than FRAME_MAX_PAYLOAD
+ ******************************************************************************/
+frame_err_t frame_send(frame_link_t *p_link, uint8_t const *p_data, uint32_t size)
+{
+    frame_slot_t *p_slot;
+    
+    if (FRAME_MAX_PAYLOAD < size)
+    {
+        return FRAME_ERR_SIZE;
+    }
+    
+    if (0U == frame_send_space(p_link))
+    {
+        return FRAME_ERR_WINDOW_FULL;
+    }
+    
+    p_slot = &p_link->tx_slot[FRAME_SLOT(p_link->tx_next)];
+    memcpy(p_slot->data, p_data, size);
+    p_slot->p_template = NULL;
+    p_slot->size       = (uint16_t)size;
+    frame_queue(p_link, p_slot);
+    
+    return FRAME_SUCCESS;
+}
+
+/******************************************************************************
+ * @brief Queue a frame encoded by frame_template_encode() and send it.
+ *
+ * Nothing is copied: the template is written in place on every
+ * transmission and must stay valid until the peer acknowledges it.
+ *
+ * @param[in]  p_link         Link state
+ * @param[in]  p_template     Encoded frame and its CRC shift table
+ *
+ * @retval FRAME_SUCCESS          Queued
+ * @retval FRAME_ERR_WINDOW_FULL  FRAME_WINDOW_SIZE frames are waiting for ack
+ * @retval FRAME_ERR_SIZE         Not a data frame of a valid size
+ ******************************************************************************/
+frame_err_t frame_send_template(frame_link_t *p_link, frame_template_t *p_template)
+{
+    frame_slot_t *p_slot;
+    
+    if ((FRAME_HEADER_SIZE + FRAME_CRC_SIZE > p_template->size) || (FRAME_MAX_SIZE < p_template->size) ||
+        (FRAME_TYPE_DATA != p_template->p_frame[FRAME_OFS_TYPE]))
+    {
+        return FRAME_ERR_SIZE;
+    }
+    
+    if (0U == frame_send_space(p_link))
+    {
+        return FRAME_ERR_WINDOW_FULL;
+    }
+    
+    p_slot = &p_link->tx_slot[FRAME_SLOT(p_link->tx_next)];
+    p_slot->p_template = p_template;
+    p_slot->size       = (uint16_t)(p_template->size - FRAME_HEADER_SIZE - FRAME_CRC_SIZE);
+    frame_queue(p_link, p_slot);
+    
+    return FRAME_SUCCESS;
+}
+
+/******************************************************************************
+ * @brief Encode a data frame once, for frame_send_template().
+ *
+ * seq, ack and sack are left at 0; the link fills them in when it sends.
+ * The shift table of the template comes from crc32_shift_init() of
+ * FRAME_TEMPLATE_FOLLOWING() bytes, and is the same for frames of a size.
+ *
+ * @param[out] p_frame        Frame, FRAME_HEADER_SIZE + size + FRAME_CRC_SIZE bytes
+ * @param[in]  p_data         Payload
+ * @param[in]  size           Payload size, up to FRAME_MAX_PAYLOAD
+ *
+ * @retval Frame size, or 0 if the payload is too large
+ ******************************************************************************/
+uint32_t frame_template_encode(uint8_t *p_frame, uint8_t const *p_data, uint32_t size)
+{
+    uint32_t crc;
+    
+    if (FRAME_MAX_PAYLOAD < size)
+    {
+        return 0U;
+    }
+    
+    p_frame[FRAME_OFS_SYNC0]     = FRAME_SYNC0;
+    p_frame[FRAME_OFS_SYNC1]     = FRAME_SYNC1;
+    p_frame[FRAME_OFS_TYPE]      = FRAME_TYPE_DATA;
+    p_frame[FRAME_OFS_SEQ]       = 0U;
+    p_frame[FRAME_OFS_ACK]       = 0U;
+    p_frame[FRAME_OFS_SACK]      = 0U;
+    p_frame[FRAME_OFS_SIZE]      = (uint8_t)(size >> 8);
+    p_frame[FRAME_OFS_SIZE + 1U] = (uint8_t)size;
+    if (0U != size)
+    {
+        memcpy(&p_frame[FRAME_HEADER_SIZE], p_data, size);
+    }
+    
+    crc = crc32_calc(0U, p_frame, FRAME_HEADER_SIZE + size);
+    p_frame[FRAME_HEADER_SIZE + size]      = (uint8_t)(crc >> 24);
+    p_frame[FRAME_HEADER_SIZE + size + 1U] = (uint8_t)(crc >> 16);
+    p_frame[FRAME_HEADER_SIZE + size + 2U] = (uint8_t)(crc >> 8);
+    p_frame[FRAME_HEADER_SIZE + size + 3U] = (uint8_t)crc;
+    
+    return FRAME_HEADER_SIZE + size + FRAME_CRC_SIZE;
+}
+
+/******************************************************************************
+ * @brief Number of payloads that frame_send() accepts now.
+ *
+ * @param[in]  p_link         Link state
+ *
+ * @retval Free transmit window slots
+ ******************************************************************************/
+uint32_t frame_send_space(frame_link_t const *p_link)
+{
+    return FRAME_WINDOW_SIZE - (uint8_t)(p_link->tx_next - p_link->tx_base);
+}
+
+/******************************************************************************
+ * @brief Check whether everything sent has been acknowledged.
+ *
+ * @param[in]  p_link         Link state
+ *
+ * @retval true   Nothing in flight and no reset in progress
+ * @retval false  Frames are waiting for acknowledgement
+ ******************************************************************************/
+bool frame_idle(frame_link_t const *p_link)
+{
+    return (p_link->tx_base == p_link->tx_next) && (0U == p_link->reset_pending);
+}
+
+/******************************************************************************
+ * @brief Feed received bytes.
+ *
+ * Bytes may arrive in any split. Complete frames are processed at once;
+ * payloads are delivered in sequence order, each exactly once. Corrupted
+ * frames are dropped and the stream is searched for the next frame.
+ *
+ * @param[in]  p_link         Link state
+ * @param[in]  p_data         Received bytes
+ * @param[in]  size           Number of bytes
+ ******************************************************************************/
+void frame_input(frame_link_t *p_link, uint8_t const *p_data, uint32_t size)
+{
+    while (0U != size)
+    {
+        uint32_t space = FRAME_MAX_SIZE - p_link->rx_len;
+        uint32_t copy  = (size < space) ? size : space;
+        uint32_t used;
+        
+        memcpy(&p_link->rx_buf[p_link->rx_len], p_data, copy);
+        p_link->rx_len += copy;
+        p_data         += copy;
+        size           -= copy;
+        
+        /* Keep the bytes of an incomplete frame at the start of the buffer. */
+        used = frame_parse(p_link);
+        if (0U != used)
+        {
+            p_link->rx_len -= used;
+            memmove(p_link->rx_buf, &p_link->rx_buf[used], p_link->rx_len);
+        }
+    }
+}
+
+/******************************************************************************
+ * @brief Run timers.
+ *
+ * Resends frames whose acknowledgement timed out, delivers payloads held
+ * back by a full transmit window or a busy command layer and sends a pending
+ * acknowledgement. Call it
+ * after each batch of frame_input() calls and periodically.
+ *
+ * @param[in]  p_link         Link state
+ * @param[in]  now_ms         Current time in milliseconds (free running)
+ ******************************************************************************/
+void frame_poll(frame_link_t *p_link, uint32_t now_ms)
+{
+    p_link->now_ms = now_ms;
+    
+    if (0U != p_link->reset_pending)
+    {
+        if ((now_ms - p_link->reset_sent_ms) >= p_link->cfg.retry_timeout_ms)
+        {
+            p_link->reset_sent_ms = now_ms;
+            frame_transmit(p_link, FRAME_TYPE_RESET, 0U, NULL, 0U);
+        }
+    }
+    else
+    {
+        for (uint8_t seq = p_link->tx_base; seq != p_link->tx_next; seq++)
+        {
+            frame_slot_t *p_slot = &p_link->tx_slot[FRAME_SLOT(seq)];
+            
+            if ((0U == p_slot->sacked) && ((now_ms - p_slot->sent_ms) >= p_link->cfg.retry_timeout_ms))
+            {
+                p_link->stats.tx_retransmits++;
+                frame_transmit_data(p_link, seq);
+            }
+        }
+    }
+    
+    frame_deliver(p_link);
+    
+    /* Acknowledge what was received since the last data frame went out. */
+    if (0U != p_link->ack_pending)
+    {
+        frame_transmit(p_link, FRAME_TYPE_ACK, p_link->tx_next, NULL, 0U);
+    }
+}
+
+/******************************************************************************
+ * @brief Encode a frame into the transmit buffer and write it.
+ *
+ * Every frame carries the current acknowledgement state.
+ ******************************************************************************/
+static void frame_transmit(frame_link_t *p_link, uint8_t type, uint8_t seq, uint8_t const *p_data, uint32_t size)
+{
+    uint8_t  *p_buf = p_link->tx_buf;
+    uint8_t  ack    = frame_ack_get(p_link);
+    uint32_t crc;
+    
+    p_buf[FRAME_OFS_SYNC0]     = FRAME_SYNC0;
+    p_buf[FRAME_OFS_SYNC1]     = FRAME_SYNC1;
+    p_buf[FRAME_OFS_TYPE]      = type;
+    p_buf[FRAME_OFS_SEQ]       = seq;
+    p_buf[FRAME_OFS_ACK]       = ack;
+    p_buf[FRAME_OFS_SACK]      = frame_sack_get(p_link, ack);
+    p_buf[FRAME_OFS_SIZE]      = (uint8_t)(size >> 8);
+    p_buf[FRAME_OFS_SIZE + 1U] = (uint8_t)size;
+    
+    if (0U != size)
+    {
+        memcpy(&p_buf[FRAME_HEADER_SIZE], p_data, size);
+    }
+    
+    crc = crc32_calc(0U, p_buf, FRAME_HEADER_SIZE + size);
+    p_buf[FRAME_HEADER_SIZE + size]      = (uint8_t)(crc >> 24);
+    p_buf[FRAME_HEADER_SIZE + size + 1U] = (uint8_t)(crc >> 16);
+    p_buf[FRAME_HEADER_SIZE + size + 2U] = (uint8_t)(crc >> 8);
+    p_buf[FRAME_HEADER_SIZE + size + 3U] = (uint8_t)crc;
+    
+    p_link->ack_pending = 0U;
+    p_link->cfg.p_write(p_link->cfg.p_context, p_buf, FRAME_HEADER_SIZE + size + FRAME_CRC_SIZE);
+}
+
+/******************************************************************************
+ * @brief Send (or resend) the data frame held in the transmit window.
+ ******************************************************************************/
+static void frame_transmit_data(frame_link_t *p_link, uint8_t seq)
+{
+    frame_slot_t *p_slot = &p_link->tx_slot[FRAME_SLOT(seq)];
+    
+    p_slot->sent_ms = p_link->now_ms;
+    if (NULL != p_slot->p_template)
+    {
+        frame_transmit_template(p_link, seq, p_slot->p_template);
+    }
+    else
+    {
+        frame_transmit(p_link, FRAME_TYPE_DATA, seq, p_slot->data, p_slot->size);
+    }
+}
+
+/******************************************************************************
+ * @brief Write the current sequence and acknowledgement state into a
+ *        template, correct its CRC and write it.
+ ******************************************************************************/
+static void frame_transmit_template(frame_link_t *p_link, uint8_t seq, frame_template_t *p_template)
+{
+    uint8_t  *p_frame = p_template->p_frame;
+    uint8_t  *p_crc   = &p_frame[p_template->size - FRAME_CRC_SIZE];
+    uint8_t  fields[3];
+    uint32_t crc;
+    
+    fields[0] = seq;
+    fields[1] = frame_ack_get(p_link);
+    fields[2] = frame_sack_get(p_link, fields[1]);
+    
+    crc = ((uint32_t)p_crc[0] << 24) | ((uint32_t)p_crc[1] << 16) | ((uint32_t)p_crc[2] << 8) | p_crc[3];
+    crc = crc32_patch(crc, p_template->p_shift, &p_frame[FRAME_OFS_SEQ], fields, sizeof(fields));
+    memcpy(&p_frame[FRAME_OFS_SEQ], fields, sizeof(fields));
+    p_crc[0] = (uint8_t)(crc >> 24);
+    p_crc[1] = (uint8_t)(crc >> 16);
+    p_crc[2] = (uint8_t)(crc >> 8);
+    p_crc[3] = (uint8_t)crc;
+    
+    p_link->ack_pending = 0U;
+    p_link->cfg.p_write(p_link->cfg.p_context, p_frame, p_template->size);
+}
+
+/******************************************************************************
+ * @brief Take a filled transmit slot into the window and send it.
+ ******************************************************************************/
+static void frame_queue(frame_link_t *p_link, frame_slot_t *p_slot)
+{
+    p_slot->in_use    = 1U;
+    p_slot->sacked    = 0U;
+    p_slot->fast_retx = 0U;
+    p_slot->sent_ms   = p_link->now_ms;
+    
+    p_link->tx_next++;
+    p_link->stats.tx_frames++;
+    
+    /* While a reset is in progress the frame goes out with the reset acknowledgement. */
+    if (0U == p_link->reset_pending)
+    {
+        frame_transmit_data(p_link, (uint8_t)(p_link->tx_next - 1U));
+    }
+}
+
+/******************************************************************************
+ * @brief Drop everything in flight and restart both sequence spaces at 0.
+ ******************************************************************************/
+static void frame_window_clear(frame_link_t *p_link)
+{
+    for (uint32_t i = 0U; i < FRAME_WINDOW_SIZE; i++)
+    {
+        p_link->tx_slot[i].in_use = 0U;
+    }
+    for (uint32_t i = 0U; i < FRAME_RX_SLOTS; i++)
+    {
+        p_link->rx_slot[i].in_use = 0U;
+    }
+    
+    p_link->tx_base       = 0U;
+    p_link->tx_next       = 0U;
+    p_link->rx_base       = 0U;
+    p_link->ack_pending   = 0U;
+    p_link->reset_pending = 0U;
+    p_link->stats.resets++;
+}
+
+/******************************************************************************
+ * @brief Next sequence number expected by the receive window.
+ *
+ * Frames are acknowledged when they are received, not when they are
+ * delivered, so the acknowledgement covers frames still held for delivery,
+ * up to one window of them.
+ ******************************************************************************/
+static uint8_t frame_ack_get(frame_link_t const *p_link)
+{
+    uint8_t ack = p_link->rx_base;
+    
+    while (((uint8_t)(ack - p_link->rx_base) < FRAME_WINDOW_SIZE) && (0U != p_link->rx_slot[FRAME_RX_SLOT(ack)].in_use))
+    {
+        ack++;
+    }
+    
+    return ack;
+}
+
+/******************************************************************************
+ * @brief Selective acknowledgement bitmap of the frames received after ack.
+ ******************************************************************************/
+static uint8_t frame_sack_get(frame_link_t const *p_link, uint8_t ack)
+{
+    uint8_t sack = 0U;
+    
+    /* ack stopped at a frame that is held, not missing: report no gap, or the peer would resend it. */
+    if (0U != p_link->rx_slot[FRAME_RX_SLOT(ack)].in_use)
+    {
+        return 0U;
+    }
+    
+    for (uint32_t i = 0U; i < (FRAME_WINDOW_SIZE - 1U); i++)
+    {
+        uint8_t seq = (uint8_t)(ack + 1U + i);
+        
+        if (((uint8_t)(seq - p_link->rx_base) < FRAME_RX_SLOTS) && (0U != p_link->rx_slot[FRAME_RX_SLOT(seq)].in_use))
+        {
+            sack |= (uint8_t)(1U << i);
+        }
+    }
+    
+    return sack;
+}
+
+/******************************************************************************
+ * @brief Process the acknowledgement fields of a received frame.
+ *
+ * Frames before ack leave the window. Frames reported in sack are not resent
+ * on timeout. If sack shows that later frames arrived, the missing ones
+ * before them were lost; they are resent at once (only once each, the
+ * timeout covers a second loss).
+ ******************************************************************************/
+static void frame_ack_process(frame_link_t *p_link, uint8_t ack, uint8_t sack)
+{
+    uint8_t in_flight = (uint8_t)(p_link->tx_next - p_link->tx_base);
+    uint8_t last_sacked;
+    
+    /* Ignore acknowledgements outside the window (stale or from a previous session). */
+    if ((uint8_t)(ack - p_link->tx_base) > in_flight)
+    {
+        return;
+    }
+    
+    while (p_link->tx_base != ack)
+    {
+        p_link->tx_slot[FRAME_SLOT(p_link->tx_base)].in_use = 0U;
+        p_link->tx_base++;
+    }
+    
+    if (0U == sack)
+    {
+        return;
+    }
+    
+    in_flight   = (uint8_t)(p_link->tx_next - p_link->tx_base);
+    last_sacked = ack;
+    for (uint32_t i = 0U; i < (FRAME_WINDOW_SIZE - 1U); i++)
+    {
+        uint8_t seq = (uint8_t)(ack + 1U + i);
+        
+        if ((0U != (sack & (1U << i))) && ((uint8_t)(seq - p_link->tx_base) < in_flight))
+        {
+            p_link->tx_slot[FRAME_SLOT(seq)].sacked = 1U;
+            last_sacked = seq;
+        }
+    }
+    
+    for (uint8_t seq = p_link->tx_base; seq != last_sacked; seq++)
+    {
+        frame_slot_t *p_slot = &p_link->tx_slot[FRAME_SLOT(seq)];
+        
+        if ((0U == p_slot->sacked) && (0U == p_slot->fast_retx))
+        {
+            p_slot->fast_retx = 1U;
+            p_link->stats.tx_retransmits++;
+            frame_transmit_data(p_link, seq);
+        }
+    }
+}
+
+/******************************************************************************
+ * @brief Store a received data frame in the receive window.
+ *
+ * A frame behind the window or already held is a resend of something this
+ * end has; it is dropped but acknowledged again, since the earlier
+ * acknowledgement was evidently lost. A frame beyond the receive slots
+ * cannot come from a peer that follows the protocol; it is dropped
+ * unacknowledged.
+ ******************************************************************************/
+static void frame_data_process(frame_link_t *p_link, uint8_t seq, uint8_t const *p_data, uint32_t size)
+{
+    frame_slot_t *p_slot = &p_link->rx_slot[FRAME_RX_SLOT(seq)];
+    
+    if ((uint8_t)(seq - p_link->rx_base) < FRAME_RX_SLOTS)
+    {
+        if (0U == p_slot->in_use)
+        {
+            memcpy(p_slot->data, p_data, size);
+            p_slot->size   = (uint16_t)size;
+            p_slot->in_use = 1U;
+        }
+        else
+        {
+            p_link->stats.rx_duplicates++;
+        }
+    }
+    else if ((uint8_t)(p_link->rx_base - seq) <= FRAME_RX_SLOTS)
+    {
+        p_link->stats.rx_duplicates++;
+    }
+    else
+    {
+        /* Beyond the window. */
+    }
+    
+    p_link->ack_pending = 1U;
+}
+
+/******************************************************************************
+ * @brief Deliver in-order payloads to the command layer.
+ *
+ * A payload is only delivered while the transmit window has room, so the
+ * command layer can always answer it, and while the command layer accepts
+ * it (p_accept). Payloads held back are already acknowledged but keep their
+ * receive slot; once a window of them is held, acknowledgements stop and so
+ * does the peer. frame_poll() tries again.
+ ******************************************************************************/
+static void frame_deliver(frame_link_t *p_link)
+{
+    frame_slot_t *p_slot = &p_link->rx_slot[FRAME_RX_SLOT(p_link->rx_base)];
+    
+    while ((0U != p_slot->in_use) && (0U != frame_send_space(p_link)) && (0U == p_link->reset_pending))
+    {
+        if ((NULL != p_link->cfg.p_accept) && (false == p_link->cfg.p_accept(p_link->cfg.p_context)))
+        {
+            break;
+        }
+        
+        /* Free the slot first: an answer sent from the callback carries the acknowledgement state. The data
+         * stays valid during the callback, nothing is received meanwhile. */
+        p_slot->in_use = 0U;
+        p_link->rx_base++;
+        p_link->ack_pending = 1U;
+        p_link->stats.rx_delivered++;
+        
+        p_link->cfg.p_deliver(p_link->cfg.p_context, p_slot->data, p_slot->size);
+        
+        p_slot = &p_link->rx_slot[FRAME_RX_SLOT(p_link->rx_base)];
+    }
+}
+
+/******************************************************************************
+ * @brief Process one frame that passed the CRC check.
+ ******************************************************************************/
+static void frame_process(frame_link_t *p_link, uint8_t const *p_frame, uint32_t size)
+{
+    uint8_t type = p_frame[FRAME_OFS_TYPE];
+    
+    p_link->stats.rx_frames++;
+    
+    switch (type)
+    {
+        case FRAME_TYPE_RESET:
+            /* The peer starts a new session. */
+            frame_window_clear(p_link);
+            frame_transmit(p_link, FRAME_TYPE_RESET_ACK, 0U, NULL, 0U);
+            break;
+        case FRAME_TYPE_RESET_ACK:
+            if (0U != p_link->reset_pending)
+            {
+                /* Send what was queued during the reset. */
+                p_link->reset_pending = 0U;
+                for (uint8_t seq = p_link->tx_base; seq != p_link->tx_next; seq++)
+                {
+                    frame_transmit_data(p_link, seq);
+                }
+            }
+            break;
+        case FRAME_TYPE_DATA:
+            if (0U == p_link->reset_pending)
+            {
+                frame_ack_process(p_link, p_frame[FRAME_OFS_ACK], p_frame[FRAME_OFS_SACK]);
+                frame_data_process(p_link, p_frame[FRAME_OFS_SEQ], &p_frame[FRAME_HEADER_SIZE], size);
+                frame_deliver(p_link);
+            }
+            break;
+        case FRAME_TYPE_ACK:
+            if (0U == p_link->reset_pending)
+            {
+                frame_ack_process(p_link, p_frame[FRAME_OFS_ACK], p_frame[FRAME_OFS_SACK]);
+                frame_deliver(p_link);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/******************************************************************************
+ * @brief Find and process complete frames in the reassembly buffer.
+ *
+ * @retval Number of bytes consumed from the start of the buffer
+ ******************************************************************************/
+static uint32_t frame_parse(frame_link_t *p_link)
+{
+    uint8_t const *p_buf = p_link->rx_buf;
+    uint32_t      pos    = 0U;
+    
+    while (pos < p_link->rx_len)
+    {
+        uint32_t avail = p_link->rx_len - pos;
+        uint32_t payload_size;
+        uint32_t frame_size;
+        uint32_t crc;
+        uint8_t  type;
+        
+        /* Search for the start of a frame. */
+        if ((FRAME_SYNC0 != p_buf[pos]) || ((avail >= 2U) && (FRAME_SYNC1 != p_buf[pos + 1U])))
+        {
+            p_link->stats.rx_framing_errors++;
+            pos++;
+            continue;
+        }
+        
+        if (avail < FRAME_HEADER_SIZE)
+        {
+            break;
+        }
+        
+        type         = p_buf[pos + FRAME_OFS_TYPE];
+        payload_size = ((uint32_t)p_buf[pos + FRAME_OFS_SIZE] << 8) | p_buf[pos + FRAME_OFS_SIZE + 1U];
+        if ((FRAME_MAX_PAYLOAD < payload_size) || (FRAME_TYPE_DATA > type) || (FRAME_TYPE_RESET_ACK < type))
+        {
+            p_link->stats.rx_framing_errors++;
+            pos++;
+            continue;
+        }
+        
+        frame_size = FRAME_HEADER_SIZE + payload_size + FRAME_CRC_SIZE;
+        if (avail < frame_size)
+        {
+            break;
+        }
+        
+        crc = ((uint32_t)p_buf[pos + frame_size - 4U] << 24) | ((uint32_t)p_buf[pos + frame_size - 3U] << 16) |
+              ((uint32_t)p_buf[pos + frame_size - 2U] << 8)  |  (uint32_t)p_buf[pos + frame_size - 1U];
+        if (crc32_calc(0U, &p_buf[pos], FRAME_HEADER_SIZE + payload_size) != crc)
+        {
+            /* Corrupted, or a false sync inside other data: resume the search after the sync byte. */
+            p_link->stats.rx_crc_errors++;
+            pos++;
+            continue;
+        }
+        
+        frame_process(p_link, &p_buf[pos], payload_size);
+        pos += frame_size;
+    }
+    
+    return pos;
+}
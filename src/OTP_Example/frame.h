@@ -0,0 +1,165 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+#ifndef __FRAME_H__
+#define __FRAME_H__
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Number of frames that may be in flight in each direction */
+#define FRAME_WINDOW_SIZE          (8U)
+
+/* Receive slots. Frames held for delivery are acknowledged (at most a window
+ * of them), so the peer may send up to a window beyond those: twice the
+ * window keeps a slot for every frame it may send. */
+#define FRAME_RX_SLOTS             (2U * FRAME_WINDOW_SIZE)
+
+/* Largest payload carried by one frame */
+#define FRAME_MAX_PAYLOAD          (1024U)
+
+/* Frame layout:
+ *   [0] FRAME_SYNC0  [1] FRAME_SYNC1  [2] type  [3] seq  [4] ack  [5] sack
+ *   [6..7] payload size (big endian)  [8..] payload  [last 4] CRC-32 (big endian)
+ * ack is the next sequence number the sender of the frame expects, sack bit i
+ * tells that frame ack + 1 + i has been received out of order. The CRC covers
+ * the header and the payload. */
+#define FRAME_SYNC0                (0xA5U)
+#define FRAME_SYNC1                (0x5AU)
+#define FRAME_HEADER_SIZE          (8U)
+#define FRAME_CRC_SIZE             (4U)
+#define FRAME_MAX_SIZE             (FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD + FRAME_CRC_SIZE)
+
+/* Bytes after sack of a frame, those the CRC shift table of a template covers */
+#define FRAME_TEMPLATE_FOLLOWING(frame_size)  ((frame_size) - FRAME_CRC_SIZE - 6U)
+
+/* Frame types */
+#define FRAME_TYPE_DATA            (0x01U)
+#define FRAME_TYPE_ACK             (0x02U)
+#define FRAME_TYPE_RESET           (0x03U)
+#define FRAME_TYPE_RESET_ACK       (0x04U)
+
+/* Default retransmission timeout */
+#define FRAME_RETRY_TIMEOUT_MS     (1000U)
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+/* Frame error code */
+typedef enum e_frame_err
+{
+    FRAME_SUCCESS          = 0,
+    FRAME_ERR_WINDOW_FULL  = 1,
+    FRAME_ERR_SIZE         = 2,
+} frame_err_t;
+
+/* Link configuration */
+typedef struct
+{
+    /* Write an encoded frame to the line. */
+    void (*p_write)(void *p_context, uint8_t const *p_data, uint32_t size);
+    /* Deliver a received payload to the command layer, in order and exactly once. */
+    void (*p_deliver)(void *p_context, uint8_t const *p_data, uint32_t size);
+    /* Optional: return false to hold deliveries back while the command layer is busy. */
+    bool (*p_accept)(void *p_context);
+    void     *p_context;
+    uint32_t retry_timeout_ms;         // 0 selects FRAME_RETRY_TIMEOUT_MS
+} frame_cfg_t;
+
+/* Link statistics */
+typedef struct
+{
+    uint32_t tx_frames;                // Data frames sent for the first time
+    uint32_t tx_retransmits;           // Data frames sent again (timeout or gap reported by the peer)
+    uint32_t rx_frames;                // Valid frames received
+    uint32_t rx_delivered;             // Payloads delivered to the command layer
+    uint32_t rx_duplicates;            // Data frames received again and dropped
+    uint32_t rx_crc_errors;            // Frames dropped for a CRC mismatch
+    uint32_t rx_framing_errors;        // Bytes skipped while searching for a frame
+    uint32_t resets;                   // Link resets
+} frame_stats_t;
+
+/* Data frame encoded ahead of time, CRC included (frame_send_template()).
+ * Each transmission writes seq, ack and sack into it and corrects the CRC
+ * with p_shift, instead of copying and encoding the payload again. */
+typedef struct
+{
+    uint8_t        *p_frame;           // Whole frame; seq, ack and sack are rewritten in place
+    uint32_t        size;
+    uint32_t const *p_shift;           // crc32_shift_init() of FRAME_TEMPLATE_FOLLOWING(size) bytes
+} frame_template_t;
+
+/* One window slot */
+typedef struct
+{
+    uint8_t  in_use;                   // Transmit: waiting for ack. Receive: held for delivery.
+    uint8_t  sacked;                   // Transmit: received by the peer out of order
+    uint8_t  fast_retx;                // Transmit: already resent for a gap reported by the peer
+    uint16_t size;
+    uint32_t sent_ms;
+    frame_template_t *p_template;      // Transmit: the frame to send instead of data, or NULL
+    uint8_t  data[FRAME_MAX_PAYLOAD];
+} frame_slot_t;
+
+/* Link state */
+typedef struct
+{
+    frame_cfg_t   cfg;
+    uint32_t      now_ms;
+    
+    /* Transmit window: tx_base is the oldest unacknowledged frame, tx_next the next new one. */
+    uint8_t       tx_base;
+    uint8_t       tx_next;
+    uint8_t       reset_pending;
+    uint32_t      reset_sent_ms;
+    frame_slot_t  tx_slot[FRAME_WINDOW_SIZE];
+    
+    /* Receive window: rx_base is the next frame to deliver. */
+    uint8_t       rx_base;
+    uint8_t       ack_pending;
+    frame_slot_t  rx_slot[FRAME_RX_SLOTS];
+    
+    /* Byte stream reassembly and frame encoding */
+    uint32_t      rx_len;
+    uint8_t       rx_buf[FRAME_MAX_SIZE];
+    uint8_t       tx_buf[FRAME_MAX_SIZE];
+    
+    frame_stats_t stats;
+} frame_link_t;
+
+/******************************************************************************
+ * Exported global functions (to be accessed by other files)
+ ******************************************************************************/
+void frame_init(frame_link_t *p_link, frame_cfg_t const *p_cfg);
+void frame_reset(frame_link_t *p_link);
+frame_err_t frame_send(frame_link_t *p_link, uint8_t const *p_data, uint32_t size);
+frame_err_t frame_send_template(frame_link_t *p_link, frame_template_t *p_template);
+uint32_t frame_template_encode(uint8_t *p_frame, uint8_t const *p_data, uint32_t size);
+uint32_t frame_send_space(frame_link_t const *p_link);
+bool frame_idle(frame_link_t const *p_link);
+void frame_input(frame_link_t *p_link, uint8_t const *p_data, uint32_t size);
+void frame_poll(frame_link_t *p_link, uint32_t now_ms);
+
+#endif /* __FRAME_H__ */
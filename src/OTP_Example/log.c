@@ -0,0 +1,230 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "log.h"
+#include "systime.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+#define LOG_RING_MASK           (LOG_RING_WORDS - 1U)
+
+#if ((LOG_RING_WORDS & LOG_RING_MASK) != 0U)
+#error "LOG_RING_WORDS must be a power of two"
+#endif
+
+/* The ring lives in system RAM (the non-cache buffer block, cleared at
+ * startup), not in the ATCM that holds the code, .bss and the heap. */
+#if defined(_RENESAS_RZN_)
+#define LOG_RING_SECTION        BSP_PLACE_IN_SECTION(".noncache_buffer")
+#else
+#define LOG_RING_SECTION
+#endif
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static uint32_t          s_g_log_ring[LOG_RING_WORDS] LOG_RING_SECTION;
+static volatile uint32_t s_g_log_head    = 0U;      // Words reserved by writers (free running)
+static volatile uint32_t s_g_log_tail    = 0U;      // Words freed by the drain (free running)
+static uint32_t          s_g_log_read    = 0U;      // End of the records the last drain returned
+static volatile uint32_t s_g_log_dropped = 0U;      // Records that did not fit
+
+#if defined(_RENESAS_RZN_)
+/* Replace *p_word by desired if it still holds expected. An interrupt
+ * between the two accesses clears the exclusive monitor, so the store
+ * fails and the caller tries again. */
+static inline bool log_swap(volatile uint32_t *p_word, uint32_t expected, uint32_t desired)
+{
+    if (__LDREXW(p_word) != expected)
+    {
+        __CLREX();
+        return false;
+    }
+    
+    return (0U == __STREXW(desired, p_word));
+}
+
+static inline void log_barrier(void)
+{
+    __DMB();
+}
+
+#else
+static inline bool log_swap(volatile uint32_t *p_word, uint32_t expected, uint32_t desired)
+{
+    return __atomic_compare_exchange_n(p_word, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+
+static inline void log_barrier(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+#endif
+
+/******************************************************************************
+ * @brief Add a record to the ring (use the LOG0 to LOG4 macros).
+ *
+ * The words are reserved by moving the head with an exclusive access, so
+ * an interrupt handler may log while the main loop is in the middle of a
+ * record: each writer fills its own words. The header goes last, after a
+ * barrier, and marks the record complete for log_drain(). When the ring is
+ * full the record is dropped and counted; logging never waits.
+ *
+ * @param[in]  token          log_token_t
+ * @param[in]  nargs          Arguments that follow (up to LOG_MAX_ARGS)
+ * @param[in]  a0 - a3        Arguments
+ ******************************************************************************/
+void log_write(uint32_t token, uint32_t nargs, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3)
+{
+    uint32_t words = LOG_RECORD_WORDS(nargs);
+    uint32_t head;
+    uint32_t dropped;
+    
+    do
+    {
+        head = s_g_log_head;
+        if ((head + words) - s_g_log_tail > LOG_RING_WORDS)
+        {
+            do
+            {
+                dropped = s_g_log_dropped;
+            } while (false == log_swap(&s_g_log_dropped, dropped, dropped + 1U));
+            
+            return;
+        }
+    } while (false == log_swap(&s_g_log_head, head, head + words));
+    
+    s_g_log_ring[(head + 1U) & LOG_RING_MASK] = (uint32_t)systime_now();
+    switch (nargs)
+    {
+        case 4U:
+            s_g_log_ring[(head + 5U) & LOG_RING_MASK] = a3;
+            /* fall through */
+        case 3U:
+            s_g_log_ring[(head + 4U) & LOG_RING_MASK] = a2;
+            /* fall through */
+        case 2U:
+            s_g_log_ring[(head + 3U) & LOG_RING_MASK] = a1;
+            /* fall through */
+        case 1U:
+            s_g_log_ring[(head + 2U) & LOG_RING_MASK] = a0;
+            break;
+        default:
+            break;
+    }
+    
+    log_barrier();
+    s_g_log_ring[head & LOG_RING_MASK] = LOG_HEADER(token, nargs);
+}
+
+/******************************************************************************
+ * @brief Take complete records from the ring.
+ *
+ * Records are copied in the order their words were reserved, as big endian
+ * words. The drain stops at a record whose writer has not finished it yet
+ * (it was interrupted), and at the first record that does not fit in
+ * p_out. The records copied stay in the ring until the next drain that is
+ * not a repeat frees them, so a response that was lost can be sent again.
+ * Call it from the main loop only.
+ *
+ * @param[out] p_out          Destination
+ * @param[in]  size           Destination size in bytes
+ * @param[in]  again          Copy the records of the last drain again
+ *                            instead of freeing them
+ *
+ * @retval Bytes copied
+ ******************************************************************************/
+uint32_t log_drain(uint8_t *p_out, uint32_t size, bool again)
+{
+    uint32_t tail  = s_g_log_tail;
+    uint32_t count = 0U;
+    
+    if (false == again)
+    {
+        /* Every word is cleared before it is handed back, not just the
+         * header: the header of a later record may land on an old argument
+         * word, which must not look complete until its writer says so. */
+        for (; tail != s_g_log_read; tail++)
+        {
+            s_g_log_ring[tail & LOG_RING_MASK] = 0U;
+        }
+        
+        log_barrier();
+        s_g_log_tail = tail;
+    }
+    
+    while (tail != s_g_log_head)
+    {
+        uint32_t header = s_g_log_ring[tail & LOG_RING_MASK];
+        uint32_t words  = LOG_RECORD_WORDS(LOG_HEADER_NARGS(header));
+        
+        if ((LOG_RECORD_MARK != (header & 0xFFU)) || (LOG_HEADER_NARGS(header) > LOG_MAX_ARGS) ||
+            ((size - count) < (words * 4U)))
+        {
+            break;
+        }
+        log_barrier();
+        
+        for (uint32_t i = 0U; i < words; i++)
+        {
+            uint32_t word = s_g_log_ring[(tail + i) & LOG_RING_MASK];
+            p_out[count++] = (uint8_t)(word >> 24);
+            p_out[count++] = (uint8_t)(word >> 16);
+            p_out[count++] = (uint8_t)(word >> 8);
+            p_out[count++] = (uint8_t)word;
+        }
+        
+        tail += words;
+    }
+    
+    s_g_log_read = tail;
+    
+    return count;
+}
+
+/******************************************************************************
+ * @brief Bytes of records the last log_drain() did not return.
+ ******************************************************************************/
+uint32_t log_pending(void)
+{
+    return (s_g_log_head - s_g_log_read) * 4U;
+}
+
+/******************************************************************************
+ * @brief Records dropped since reset because the ring was full.
+ ******************************************************************************/
+uint32_t log_dropped(void)
+{
+    return s_g_log_dropped;
+}
+
+/******************************************************************************
+ * @brief Rate of the record time stamps, in Hz.
+ ******************************************************************************/
+uint32_t log_tick_hz(void)
+{
+    return SYSTIME_HZ;
+}
@@ -0,0 +1,94 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+#ifndef __LOG_H__
+#define __LOG_H__
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Log tokens: name, number of arguments, format. The format strings only
+ * live in this table. The firmware expands it to the token numbers alone,
+ * the host decoder (tools/provision/log_decode.c) to the strings, so no
+ * text is stored or formatted on the board. A format takes 32-bit
+ * arguments only (%u, %d, %x and their widths). Add new tokens at the end,
+ * so that logs of older firmware still decode. */
+#define LOG_TOKENS(X) \
+    X(LOG_BOOT,           0U, "board started") \
+    X(LOG_OTP_WRITE,      3U, "otp write 0x%03x = 0x%04x: %u") \
+    X(LOG_OTP_READ_FAIL,  1U, "otp read 0x%03x failed") \
+    X(LOG_OTP_POWER_FAIL, 0U, "otp power on refused, power-down not finished") \
+    X(LOG_CMD_DONE,       3U, "command 0x%02x tag %u: ret %u") \
+    X(LOG_SCI_RX_PACKET,  2U, "sci rx packet of %u bytes in %u RXI interrupts") \
+    X(LOG_SCI_RX_ERROR,   1U, "sci rx error, event 0x%x")
+
+/* Words of the record ring, a power of two. It is in system RAM (log.c). */
+#define LOG_RING_WORDS       (4096U)
+/* Most arguments of one record */
+#define LOG_MAX_ARGS         (4U)
+
+/* Record: header word, time stamp word, then the arguments. The header is
+ * written last and holds LOG_RECORD_MARK, so a record still being written
+ * (its header 0) is never read. */
+#define LOG_RECORD_MARK      (0xA5U)
+#define LOG_HEADER(token, nargs)    (((uint32_t)(token) << 16) | ((uint32_t)(nargs) << 8) | LOG_RECORD_MARK)
+#define LOG_HEADER_TOKEN(header)    ((header) >> 16)
+#define LOG_HEADER_NARGS(header)    (((header) >> 8) & 0xFFU)
+#define LOG_RECORD_WORDS(nargs)     (2U + (nargs))
+
+/* Log a record. Safe from interrupt handlers: takes no lock, and a record
+ * that does not fit is counted as dropped instead of waiting. */
+#define LOG0(token)                 log_write((token), 0U, 0U, 0U, 0U, 0U)
+#define LOG1(token, a)              log_write((token), 1U, (uint32_t)(a), 0U, 0U, 0U)
+#define LOG2(token, a, b)           log_write((token), 2U, (uint32_t)(a), (uint32_t)(b), 0U, 0U)
+#define LOG3(token, a, b, c)        log_write((token), 3U, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), 0U)
+#define LOG4(token, a, b, c, d)     log_write((token), 4U, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), \
+                                              (uint32_t)(d))
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+#define LOG_TOKEN_ENUM(name, nargs, format)    name,
+typedef enum
+{
+    LOG_TOKENS(LOG_TOKEN_ENUM)
+    LOG_TOKEN_COUNT
+} log_token_t;
+#undef LOG_TOKEN_ENUM
+
+/******************************************************************************
+ * Exported global functions (to be accessed by other files)
+ ******************************************************************************/
+void log_write(uint32_t token, uint32_t nargs, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+
+/* Drain: copy whole records (big endian words) to p_out. They are freed by
+ * the next drain, unless it is a repeat (again) that copies them once more.
+ * Called from the main loop only. */
+uint32_t log_drain(uint8_t *p_out, uint32_t size, bool again);
+uint32_t log_pending(void);
+uint32_t log_dropped(void);
+uint32_t log_tick_hz(void);
+
+#endif /* __LOG_H__ */
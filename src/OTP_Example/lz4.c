@@ -0,0 +1,142 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "lz4.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Shortest match; a token holds the match length minus this */
+#define LZ4_MIN_MATCH             (4U)
+
+/* Token nibble value that continues a length in the following bytes */
+#define LZ4_LENGTH_MORE           (15U)
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static bool lz4_length(uint8_t const **pp_src, uint8_t const *p_end, uint32_t *p_length);
+
+/******************************************************************************
+ * @brief Decode one LZ4 block.
+ *
+ * Each sequence is a token (literal length in the high nibble, match length
+ * minus 4 in the low one), extra length bytes, the literals, a 2-byte little
+ * endian match offset and extra match length bytes. The last sequence has
+ * literals only. Every length and offset is checked against the buffers, so
+ * a damaged block cannot write outside p_dst.
+ *
+ * @param[in]  p_src          LZ4 block
+ * @param[in]  src_size       Block size
+ * @param[out] p_dst          Decoded data
+ * @param[in]  dst_size       Room in p_dst
+ *
+ * @retval Decoded size, or -1 on a malformed block
+ ******************************************************************************/
+int32_t lz4_decode(uint8_t const *p_src, uint32_t src_size, uint8_t *p_dst, uint32_t dst_size)
+{
+    uint8_t const *p_end = p_src + src_size;
+    uint32_t      out    = 0U;
+    
+    while (p_src < p_end)
+    {
+        uint8_t  token   = *p_src++;
+        uint32_t length  = (uint32_t)(token >> 4);
+        uint32_t offset;
+        
+        /* Literals */
+        if ((LZ4_LENGTH_MORE == length) && (false == lz4_length(&p_src, p_end, &length)))
+        {
+            return -1;
+        }
+        if ((length > (uint32_t)(p_end - p_src)) || (length > (dst_size - out)))
+        {
+            return -1;
+        }
+        for (uint32_t i = 0U; i < length; i++)
+        {
+            p_dst[out++] = *p_src++;
+        }
+        
+        if (p_src == p_end)
+        {
+            /* The last sequence. */
+            break;
+        }
+        
+        /* Match */
+        if (2 > (p_end - p_src))
+        {
+            return -1;
+        }
+        offset = (uint32_t)p_src[0] | ((uint32_t)p_src[1] << 8);
+        p_src += 2;
+        length = (uint32_t)(token & 0x0FU);
+        if ((LZ4_LENGTH_MORE == length) && (false == lz4_length(&p_src, p_end, &length)))
+        {
+            return -1;
+        }
+        length += LZ4_MIN_MATCH;
+        if ((0U == offset) || (offset > out) || (length > (dst_size - out)))
+        {
+            return -1;
+        }
+        
+        /* Byte by byte: a match may overlap the bytes it produces. */
+        for (uint32_t i = 0U; i < length; i++)
+        {
+            p_dst[out] = p_dst[out - offset];
+            out++;
+        }
+    }
+    
+    return (int32_t)out;
+}
+
+/******************************************************************************
+ * @brief Add the extra length bytes that follow a token nibble of 15.
+ *
+ * @retval true   Length read
+ * @retval false  The block ends inside the length
+ ******************************************************************************/
+static bool lz4_length(uint8_t const **pp_src, uint8_t const *p_end, uint32_t *p_length)
+{
+    uint8_t const *p_src = *pp_src;
+    uint8_t       byte;
+    
+    do
+    {
+        if ((p_src == p_end) || (*p_length > 0x00FFFFFFU))
+        {
+            return false;
+        }
+        byte       = *p_src++;
+        *p_length += byte;
+    } while (255U == byte);
+    
+    *pp_src = p_src;
+    
+    return true;
+}
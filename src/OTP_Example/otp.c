@@ -22,7 +22,22 @@
  * Includes   <System Includes> , "Project Includes"
  ******************************************************************************/
 #include "hal_data.h"
+#include "log.h"
 #include "otp.h"
+#include "otp_audit.h"
+#include "systime.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Longest wait for the OTP controller, far beyond its access times */
+#define OTP_CMD_TIMEOUT_US      (100000U)
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static otp_err_t otp_wait_cmd_rdy(uint32_t ready);
+static otp_err_t otp_write_done(uint16_t otp_addr, uint16_t data, otp_err_t ret);
 
 /******************************************************************************
  * @brief OTP power on.
@@ -38,6 +53,7 @@ otp_err_t otp_power_on(void)
         /* Confirm completion of the power-down process. */
         if (1U ==  R_OTP->OTPPWR_b.PWR)
         {
+            LOG0(LOG_OTP_POWER_FAIL);
             return OTP_ERROR;
         }
     }
@@ -58,13 +74,7 @@ void otp_power_off(void)
     R_OTP->OTPPWR_b.PWR  = 0U;
     R_OTP->OTPPWR_b.ACCL = 0U;
     
-    while (1)
-    {
-        if (0U == R_OTP->OTPSTR_b.CMD_RDY)
-        {
-            break;
-        }
-    }
+    (void)otp_wait_cmd_rdy(0U);
     
     return;
 }
@@ -81,9 +91,13 @@ void otp_power_off(void)
 otp_err_t write_otp_data(uint16_t otp_addr, uint16_t data)
 {
     otp_err_t ret = OTP_SUCCESS;
+    systime_t deadline;
     
     /* Confirm that CMD_RDY bit of the OTP access status register (OTPSTR.CMD_RDY) is 1. */
-    while (0U == R_OTP->OTPSTR_b.CMD_RDY);
+    if (OTP_SUCCESS != otp_wait_cmd_rdy(1U))
+    {
+        return otp_write_done(otp_addr, data, OTP_ERROR);
+    }
     
     /* Set the PWR and ACCL bits of the OTP Power Control Register. */
     R_OTP->OTPPWR_b.PWR  = 1U;
@@ -99,21 +113,20 @@ otp_err_t write_otp_data(uint16_t otp_addr, uint16_t data)
     R_OTP->OTPSTAWR_b.STAWR = 1U;
     
     /* Poll the STAWR bit untill changing to 0 in order to detect the completion of the write command acceptance. */
-    while (1)
+    deadline = systime_deadline_us(OTP_CMD_TIMEOUT_US);
+    while ((0U != R_OTP->OTPSTAWR_b.STAWR) && (false == systime_expired(deadline)))
     {
-        if (0U == R_OTP->OTPSTAWR_b.STAWR)
-        {
-            break;
-        }
+        ;
+    }
+    if (0U != R_OTP->OTPSTAWR_b.STAWR)
+    {
+        return otp_write_done(otp_addr, data, OTP_ERROR);
     }
     
     /* Poll the CMD_RDY bit untill changing to 1 in order to detect the completion of the write command. */
-    while (1)
+    if (OTP_SUCCESS != otp_wait_cmd_rdy(1U))
     {
-        if (1U == R_OTP->OTPSTR_b.CMD_RDY)
-        {
-            break;
-        }
+        return otp_write_done(otp_addr, data, OTP_ERROR);
     }
     
     /* Check OTP write error. */
@@ -128,7 +141,7 @@ otp_err_t write_otp_data(uint16_t otp_addr, uint16_t data)
         R_OTP->OTPSTR_b.ERR_RDY_WR = 0U;
     }
     
-    return ret;
+    return otp_write_done(otp_addr, data, ret);
 }
 
 /******************************************************************************
@@ -145,25 +158,22 @@ otp_err_t read_otp_data(uint16_t otp_addr, uint16_t *p_data)
     otp_err_t ret = OTP_SUCCESS;
     
     /* Confirm that CMD_RDY bit of the OTP access status register (OTPSTR.CMD_RDY) is 1. */
-    while (0U == R_OTP->OTPSTR_b.CMD_RDY);
+    ret = otp_wait_cmd_rdy(1U);
     
-    /* Set the PWR and ACCL bits of the OTP Power Control Register. */
-    R_OTP->OTPPWR_b.PWR  = 1U;
-    R_OTP->OTPPWR_b.ACCL = 1U;
-    
-    /* Set the read address to the OTP Read Address Register. */
-    R_OTP->OTPADRRD_b.ADRRD = otp_addr;
-    
-    /* Read the OTP Read Data Register. */
-    *p_data = R_OTP->OTPDATARD_b.DATARD;
-    
-    /* Poll the CMD_RDY bit untill changing to 1 in order to detect the completion of the write command. */
-    while (1)
+    if (OTP_SUCCESS == ret)
     {
-        if (1U == R_OTP->OTPSTR_b.CMD_RDY)
-        {
-            break;
-        }
+        /* Set the PWR and ACCL bits of the OTP Power Control Register. */
+        R_OTP->OTPPWR_b.PWR  = 1U;
+        R_OTP->OTPPWR_b.ACCL = 1U;
+        
+        /* Set the read address to the OTP Read Address Register. */
+        R_OTP->OTPADRRD_b.ADRRD = otp_addr;
+        
+        /* Read the OTP Read Data Register. */
+        *p_data = R_OTP->OTPDATARD_b.DATARD;
+        
+        /* Poll the CMD_RDY bit untill changing to 1 in order to detect the completion of the write command. */
+        ret = otp_wait_cmd_rdy(1U);
     }
     
     /* Check OTP read error. */
@@ -178,6 +188,11 @@ otp_err_t read_otp_data(uint16_t otp_addr, uint16_t *p_data)
         R_OTP->OTPSTR_b.ERR_RDY_RD = 0U;
     }
     
+    if (OTP_SUCCESS != ret)
+    {
+        LOG1(LOG_OTP_READ_FAIL, otp_addr);
+    }
+    
     return ret;
 }
 
@@ -266,3 +281,38 @@ otp_err_t read_otp_multiple_data(uint16_t addr, uint8_t *p_data, uint8_t data_le
     
     return ret;
 }
+
+/******************************************************************************
+ * @brief Poll CMD_RDY until it reads the wanted value, for up to
+ *        OTP_CMD_TIMEOUT_US.
+ *
+ * The value is read once more after the deadline, so a wait that was
+ * interrupted past it does not fail an access that completed.
+ *
+ * @param[in]  ready          Wanted value of OTPSTR.CMD_RDY
+ *
+ * @retval OTP_SUCCESS   CMD_RDY reads ready
+ * @retval OTP_ERROR     The controller did not get there in time
+ ******************************************************************************/
+static otp_err_t otp_wait_cmd_rdy(uint32_t ready)
+{
+    systime_t deadline = systime_deadline_us(OTP_CMD_TIMEOUT_US);
+    
+    while ((ready != R_OTP->OTPSTR_b.CMD_RDY) && (false == systime_expired(deadline)))
+    {
+        ;
+    }
+    
+    return (ready == R_OTP->OTPSTR_b.CMD_RDY) ? OTP_SUCCESS : OTP_ERROR;
+}
+
+/******************************************************************************
+ * @brief Log and audit the result of a write, and return it.
+ ******************************************************************************/
+static otp_err_t otp_write_done(uint16_t otp_addr, uint16_t data, otp_err_t ret)
+{
+    LOG3(LOG_OTP_WRITE, otp_addr, data, ret);
+    otp_audit_record(otp_addr, data, (uint8_t)ret);
+    
+    return ret;
+}
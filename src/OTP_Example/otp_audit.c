@@ -0,0 +1,138 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include "otp_audit.h"
+#include "systime.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+#define OTP_AUDIT_MASK           (OTP_AUDIT_ENTRIES - 1U)
+
+#if ((OTP_AUDIT_ENTRIES & OTP_AUDIT_MASK) != 0U)
+#error "OTP_AUDIT_ENTRIES must be a power of two"
+#endif
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+/* One OTP write */
+typedef struct
+{
+    systime_t  stamp;
+    uint16_t   address;
+    uint16_t   value;
+    uint8_t    result;
+} otp_audit_entry_t;
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static otp_audit_entry_t s_g_audit_ring[OTP_AUDIT_ENTRIES];
+static uint32_t          s_g_audit_written = 0U;    // Entries recorded since reset (free running)
+
+/******************************************************************************
+ * @brief Record one OTP write.
+ *
+ * Every write goes through write_otp_data(), which calls this once the
+ * OTP has finished, with the result it returns: a few stores to RAM, and
+ * nothing is sent. The host fetches the entries when it asks for them
+ * (READ_AUDIT), so the writes themselves never wait for the audit.
+ *
+ * @param[in]  otp_addr       Write address
+ * @param[in]  data           Write data
+ * @param[in]  result         otp_err_t of the write
+ ******************************************************************************/
+void otp_audit_record(uint16_t otp_addr, uint16_t data, uint8_t result)
+{
+    otp_audit_entry_t *p_entry = &s_g_audit_ring[s_g_audit_written & OTP_AUDIT_MASK];
+    
+    p_entry->stamp   = systime_now();
+    p_entry->address = otp_addr;
+    p_entry->value   = data;
+    p_entry->result  = result;
+    s_g_audit_written++;
+}
+
+/******************************************************************************
+ * @brief Copy entries for the host, from a sequence number on.
+ *
+ * Entry n is the n-th write since reset. The ring keeps the last
+ * OTP_AUDIT_ENTRIES, and reading frees nothing, so a host that lost an
+ * answer simply asks again with the same cursor. When the entry at cursor
+ * is already overwritten, or the cursor lies beyond the last entry (the
+ * board was reset since), the copy starts at the oldest entry kept; the
+ * host tells both cases apart by *p_first.
+ *
+ * @param[in]  cursor         Sequence number of the first entry wanted
+ * @param[out] p_out          Destination (OTP_AUDIT_ENTRY_SIZE bytes per entry)
+ * @param[in]  max_entries    Entries p_out holds
+ * @param[out] p_first        Sequence number of the first entry copied
+ *
+ * @retval Entries copied
+ ******************************************************************************/
+uint32_t otp_audit_read(uint32_t cursor, uint8_t *p_out, uint32_t max_entries, uint32_t *p_first)
+{
+    uint32_t written = s_g_audit_written;
+    uint32_t oldest  = (OTP_AUDIT_ENTRIES < written) ? (written - OTP_AUDIT_ENTRIES) : 0U;
+    uint32_t count;
+    
+    if ((cursor < oldest) || (cursor > written))
+    {
+        cursor = oldest;
+    }
+    count = written - cursor;
+    if (count > max_entries)
+    {
+        count = max_entries;
+    }
+    
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        otp_audit_entry_t const *p_entry = &s_g_audit_ring[(cursor + i) & OTP_AUDIT_MASK];
+        uint8_t                 *p_dst   = &p_out[i * OTP_AUDIT_ENTRY_SIZE];
+        
+        p_dst[0] = (uint8_t)(p_entry->address >> 8);
+        p_dst[1] = (uint8_t)p_entry->address;
+        p_dst[2] = (uint8_t)(p_entry->value >> 8);
+        p_dst[3] = (uint8_t)p_entry->value;
+        p_dst[4] = p_entry->result;
+        for (uint32_t b = 0U; b < 8U; b++)
+        {
+            p_dst[5U + b] = (uint8_t)(p_entry->stamp >> (56U - (b * 8U)));
+        }
+    }
+    
+    *p_first = cursor;
+    
+    return count;
+}
+
+/******************************************************************************
+ * @brief OTP writes recorded since reset.
+ ******************************************************************************/
+uint32_t otp_audit_written(void)
+{
+    return s_g_audit_written;
+}
@@ -0,0 +1,420 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "hal_data.h"
+#include "otp.h"
+#include "otp_plan.h"
+#include "sha256.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* JTAG authentication mode and type, as cmd_otp_auth.c */
+#define JTAG_MODE_NO_AUTH         (0U)
+#define JTAG_MODE_AUTHLV1         (1U)
+#define JTAG_MODE_AUTHLV2         (2U)
+#define JTAG_MODE_PROHIBIT        (4U)
+#define TYPE_PLAIN                (0U)
+#define TYPE_HASH                 (1U)
+
+/* SCI/USB boot mode */
+#define SCIUSB_BOOT_MODE_ENABLE   (0U)
+#define SCIUSB_BOOT_MODE_DISABLE  (1U)
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static plan_err_t plan_words(otp_profile_t const *p_profile, otp_state_t const *p_state, otp_plan_t *p_plan);
+static plan_err_t plan_counter(otp_profile_t const *p_profile, otp_state_t const *p_state, otp_plan_t *p_plan);
+static plan_err_t plan_sciusb(otp_profile_t const *p_profile, otp_state_t const *p_state, otp_plan_t *p_plan);
+static plan_err_t plan_jauth(otp_profile_t const *p_profile, otp_state_t const *p_state, otp_plan_t *p_plan);
+static bool plan_write_once(uint16_t addr);
+static plan_step_t *plan_add(otp_plan_t *p_plan, uint8_t action);
+static uint32_t bit_count(uint16_t value);
+
+/******************************************************************************
+ * @brief Plan the OTP writes that take a board to a profile.
+ *
+ * The whole plan is made before anything is written, from the rules the
+ * commands enforce: OTP bits are only ever set, a write-once word (user
+ * area, boot mode areas) takes one value, SCI/USB boot can only be
+ * disabled, and the JTAG mode only goes up, with the type fixed once a mode
+ * is set. A value the board already has costs no write. The writes are
+ * ordered so that the ones that restrict the board most come last: the
+ * write-once words and the counter, then SCI/USB boot, then JTAG
+ * authentication. A failed step then leaves the board open to be fixed.
+ *
+ * @param[in]  p_profile      Target
+ * @param[in]  p_state        Current values
+ * @param[out] p_plan         Steps, or the conflict
+ *
+ * @retval PLAN_OK   The steps reach the profile
+ * @retval others    The profile cannot be reached; p_plan has no steps
+ ******************************************************************************/
+plan_err_t otp_plan_make (otp_profile_t const *p_profile, otp_state_t const *p_state, otp_plan_t *p_plan)
+{
+    plan_err_t err;
+    
+    memset(p_plan, 0, sizeof(*p_plan));
+    
+    err = plan_words(p_profile, p_state, p_plan);
+    
+    if (PLAN_OK == err)
+    {
+        err = plan_counter(p_profile, p_state, p_plan);
+    }
+    
+    if (PLAN_OK == err)
+    {
+        err = plan_sciusb(p_profile, p_state, p_plan);
+    }
+    
+    if (PLAN_OK == err)
+    {
+        err = plan_jauth(p_profile, p_state, p_plan);
+    }
+    
+    if (PLAN_OK != err)
+    {
+        p_plan->num_steps = 0U;
+    }
+    else
+    {
+        p_plan->err_addr = 0U;
+    }
+    p_plan->err = err;
+    
+    return err;
+}
+
+/******************************************************************************
+ * @brief JTAG mode from the raw mode word. The highest mode bit set counts.
+ ******************************************************************************/
+uint8_t otp_plan_jauth_mode (uint16_t mode_word)
+{
+    if (mode_word & JTAG_MODE_PROHIBIT)
+    {
+        return JTAG_MODE_PROHIBIT;
+    }
+    else if (mode_word & JTAG_MODE_AUTHLV2)
+    {
+        return JTAG_MODE_AUTHLV2;
+    }
+    else if (mode_word & JTAG_MODE_AUTHLV1)
+    {
+        return JTAG_MODE_AUTHLV1;
+    }
+    else
+    {
+        return JTAG_MODE_NO_AUTH;
+    }
+}
+
+/******************************************************************************
+ * @brief Address of a counter area word.
+ ******************************************************************************/
+uint16_t otp_plan_counter_addr (uint32_t index)
+{
+    return (uint16_t)(COUNTER_AREA_START_ADDR + index);
+}
+
+/******************************************************************************
+ * @brief Address and size of the ID area of a mode and type.
+ ******************************************************************************/
+bool otp_plan_id_area (uint8_t mode, uint8_t type, uint16_t *p_addr, uint32_t *p_size)
+{
+    switch (mode)
+    {
+        case JTAG_MODE_AUTHLV1:
+            *p_addr = (TYPE_HASH == type) ? JTAG_AUTH_ID1_HASH_ADDR : JTAG_AUTH_ID1_PLAIN_ADDR;
+            break;
+        case JTAG_MODE_AUTHLV2:
+            *p_addr = (TYPE_HASH == type) ? JTAG_AUTH_ID4_HASH_ADDR : JTAG_AUTH_ID4_PLAIN_ADDR;
+            break;
+        default:
+            return false;
+    }
+    *p_size = (TYPE_HASH == type) ? PLAN_ID_VALUE_SIZE : PLAN_ID_SIZE;
+    
+    return true;
+}
+
+/******************************************************************************
+ * @brief Write-once words: written only where they are still blank.
+ ******************************************************************************/
+static plan_err_t plan_words (otp_profile_t const *p_profile, otp_state_t const *p_state, otp_plan_t *p_plan)
+{
+    if (p_profile->num_words > PLAN_MAX_WORDS)
+    {
+        return PLAN_ERR_ADDRESS;
+    }
+    
+    for (uint32_t i = 0U; i < p_profile->num_words; i++)
+    {
+        plan_word_t const *p_word = &p_profile->words[i];
+        
+        p_plan->err_addr = p_word->addr;
+        
+        if (false == plan_write_once(p_word->addr))
+        {
+            return PLAN_ERR_ADDRESS;
+        }
+        
+        for (uint32_t j = 0U; j < i; j++)
+        {
+            if (p_profile->words[j].addr == p_word->addr)
+            {
+                return PLAN_ERR_DUPLICATE;
+            }
+        }
+        
+        if (p_state->words[i] == p_word->value)
+        {
+            continue;
+        }
+        
+        /* A written word is locked: cmd_write_otp() verifies the whole word. */
+        if (0U != p_state->words[i])
+        {
+            return PLAN_ERR_LOCKED;
+        }
+        
+        plan_step_t *p_step = plan_add(p_plan, PLAN_WRITE_OTP);
+        p_step->addr  = p_word->addr;
+        p_step->value = p_word->value;
+    }
+    
+    return PLAN_OK;
+}
+
+/******************************************************************************
+ * @brief Anti-rollback counter: the missing bits are set from the lowest
+ *        clear one up, so a counter kept as a run of ones stays one.
+ ******************************************************************************/
+static plan_err_t plan_counter (otp_profile_t const *p_profile, otp_state_t const *p_state, otp_plan_t *p_plan)
+{
+    uint32_t set = 0U;
+    
+    p_plan->err_addr = COUNTER_AREA_START_ADDR;
+    
+    if (p_profile->counter_min > PLAN_COUNTER_BITS)
+    {
+        return PLAN_ERR_COUNTER;
+    }
+    
+    for (uint32_t i = 0U; i < PLAN_COUNTER_WORDS; i++)
+    {
+        set += bit_count(p_state->counter[i]);
+    }
+    
+    for (uint32_t i = 0U; (i < PLAN_COUNTER_WORDS) && (set < p_profile->counter_min); i++)
+    {
+        uint16_t value = p_state->counter[i];
+        
+        for (uint32_t bit = 0U; (bit < 16U) && (set < p_profile->counter_min); bit++)
+        {
+            if (0U == (value & (1U << bit)))
+            {
+                value = (uint16_t)(value | (1U << bit));
+                set++;
+            }
+        }
+        
+        if (value != p_state->counter[i])
+        {
+            plan_step_t *p_step = plan_add(p_plan, PLAN_WRITE_OTP);
+            p_step->addr  = otp_plan_counter_addr(i);
+            p_step->value = value;
+        }
+    }
+    
+    return PLAN_OK;
+}
+
+/******************************************************************************
+ * @brief SCI/USB boot: can be disabled, never enabled again.
+ ******************************************************************************/
+static plan_err_t plan_sciusb (otp_profile_t const *p_profile, otp_state_t const *p_state, otp_plan_t *p_plan)
+{
+    p_plan->err_addr = SCI_USB_BOOT_ADDR;
+    
+    switch (p_profile->sciusb_mode)
+    {
+        case PLAN_KEEP:
+            return PLAN_OK;
+        case SCIUSB_BOOT_MODE_ENABLE:
+            return (SCIUSB_BOOT_MODE_ENABLE == p_state->sciusb_mode) ? PLAN_OK : PLAN_ERR_SCIUSB;
+        case SCIUSB_BOOT_MODE_DISABLE:
+            break;
+        default:
+            return PLAN_ERR_SCIUSB;
+    }
+    
+    if (SCIUSB_BOOT_MODE_DISABLE != p_state->sciusb_mode)
+    {
+        plan_add(p_plan, PLAN_SET_SCIUSB)->mode = SCIUSB_BOOT_MODE_DISABLE;
+    }
+    
+    return PLAN_OK;
+}
+
+/******************************************************************************
+ * @brief JTAG authentication, with the rules of cmd_setup_jtag_auth(): the
+ *        mode only goes up, and the type changes from plain to hash only
+ *        while no mode is set. The ID area is checked when the state has
+ *        it; otherwise the ID is verified when SETUP_JAUTH writes it, before
+ *        the mode. When the board already has the mode nothing is written,
+ *        so the area must then hold the ID exactly.
+ ******************************************************************************/
+static plan_err_t plan_jauth (otp_profile_t const *p_profile, otp_state_t const *p_state, otp_plan_t *p_plan)
+{
+    uint8_t  mode  = p_profile->jauth_mode;
+    uint8_t  type  = p_profile->jauth_type;
+    uint16_t addr  = 0U;
+    uint32_t size  = 0U;
+    uint8_t  value[PLAN_ID_VALUE_SIZE];
+    
+    p_plan->err_addr = JTAG_AUTH_MODE_ADDR;
+    
+    switch (mode)
+    {
+        case PLAN_KEEP:
+            return PLAN_OK;
+        case JTAG_MODE_NO_AUTH:
+        case JTAG_MODE_AUTHLV1:
+        case JTAG_MODE_AUTHLV2:
+        case JTAG_MODE_PROHIBIT:
+            break;
+        default:
+            return PLAN_ERR_MODE;
+    }
+    
+    if (mode < p_state->jauth_mode)
+    {
+        return PLAN_ERR_MODE;
+    }
+    
+    p_plan->err_addr = JTAG_AUTH_TYPE_ADDR;
+    
+    if ((TYPE_PLAIN != type) && (TYPE_HASH != type))
+    {
+        return PLAN_ERR_TYPE;
+    }
+    
+    if ((type != p_state->jauth_type) &&
+        ((TYPE_HASH != type) || (JTAG_MODE_NO_AUTH != p_state->jauth_mode) || (JTAG_MODE_NO_AUTH == mode)))
+    {
+        return PLAN_ERR_TYPE;
+    }
+    
+    /* The ID must fit over what the area holds: bits are only ever set. With
+     * the mode already set no step writes it, so it must be there already. */
+    if ((true == otp_plan_id_area(mode, type, &addr, &size)) && (true == p_state->id_known))
+    {
+        p_plan->err_addr = addr;
+        
+        if (TYPE_HASH == type)
+        {
+            sha256_calc(p_profile->jauth_id, PLAN_ID_SIZE, value);
+        }
+        else
+        {
+            memcpy(value, p_profile->jauth_id, PLAN_ID_SIZE);
+        }
+        
+        for (uint32_t i = 0U; i < size; i++)
+        {
+            if ((0U != (p_state->id[i] & (uint8_t)~value[i])) ||
+                ((mode == p_state->jauth_mode) && (p_state->id[i] != value[i])))
+            {
+                return PLAN_ERR_ID;
+            }
+        }
+    }
+    
+    if (mode != p_state->jauth_mode)
+    {
+        plan_step_t *p_step = plan_add(p_plan, (JTAG_MODE_PROHIBIT == mode) ? PLAN_SET_JAUTH : PLAN_SETUP_JAUTH);
+        p_step->mode = mode;
+        p_step->type = type;
+    }
+    
+    return PLAN_OK;
+}
+
+/******************************************************************************
+ * @brief Check whether a word is in a write-once area cmd_write_otp() writes.
+ ******************************************************************************/
+static bool plan_write_once (uint16_t addr)
+{
+    if ((USER_AREA_START_ADDR <= addr) && (addr <= USER_AREA_END_ADDR))
+    {
+        return true;
+    }
+#if defined(BSP_MCU_GROUP_RZN2L) || defined(BSP_MCU_GROUP_RZT2L)
+    if ((SHOSTIF_BOOT_AREA_START_ADDR <= addr) && (addr <= SHOSTIF_BOOT_AREA_END_ADDR))
+    {
+        return true;
+    }
+#endif
+#if defined(BSP_MCU_GROUP_RZN2L)
+    if ((PHOSTIF_BOOT_AREA_START_ADDR <= addr) && (addr <= PHOSTIF_BOOT_AREA_END_ADDR))
+    {
+        return true;
+    }
+#endif
+    
+    return false;
+}
+
+/******************************************************************************
+ * @brief Append a step. The steps of one profile never exceed PLAN_MAX_STEPS.
+ ******************************************************************************/
+static plan_step_t *plan_add (otp_plan_t *p_plan, uint8_t action)
+{
+    plan_step_t *p_step = &p_plan->steps[p_plan->num_steps++];
+    
+    memset(p_step, 0, sizeof(*p_step));
+    p_step->action = action;
+    
+    return p_step;
+}
+
+/******************************************************************************
+ * @brief Number of bits set.
+ ******************************************************************************/
+static uint32_t bit_count (uint16_t value)
+{
+    uint32_t count = 0U;
+    
+    while (0U != value)
+    {
+        value &= (uint16_t)(value - 1U);
+        count++;
+    }
+    
+    return count;
+}
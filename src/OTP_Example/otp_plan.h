@@ -0,0 +1,136 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+#ifndef __OTP_PLAN_H__
+#define __OTP_PLAN_H__
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Profile limits */
+#define PLAN_MAX_WORDS             (8U)                 // Write-once words in a profile
+#define PLAN_COUNTER_WORDS         (20U)                // Words of the anti-rollback counter area
+#define PLAN_COUNTER_BITS          (PLAN_COUNTER_WORDS * 16U)
+#define PLAN_ID_SIZE               (16U)                // JTAG authentication ID
+#define PLAN_ID_VALUE_SIZE         (32U)                // The ID, or its SHA-256 for the hash type
+#define PLAN_MAX_STEPS             (PLAN_MAX_WORDS + PLAN_COUNTER_WORDS + 2U)
+
+/* Profile field the board may have at any value */
+#define PLAN_KEEP                  (0xFFU)
+
+/* Step actions, each one command of device_setup.h */
+#define PLAN_WRITE_OTP             (0U)                 // WRITE_OTP addr value
+#define PLAN_SET_SCIUSB            (1U)                 // SET_SCIUSB mode
+#define PLAN_SET_JAUTH             (2U)                 // SET_JAUTH mode type (permanent prohibition)
+#define PLAN_SETUP_JAUTH           (3U)                 // SETUP_JAUTH mode type with the profile's ID
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+/* Why a profile cannot be reached on a board */
+typedef enum e_plan_err
+{
+    PLAN_OK = 0,
+    PLAN_ERR_ADDRESS,                   // Word outside the write-once areas
+    PLAN_ERR_DUPLICATE,                 // Word listed twice
+    PLAN_ERR_LOCKED,                    // Word already written with another value
+    PLAN_ERR_COUNTER,                   // More bits than the counter area holds
+    PLAN_ERR_SCIUSB,                    // SCI/USB boot already disabled, or bad mode
+    PLAN_ERR_MODE,                      // JTAG mode already higher, or bad mode
+    PLAN_ERR_TYPE,                      // JTAG type cannot change any more
+    PLAN_ERR_ID,                        // JTAG ID area holds bits the ID does not have,
+                                        // or another ID when the mode is already set
+    PLAN_ERR_READ,                      // Board state could not be read
+} plan_err_t;
+
+/* Write-once word */
+typedef struct
+{
+    uint16_t    addr;
+    uint16_t    value;
+} plan_word_t;
+
+/* What a board should look like when provisioned */
+typedef struct
+{
+    uint8_t     jauth_mode;                         // 0, 1, 2, 4 (prohibit) or PLAN_KEEP
+    uint8_t     jauth_type;                         // 0 plain, 1 hash
+    uint8_t     jauth_id[PLAN_ID_SIZE];             // For modes 1 and 2
+    uint8_t     sciusb_mode;                        // 0 enabled, 1 disabled or PLAN_KEEP
+    uint16_t    counter_min;                        // Anti-rollback counter bits that must be set
+    uint8_t     num_words;
+    plan_word_t words[PLAN_MAX_WORDS];              // User area and boot mode area words
+} otp_profile_t;
+
+/* What the board looks like now */
+typedef struct
+{
+    uint8_t     jauth_mode;                         // As cmd_get_jtag_auth() returns it
+    uint8_t     jauth_type;
+    bool        id_known;                           // id holds the ID area of the profile's mode
+    uint8_t     id[PLAN_ID_VALUE_SIZE];
+    uint8_t     sciusb_mode;
+    uint16_t    counter[PLAN_COUNTER_WORDS];
+    uint16_t    words[PLAN_MAX_WORDS];              // Current value of each profile word
+} otp_state_t;
+
+/* One write */
+typedef struct
+{
+    uint8_t     action;                             // PLAN_WRITE_OTP ...
+    uint8_t     mode;
+    uint8_t     type;
+    uint16_t    addr;
+    uint16_t    value;
+} plan_step_t;
+
+/* Writes that take a board from its state to a profile, in order */
+typedef struct
+{
+    plan_err_t  err;
+    uint16_t    err_addr;                           // OTP word of the conflict
+    uint32_t    num_steps;
+    plan_step_t steps[PLAN_MAX_STEPS];
+} otp_plan_t;
+
+/******************************************************************************
+ * Exported global functions (to be accessed by other files)
+ ******************************************************************************/
+/* Plan the writes for a profile. Returns PLAN_OK, or the first conflict with
+ * no steps: nothing of an impossible profile is written. */
+plan_err_t otp_plan_make(otp_profile_t const *p_profile, otp_state_t const *p_state, otp_plan_t *p_plan);
+
+/* JTAG mode as cmd_get_jtag_auth() reports it, from the raw mode word. */
+uint8_t otp_plan_jauth_mode(uint16_t mode_word);
+
+/* Address of the counter area word. */
+uint16_t otp_plan_counter_addr(uint32_t index);
+
+/* Where the ID of a mode and type is held, and its size. Returns false for
+ * a mode without an ID. */
+bool otp_plan_id_area(uint8_t mode, uint8_t type, uint16_t *p_addr, uint32_t *p_size);
+
+#endif /* __OTP_PLAN_H__ */
@@ -0,0 +1,390 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#if defined(_RENESAS_RZN_)
+#include "hal_data.h"
+#endif
+#include "sha256.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Length field at the end of the last block */
+#define SHA256_LENGTH_SIZE        (8U)
+
+/* HMAC pads */
+#define HMAC_IPAD                 (0x36U)
+#define HMAC_OPAD                 (0x5CU)
+
+/* Round functions (FIPS 180-4, 4.1.2). The rotations are free on the
+ * Cortex-R52 barrel shifter, so each sigma is three data processing
+ * instructions. */
+#define ROTR(x, n)                (((x) >> (n)) | ((x) << (32U - (n))))
+#define CH(x, y, z)               ((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x, y, z)              (((x) & (y)) | ((z) & ((x) | (y))))
+#define SIGMA0(x)                 (ROTR((x), 2U) ^ ROTR((x), 13U) ^ ROTR((x), 22U))
+#define SIGMA1(x)                 (ROTR((x), 6U) ^ ROTR((x), 11U) ^ ROTR((x), 25U))
+#define SMALL_SIGMA0(x)           (ROTR((x), 7U) ^ ROTR((x), 18U) ^ ((x) >> 3U))
+#define SMALL_SIGMA1(x)           (ROTR((x), 17U) ^ ROTR((x), 19U) ^ ((x) >> 10U))
+
+/* Message schedule, kept in a 16 word ring: W[t] for t >= 16 replaces
+ * W[t - 16] in place, so no 64 word array is needed. */
+#define SCHEDULE(w, t)            ((w)[(t) & 15U] += SMALL_SIGMA1((w)[((t) - 2U) & 15U]) + (w)[((t) - 7U) & 15U] + \
+                                   SMALL_SIGMA0((w)[((t) - 15U) & 15U]))
+
+/* One round. The working variables are not shifted; each round is written
+ * with its own rotation of a..h instead, so the rounds move no data. */
+#define ROUND(a, b, c, d, e, f, g, h, k, w)                             \
+    do                                                                  \
+    {                                                                   \
+        uint32_t t1 = (h) + SIGMA1(e) + CH((e), (f), (g)) + (k) + (w);  \
+        (d) += t1;                                                      \
+        (h)  = t1 + SIGMA0(a) + MAJ((a), (b), (c));                     \
+    } while (0)
+
+/* Eight rounds, one for each rotation of the working variables */
+#define ROUNDS_8(i, W0, W1, W2, W3, W4, W5, W6, W7)                                 \
+    do                                                                              \
+    {                                                                               \
+        ROUND(a, b, c, d, e, f, g, h, s_g_sha256_k[(i) + 0U], W0);                   \
+        ROUND(h, a, b, c, d, e, f, g, s_g_sha256_k[(i) + 1U], W1);                   \
+        ROUND(g, h, a, b, c, d, e, f, s_g_sha256_k[(i) + 2U], W2);                   \
+        ROUND(f, g, h, a, b, c, d, e, s_g_sha256_k[(i) + 3U], W3);                   \
+        ROUND(e, f, g, h, a, b, c, d, s_g_sha256_k[(i) + 4U], W4);                   \
+        ROUND(d, e, f, g, h, a, b, c, s_g_sha256_k[(i) + 5U], W5);                   \
+        ROUND(c, d, e, f, g, h, a, b, s_g_sha256_k[(i) + 6U], W6);                   \
+        ROUND(b, c, d, e, f, g, h, a, s_g_sha256_k[(i) + 7U], W7);                   \
+    } while (0)
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+/* Round constants (FIPS 180-4, 4.2.2) */
+static const uint32_t s_g_sha256_k[64] =
+{
+    0x428A2F98UL, 0x71374491UL, 0xB5C0FBCFUL, 0xE9B5DBA5UL, 0x3956C25BUL, 0x59F111F1UL, 0x923F82A4UL, 0xAB1C5ED5UL,
+    0xD807AA98UL, 0x12835B01UL, 0x243185BEUL, 0x550C7DC3UL, 0x72BE5D74UL, 0x80DEB1FEUL, 0x9BDC06A7UL, 0xC19BF174UL,
+    0xE49B69C1UL, 0xEFBE4786UL, 0x0FC19DC6UL, 0x240CA1CCUL, 0x2DE92C6FUL, 0x4A7484AAUL, 0x5CB0A9DCUL, 0x76F988DAUL,
+    0x983E5152UL, 0xA831C66DUL, 0xB00327C8UL, 0xBF597FC7UL, 0xC6E00BF3UL, 0xD5A79147UL, 0x06CA6351UL, 0x14292967UL,
+    0x27B70A85UL, 0x2E1B2138UL, 0x4D2C6DFCUL, 0x53380D13UL, 0x650A7354UL, 0x766A0ABBUL, 0x81C2C92EUL, 0x92722C85UL,
+    0xA2BFE8A1UL, 0xA81A664BUL, 0xC24B8B70UL, 0xC76C51A3UL, 0xD192E819UL, 0xD6990624UL, 0xF40E3585UL, 0x106AA070UL,
+    0x19A4C116UL, 0x1E376C08UL, 0x2748774CUL, 0x34B0BCB5UL, 0x391C0CB3UL, 0x4ED8AA4AUL, 0x5B9CCA4FUL, 0x682E6FF3UL,
+    0x748F82EEUL, 0x78A5636FUL, 0x84C87814UL, 0x8CC70208UL, 0x90BEFFFAUL, 0xA4506CEBUL, 0xBEF9A3F7UL, 0xC67178F2UL,
+};
+
+/* Initial hash value (FIPS 180-4, 5.3.3) */
+static const uint32_t s_g_sha256_h0[8] =
+{
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL, 0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL,
+};
+
+static uint32_t load_be32(uint8_t const *p_data);
+static void store_be32(uint8_t *p_data, uint32_t value);
+static void sha256_blocks(uint32_t *p_state, uint8_t const *p_data, uint32_t count);
+
+/******************************************************************************
+ * @brief Start a hash.
+ *
+ * @param[out] p_ctx          Hash state
+ ******************************************************************************/
+void sha256_init (sha256_ctx_t *p_ctx)
+{
+    memcpy(p_ctx->state, s_g_sha256_h0, sizeof(p_ctx->state));
+    p_ctx->length = 0U;
+    p_ctx->used   = 0U;
+}
+
+/******************************************************************************
+ * @brief Hash more data.
+ *
+ * Whole blocks are compressed straight from p_data; only a partial block at
+ * either end is copied into the state.
+ *
+ * @param[in,out] p_ctx       Hash state
+ * @param[in]  p_data         Data
+ * @param[in]  size           Data size in bytes
+ ******************************************************************************/
+void sha256_update (sha256_ctx_t *p_ctx, uint8_t const *p_data, uint32_t size)
+{
+    p_ctx->length += size;
+    
+    /* Complete a partial block first. */
+    if (0U != p_ctx->used)
+    {
+        uint32_t fill = SHA256_BLOCK_SIZE - p_ctx->used;
+        
+        if (size < fill)
+        {
+            memcpy(&p_ctx->block[p_ctx->used], p_data, size);
+            p_ctx->used += size;
+            return;
+        }
+        
+        memcpy(&p_ctx->block[p_ctx->used], p_data, fill);
+        sha256_blocks(p_ctx->state, p_ctx->block, 1U);
+        p_ctx->used = 0U;
+        p_data     += fill;
+        size       -= fill;
+    }
+    
+    if (size >= SHA256_BLOCK_SIZE)
+    {
+        sha256_blocks(p_ctx->state, p_data, size / SHA256_BLOCK_SIZE);
+        p_data += size & ~(SHA256_BLOCK_SIZE - 1U);
+        size   &= SHA256_BLOCK_SIZE - 1U;
+    }
+    
+    memcpy(p_ctx->block, p_data, size);
+    p_ctx->used = size;
+}
+
+/******************************************************************************
+ * @brief Finish a hash.
+ *
+ * Appends the padding (0x80, zeros, the bit length in big endian) and
+ * writes the digest. The state must be started again before reuse.
+ *
+ * @param[in,out] p_ctx       Hash state
+ * @param[out] p_digest       SHA256_DIGEST_SIZE bytes
+ ******************************************************************************/
+void sha256_final (sha256_ctx_t *p_ctx, uint8_t *p_digest)
+{
+    uint32_t used = p_ctx->used;
+    
+    p_ctx->block[used++] = 0x80U;
+    
+    /* No room for the length: pad out this block and use another. */
+    if (used > (SHA256_BLOCK_SIZE - SHA256_LENGTH_SIZE))
+    {
+        memset(&p_ctx->block[used], 0, SHA256_BLOCK_SIZE - used);
+        sha256_blocks(p_ctx->state, p_ctx->block, 1U);
+        used = 0U;
+    }
+    
+    memset(&p_ctx->block[used], 0, (SHA256_BLOCK_SIZE - SHA256_LENGTH_SIZE) - used);
+    store_be32(&p_ctx->block[SHA256_BLOCK_SIZE - 8U], p_ctx->length >> 29U);
+    store_be32(&p_ctx->block[SHA256_BLOCK_SIZE - 4U], p_ctx->length << 3U);
+    sha256_blocks(p_ctx->state, p_ctx->block, 1U);
+    
+    for (uint32_t i = 0U; i < 8U; i++)
+    {
+        store_be32(&p_digest[i * 4U], p_ctx->state[i]);
+    }
+}
+
+/******************************************************************************
+ * @brief Calculate the SHA-256 of one buffer.
+ *
+ * @param[in]  p_data         Data
+ * @param[in]  size           Data size in bytes
+ * @param[out] p_digest       SHA256_DIGEST_SIZE bytes
+ ******************************************************************************/
+void sha256_calc (uint8_t const *p_data, uint32_t size, uint8_t *p_digest)
+{
+    sha256_ctx_t ctx;
+    
+    sha256_init(&ctx);
+    sha256_update(&ctx, p_data, size);
+    sha256_final(&ctx, p_digest);
+}
+
+/******************************************************************************
+ * @brief Calculate HMAC-SHA256.
+ *
+ * The work area is on the stack and wiped before returning, so no key
+ * material stays there.
+ *
+ * @param[in]  p_key          Key
+ * @param[in]  key_size       Key size in bytes
+ * @param[in]  p_data         Message
+ * @param[in]  size           Message size in bytes
+ * @param[out] p_mac          SHA256_DIGEST_SIZE bytes
+ ******************************************************************************/
+void sha256_hmac (uint8_t const *p_key, uint32_t key_size, uint8_t const *p_data, uint32_t size,
+                  uint8_t *p_mac)
+{
+    sha256_hmac_work_t work;
+    
+    sha256_hmac_work(&work, p_key, key_size, p_data, size, p_mac);
+}
+
+/******************************************************************************
+ * @brief Calculate HMAC-SHA256 in a work area of the caller.
+ *
+ * On the board the work area is static, so the HMAC costs no more stack than
+ * a hash update. The padded key, the inner hash and the hash state are
+ * wiped before returning.
+ *
+ * @param[out] p_work         Work area
+ * @param[in]  p_key          Key
+ * @param[in]  key_size       Key size in bytes
+ * @param[in]  p_data         Message
+ * @param[in]  size           Message size in bytes
+ * @param[out] p_mac          SHA256_DIGEST_SIZE bytes
+ ******************************************************************************/
+void sha256_hmac_work (sha256_hmac_work_t *p_work, uint8_t const *p_key, uint32_t key_size,
+                       uint8_t const *p_data, uint32_t size, uint8_t *p_mac)
+{
+    /* Key, zero padded to a block. */
+    memset(p_work->pad, 0, sizeof(p_work->pad));
+    if (key_size > SHA256_BLOCK_SIZE)
+    {
+        sha256_init(&p_work->ctx);
+        sha256_update(&p_work->ctx, p_key, key_size);
+        sha256_final(&p_work->ctx, p_work->pad);
+    }
+    else
+    {
+        memcpy(p_work->pad, p_key, key_size);
+    }
+    
+    /* Inner hash: H((K ^ ipad) || message). */
+    for (uint32_t i = 0U; i < SHA256_BLOCK_SIZE; i++)
+    {
+        p_work->pad[i] ^= HMAC_IPAD;
+    }
+    sha256_init(&p_work->ctx);
+    sha256_update(&p_work->ctx, p_work->pad, SHA256_BLOCK_SIZE);
+    sha256_update(&p_work->ctx, p_data, size);
+    sha256_final(&p_work->ctx, p_work->inner);
+    
+    /* Outer hash: H((K ^ opad) || inner). */
+    for (uint32_t i = 0U; i < SHA256_BLOCK_SIZE; i++)
+    {
+        p_work->pad[i] ^= (uint8_t) (HMAC_IPAD ^ HMAC_OPAD);
+    }
+    sha256_init(&p_work->ctx);
+    sha256_update(&p_work->ctx, p_work->pad, SHA256_BLOCK_SIZE);
+    sha256_update(&p_work->ctx, p_work->inner, SHA256_DIGEST_SIZE);
+    sha256_final(&p_work->ctx, p_mac);
+    
+    sha256_wipe(p_work, sizeof(*p_work));
+}
+
+/******************************************************************************
+ * @brief Clear a buffer that held secret data.
+ *
+ * A memset() of a buffer that is not read again may be removed by the
+ * compiler; stores through a volatile pointer are not.
+ *
+ * @param[out] p_data         Buffer
+ * @param[in]  size           Size in bytes
+ ******************************************************************************/
+void sha256_wipe (void *p_data, uint32_t size)
+{
+    volatile uint8_t *p_byte = (volatile uint8_t *) p_data;
+    
+    while (0U != size)
+    {
+        *p_byte++ = 0U;
+        size--;
+    }
+}
+
+/******************************************************************************
+ * @brief Compress whole blocks into the chaining value.
+ *
+ * The 64 rounds run as four passes of 16, each pass fully unrolled: the
+ * first loads W[0..15], the others extend the schedule in the 16 word ring
+ * as they go. The working variables stay in registers and the ring index of
+ * every access is a constant, so a pass has no loads other than W and K.
+ *
+ * @param[in,out] p_state     Chaining value
+ * @param[in]  p_data         Blocks
+ * @param[in]  count          Number of blocks
+ ******************************************************************************/
+static void sha256_blocks (uint32_t *p_state, uint8_t const *p_data, uint32_t count)
+{
+    uint32_t w[16];
+    
+    while (0U != count)
+    {
+        uint32_t a = p_state[0];
+        uint32_t b = p_state[1];
+        uint32_t c = p_state[2];
+        uint32_t d = p_state[3];
+        uint32_t e = p_state[4];
+        uint32_t f = p_state[5];
+        uint32_t g = p_state[6];
+        uint32_t h = p_state[7];
+        
+        for (uint32_t t = 0U; t < 16U; t++)
+        {
+            w[t] = load_be32(&p_data[t * 4U]);
+        }
+        
+        ROUNDS_8(0U, w[0], w[1], w[2], w[3], w[4], w[5], w[6], w[7]);
+        ROUNDS_8(8U, w[8], w[9], w[10], w[11], w[12], w[13], w[14], w[15]);
+        
+        for (uint32_t i = 16U; i < 64U; i += 16U)
+        {
+            ROUNDS_8(i, SCHEDULE(w, 0U), SCHEDULE(w, 1U), SCHEDULE(w, 2U), SCHEDULE(w, 3U),
+                     SCHEDULE(w, 4U), SCHEDULE(w, 5U), SCHEDULE(w, 6U), SCHEDULE(w, 7U));
+            ROUNDS_8(i + 8U, SCHEDULE(w, 8U), SCHEDULE(w, 9U), SCHEDULE(w, 10U), SCHEDULE(w, 11U),
+                     SCHEDULE(w, 12U), SCHEDULE(w, 13U), SCHEDULE(w, 14U), SCHEDULE(w, 15U));
+        }
+        
+        p_state[0] += a;
+        p_state[1] += b;
+        p_state[2] += c;
+        p_state[3] += d;
+        p_state[4] += e;
+        p_state[5] += f;
+        p_state[6] += g;
+        p_state[7] += h;
+        
+        p_data += SHA256_BLOCK_SIZE;
+        count--;
+    }
+}
+
+/******************************************************************************
+ * @brief Load a big endian word from any alignment.
+ ******************************************************************************/
+static uint32_t load_be32 (uint8_t const *p_data)
+{
+#if defined(_RENESAS_RZN_)
+    uint32_t value;
+    
+    /* One unaligned LDR and a REV on the Cortex-R52. */
+    memcpy(&value, p_data, sizeof(value));
+    
+    return __REV(value);
+#else
+    return ((uint32_t) p_data[0] << 24U) | ((uint32_t) p_data[1] << 16U) |
+           ((uint32_t) p_data[2] << 8U) | (uint32_t) p_data[3];
+#endif
+}
+
+/******************************************************************************
+ * @brief Store a big endian word.
+ ******************************************************************************/
+static void store_be32 (uint8_t *p_data, uint32_t value)
+{
+    p_data[0] = (uint8_t) (value >> 24U);
+    p_data[1] = (uint8_t) (value >> 16U);
+    p_data[2] = (uint8_t) (value >> 8U);
+    p_data[3] = (uint8_t) value;
+}
@@ -0,0 +1,76 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+#ifndef __SHA256_H__
+#define __SHA256_H__
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Digest and block sizes in bytes */
+#define SHA256_DIGEST_SIZE         (32U)
+#define SHA256_BLOCK_SIZE          (64U)
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+/* Hash state. Lives wherever the caller puts it; nothing is allocated. */
+typedef struct
+{
+    uint32_t state[8];                      // Chaining value H0..H7
+    uint32_t length;                        // Bytes hashed so far
+    uint32_t used;                          // Bytes held in block
+    uint8_t  block[SHA256_BLOCK_SIZE];      // Partial block
+} sha256_ctx_t;
+
+/* HMAC work area: the hash state and the key material. Static on the board,
+ * where the stack is small; sha256_hmac() puts one on the stack. */
+typedef struct
+{
+    sha256_ctx_t ctx;
+    uint8_t      pad[SHA256_BLOCK_SIZE];    // Key ^ ipad, then key ^ opad
+    uint8_t      inner[SHA256_DIGEST_SIZE]; // Inner hash
+} sha256_hmac_work_t;
+
+/******************************************************************************
+ * Exported global functions (to be accessed by other files)
+ ******************************************************************************/
+/* SHA-256 (FIPS 180-4) of less than 4 GB. sha256_calc() hashes one buffer;
+ * init, update and final hash data that arrives in pieces. */
+void sha256_init(sha256_ctx_t *p_ctx);
+void sha256_update(sha256_ctx_t *p_ctx, uint8_t const *p_data, uint32_t size);
+void sha256_final(sha256_ctx_t *p_ctx, uint8_t *p_digest);
+void sha256_calc(uint8_t const *p_data, uint32_t size, uint8_t *p_digest);
+
+/* HMAC-SHA256 (RFC 2104). Keys longer than a block are hashed first.
+ * sha256_hmac_work() does it in the caller's work area and wipes it. */
+void sha256_hmac(uint8_t const *p_key, uint32_t key_size, uint8_t const *p_data, uint32_t size,
+                 uint8_t *p_mac);
+void sha256_hmac_work(sha256_hmac_work_t *p_work, uint8_t const *p_key, uint32_t key_size,
+                      uint8_t const *p_data, uint32_t size, uint8_t *p_mac);
+
+/* Clear a buffer that held secret data; the stores are not optimized out. */
+void sha256_wipe(void *p_data, uint32_t size);
+
+#endif /* __SHA256_H__ */
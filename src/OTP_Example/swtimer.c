@@ -0,0 +1,226 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stddef.h>
+#include "swtimer.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+#define SWTIMER_SLOT_MASK          (SWTIMER_SLOTS - 1UL)
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static swtimer_link_t s_g_swtimer_wheel[SWTIMER_LEVELS][SWTIMER_SLOTS];    // Slot list heads
+static uint32_t       s_g_swtimer_now;                                     // Last tick run
+
+static void swtimer_insert(swtimer_t *p_timer);
+static void swtimer_unlink(swtimer_link_t *p_link);
+static void swtimer_cascade(uint32_t level);
+
+/******************************************************************************
+ * @brief Initialize the wheel.
+ *
+ * The wheel keeps no clock of its own: the caller passes the tick count of
+ * its time base (event_now_ms() on the board) here and to
+ * swtimer_advance(), so every timer shares the one hardware timer behind it.
+ *
+ * @param[in]  now            Current tick
+ ******************************************************************************/
+void swtimer_open(uint32_t now)
+{
+    for (uint32_t level = 0U; level < SWTIMER_LEVELS; level++)
+    {
+        for (uint32_t slot = 0U; slot < SWTIMER_SLOTS; slot++)
+        {
+            s_g_swtimer_wheel[level][slot].p_next = &s_g_swtimer_wheel[level][slot];
+            s_g_swtimer_wheel[level][slot].p_prev = &s_g_swtimer_wheel[level][slot];
+        }
+    }
+    s_g_swtimer_now = now;
+}
+
+/******************************************************************************
+ * @brief Set up a timer, not started.
+ *
+ * @param[out] p_timer        Timer
+ * @param[in]  p_callback     Run when the timer expires
+ * @param[in]  p_context      Passed to p_callback
+ ******************************************************************************/
+void swtimer_init(swtimer_t *p_timer, swtimer_callback_t p_callback, void *p_context)
+{
+    p_timer->link.p_next = NULL;
+    p_timer->link.p_prev = NULL;
+    p_timer->expires     = 0U;
+    p_timer->period      = 0U;
+    p_timer->p_callback  = p_callback;
+    p_timer->p_context   = p_context;
+}
+
+/******************************************************************************
+ * @brief Start a timer, or start it again from now if it runs.
+ *
+ * O(1): the timer goes to the slot its delay falls in, on the finest level
+ * that reaches that far.
+ *
+ * @param[in]  p_timer        Timer set up by swtimer_init()
+ * @param[in]  delay          Ticks from now, at least 1
+ * @param[in]  period         Ticks between later runs, 0 for one shot
+ ******************************************************************************/
+void swtimer_start(swtimer_t *p_timer, uint32_t delay, uint32_t period)
+{
+    swtimer_cancel(p_timer);
+    
+    if (0U == delay)
+    {
+        delay = 1U;
+    }
+    if (SWTIMER_MAX_DELAY < delay)
+    {
+        delay = SWTIMER_MAX_DELAY;
+    }
+    p_timer->expires = s_g_swtimer_now + delay;
+    p_timer->period  = (SWTIMER_MAX_DELAY < period) ? SWTIMER_MAX_DELAY : period;
+    swtimer_insert(p_timer);
+}
+
+/******************************************************************************
+ * @brief Stop a timer. O(1); a timer not started is left as it is.
+ ******************************************************************************/
+void swtimer_cancel(swtimer_t *p_timer)
+{
+    if (NULL != p_timer->link.p_next)
+    {
+        swtimer_unlink(&p_timer->link);
+    }
+}
+
+/******************************************************************************
+ * @brief Check whether a timer is started.
+ ******************************************************************************/
+bool swtimer_active(swtimer_t const *p_timer)
+{
+    return (NULL != p_timer->link.p_next);
+}
+
+/******************************************************************************
+ * @brief Run the timers that expired up to now. Call it from the main loop.
+ *
+ * Goes through the ticks since the last call one by one. When the level 0
+ * wheel wraps, the next slot of level 1 is spread out over it, and so on
+ * up the levels, so each timer is moved at most once per level. The
+ * callbacks run here, not in an interrupt handler; they may start and
+ * cancel any timer, themselves included. A periodic timer is started again
+ * before its callback, from the tick it was due, so it does not drift.
+ *
+ * @param[in]  now            Current tick
+ ******************************************************************************/
+void swtimer_advance(uint32_t now)
+{
+    while (s_g_swtimer_now != now)
+    {
+        s_g_swtimer_now++;
+        
+        if (0U == (s_g_swtimer_now & SWTIMER_SLOT_MASK))
+        {
+            swtimer_cascade(1U);
+        }
+        
+        swtimer_link_t *p_head = &s_g_swtimer_wheel[0][s_g_swtimer_now & SWTIMER_SLOT_MASK];
+        
+        /* Take the timers one at a time: a callback may cancel the next one. */
+        while (p_head->p_next != p_head)
+        {
+            swtimer_t *p_timer = (swtimer_t *)p_head->p_next;
+            
+            swtimer_unlink(&p_timer->link);
+            if (0U != p_timer->period)
+            {
+                p_timer->expires += p_timer->period;
+                swtimer_insert(p_timer);
+            }
+            p_timer->p_callback(p_timer->p_context);
+        }
+    }
+}
+
+/******************************************************************************
+ * @brief Link a timer into the slot of its expiry tick.
+ ******************************************************************************/
+static void swtimer_insert(swtimer_t *p_timer)
+{
+    uint32_t        delta = p_timer->expires - s_g_swtimer_now;
+    uint32_t        level = 0U;
+    swtimer_link_t *p_head;
+    
+    /* delta is 0 only for a timer cascaded on its own tick: level 0 then,
+     * and that slot runs right after the cascade. */
+    while ((delta >> (SWTIMER_SLOT_BITS * (level + 1U))) != 0U)
+    {
+        level++;
+    }
+    
+    p_head = &s_g_swtimer_wheel[level][(p_timer->expires >> (SWTIMER_SLOT_BITS * level)) & SWTIMER_SLOT_MASK];
+    p_timer->link.p_next   = p_head;
+    p_timer->link.p_prev   = p_head->p_prev;
+    p_head->p_prev->p_next = &p_timer->link;
+    p_head->p_prev         = &p_timer->link;
+}
+
+/******************************************************************************
+ * @brief Unlink a slot list entry and mark the timer not started.
+ ******************************************************************************/
+static void swtimer_unlink(swtimer_link_t *p_link)
+{
+    p_link->p_prev->p_next = p_link->p_next;
+    p_link->p_next->p_prev = p_link->p_prev;
+    p_link->p_next         = NULL;
+    p_link->p_prev         = NULL;
+}
+
+/******************************************************************************
+ * @brief Spread the current slot of a level over the finer levels.
+ *
+ * The level above is cascaded first when this level wraps too, so its
+ * timers reach this slot before it is spread.
+ ******************************************************************************/
+static void swtimer_cascade(uint32_t level)
+{
+    uint32_t        slot = (s_g_swtimer_now >> (SWTIMER_SLOT_BITS * level)) & SWTIMER_SLOT_MASK;
+    swtimer_link_t *p_head;
+    
+    if ((0U == slot) && ((level + 1U) < SWTIMER_LEVELS))
+    {
+        swtimer_cascade(level + 1U);
+    }
+    
+    p_head = &s_g_swtimer_wheel[level][slot];
+    while (p_head->p_next != p_head)
+    {
+        swtimer_t *p_timer = (swtimer_t *)p_head->p_next;
+        
+        swtimer_unlink(&p_timer->link);
+        swtimer_insert(p_timer);
+    }
+}
@@ -0,0 +1,75 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+#ifndef __SWTIMER_H__
+#define __SWTIMER_H__
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Wheel shape: SWTIMER_LEVELS wheels of 2^SWTIMER_SLOT_BITS slots. A slot
+ * of level n spans 2^(SWTIMER_SLOT_BITS * n) ticks. */
+#define SWTIMER_SLOT_BITS          (6U)
+#define SWTIMER_SLOTS              (1UL << SWTIMER_SLOT_BITS)
+#define SWTIMER_LEVELS             (4U)
+
+/* Longest delay, 2^24 - 1 ticks (4.6 hours of 1 ms ticks). Longer ones are cut to it. */
+#define SWTIMER_MAX_DELAY          ((1UL << (SWTIMER_SLOT_BITS * SWTIMER_LEVELS)) - 1UL)
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+/* Called from swtimer_advance() when the timer expires */
+typedef void (*swtimer_callback_t)(void *p_context);
+
+/* Slot list link */
+typedef struct st_swtimer_link
+{
+    struct st_swtimer_link *p_next;
+    struct st_swtimer_link *p_prev;
+} swtimer_link_t;
+
+/* Timer. Owned by the caller, usually static: the wheel links it into a
+ * slot list and allocates nothing. */
+typedef struct
+{
+    swtimer_link_t     link;             // First: a slot list entry is the timer. p_next NULL when not started
+    uint32_t           expires;          // Tick it runs at
+    uint32_t           period;           // Ticks between runs, 0 for one shot
+    swtimer_callback_t p_callback;
+    void              *p_context;
+} swtimer_t;
+
+/******************************************************************************
+ * Exported global functions (to be accessed by other files)
+ ******************************************************************************/
+void swtimer_open(uint32_t now);
+void swtimer_init(swtimer_t *p_timer, swtimer_callback_t p_callback, void *p_context);
+void swtimer_start(swtimer_t *p_timer, uint32_t delay, uint32_t period);
+void swtimer_cancel(swtimer_t *p_timer);
+bool swtimer_active(swtimer_t const *p_timer);
+void swtimer_advance(uint32_t now);
+
+#endif /* __SWTIMER_H__ */
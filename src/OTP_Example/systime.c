@@ -0,0 +1,109 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include "systime.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+#if defined(_RENESAS_RZN_)
+/* CNTKCTL: the event stream sends an event on every 0 to 1 transition of
+ * count bit SYSTIME_EVENT_BIT, every 32 counts (1.28 us at 25 MHz) for
+ * bit 4. It bounds how late systime_wait_until() returns. */
+#define SYSTIME_EVENT_BIT        (4U)
+#define SYSTIME_CNTKCTL_EVNTEN   (1UL << 2)
+#define SYSTIME_CNTKCTL_EVNTI    (SYSTIME_EVENT_BIT << 4)
+#endif
+
+/******************************************************************************
+ * @brief Start the event stream that wakes systime_wait_until().
+ *
+ * The count itself runs from bsp_global_system_counter_init() on.
+ ******************************************************************************/
+void systime_open(void)
+{
+#if defined(_RENESAS_RZN_)
+    uint32_t cntkctl;
+    
+    __get_CP(15, 0, cntkctl, 14, 1, 0);
+    cntkctl &= ~(0xFUL << 4);
+    __set_CP(15, 0, cntkctl | SYSTIME_CNTKCTL_EVNTEN | SYSTIME_CNTKCTL_EVNTI, 14, 1, 0);
+    __ISB();
+#endif
+}
+
+/******************************************************************************
+ * @brief Wait for a deadline in WFE.
+ *
+ * The event stream wakes the core every few counts, so the wait ends within
+ * about a microsecond of the deadline whether or not an interrupt comes.
+ * For short waits, such as a hardware settling time.
+ *
+ * @param[in]  deadline       Absolute time (systime_now() counts)
+ ******************************************************************************/
+void systime_wait_until(systime_t deadline)
+{
+#if defined(_RENESAS_RZN_)
+    while (false == systime_expired(deadline))
+    {
+        __WFE();
+    }
+#else
+    systime_sleep_until(deadline);
+#endif
+}
+
+/******************************************************************************
+ * @brief Wait for a deadline in WFI.
+ *
+ * Only interrupts wake the core, so the wait ends at the first interrupt
+ * after the deadline: with the main loop tick (event.h) within
+ * EVENT_TICK_MS. For long waits, where that is close enough.
+ *
+ * @param[in]  deadline       Absolute time (systime_now() counts)
+ ******************************************************************************/
+void systime_sleep_until(systime_t deadline)
+{
+#if defined(_RENESAS_RZN_)
+    while (false == systime_expired(deadline))
+    {
+        __WFI();
+    }
+#else
+    while (false == systime_expired(deadline))
+    {
+        systime_t       left = deadline - systime_now();
+        struct timespec ts   = {(time_t)(left / SYSTIME_HZ), (long)((left % SYSTIME_HZ) * 1000U)};
+        (void)nanosleep(&ts, NULL);
+    }
+#endif
+}
+
+/******************************************************************************
+ * @brief Wait a number of microseconds, in WFE (R_BSP_SoftwareDelay()
+ *        without the loop count calibration).
+ ******************************************************************************/
+void systime_delay_us(uint32_t us)
+{
+    systime_wait_until(systime_deadline_us(us));
+}
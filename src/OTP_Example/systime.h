@@ -0,0 +1,95 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+#ifndef __SYSTIME_H__
+#define __SYSTIME_H__
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#if defined(_RENESAS_RZN_)
+#include "hal_data.h"
+#else
+#include <time.h>
+#endif
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Count rate: the generic timer on the board (CNTPCT, started by
+ * bsp_global_system_counter_init()), microseconds on the host */
+#if defined(_RENESAS_RZN_)
+#define SYSTIME_HZ               (BSP_GLOBAL_SYSTEM_COUNTER_CLOCK_HZ)
+#else
+#define SYSTIME_HZ               (1000000U)
+#endif
+
+/* Counts of a duration */
+#define SYSTIME_US(us)           (((uint64_t)(us) * SYSTIME_HZ) / 1000000U)
+#define SYSTIME_MS(ms)           (((uint64_t)(ms) * SYSTIME_HZ) / 1000U)
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+/* Absolute time in counts since reset. 64 bits do not wrap (23000 years at
+ * 25 MHz), so deadlines compare directly. */
+typedef uint64_t systime_t;
+
+/******************************************************************************
+ * Exported global functions (to be accessed by other files)
+ ******************************************************************************/
+void systime_open(void);
+void systime_wait_until(systime_t deadline);
+void systime_sleep_until(systime_t deadline);
+void systime_delay_us(uint32_t us);
+
+/******************************************************************************
+ * @brief Current time.
+ ******************************************************************************/
+static inline systime_t systime_now(void)
+{
+#if defined(_RENESAS_RZN_)
+    return __get_CNTPCT();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return ((systime_t)ts.tv_sec * 1000000U) + ((systime_t)ts.tv_nsec / 1000U);
+#endif
+}
+
+/******************************************************************************
+ * @brief Deadline a number of microseconds from now.
+ ******************************************************************************/
+static inline systime_t systime_deadline_us(uint32_t us)
+{
+    return systime_now() + SYSTIME_US(us);
+}
+
+/******************************************************************************
+ * @brief Check a deadline without waiting.
+ ******************************************************************************/
+static inline bool systime_expired(systime_t deadline)
+{
+    return (systime_now() >= deadline);
+}
+
+#endif /* __SYSTIME_H__ */
@@ -0,0 +1,61 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+#ifndef __TRANSPORT_H__
+#define __TRANSPORT_H__
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+/* Transport error code */
+typedef enum e_transport_err
+{
+    TRANSPORT_SUCCESS  = 0,
+    TRANSPORT_ERROR    = 1,
+    TRANSPORT_TIMEOUT  = 2,
+} transport_err_t;
+
+/* Byte stream to the host. Implemented by the SCI driver on the board
+ * (src/transport_sci.c) and by pipe, pty and loopback backends on Linux
+ * (tools/sim/transport_host.c). */
+typedef struct st_transport_api
+{
+    /* Queue bytes for sending. Waits only while earlier bytes still hold the send buffers. */
+    transport_err_t (* send)(void * const p_ctrl, uint8_t const * const p_data, uint32_t const size);
+    /* Copy up to size received bytes without waiting. Returns the number of bytes copied. */
+    uint32_t        (* receive)(void * const p_ctrl, uint8_t * const p_data, uint32_t const size);
+    /* Wait until bytes can be received, at most timeout_ms. TRANSPORT_TIMEOUT if none arrived. */
+    transport_err_t (* poll)(void * const p_ctrl, uint32_t const timeout_ms);
+    /* Wait until every queued byte has left. */
+    transport_err_t (* flush)(void * const p_ctrl);
+} transport_api_t;
+
+/* Transport instance */
+typedef struct st_transport_instance
+{
+    void                  * p_ctrl;     // Backend state
+    transport_api_t const * p_api;      // Backend functions
+} transport_instance_t;
+
+#endif /* __TRANSPORT_H__ */
@@ -0,0 +1,143 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include "hal_data.h"
+#include "event.h"
+#include "systime.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Generic timer counts per tick */
+#define EVENT_TICK_COUNTS       (SYSTIME_MS(EVENT_TICK_MS))
+/* Tick interrupt: EL1 physical timer (PPI, INTID 30) */
+#define EVENT_TICK_IRQ          (NonSecurePhysicalTimerInt)
+#define EVENT_TICK_IPL          (14U)
+/* CNTP_CTL.ENABLE */
+#define EVENT_CNTP_CTL_ENABLE   (1UL << 0)
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static volatile uint32_t s_g_event_pending = 0U;    // Posted and not taken yet
+static volatile uint32_t s_g_event_now_ms  = 0U;    // Ticks since event_open(), in milliseconds
+static systime_t         s_g_event_next    = 0U;    // Generic timer count of the next tick
+
+static void event_tick_isr(void);
+
+/* SGI and PPI handlers (system.c) */
+extern fsp_vector_t g_sgi_ppi_vector_table[BSP_CORTEX_VECTOR_TABLE_ENTRIES];
+
+/******************************************************************************
+ * @brief Start the tick.
+ *
+ * The tick comes from the compare of the EL1 physical timer against the
+ * generic timer count (CNTPCT, started by bsp_global_system_counter_init()),
+ * so it needs no peripheral timer and keeps the same time base as the log.
+ ******************************************************************************/
+void event_open(void)
+{
+    g_sgi_ppi_vector_table[(int32_t)EVENT_TICK_IRQ + (int32_t)BSP_VECTOR_NUM_OFFSET] = event_tick_isr;
+    
+    s_g_event_next = systime_now() + EVENT_TICK_COUNTS;
+    __set_CNTP_CVAL(s_g_event_next);
+    __set_CNTP_CTL(EVENT_CNTP_CTL_ENABLE);
+    __ISB();
+    
+    R_BSP_IrqCfgEnable(EVENT_TICK_IRQ, EVENT_TICK_IPL, NULL);
+}
+
+/******************************************************************************
+ * @brief Post events to the main loop.
+ *
+ * The bits are set with an exclusive access, so handlers of any priority
+ * and the main loop may post at the same time. Safe from interrupt handlers.
+ *
+ * @param[in]  events         EVENT_ bits
+ ******************************************************************************/
+void event_post(uint32_t events)
+{
+    uint32_t pending;
+    
+    do
+    {
+        pending = __LDREXW(&s_g_event_pending);
+    } while (0U != __STREXW(pending | events, &s_g_event_pending));
+}
+
+/******************************************************************************
+ * @brief Take the posted events, sleeping until there are some.
+ *
+ * The check and the WFI run with IRQs masked: an interrupt that arrives in
+ * between still ends the WFI, and is handled once IRQs are unmasked, so no
+ * event is slept through. Pass sleep false while there is work left over
+ * from the last events; the call then returns at once.
+ *
+ * @param[in]  sleep          Wait in WFI while no event is posted
+ *
+ * @retval EVENT_ bits posted since the last call (0 only if sleep is false)
+ ******************************************************************************/
+uint32_t event_wait(bool sleep)
+{
+    uint32_t events;
+    
+    while (1)
+    {
+        __disable_irq();
+        events = s_g_event_pending;
+        if ((0U != events) || (false == sleep))
+        {
+            s_g_event_pending = 0U;
+            __enable_irq();
+            break;
+        }
+        __DSB();
+        __WFI();
+        __enable_irq();
+    }
+    
+    return events;
+}
+
+/******************************************************************************
+ * @brief Milliseconds since event_open(), in whole ticks.
+ ******************************************************************************/
+uint32_t event_now_ms(void)
+{
+    return s_g_event_now_ms;
+}
+
+/******************************************************************************
+ * @brief Tick interrupt handler.
+ *
+ * The next compare value is one tick after the last one, not after now, so
+ * a late handler does not make the time drift.
+ ******************************************************************************/
+static void event_tick_isr(void)
+{
+    s_g_event_next += EVENT_TICK_COUNTS;
+    __set_CNTP_CVAL(s_g_event_next);
+    __ISB();
+    s_g_event_now_ms += EVENT_TICK_MS;
+    event_post(EVENT_TICK);
+}
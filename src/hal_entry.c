@@ -19,10 +19,17 @@
  **********************************************************************************************************************/
 
 #include "hal_data.h"
+#include "cmd_flash.h"
 #include "cmd_otp.h"
 #include "cmd_otp_auth.h"
 #include "common.h"
 #include "device_setup.h"
+#include "event.h"
+#include "log.h"
+#include "sha256.h"
+#include "swtimer.h"
+#include "systime.h"
+#include "transport_sci.h"
 
 void R_BSP_WarmStart(bsp_warm_start_event_t event) BSP_PLACE_IN_SECTION(".warm_start");
 
@@ -31,31 +38,39 @@ extern bsp_leds_t g_bsp_leds;
 /******************************************************************************
  * Macro definitions
  ******************************************************************************/
-/* Buffer address of send / received packets  */
-#define PACKET_BUFFER_ADDR      ((uint32_t)0x30000000UL)
-/* SCI setting value  */
-#define SCI_UART_BAUDRATE       (115200U)
-#define SCI_BUND_RATE_ERR       (5000U)
-
-/******************************************************************************
- * Private global variables and functions
- ******************************************************************************/
-static volatile uint32_t s_g_sci_send_packet_complete     = 0U;  // Send packet completion flag 
-static volatile uint32_t s_g_sci_receive_packet_complete  = 0U;  // Receive packet completion flag 
-static volatile uint32_t s_g_usb_receive_packet_complete  = 0U;  // Receive packet completion flag 
-
-static void sci_uart_set_baud(void);
-static void handle_module_error(fsp_err_t fsp_err);
+/* LED blink period */
+#define LED_TOGGLE_PERIOD_MS    (500U)
+/* xSPI0 CS0 flash, non-cacheable mirror */
+#define FLASH_MEMORY_ADDR       ((uint32_t)0x40000000UL)
+/* SHA-256 benchmark input size */
+#define SHA256_BENCH_SIZE       (4096U)
+/* PMU: PMCR.E enables the counters, PMCR.C resets the cycle counter; PMCNTENSET bit 31 is the cycle counter */
+#define PMU_PMCR_E              (1UL << 0)
+#define PMU_PMCR_C              (1UL << 2)
+#define PMU_PMCNTEN_CYCLE       (1UL << 31)
 
 uint8_t debug_control = 0;
 uint16_t debug_otp_addr, debug_otp_data;
 uint8_t jauth_mode, jauth_type, uuid[16];
 uint8_t jauth_id[16]={0x55,0x55,0x55,0x55,0x55,0x55,0x55,0x55,0xAA,0xAA,0xAA,0xAA,0xAA,0xAA,0xAA,0xAA};
+/* Master key for debug_control = 9, set it in the debugger. Not kept in the program image. */
+uint8_t jauth_key[32];
+/* SHA-256 benchmark result: core cycles for SHA256_BENCH_SIZE zero bytes, cycles per byte, and the digest */
+uint32_t debug_sha256_cycles, debug_sha256_cycles_per_byte;
+uint8_t debug_sha256_digest[SHA256_DIGEST_SIZE];
+static uint8_t sha256_bench_data[SHA256_BENCH_SIZE];
+static swtimer_t led_timer;
+
+static void sha256_benchmark(void);
+static void led_toggle(void *p_context);
 
 /*
 Step to set Jtag authentication password:
 1. set debug_control = 3, set mode = 1 type = 0, to add a password to Jtag
 2.  set debug_control = 5, and run   else if(debug_control == 5) to write the authentication password to jauth_id.
+Or set debug_control = 8 to do both steps at once (mode 1 or 2), writing the ID first and the mode last.
+Or set debug_control = 9 to do the same with an ID derived from the unique ID and jauth_key: HMAC-SHA256(jauth_key, UID), first 16 bytes (provision -k key -u uid prints it).
+For hash authentication use type = 1 in both steps; step 2 then writes the SHA-256 of jauth_id. Set the type before any mode has been set.
 And you can write mode = 8 to Permanent prohibition of JTAG connection(Please take care of this usage, if set, it will never recover)
 */
 
@@ -67,14 +82,9 @@ And you can write mode = 8 to Permanent prohibition of JTAG connection(Please ta
  **********************************************************************************************************************/
 void hal_entry (void)
 {
-    /* Define the units to be used with the software delay function */
-    const bsp_delay_units_t bsp_delay_units = BSP_DELAY_UNITS_MILLISECONDS;
-    /* Set the blink frequency (must be <= bsp_delay_units */
-    const uint32_t freq_in_hz = 2;
     uint8_t   return_code     = 0U;
-    /* Calculate the delay in terms of bsp_delay_units */
-    const uint32_t delay = bsp_delay_units / freq_in_hz;
-    fsp_err_t fsp_err;
+    uint32_t  events          = 0U;
+    bool      busy            = false;
     /* LED type structure */
     bsp_leds_t leds = g_bsp_leds;
     /* Turn off LEDs */
@@ -82,27 +92,35 @@ void hal_entry (void)
     {
         R_BSP_PinClear(BSP_IO_REGION_SAFE, (bsp_io_port_pin_t) leds.p_leds[i]);
     }
+    LOG0(LOG_BOOT);
     /* Initializes the module. */
-    fsp_err = R_SCI_UART_Open(&g_uart0_ctrl, &g_uart0_cfg);
-    handle_module_error(fsp_err);
-    sci_uart_set_baud();
+    transport_sci_open();
+    cmd_flash_open(&g_qspi0, (uint8_t *)FLASH_MEMORY_ADDR);
+    device_setup(&g_transport_sci);
+    systime_open();
+    event_open();
+    swtimer_open(event_now_ms());
+    swtimer_init(&led_timer, led_toggle, &leds);
+    swtimer_start(&led_timer, LED_TOGGLE_PERIOD_MS, LED_TOGGLE_PERIOD_MS);
     /* Enable interrupt. */
     __asm volatile ("cpsie i");
     
     while (1)
     {
-        /* Toggle board LEDs */
-        for (uint32_t i = 0; i < leds.led_count; i++)
+        /* Sleep in WFI until an interrupt posts an event: received bytes, a
+         * free transmit buffer or the tick. A queued command or flash work
+         * left over from the last pass runs on without waiting. */
+        events = event_wait(false == busy);
+        if (0U != (events & EVENT_TICK))
         {
-            R_BSP_PinToggle(BSP_IO_REGION_SAFE, (bsp_io_port_pin_t) leds.p_leds[i]);
-        }
-        /* Delay */
-        R_BSP_SoftwareDelay(delay, bsp_delay_units);
-        /* Check if SCI reception is complete. */
-        if (1U == s_g_sci_receive_packet_complete)
-        {
-            /* Execute command. add your own code here*/
+            transport_sci_tick();
+            /* Run the software timers due by now, the LED blink among them */
+            swtimer_advance(event_now_ms());
         }
+        /* Execute commands. Frames may span reads, the link reassembles them. */
+        device_setup_poll(event_now_ms());
+        busy = device_setup_busy();
+        /* debug_control is set from the debugger; the next tick picks it up. */
         if(debug_control == 1){
           debug_control = 0;
           return_code = cmd_write_otp(debug_otp_addr, debug_otp_data);   
@@ -128,6 +146,19 @@ void hal_entry (void)
           debug_control = 0;
           return_code = cmd_get_unique_id(uuid);//get uuid  
         }
+        else if(debug_control == 7){
+          debug_control = 0;
+          sha256_benchmark();//cycles per byte in debug_sha256_cycles_per_byte
+        }
+        else if(debug_control == 8){
+          debug_control = 0;
+          return_code = cmd_setup_jtag_auth(jauth_mode, jauth_type, jauth_id);//steps 1 and 2 in one OTP session
+        }
+        else if(debug_control == 9){
+          debug_control = 0;
+          return_code = cmd_derive_jtag_auth(jauth_mode, jauth_type, jauth_key, sizeof(jauth_key));//per-board ID
+          sha256_wipe(jauth_key, sizeof(jauth_key));
+        }
         else;
         
         if(return_code == 0)
@@ -135,58 +166,48 @@ void hal_entry (void)
     }
 }
 
-/******************************************************************************
- * @brief Module error handler.
+/*******************************************************************************************************************//**
+ * @brief  Time one SHA-256 of SHA256_BENCH_SIZE bytes with the PMU cycle counter.
  *
- * @param[in]  fsp_err        FSP module return code.
- ******************************************************************************/
-static void handle_module_error (fsp_err_t fsp_err)
+ * The data is hashed once before the timed run, so the code and the round constants are in the caches.
+ **********************************************************************************************************************/
+static void sha256_benchmark (void)
 {
-    /* If an error occurs in each module, the setup process is stopped. */
-    if (FSP_SUCCESS != fsp_err)
-    {
-        while (1);
-    }
-}
+    uint32_t pmcr;
+    uint32_t start;
+    uint32_t end;
 
+    __get_CP(15, 0, pmcr, 9, 12, 0);
+    __set_CP(15, 0, pmcr | PMU_PMCR_E | PMU_PMCR_C, 9, 12, 0);
+    __set_CP(15, 0, PMU_PMCNTEN_CYCLE, 9, 12, 1);
 
-/******************************************************************************
- * @brief Set the band for SCI communication.
- ******************************************************************************/
-static void sci_uart_set_baud (void)
-{
-    baud_setting_t baud_setting;
-    uint32_t       baud_rate                 = SCI_UART_BAUDRATE;
-    bool           enable_bitrate_modulation = false;
-    uint32_t       error_rate_x_1000         = SCI_BUND_RATE_ERR;
-    fsp_err_t      fsp_err;
-    
-    fsp_err = R_SCI_UART_BaudCalculate(baud_rate, enable_bitrate_modulation, error_rate_x_1000, &baud_setting);
-    handle_module_error(fsp_err);
-    fsp_err = R_SCI_UART_BaudSet(&g_uart0_ctrl, (void *)&baud_setting);
-    handle_module_error(fsp_err);
+    sha256_calc(sha256_bench_data, SHA256_BENCH_SIZE, debug_sha256_digest);
+
+    __ISB();
+    __get_CP(15, 0, start, 9, 13, 0);
+    sha256_calc(sha256_bench_data, SHA256_BENCH_SIZE, debug_sha256_digest);
+    __ISB();
+    __get_CP(15, 0, end, 9, 13, 0);
+
+    debug_sha256_cycles          = end - start;
+    debug_sha256_cycles_per_byte = debug_sha256_cycles / SHA256_BENCH_SIZE;
 }
 
-/******************************************************************************
- * @brief SCI UART module callback function.
+/*******************************************************************************************************************//**
+ * @brief  Toggle board LEDs. Periodic software timer callback.
  *
- * @param[in]  p_args         Callback information.
- ******************************************************************************/
-void sci_uart_callback (uart_callback_args_t *p_args)
-{    
-    /* Handle the UART event. */
-    switch (p_args->event)
+ * @param[in]  p_context  The bsp_leds_t of the board
+ **********************************************************************************************************************/
+static void led_toggle (void * p_context)
+{
+    bsp_leds_t const * p_leds = (bsp_leds_t const *) p_context;
+
+    for (uint32_t i = 0; i < p_leds->led_count; i++)
     {
-        /* Receive complete. */
-        case UART_EVENT_RX_COMPLETE:  
-            break;      
-        /* Transmit complete. */
-        case UART_EVENT_TX_COMPLETE:
-            break;
-        default:
-            break;
+        R_BSP_PinToggle(BSP_IO_REGION_SAFE, (bsp_io_port_pin_t) p_leds->p_leds[i]);
     }
 }
+
 /*******************************************************************************************************************//**
  * This function is called at various points during the startup process.  This implementation uses the event that is
  * called right before main() to set up the pins.
@@ -0,0 +1,461 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <string.h>
+#include "hal_data.h"
+#include "event.h"
+#include "frame.h"
+#include "log.h"
+#include "transport_sci.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Buffer address of received packets  */
+#define PACKET_BUFFER_ADDR      ((uint32_t)0x30000000UL)
+#define PACKET_BUFFER_SIZE      (0x00010000UL)
+/* Bytes received while no read is armed */
+#define RX_CHAR_BUFFER_SIZE     (256U)
+/* Size of one transmit buffer */
+#define TX_BUFFER_SIZE          (FRAME_MAX_SIZE)
+/* SCI setting value  */
+#define SCI_UART_BAUDRATE       (115200U)
+#define SCI_BUND_RATE_ERR       (5000U)
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static volatile uint32_t s_g_sci_send_packet_complete     = 1U;  // Send packet completion flag 
+static volatile uint32_t s_g_sci_send_line_idle           = 1U;  // Last byte has left the line
+static volatile uint32_t s_g_sci_receive_packet_complete  = 0U;  // Receive packet completion flag 
+static volatile uint32_t s_g_sci_receive_packet_size      = 0U;  // Received packet size
+static uint32_t          s_g_sci_receive_packet_offset    = 0U;  // Bytes of the packet already taken
+static uint32_t          s_g_sci_rx_isr_start             = 0U;  // RXI entry count at start of reception
+static uint32_t          s_g_sci_rx_last_remaining        = 0U;  // Remaining bytes at the previous step
+static uint8_t           s_g_sci_rx_char[RX_CHAR_BUFFER_SIZE];   // Bytes received while no read is armed
+static volatile uint32_t s_g_sci_rx_char_head             = 0U;  // Write index (callback)
+static uint32_t          s_g_sci_rx_char_tail             = 0U;  // Read index
+static uint32_t          s_g_sci_rx_char_armed            = 0U;  // Write index when the read was armed
+static uint32_t          s_g_sci_tx_index                 = 0U;  // Transmit buffer to fill next
+/* Transmit buffers, double buffered. Read by the DMAC, so not cached. */
+static uint8_t           s_g_sci_tx_buffer[2][TX_BUFFER_SIZE] BSP_PLACE_IN_SECTION(".noncache_buffer");
+
+static transport_err_t transport_sci_send(void * const p_ctrl, uint8_t const * const p_data, uint32_t const size);
+static uint32_t transport_sci_receive(void * const p_ctrl, uint8_t * const p_data, uint32_t const size);
+static transport_err_t transport_sci_poll(void * const p_ctrl, uint32_t const timeout_ms);
+static transport_err_t transport_sci_flush(void * const p_ctrl);
+static bool transport_sci_readable(void);
+static void transport_sci_sleep_until(volatile uint32_t const *p_flag);
+static void sci_uart_set_baud(void);
+static void sci_uart_receive_start(void);
+static void sci_uart_receive_timeout(void);
+static void handle_module_error(fsp_err_t fsp_err);
+
+uint32_t debug_rx_packet_size, debug_rx_isr_count;  // Size and RXI entries of the last received packet
+
+static transport_api_t const s_g_transport_sci_api =
+{
+    .send    = transport_sci_send,
+    .receive = transport_sci_receive,
+    .poll    = transport_sci_poll,
+    .flush   = transport_sci_flush,
+};
+
+/******************************************************************************
+ * Exported global variables
+ ******************************************************************************/
+transport_instance_t const g_transport_sci =
+{
+    .p_ctrl = &g_uart0_ctrl,
+    .p_api  = &s_g_transport_sci_api,
+};
+
+/******************************************************************************
+ * @brief Open SCI0 and start reception.
+ ******************************************************************************/
+void transport_sci_open (void)
+{
+    fsp_err_t fsp_err;
+    
+    /* Initializes the module. */
+    fsp_err = R_SCI_UART_Open(&g_uart0_ctrl, &g_uart0_cfg);
+    handle_module_error(fsp_err);
+    sci_uart_set_baud();
+    sci_uart_receive_start();
+}
+
+/******************************************************************************
+ * @brief Send bytes to the host.
+ *
+ * The bytes are copied to the free transmit buffer, then sent as soon as the
+ * previous write has handed its last byte to the SCI, so frames leave back
+ * to back.
+ *
+ * @param[in]  p_ctrl         Not used
+ * @param[in]  p_data         Bytes to send
+ * @param[in]  size           Number of bytes
+ *
+ * @retval TRANSPORT_SUCCESS  Bytes queued
+ * @retval TRANSPORT_ERROR    Write failure
+ ******************************************************************************/
+static transport_err_t transport_sci_send (void * const p_ctrl, uint8_t const * const p_data, uint32_t const size)
+{
+    uint32_t  offset = 0U;
+    fsp_err_t fsp_err;
+    
+    FSP_PARAMETER_NOT_USED(p_ctrl);
+    
+    while (offset < size)
+    {
+        uint8_t  *p_buf = s_g_sci_tx_buffer[s_g_sci_tx_index];
+        uint32_t chunk  = size - offset;
+        
+        if (TX_BUFFER_SIZE < chunk)
+        {
+            chunk = TX_BUFFER_SIZE;
+        }
+        memcpy(p_buf, p_data + offset, chunk);
+        
+        /* Wait for the previous write. */
+        transport_sci_sleep_until(&s_g_sci_send_packet_complete);
+        
+        s_g_sci_send_packet_complete = 0U;
+        s_g_sci_send_line_idle       = 0U;
+        fsp_err = R_SCI_UART_Write(&g_uart0_ctrl, p_buf, chunk);
+        if (FSP_SUCCESS != fsp_err)
+        {
+            s_g_sci_send_packet_complete = 1U;
+            s_g_sci_send_line_idle       = 1U;
+            return TRANSPORT_ERROR;
+        }
+        s_g_sci_tx_index ^= 1U;
+        offset           += chunk;
+    }
+    
+    return TRANSPORT_SUCCESS;
+}
+
+/******************************************************************************
+ * @brief Take received bytes, in the order they arrived on the line.
+ *
+ * Bytes that arrived while no read was armed come before the bytes of the
+ * read armed after them. A completed read is armed again once all of its
+ * bytes have been taken.
+ *
+ * @param[in]  p_ctrl         Not used
+ * @param[out] p_data         Destination
+ * @param[in]  size           Destination size
+ *
+ * @retval Number of bytes copied
+ ******************************************************************************/
+static uint32_t transport_sci_receive (void * const p_ctrl, uint8_t * const p_data, uint32_t const size)
+{
+    uint32_t count = 0U;
+    
+    FSP_PARAMETER_NOT_USED(p_ctrl);
+    
+    while (count < size)
+    {
+        if (s_g_sci_rx_char_tail != s_g_sci_rx_char_armed)
+        {
+            /* Received before the current read was armed. */
+            p_data[count++] = s_g_sci_rx_char[s_g_sci_rx_char_tail % RX_CHAR_BUFFER_SIZE];
+            s_g_sci_rx_char_tail++;
+        }
+        else if (1U == s_g_sci_receive_packet_complete)
+        {
+            uint32_t chunk = s_g_sci_receive_packet_size - s_g_sci_receive_packet_offset;
+            
+            if ((size - count) < chunk)
+            {
+                chunk = size - count;
+            }
+            memcpy(p_data + count, (uint8_t *)PACKET_BUFFER_ADDR + s_g_sci_receive_packet_offset, chunk);
+            count                         += chunk;
+            s_g_sci_receive_packet_offset += chunk;
+            
+            if (s_g_sci_receive_packet_offset == s_g_sci_receive_packet_size)
+            {
+                sci_uart_receive_start();
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+    
+    return count;
+}
+
+/******************************************************************************
+ * @brief Run the software receive timeout, once per tick (EVENT_TICK).
+ ******************************************************************************/
+void transport_sci_tick(void)
+{
+    sci_uart_receive_timeout();
+}
+
+/******************************************************************************
+ * @brief Wait for received bytes.
+ *
+ * Sleeps in WFI between interrupts and runs the software receive timeout
+ * once per tick. The main loop does not call it: it takes EVENT_SCI_RX and
+ * calls transport_sci_tick() instead.
+ *
+ * @param[in]  p_ctrl         Not used
+ * @param[in]  timeout_ms     Longest wait
+ *
+ * @retval TRANSPORT_SUCCESS  Bytes can be received
+ * @retval TRANSPORT_TIMEOUT  No bytes arrived
+ ******************************************************************************/
+static transport_err_t transport_sci_poll (void * const p_ctrl, uint32_t const timeout_ms)
+{
+    uint32_t start_ms = event_now_ms();
+    uint32_t last_ms  = start_ms;
+    
+    FSP_PARAMETER_NOT_USED(p_ctrl);
+    
+    while (false == transport_sci_readable())
+    {
+        if ((last_ms - start_ms) >= timeout_ms)
+        {
+            return TRANSPORT_TIMEOUT;
+        }
+        
+        /* Woken by the next received byte or tick at the latest. */
+        __WFI();
+        if (last_ms != event_now_ms())
+        {
+            last_ms = event_now_ms();
+            /* End a packet whose length is a multiple of the FIFO trigger: no receive timeout is raised for it. */
+            sci_uart_receive_timeout();
+        }
+    }
+    
+    return TRANSPORT_SUCCESS;
+}
+
+/******************************************************************************
+ * @brief Wait until the last queued byte has left the line.
+ *
+ * @param[in]  p_ctrl         Not used
+ *
+ * @retval TRANSPORT_SUCCESS  Transmission ended
+ ******************************************************************************/
+static transport_err_t transport_sci_flush (void * const p_ctrl)
+{
+    FSP_PARAMETER_NOT_USED(p_ctrl);
+    
+    transport_sci_sleep_until(&s_g_sci_send_line_idle);
+    
+    return TRANSPORT_SUCCESS;
+}
+
+/******************************************************************************
+ * @brief Check for bytes not taken yet.
+ ******************************************************************************/
+static bool transport_sci_readable (void)
+{
+    if (s_g_sci_rx_char_tail != s_g_sci_rx_char_head)
+    {
+        return true;
+    }
+    
+    return (1U == s_g_sci_receive_packet_complete) ? true : false;
+}
+
+/******************************************************************************
+ * @brief Sleep in WFI until a flag set by the SCI callback is 1.
+ *
+ * The flag is checked with IRQs masked, so the interrupt that sets it
+ * cannot slip in between the check and the WFI; it ends the WFI and runs
+ * once IRQs are unmasked.
+ ******************************************************************************/
+static void transport_sci_sleep_until(volatile uint32_t const *p_flag)
+{
+    while (1)
+    {
+        __disable_irq();
+        if (0U != *p_flag)
+        {
+            __enable_irq();
+            break;
+        }
+        __DSB();
+        __WFI();
+        __enable_irq();
+    }
+}
+
+/******************************************************************************
+ * @brief Module error handler.
+ *
+ * @param[in]  fsp_err        FSP module return code.
+ ******************************************************************************/
+static void handle_module_error (fsp_err_t fsp_err)
+{
+    /* If an error occurs in each module, the setup process is stopped. */
+    if (FSP_SUCCESS != fsp_err)
+    {
+        while (1);
+    }
+}
+
+/******************************************************************************
+ * @brief Set the band for SCI communication.
+ ******************************************************************************/
+static void sci_uart_set_baud (void)
+{
+    baud_setting_t baud_setting;
+    uint32_t       baud_rate                 = SCI_UART_BAUDRATE;
+    bool           enable_bitrate_modulation = false;
+    uint32_t       error_rate_x_1000         = SCI_BUND_RATE_ERR;
+    fsp_err_t      fsp_err;
+    
+    /* Standard rates come from the precomputed table; others fall back to the search. */
+    fsp_err = R_SCI_UART_BaudLookup(baud_rate, enable_bitrate_modulation, error_rate_x_1000, &baud_setting);
+    handle_module_error(fsp_err);
+    fsp_err = R_SCI_UART_BaudSet(&g_uart0_ctrl, (void *)&baud_setting);
+    handle_module_error(fsp_err);
+}
+
+/******************************************************************************
+ * @brief Start reception of a packet into the packet buffer.
+ *
+ * The read is sized for the whole buffer. Packets are variable length, so
+ * reception ends when the line goes idle (UART_EVENT_RX_IDLE) instead.
+ ******************************************************************************/
+static void sci_uart_receive_start (void)
+{
+    fsp_err_t fsp_err;
+
+    s_g_sci_receive_packet_complete = 0U;
+    s_g_sci_receive_packet_size     = 0U;
+    s_g_sci_receive_packet_offset   = 0U;
+    s_g_sci_rx_isr_start            = g_uart0_ctrl.rxi_count;
+    s_g_sci_rx_last_remaining       = PACKET_BUFFER_SIZE;
+
+    fsp_err = R_SCI_UART_Read(&g_uart0_ctrl, (uint8_t *)PACKET_BUFFER_ADDR, PACKET_BUFFER_SIZE);
+    handle_module_error(fsp_err);
+
+    /* Bytes received from here on land in the packet buffer. */
+    s_g_sci_rx_char_armed = s_g_sci_rx_char_head;
+}
+
+/******************************************************************************
+ * @brief Software receive timeout.
+ *
+ * The FIFO receive timeout only fires while data is waiting below the
+ * trigger level. If a frame ends exactly on a trigger boundary the FIFO is
+ * empty when the line goes idle, so the frame is ended here once no data has
+ * arrived for a whole tick (EVENT_TICK_MS).
+ ******************************************************************************/
+static void sci_uart_receive_timeout (void)
+{
+    uint32_t remaining;
+
+    if (1U == s_g_sci_receive_packet_complete)
+    {
+        return;
+    }
+
+    remaining = *(volatile uint32_t *)&g_uart0_ctrl.rx_dest_bytes;
+    if ((PACKET_BUFFER_SIZE != remaining) && (s_g_sci_rx_last_remaining == remaining))
+    {
+        R_BSP_IrqDisable(g_uart0_cfg.rxi_irq);
+        if (0U == s_g_sci_receive_packet_complete)
+        {
+            (void)R_SCI_UART_ReadStop(&g_uart0_ctrl, &remaining);
+            s_g_sci_receive_packet_size     = PACKET_BUFFER_SIZE - remaining;
+            s_g_sci_receive_packet_complete = 1U;
+            debug_rx_packet_size = s_g_sci_receive_packet_size;
+            debug_rx_isr_count   = g_uart0_ctrl.rxi_count - s_g_sci_rx_isr_start;
+            LOG2(LOG_SCI_RX_PACKET, debug_rx_packet_size, debug_rx_isr_count);
+            event_post(EVENT_SCI_RX);
+        }
+        R_BSP_IrqEnable(g_uart0_cfg.rxi_irq);
+    }
+    s_g_sci_rx_last_remaining = remaining;
+}
+
+/******************************************************************************
+ * @brief SCI UART module callback function.
+ *
+ * @param[in]  p_args         Callback information.
+ ******************************************************************************/
+void sci_uart_callback (uart_callback_args_t *p_args)
+{    
+    /* Handle the UART event. */
+    switch (p_args->event)
+    {
+        /* Receive complete: the packet filled the whole buffer. */
+        case UART_EVENT_RX_COMPLETE:  
+            s_g_sci_receive_packet_size     = PACKET_BUFFER_SIZE;
+            s_g_sci_receive_packet_complete = 1U;
+            debug_rx_packet_size = s_g_sci_receive_packet_size;
+            debug_rx_isr_count   = g_uart0_ctrl.rxi_count - s_g_sci_rx_isr_start;
+            LOG2(LOG_SCI_RX_PACKET, debug_rx_packet_size, debug_rx_isr_count);
+            event_post(EVENT_SCI_RX);
+            break;      
+        /* Receive timeout: the line went idle, end the packet here. */
+        case UART_EVENT_RX_IDLE:
+        {
+            uint32_t remaining = 0U;
+            (void)R_SCI_UART_ReadStop(&g_uart0_ctrl, &remaining);
+            s_g_sci_receive_packet_size     = PACKET_BUFFER_SIZE - remaining;
+            s_g_sci_receive_packet_complete = 1U;
+            debug_rx_packet_size = s_g_sci_receive_packet_size;
+            debug_rx_isr_count   = g_uart0_ctrl.rxi_count - s_g_sci_rx_isr_start;
+            LOG2(LOG_SCI_RX_PACKET, debug_rx_packet_size, debug_rx_isr_count);
+            event_post(EVENT_SCI_RX);
+            break;
+        }
+        /* Received while no read is armed: keep the byte for transport_sci_receive(). */
+        case UART_EVENT_RX_CHAR:
+            s_g_sci_rx_char[s_g_sci_rx_char_head % RX_CHAR_BUFFER_SIZE] = (uint8_t)p_args->data;
+            s_g_sci_rx_char_head++;
+            event_post(EVENT_SCI_RX);
+            break;
+        /* Last byte handed to the SCI: the next write may start. */
+        case UART_EVENT_TX_DATA_EMPTY:
+            s_g_sci_send_packet_complete = 1U;
+            event_post(EVENT_SCI_TX);
+            break;
+        /* Transmit complete. */
+        case UART_EVENT_TX_COMPLETE:
+            s_g_sci_send_packet_complete = 1U;
+            s_g_sci_send_line_idle       = 1U;
+            event_post(EVENT_SCI_TX);
+            break;
+        /* Line errors: kept in the log for the host (READ_LOG). */
+        case UART_EVENT_ERR_PARITY:
+        case UART_EVENT_ERR_FRAMING:
+        case UART_EVENT_ERR_OVERFLOW:
+        case UART_EVENT_BREAK_DETECT:
+            LOG1(LOG_SCI_RX_ERROR, p_args->event);
+            break;
+        default:
+            break;
+    }
+}
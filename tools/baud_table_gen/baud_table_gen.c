@@ -0,0 +1,469 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Host tool: generates rzn_gen/sci_uart_baud_table.c, the precomputed
+ * baud setting table used by R_SCI_UART_BaudLookup().
+ *
+ * The search below is a line-for-line copy of R_SCI_UART_BaudCalculate() so
+ * that a table hit returns exactly what the runtime search would have
+ * returned. Keep the two in sync when the driver is updated.
+ *
+ * Usage:
+ *   baud_table_gen [-c clock_hz] [-o file]   Emit the table (default stdout)
+ *   baud_table_gen -b [-n iterations]        Benchmark search vs. table
+ ******************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+#define NUM_DIVISORS_ASYNC      (13U)
+#define MDDR_MIN                (128U)
+#define MDDR_MAX                (256U)
+#define BRR_MAX                 (255U)
+#define CLOCK_96MHZ             (96000000U)
+#define PERCENT_100_X_1000      (100000)
+#define MDDR_DIVISOR            (256)
+
+/* Number of search passes (select_16_base_clk_cycles = 0 and 1) */
+#define NUM_PASSES              (2U)
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+typedef struct
+{
+    uint8_t bgdm;
+    uint8_t abcs;
+    uint8_t abcse;
+    uint8_t cks;
+} divisor_t;
+
+/* Host mirror of baud_setting_t.baudrate_bits_b */
+typedef struct
+{
+    uint8_t  bgdm;
+    uint8_t  abcs;
+    uint8_t  abcse;
+    uint8_t  brr;
+    uint8_t  brme;
+    uint8_t  cks;
+    uint8_t  mddr;
+} setting_t;
+
+typedef struct
+{
+    setting_t setting;
+    int32_t   error_x_1000;
+} result_t;
+
+/******************************************************************************
+ * Private global variables
+ ******************************************************************************/
+static const divisor_t s_async_baud[NUM_DIVISORS_ASYNC] =
+{
+    {0U, 0U, 1U, 0U},                  /* BGDM, ABCS, ABCSE, n */
+    {1U, 1U, 0U, 0U},
+    {1U, 0U, 0U, 0U},
+    {0U, 0U, 1U, 1U},
+    {0U, 0U, 0U, 0U},
+    {1U, 0U, 0U, 1U},
+    {0U, 0U, 1U, 2U},
+    {0U, 0U, 0U, 1U},
+    {1U, 0U, 0U, 2U},
+    {0U, 0U, 1U, 3U},
+    {0U, 0U, 0U, 2U},
+    {1U, 0U, 0U, 3U},
+    {0U, 0U, 0U, 3U}
+};
+
+static const uint16_t s_div_coefficient[NUM_DIVISORS_ASYNC] =
+{
+    6U, 8U, 16U, 24U, 32U, 64U, 96U, 128U, 256U, 384U, 512U, 1024U, 2048U,
+};
+
+/* Standard rates. Keep sorted ascending: the lookup is a binary search. */
+static const uint32_t s_std_rates[] =
+{
+    1200U, 2400U, 4800U, 9600U, 14400U, 19200U, 28800U, 38400U, 57600U, 76800U, 115200U, 128000U, 153600U,
+    230400U, 250000U, 256000U, 460800U, 500000U, 576000U, 921600U, 1000000U, 1152000U, 1500000U, 2000000U,
+    2500000U, 3000000U, 4000000U, 6000000U, 8000000U, 12000000U,
+};
+
+#define NUM_STD_RATES    (sizeof(s_std_rates) / sizeof(s_std_rates[0]))
+
+/******************************************************************************
+ * @brief Copy of the R_SCI_UART_BaudCalculate() search, limited to passes
+ *        [0, last_pass]. Running with last_pass = 0 gives the result the
+ *        driver returns when pass 0 already meets the error limit; running
+ *        with last_pass = 1 gives the result when it does not.
+ ******************************************************************************/
+static void baud_search (uint32_t freq_hz, uint32_t baudrate, bool bitrate_modulation, uint32_t last_pass,
+                         result_t * p_result)
+{
+    setting_t * p_set = &p_result->setting;
+
+    memset(p_set, 0, sizeof(*p_set));
+    p_set->brr  = BRR_MAX;
+    p_set->brme = 0U;
+    p_set->mddr = MDDR_MIN;
+
+    int32_t  hit_bit_err = PERCENT_100_X_1000;
+    uint32_t hit_mddr    = 0U;
+    uint32_t divisor     = 0U;
+
+    for (uint32_t select_16_base_clk_cycles = 0U; select_16_base_clk_cycles <= last_pass; select_16_base_clk_cycles++)
+    {
+        for (uint32_t i = 0U; i < NUM_DIVISORS_ASYNC; i++)
+        {
+            if (((uint8_t) select_16_base_clk_cycles) ^ (s_async_baud[i].abcs | s_async_baud[i].abcse))
+            {
+                continue;
+            }
+
+            divisor = (uint32_t) s_div_coefficient[i] * baudrate;
+            uint32_t temp_brr = freq_hz / divisor;
+
+            if (temp_brr <= (BRR_MAX + 1U))
+            {
+                while (temp_brr > 0U)
+                {
+                    temp_brr -= 1U;
+
+                    int32_t err_divisor = (int32_t) (divisor * (temp_brr + 1U));
+                    int32_t bit_err     = (int32_t) (((((int64_t) freq_hz) * PERCENT_100_X_1000) / err_divisor) -
+                                                     PERCENT_100_X_1000);
+
+                    uint32_t mddr = 0U;
+                    if (bitrate_modulation)
+                    {
+                        mddr = (uint32_t) err_divisor / (freq_hz / MDDR_MAX);
+                        if (mddr < MDDR_MIN)
+                        {
+                            break;
+                        }
+
+                        bit_err = (((bit_err + PERCENT_100_X_1000) * (int32_t) mddr) / MDDR_DIVISOR) -
+                                  PERCENT_100_X_1000;
+                    }
+
+                    if (bit_err < 0)
+                    {
+                        bit_err = -bit_err;
+                    }
+
+                    if (bit_err < hit_bit_err)
+                    {
+                        p_set->bgdm  = s_async_baud[i].bgdm;
+                        p_set->abcs  = s_async_baud[i].abcs;
+                        p_set->abcse = s_async_baud[i].abcse;
+                        p_set->cks   = s_async_baud[i].cks;
+                        p_set->brr   = (uint8_t) temp_brr;
+                        hit_bit_err  = bit_err;
+                        hit_mddr     = mddr;
+                    }
+
+                    if (bitrate_modulation)
+                    {
+                        p_set->brme = 1U;
+                        p_set->mddr = (uint8_t) hit_mddr; /* 256 truncates to 0, as in the driver */
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    p_result->error_x_1000 = hit_bit_err;
+}
+
+/******************************************************************************
+ * @brief Runtime-equivalent search: pass 1 only runs if pass 0 misses the
+ *        requested error. Used as the "before" case of the benchmark.
+ ******************************************************************************/
+static int baud_calculate (uint32_t freq_hz, uint32_t baudrate, bool bitrate_modulation, uint32_t err_x_1000,
+                           result_t * p_result)
+{
+    baud_search(freq_hz, baudrate, bitrate_modulation, 0U, p_result);
+    if (p_result->error_x_1000 > (int32_t) err_x_1000)
+    {
+        baud_search(freq_hz, baudrate, bitrate_modulation, 1U, p_result);
+    }
+
+    return (p_result->error_x_1000 <= (int32_t) err_x_1000) ? 0 : -1;
+}
+
+/******************************************************************************
+ * @brief Emit one table setting as a designated initializer.
+ ******************************************************************************/
+static void emit_setting (FILE * fp, result_t const * p_r, char const * p_comment)
+{
+    fprintf(fp,
+            "                {.setting = {.baudrate_bits_b = {.bgdm = %uU, .abcs = %uU, .abcse = %uU, .brr = %3uU, "
+            ".brme = %uU, .cks = %uU, .mddr = %3uU}}, .error_x_1000 = %6d}, /* %s */\n",
+            p_r->setting.bgdm, p_r->setting.abcs, p_r->setting.abcse, p_r->setting.brr, p_r->setting.brme,
+            p_r->setting.cks, p_r->setting.mddr, (int) p_r->error_x_1000, p_comment);
+}
+
+/******************************************************************************
+ * @brief Emit rzn_gen/sci_uart_baud_table.c.
+ ******************************************************************************/
+static void emit_table (FILE * fp, uint32_t freq_hz)
+{
+    fprintf(fp, "/* generated baud setting table source file - do not edit */\n");
+    fprintf(fp, "/* regenerate with tools/baud_table_gen/baud_table_gen -c %u -o rzn_gen/sci_uart_baud_table.c */\n",
+            (unsigned) freq_hz);
+    fprintf(fp, "#include \"r_sci_uart.h\"\n");
+    fprintf(fp, "#if SCI_UART_CFG_BAUD_TABLE_ENABLE\n");
+    fprintf(fp, "static const sci_uart_baud_table_entry_t g_sci_uart_baud_table_entries[%u] =\n{\n",
+            (unsigned) NUM_STD_RATES);
+
+    for (uint32_t r = 0U; r < NUM_STD_RATES; r++)
+    {
+        fprintf(fp, "    {\n        .baudrate = %uU,\n        .setting  =\n        {\n", (unsigned) s_std_rates[r]);
+        for (uint32_t mod = 0U; mod < 2U; mod++)
+        {
+            fprintf(fp, "            {                  /* bitrate_modulation = %s */\n", mod ? "true" : "false");
+            for (uint32_t pass = 0U; pass < NUM_PASSES; pass++)
+            {
+                result_t result;
+                baud_search(freq_hz, s_std_rates[r], (bool) mod, pass, &result);
+                emit_setting(fp, &result, pass ? "passes 0-1" : "pass 0");
+            }
+
+            fprintf(fp, "            },\n");
+        }
+
+        fprintf(fp, "        },\n    },\n");
+    }
+
+    fprintf(fp, "};\n\n");
+    fprintf(fp, "const sci_uart_baud_table_t g_sci_uart_baud_table =\n{\n");
+    fprintf(fp, "    .clock_hz    = %uU,\n", (unsigned) freq_hz);
+    fprintf(fp, "    .num_entries = %uU,\n", (unsigned) NUM_STD_RATES);
+    fprintf(fp, "    .p_entries   = g_sci_uart_baud_table_entries,\n");
+    fprintf(fp, "};\n");
+    fprintf(fp, "#endif\n");
+}
+
+/******************************************************************************
+ * @brief Table lookup equivalent to R_SCI_UART_BaudLookup() (hit path only).
+ ******************************************************************************/
+static result_t s_table[NUM_STD_RATES][2][NUM_PASSES];
+
+static int baud_lookup (uint32_t baudrate, bool bitrate_modulation, uint32_t err_x_1000, result_t * p_result)
+{
+    uint32_t lo = 0U;
+    uint32_t hi = NUM_STD_RATES;
+
+    while (lo < hi)
+    {
+        uint32_t mid = (lo + hi) / 2U;
+        if (s_std_rates[mid] < baudrate)
+        {
+            lo = mid + 1U;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    if ((lo == NUM_STD_RATES) || (s_std_rates[lo] != baudrate))
+    {
+        return -2;
+    }
+
+    result_t const * p_hit = &s_table[lo][bitrate_modulation][0];
+    if (p_hit->error_x_1000 > (int32_t) err_x_1000)
+    {
+        p_hit++;
+    }
+
+    *p_result = *p_hit;
+
+    return (p_hit->error_x_1000 <= (int32_t) err_x_1000) ? 0 : -1;
+}
+
+static double now_ns (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((double) ts.tv_sec * 1e9) + (double) ts.tv_nsec;
+}
+
+/******************************************************************************
+ * @brief Benchmark the runtime search against the table and verify that both
+ *        agree for every standard rate, mode and a range of error limits.
+ ******************************************************************************/
+static int run_benchmark (uint32_t freq_hz, uint32_t iterations)
+{
+    static const uint32_t errs[] = {0U, 500U, 1000U, 2000U, 5000U, 10000U};
+    volatile int32_t      sink   = 0;
+    uint32_t              mismatches = 0U;
+
+    for (uint32_t r = 0U; r < NUM_STD_RATES; r++)
+    {
+        for (uint32_t mod = 0U; mod < 2U; mod++)
+        {
+            for (uint32_t pass = 0U; pass < NUM_PASSES; pass++)
+            {
+                baud_search(freq_hz, s_std_rates[r], (bool) mod, pass, &s_table[r][mod][pass]);
+            }
+        }
+    }
+
+    for (uint32_t r = 0U; r < NUM_STD_RATES; r++)
+    {
+        for (uint32_t mod = 0U; mod < 2U; mod++)
+        {
+            for (uint32_t e = 0U; e < (sizeof(errs) / sizeof(errs[0])); e++)
+            {
+                result_t a;
+                result_t b;
+                int      ra = baud_calculate(freq_hz, s_std_rates[r], (bool) mod, errs[e], &a);
+                int      rb = baud_lookup(s_std_rates[r], (bool) mod, errs[e], &b);
+                if ((ra != rb) || ((0 == ra) && (0 != memcmp(&a.setting, &b.setting, sizeof(a.setting)))))
+                {
+                    fprintf(stderr, "mismatch: %u bps mod=%u err=%u\n", (unsigned) s_std_rates[r], (unsigned) mod,
+                            (unsigned) errs[e]);
+                    mismatches++;
+                }
+            }
+        }
+    }
+
+    printf("clock %u Hz, %u standard rates, %u iterations\n", (unsigned) freq_hz, (unsigned) NUM_STD_RATES,
+           (unsigned) iterations);
+    printf("%-10s %-4s %14s %14s %9s\n", "rate", "mod", "search ns/op", "table ns/op", "speedup");
+
+    double total_search = 0.0;
+    double total_table  = 0.0;
+
+    for (uint32_t r = 0U; r < NUM_STD_RATES; r++)
+    {
+        for (uint32_t mod = 0U; mod < 2U; mod++)
+        {
+            result_t result;
+            double   t0 = now_ns();
+            for (uint32_t n = 0U; n < iterations; n++)
+            {
+                (void) baud_calculate(freq_hz, s_std_rates[r], (bool) mod, 5000U, &result);
+                sink += result.setting.brr;
+            }
+
+            double t1 = now_ns();
+            for (uint32_t n = 0U; n < iterations; n++)
+            {
+                (void) baud_lookup(s_std_rates[r], (bool) mod, 5000U, &result);
+                sink += result.setting.brr;
+            }
+
+            double t2 = now_ns();
+            double ts = (t1 - t0) / iterations;
+            double tt = (t2 - t1) / iterations;
+            total_search += ts;
+            total_table  += tt;
+            printf("%-10u %-4u %14.1f %14.1f %8.1fx\n", (unsigned) s_std_rates[r], (unsigned) mod, ts, tt,
+                   (tt > 0.0) ? (ts / tt) : 0.0);
+        }
+    }
+
+    printf("%-15s %14.1f %14.1f %8.1fx\n", "mean", total_search / (2 * NUM_STD_RATES),
+           total_table / (2 * NUM_STD_RATES), (total_table > 0.0) ? (total_search / total_table) : 0.0);
+    printf("table/search agreement: %s (%u mismatches)\n", (0U == mismatches) ? "OK" : "FAILED",
+           (unsigned) mismatches);
+
+    (void) sink;
+
+    return (0U == mismatches) ? 0 : 1;
+}
+
+int main (int argc, char ** argv)
+{
+    uint32_t     freq_hz    = CLOCK_96MHZ;
+    uint32_t     iterations = 20000U;
+    bool         benchmark  = false;
+    char const * p_out      = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((0 == strcmp(argv[i], "-c")) && ((i + 1) < argc))
+        {
+            freq_hz = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-o")) && ((i + 1) < argc))
+        {
+            p_out = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-n")) && ((i + 1) < argc))
+        {
+            iterations = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if (0 == strcmp(argv[i], "-b"))
+        {
+            benchmark = true;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-c clock_hz] [-o file] | -b [-n iterations]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (benchmark)
+    {
+        return run_benchmark(freq_hz, iterations);
+    }
+
+    FILE * fp = stdout;
+    if (NULL != p_out)
+    {
+        fp = fopen(p_out, "w");
+        if (NULL == fp)
+        {
+            perror(p_out);
+            return 1;
+        }
+    }
+
+    emit_table(fp, freq_hz);
+
+    if (stdout != fp)
+    {
+        fclose(fp);
+    }
+
+    return 0;
+}
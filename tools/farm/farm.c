@@ -0,0 +1,1240 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Host tool: provisioning farm.
+ *
+ * Runs one compiled script (provision -c) on every station of a line at
+ * once: one serial device per fixture, each with its own link and its own
+ * window of commands in flight, as provision keeps for one board. One
+ * thread drives all the lines through epoll. Reads and writes never block
+ * it: a line that does not take bytes keeps them in its own queue and is
+ * written when epoll reports it writable again.
+ *
+ * The work around the link runs on a pool of worker threads: deriving the
+ * JTAG ID of a board (-k), looking its UID up in the registry (-N), and
+ * recording the run (-R, -L). Each station hands its tasks to one worker,
+ * and a worker with nothing of its own steals the oldest task of another,
+ * so a slow registry append on one station never holds up the others.
+ * Results come back to the link thread through an eventfd.
+ *
+ * A station works board after board. It asks the board for its UID
+ * (GET_UID); a UID it has just provisioned means the board has not been
+ * changed yet, and it asks again a second later. With -s the same board
+ * is run again at once (a bench with virtual boards). Each run gets a new
+ * session ID, and the derived ID is worked out while the first commands
+ * are already on the line; the command that needs it waits for it. When
+ * the board stops answering, the link is reset and the unanswered
+ * commands are sent again, -r times, as provision does.
+ *
+ * SIGINT or SIGTERM stops the stations once their current boards are
+ * done. The report gives the boards of each station and the boards per
+ * hour of the farm.
+ *
+ * Usage:
+ *   farm -x compiled [-k key] [-R registry] [-N] [-L log] [-w workers] [-b baud] [-t timeout_s]
+ *        [-r retries] [-n boards] [-s] device...
+ *
+ * -n stops each station after that many boards (default: until stopped).
+ * -N skips boards the registry holds a run without failures of.
+ *
+ * Build:
+ *   gcc -O2 -pthread -Itools/sim -Itools/registry -Itools/provision -Isrc/OTP_Example -Irzn/fsp/inc \
+ *       -Irzn/fsp/inc/api -o farm tools/farm/farm.c tools/provision/compiled_script.c \
+ *       tools/sim/transport_host.c tools/registry/uid_registry.c src/OTP_Example/frame.c \
+ *       src/OTP_Example/crc.c src/OTP_Example/sha256.c
+ ******************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include "hal_data.h"
+#include "common.h"
+#include "cmd_otp.h"
+#include "otp.h"
+#include "crc.h"
+#include "frame.h"
+#include "sha256.h"
+#include "device_setup.h"
+#include "transport_host.h"
+#include "compiled_script.h"
+#include "uid_registry.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+#define DEFAULT_BAUD_RATE       (115200U)
+#define DEFAULT_TIMEOUT_S       (5U)
+#define DEFAULT_RETRIES         (2U)
+#define DEFAULT_WORKERS         (4U)
+#define MAX_STATIONS            (256U)
+#define MAX_WORKERS             (64U)
+#define POLL_MS                 (10U)
+#define PROBE_INTERVAL_S        (1.0)               // Between GET_UIDs while the same board is in
+#define STATION_TX_SIZE         (0x10000U)          // Bytes a line may hold back
+#define WORKER_QUEUE_SIZE       (1024U)             // Tasks of one worker, a power of two
+#define MAX_RESPONSE_DATA       (UID_SIZE)
+#define PROBE_TAG               (0xFFU)
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+/* Station state */
+typedef enum e_station_state
+{
+    STATION_CONNECT,                                // Link reset sent, waiting for the board
+    STATION_PROBE,                                  // GET_UID sent
+    STATION_PROBE_WAIT,                             // Same board still in, asking again later
+    STATION_LOOKUP,                                 // Registry lookup of the UID (-N)
+    STATION_RUN,                                    // Script in flight
+    STATION_RECONNECT,                              // Link reset in a run, commands to be sent again
+    STATION_DONE,
+} station_state_t;
+
+/* Worker task kind */
+typedef enum e_task_kind
+{
+    TASK_DERIVE,                                    // JTAG ID of a UID
+    TASK_LOOKUP,                                    // Registry record of a UID
+    TASK_REPORT,                                    // Registry append and log line
+} task_kind_t;
+
+struct st_station;
+
+/* Work handed from the link thread to the workers */
+typedef struct
+{
+    task_kind_t         kind;
+    struct st_station * p_station;
+    uint32_t            board;                      // Board of the station the task is for
+    uint8_t             uid[UID_SIZE];
+    uint8_t             id[JAUTHID_ID_SIZE];        // TASK_DERIVE result
+    bool                provisioned;                // TASK_LOOKUP result: a run without failures
+    registry_record_t   rec;                        // TASK_REPORT
+    char                text[256];                  // TASK_REPORT log line
+} task_t;
+
+/* One command of the script on one station */
+typedef struct
+{
+    frame_template_t tpl;
+    bool             needs_id;                      // Has a derived JTAG ID slot
+    bool             done;
+    uint8_t          ret;
+    uint8_t          data_size;
+    uint8_t          data[MAX_RESPONSE_DATA];
+} station_job_t;
+
+/* One fixture */
+typedef struct st_station
+{
+    char const          * p_path;
+    char                  name[REGISTRY_STATION_SIZE];
+    uint32_t              index;
+    transport_fd_ctrl_t   line;
+    frame_link_t          link;
+    cscript_t             script;                   // Own mapping: the link patches the frames
+    station_job_t       * p_jobs;
+    station_state_t       state;
+    double                deadline;
+    uint32_t              retries;
+
+    /* The script in flight, as in provision */
+    uint32_t              num_sent;
+    uint32_t              num_issued;
+    uint32_t              num_answered;
+    uint32_t              num_done;
+    uint32_t              num_failed;
+    uint32_t              last_done;
+    uint32_t              retries_left;
+    bool                  id_wanted;                // The script derives an ID
+    bool                  id_ready;                 // The derived ID is patched in
+
+    /* The board */
+    uint8_t               uid[UID_SIZE];
+    uint8_t               last_uid[UID_SIZE];
+    bool                  have_last;
+    double                board_s;
+
+    /* Bytes the line has not taken yet */
+    uint8_t             * p_tx;
+    uint32_t              tx_head;
+    uint32_t              tx_tail;
+    uint32_t              tx_dropped;
+    bool                  tx_armed;                 // Waiting for EPOLLOUT
+
+    task_t                task;                     // Derive or lookup in progress
+    bool                  task_busy;
+
+    /* Report */
+    uint32_t              boards;
+    uint32_t              boards_failed;
+    uint32_t              boards_skipped;
+    double                run_s;                    // Time in runs
+} station_t;
+
+/* Worker thread with its own task queue */
+typedef struct
+{
+    pthread_t        thread;
+    pthread_mutex_t  lock;
+    task_t         * p_queue[WORKER_QUEUE_SIZE];
+    uint32_t         head;                          // Oldest task, taken by thieves
+    uint32_t         tail;                          // Newest task, taken by the owner
+    uid_registry_t   reg;
+    bool             have_reg;
+    uint32_t         run;
+    uint32_t         stolen;
+} worker_t;
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static station_t              s_stations[MAX_STATIONS];
+static uint32_t               s_num_stations;
+static worker_t               s_workers[MAX_WORKERS];
+static uint32_t               s_num_workers = DEFAULT_WORKERS;
+static pthread_mutex_t        s_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t         s_pool_cond = PTHREAD_COND_INITIALIZER;
+static atomic_uint            s_pending;            // Tasks queued, not yet taken
+static bool                   s_pool_stop;
+static pthread_mutex_t        s_done_lock = PTHREAD_MUTEX_INITIALIZER;
+static task_t               * s_done[MAX_STATIONS * 4U];
+static uint32_t               s_num_done_tasks;
+static int                    s_event_fd = -1;
+static int                    s_epoll_fd = -1;
+static volatile sig_atomic_t  s_stop;
+
+static uint8_t                s_key[JAUTH_KEY_SIZE];
+static bool                   s_have_key;
+static char const           * p_s_registry;
+static bool                   s_skip_known;         // -N
+static int                    s_log_fd = -1;
+static bool                   s_same_board;         // -s
+static uint32_t               s_max_boards;         // -n, 0 for no limit
+static uint32_t               s_timeout_s = DEFAULT_TIMEOUT_S;
+static uint32_t               s_retries   = DEFAULT_RETRIES;
+static uint32_t               s_reports_pending;
+
+static double now_s (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+static uint32_t now_ms (void)
+{
+    return (uint32_t) (uint64_t) (now_s() * 1000.0);
+}
+
+static int parse_hex (char const * p_text, uint8_t * p_data, uint32_t size)
+{
+    if ((NULL == p_text) || ((size * 2U) != strlen(p_text)))
+    {
+        return -1;
+    }
+
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        char hex[3] = {p_text[i * 2U], p_text[(i * 2U) + 1U], '\0'};
+        if (!isxdigit((unsigned char) hex[0]) || !isxdigit((unsigned char) hex[1]))
+        {
+            return -1;
+        }
+        p_data[i] = (uint8_t) strtoul(hex, NULL, 16);
+    }
+
+    return 0;
+}
+
+static void on_signal (int sig)
+{
+    (void) sig;
+    s_stop = 1;
+}
+
+/******************************************************************************
+ * Workers
+ ******************************************************************************/
+
+/* Queue a task on the worker of its station. Called by the link thread. */
+static void task_submit (task_t * p_task)
+{
+    worker_t * p_worker = &s_workers[p_task->p_station->index % s_num_workers];
+
+    (void) pthread_mutex_lock(&p_worker->lock);
+    p_worker->p_queue[p_worker->tail++ & (WORKER_QUEUE_SIZE - 1U)] = p_task;
+    (void) pthread_mutex_unlock(&p_worker->lock);
+
+    /* Counted under the pool lock, so a worker about to sleep sees it. */
+    (void) pthread_mutex_lock(&s_pool_lock);
+    atomic_fetch_add(&s_pending, 1U);
+    (void) pthread_cond_signal(&s_pool_cond);
+    (void) pthread_mutex_unlock(&s_pool_lock);
+}
+
+/* The newest task of the worker's own queue, or the oldest of another. */
+static task_t * task_take (uint32_t self)
+{
+    task_t * p_task = NULL;
+
+    for (uint32_t n = 0U; (n < s_num_workers) && (NULL == p_task); n++)
+    {
+        worker_t * p_worker = &s_workers[(self + n) % s_num_workers];
+
+        (void) pthread_mutex_lock(&p_worker->lock);
+        if (p_worker->head != p_worker->tail)
+        {
+            if (0U == n)
+            {
+                p_task = p_worker->p_queue[--p_worker->tail & (WORKER_QUEUE_SIZE - 1U)];
+            }
+            else
+            {
+                p_task = p_worker->p_queue[p_worker->head++ & (WORKER_QUEUE_SIZE - 1U)];
+                s_workers[self].stolen++;
+            }
+        }
+        (void) pthread_mutex_unlock(&p_worker->lock);
+    }
+    if (NULL != p_task)
+    {
+        atomic_fetch_sub(&s_pending, 1U);
+    }
+
+    return p_task;
+}
+
+static void task_run (worker_t * p_worker, task_t * p_task)
+{
+    switch (p_task->kind)
+    {
+        case TASK_DERIVE:
+        {
+            uint8_t mac[SHA256_DIGEST_SIZE];
+            sha256_hmac(s_key, JAUTH_KEY_SIZE, p_task->uid, UID_SIZE, mac);
+            memcpy(p_task->id, mac, JAUTHID_ID_SIZE);
+            sha256_wipe(mac, sizeof(mac));
+            break;
+        }
+        case TASK_LOOKUP:
+        {
+            registry_record_t const * p_rec = p_worker->have_reg ? uid_registry_find(&p_worker->reg, p_task->uid) :
+                                              NULL;
+            p_task->provisioned = (NULL != p_rec) && (0U == p_rec->failed);
+            break;
+        }
+        case TASK_REPORT:
+        {
+            bool repeat = false;
+            if (p_worker->have_reg && (0 != uid_registry_append(&p_worker->reg, &p_task->rec, &repeat)))
+            {
+                snprintf(p_task->text + strlen(p_task->text) - 1U, sizeof(p_task->text) - strlen(p_task->text),
+                         " registry: %s\n", strerror(errno));
+            }
+            else if (repeat)
+            {
+                snprintf(p_task->text + strlen(p_task->text) - 1U, sizeof(p_task->text) - strlen(p_task->text),
+                         " (run %u)\n", (unsigned) p_task->rec.runs);
+            }
+
+            /* One write per line: lines of different workers do not mix. */
+            (void) write(STDOUT_FILENO, p_task->text, strlen(p_task->text));
+            if (s_log_fd >= 0)
+            {
+                (void) write(s_log_fd, p_task->text, strlen(p_task->text));
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void * worker_main (void * p_arg)
+{
+    worker_t * p_worker = (worker_t *) p_arg;
+    uint32_t   self     = (uint32_t) (p_worker - s_workers);
+    uint64_t   one      = 1U;
+
+    /* Each worker maps the registry itself; appends are serialized by the file lock. */
+    p_worker->have_reg = (NULL != p_s_registry) && (0 == uid_registry_open(&p_worker->reg, p_s_registry, true, 0U));
+
+    while (1)
+    {
+        task_t * p_task = task_take(self);
+
+        if (NULL == p_task)
+        {
+            (void) pthread_mutex_lock(&s_pool_lock);
+            while ((0U == atomic_load(&s_pending)) && !s_pool_stop)
+            {
+                (void) pthread_cond_wait(&s_pool_cond, &s_pool_lock);
+            }
+            bool stop = s_pool_stop && (0U == atomic_load(&s_pending));
+            (void) pthread_mutex_unlock(&s_pool_lock);
+            if (stop)
+            {
+                break;
+            }
+            continue;
+        }
+
+        task_run(p_worker, p_task);
+        p_worker->run++;
+
+        (void) pthread_mutex_lock(&s_done_lock);
+        s_done[s_num_done_tasks++] = p_task;
+        (void) pthread_mutex_unlock(&s_done_lock);
+        (void) write(s_event_fd, &one, sizeof(one));
+    }
+
+    if (p_worker->have_reg)
+    {
+        uid_registry_close(&p_worker->reg);
+    }
+
+    return NULL;
+}
+
+/******************************************************************************
+ * Lines
+ ******************************************************************************/
+
+static void station_arm (station_t * p_st, bool out)
+{
+    struct epoll_event ev = {.events = EPOLLIN | (out ? EPOLLOUT : 0U), .data.ptr = p_st};
+
+    if (out != p_st->tx_armed)
+    {
+        (void) epoll_ctl(s_epoll_fd, EPOLL_CTL_MOD, p_st->line.fd_in, &ev);
+        p_st->tx_armed = out;
+    }
+}
+
+/* Write what the line takes now of the held bytes. */
+static void station_flush (station_t * p_st)
+{
+    while (p_st->tx_head != p_st->tx_tail)
+    {
+        uint32_t start = p_st->tx_head % STATION_TX_SIZE;
+        uint32_t size  = p_st->tx_tail - p_st->tx_head;
+        size = ((start + size) > STATION_TX_SIZE) ? (STATION_TX_SIZE - start) : size;
+
+        ssize_t n = write(p_st->line.fd_out, &p_st->p_tx[start], size);
+        if (n <= 0)
+        {
+            if ((n < 0) && (EINTR == errno))
+            {
+                continue;
+            }
+            break;
+        }
+        p_st->tx_head += (uint32_t) n;
+    }
+    station_arm(p_st, p_st->tx_head != p_st->tx_tail);
+}
+
+/* frame_cfg_t write: hold the frame and write what the line takes. A frame
+ * that does not fit is dropped; the link sends it again. */
+static void station_write (void * p_context, uint8_t const * p_data, uint32_t size)
+{
+    station_t * p_st = (station_t *) p_context;
+
+    if ((STATION_TX_SIZE - (p_st->tx_tail - p_st->tx_head)) < size)
+    {
+        p_st->tx_dropped++;
+
+        return;
+    }
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        p_st->p_tx[(p_st->tx_tail + i) % STATION_TX_SIZE] = p_data[i];
+    }
+    p_st->tx_tail += size;
+    station_flush(p_st);
+}
+
+static void station_read (station_t * p_st)
+{
+    uint8_t chunk[1024];
+    ssize_t n;
+
+    do
+    {
+        n = read(p_st->line.fd_in, chunk, sizeof(chunk));
+        if (n > 0)
+        {
+            frame_input(&p_st->link, chunk, (uint32_t) n);
+        }
+    } while (n == (ssize_t) sizeof(chunk));
+}
+
+/******************************************************************************
+ * Stations
+ ******************************************************************************/
+
+static void station_connect (station_t * p_st, station_state_t state)
+{
+    p_st->state    = state;
+    p_st->deadline = now_s() + s_timeout_s;
+    frame_reset(&p_st->link);
+}
+
+static void station_probe (station_t * p_st)
+{
+    head_t head = {.type = PACKET_TYPE_COMMAND, .code = CMD_GET_UID, .tag = PROBE_TAG};
+
+    p_st->state    = STATION_PROBE;
+    p_st->deadline = now_s() + s_timeout_s;
+    (void) frame_send(&p_st->link, (uint8_t const *) &head, sizeof(head));
+}
+
+/* Start the script on the board whose UID the probe returned. */
+static void station_start (station_t * p_st)
+{
+    cscript_header_t const * p_header = p_st->script.p_header;
+
+    for (uint32_t i = 0U; i < p_header->num_frames; i++)
+    {
+        p_st->p_jobs[i].done = false;
+    }
+    p_st->num_sent     = 0U;
+    p_st->num_issued   = 0U;
+    p_st->num_answered = 0U;
+    p_st->num_done     = 0U;
+    p_st->num_failed   = 0U;
+    p_st->last_done    = 0U;
+    p_st->retries_left = s_retries;
+    p_st->id_ready     = !p_st->id_wanted;
+    p_st->board_s      = now_s();
+    p_st->deadline     = p_st->board_s + s_timeout_s;
+    p_st->state        = STATION_RUN;
+
+    for (uint32_t i = 0U; i < p_header->num_slots; i++)
+    {
+        if (CSCRIPT_SLOT_SESSION == p_st->script.p_slots[i].kind)
+        {
+            uint32_t id = ((uint32_t) rand() << 16) ^ (uint32_t) rand() ^ (uint32_t) (now_s() * 1e6);
+            uint8_t  be[4] = {(uint8_t) (id >> 24), (uint8_t) (id >> 16), (uint8_t) (id >> 8), (uint8_t) id};
+            cscript_patch(&p_st->script, &p_st->script.p_slots[i], be);
+        }
+    }
+
+    /* The ID is worked out while the first commands run. */
+    if (p_st->id_wanted)
+    {
+        p_st->task.kind      = TASK_DERIVE;
+        p_st->task.p_station = p_st;
+        p_st->task.board     = p_st->boards;
+        memcpy(p_st->task.uid, p_st->uid, UID_SIZE);
+        p_st->task_busy = true;
+        task_submit(&p_st->task);
+    }
+}
+
+/* The registry record of the run, from the answers, as provision -R. */
+static void station_record (station_t const * p_st, registry_record_t * p_rec)
+{
+    uint32_t counter     = 0U;
+    uint32_t counter_set = 0U;
+
+    memset(p_rec, 0, sizeof(*p_rec));
+    memcpy(p_rec->uid, p_st->uid, UID_SIZE);
+    p_rec->jauth_mode = REGISTRY_UNKNOWN;
+    p_rec->jauth_type = REGISTRY_UNKNOWN;
+
+    for (uint32_t i = 0U; i < p_st->script.p_header->num_frames; i++)
+    {
+        station_job_t const * p_job = &p_st->p_jobs[i];
+        packet_t const      * p_pkt = (packet_t const *) &p_job->tpl.p_frame[FRAME_HEADER_SIZE];
+
+        if ((false == p_job->done) || (RET_SUCCESS != p_job->ret))
+        {
+            continue;
+        }
+        if ((CMD_GET_JAUTH == p_pkt->head.code) && (2U == p_job->data_size))
+        {
+            p_rec->jauth_mode = p_job->data[0];
+            p_rec->jauth_type = p_job->data[1];
+        }
+        else if ((CMD_READ_OTP == p_pkt->head.code) && (2U == p_job->data_size))
+        {
+            uint16_t address = (uint16_t) ((p_pkt->cmd.rotp.address[0] << 8) | p_pkt->cmd.rotp.address[1]);
+            uint32_t bit     = 1U << (address - COUNTER_AREA_START_ADDR);
+
+            if ((address >= COUNTER_AREA_START_ADDR) && (address <= COUNTER_AREA_END_ADDR) &&
+                (0U == (counter_set & bit)))
+            {
+                counter_set |= bit;
+                counter     += (uint32_t) __builtin_popcount(((uint32_t) p_job->data[0] << 8) | p_job->data[1]);
+            }
+        }
+    }
+
+    p_rec->counter = ((1U << (COUNTER_AREA_END_ADDR - COUNTER_AREA_START_ADDR + 1U)) - 1U == counter_set) ?
+                     (uint16_t) counter : REGISTRY_UNKNOWN_COUNTER;
+    p_rec->time_s = (uint64_t) time(NULL);
+    memcpy(p_rec->station, p_st->name, sizeof(p_rec->station));
+}
+
+/* The board is done (or given up): report it and wait for the next one. */
+static void station_finish (station_t * p_st)
+{
+    uint32_t   num_frames = p_st->script.p_header->num_frames;
+    uint32_t   failed     = p_st->num_failed + (num_frames - p_st->num_done);
+    task_t   * p_task     = calloc(1U, sizeof(task_t));
+    double     elapsed    = now_s() - p_st->board_s;
+    char       when[32];
+    time_t     t = time(NULL);
+    struct tm  tm;
+    int        len;
+
+    p_st->boards++;
+    p_st->boards_failed += (0U != failed) ? 1U : 0U;
+    p_st->run_s         += elapsed;
+    memcpy(p_st->last_uid, p_st->uid, UID_SIZE);
+    p_st->have_last      = true;
+
+    if (NULL != p_task)
+    {
+        p_task->kind      = TASK_REPORT;
+        p_task->p_station = p_st;
+        station_record(p_st, &p_task->rec);
+        p_task->rec.failed = (uint8_t) ((failed > UINT8_MAX) ? UINT8_MAX : failed);
+
+        (void) localtime_r(&t, &tm);
+        (void) strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", &tm);
+        len = snprintf(p_task->text, sizeof(p_task->text), "%s %-10s ", when, p_st->name);
+        for (uint32_t i = 0U; i < UID_SIZE; i++)
+        {
+            len += snprintf(&p_task->text[len], sizeof(p_task->text) - (size_t) len, "%02x", p_st->uid[i]);
+        }
+        len += snprintf(&p_task->text[len], sizeof(p_task->text) - (size_t) len, " %s %u of %u commands %.2f s",
+                        (0U == failed) ? "OK  " : "FAIL", (unsigned) (num_frames - failed), (unsigned) num_frames,
+                        elapsed);
+
+        /* The first command that failed, by its script line. */
+        for (uint32_t i = 0U; (0U != failed) && (i < num_frames); i++)
+        {
+            station_job_t const   * p_job   = &p_st->p_jobs[i];
+            cscript_frame_t const * p_frame = &p_st->script.p_frames[i];
+
+            if (!p_job->done || (RET_SUCCESS != p_job->ret))
+            {
+                len += snprintf(&p_task->text[len], sizeof(p_task->text) - (size_t) len, ", line %u %.16s %s",
+                                (unsigned) p_frame->line, p_frame->name, p_job->done ? "failed" : "not answered");
+                break;
+            }
+        }
+        (void) snprintf(&p_task->text[len], sizeof(p_task->text) - (size_t) len, "\n");
+        s_reports_pending++;
+        task_submit(p_task);
+    }
+
+    if ((0U != s_max_boards) && (p_st->boards >= s_max_boards))
+    {
+        p_st->state = STATION_DONE;
+    }
+    else
+    {
+        station_probe(p_st);
+    }
+}
+
+/* Fill the window, as provision's phase 3. */
+static void station_send (station_t * p_st)
+{
+    uint32_t num_frames = p_st->script.p_header->num_frames;
+
+    while ((p_st->num_answered < num_frames) && p_st->p_jobs[p_st->num_answered].done)
+    {
+        p_st->num_answered++;
+    }
+
+    while ((p_st->num_sent < num_frames) && (0U != frame_send_space(&p_st->link)))
+    {
+        station_job_t * p_job = &p_st->p_jobs[p_st->num_sent];
+
+        if ((0U != p_st->script.p_frames[p_st->num_sent].wait) && (p_st->num_answered < p_st->num_sent))
+        {
+            break;
+        }
+        if ((false == p_st->id_ready) && p_job->needs_id)
+        {
+            break;
+        }
+        p_st->num_sent++;
+        if (p_job->done)
+        {
+            continue;
+        }
+        p_st->num_issued = (p_st->num_sent > p_st->num_issued) ? p_st->num_sent : p_st->num_issued;
+        (void) frame_send_template(&p_st->link, &p_job->tpl);
+    }
+}
+
+/* frame_cfg_t deliver */
+static void station_deliver (void * p_context, uint8_t const * p_data, uint32_t size)
+{
+    station_t        * p_st  = (station_t *) p_context;
+    response_t const * p_rsp = (response_t const *) p_data;
+    station_job_t    * p_job = NULL;
+    uint32_t           data_size;
+
+    if (sizeof(response_t) > size)
+    {
+        return;
+    }
+    data_size = size - (uint32_t) sizeof(response_t);
+
+    if (STATION_PROBE == p_st->state)
+    {
+        if ((PROBE_TAG != p_rsp->head.tag) || (CMD_GET_UID != p_rsp->head.code))
+        {
+            return;
+        }
+        if ((RET_SUCCESS != p_rsp->ret) || (UID_SIZE != data_size))
+        {
+            p_st->state    = STATION_PROBE_WAIT;
+            p_st->deadline = now_s() + PROBE_INTERVAL_S;
+            return;
+        }
+        memcpy(p_st->uid, p_rsp->data, UID_SIZE);
+
+        /* The same board, or the task of the last one still running: ask again later. */
+        if ((p_st->have_last && !s_same_board && (0 == memcmp(p_st->uid, p_st->last_uid, UID_SIZE))) ||
+            p_st->task_busy)
+        {
+            p_st->state    = STATION_PROBE_WAIT;
+            p_st->deadline = now_s() + PROBE_INTERVAL_S;
+        }
+        else if (s_skip_known)
+        {
+            p_st->state          = STATION_LOOKUP;
+            p_st->task.kind      = TASK_LOOKUP;
+            p_st->task.p_station = p_st;
+            memcpy(p_st->task.uid, p_st->uid, UID_SIZE);
+            p_st->task_busy = true;
+            task_submit(&p_st->task);
+        }
+        else
+        {
+            station_start(p_st);
+        }
+        return;
+    }
+    if ((STATION_RUN != p_st->state) && (STATION_RECONNECT != p_st->state))
+    {
+        return;
+    }
+
+    for (uint32_t i = p_st->num_issued; i-- > 0U; )
+    {
+        if ((false == p_st->p_jobs[i].done) && ((uint8_t) i == p_rsp->head.tag))
+        {
+            p_job = &p_st->p_jobs[i];
+            break;
+        }
+    }
+    if (NULL == p_job)
+    {
+        return;
+    }
+
+    packet_t const * p_pkt = (packet_t const *) &p_job->tpl.p_frame[FRAME_HEADER_SIZE];
+    p_job->done      = true;
+    p_job->ret       = ((PACKET_TYPE_RESPONSE != p_rsp->head.type) || (p_pkt->head.code != p_rsp->head.code)) ?
+                       RET_CMD_FAIL : p_rsp->ret;
+    p_job->data_size = (uint8_t) ((data_size > MAX_RESPONSE_DATA) ? MAX_RESPONSE_DATA : data_size);
+    memcpy(p_job->data, p_rsp->data, p_job->data_size);
+
+    /* A GET_UID of the script must find the board the probe found. */
+    if ((CMD_GET_UID == p_pkt->head.code) && (RET_SUCCESS == p_job->ret) &&
+        ((UID_SIZE != p_job->data_size) || (0 != memcmp(p_job->data, p_st->uid, UID_SIZE))))
+    {
+        p_job->ret = RET_CMD_FAIL;
+    }
+    p_st->num_failed += (RET_SUCCESS != p_job->ret) ? 1U : 0U;
+    p_st->num_done++;
+}
+
+/* Timers and state changes of one station. */
+static void station_step (station_t * p_st)
+{
+    double now = now_s();
+
+    switch (p_st->state)
+    {
+        case STATION_CONNECT:
+            if (frame_idle(&p_st->link))
+            {
+                station_probe(p_st);
+            }
+            else if (now > p_st->deadline)
+            {
+                station_connect(p_st, STATION_CONNECT);
+            }
+            break;
+        case STATION_PROBE:
+            if (now > p_st->deadline)
+            {
+                station_connect(p_st, STATION_CONNECT);
+            }
+            break;
+        case STATION_PROBE_WAIT:
+            if (now > p_st->deadline)
+            {
+                station_probe(p_st);
+            }
+            break;
+        case STATION_RECONNECT:
+            if (frame_idle(&p_st->link))
+            {
+                p_st->state    = STATION_RUN;
+                p_st->num_sent = 0U;
+                p_st->deadline = now + s_timeout_s;
+            }
+            else if (now > p_st->deadline)
+            {
+                station_finish(p_st);
+            }
+            break;
+        case STATION_RUN:
+            if (p_st->num_done == p_st->script.p_header->num_frames)
+            {
+                station_finish(p_st);
+                break;
+            }
+            station_send(p_st);
+            if (p_st->last_done != p_st->num_done)
+            {
+                p_st->last_done = p_st->num_done;
+                p_st->deadline  = now + s_timeout_s;
+            }
+            else if (now > p_st->deadline)
+            {
+                if (0U == p_st->retries_left)
+                {
+                    station_finish(p_st);
+                }
+                else
+                {
+                    p_st->retries_left--;
+                    station_connect(p_st, STATION_RECONNECT);
+                }
+            }
+            break;
+        default:
+            break;
+    }
+
+    /* Once stopped, no new board is started. */
+    if (s_stop && ((STATION_CONNECT == p_st->state) || (STATION_PROBE == p_st->state) ||
+                   (STATION_PROBE_WAIT == p_st->state)))
+    {
+        p_st->state = STATION_DONE;
+    }
+}
+
+/* Results of the workers, back on the link thread. */
+static void tasks_collect (void)
+{
+    task_t * done[MAX_STATIONS * 4U];
+    uint32_t count;
+    uint64_t value;
+
+    (void) read(s_event_fd, &value, sizeof(value));
+    (void) pthread_mutex_lock(&s_done_lock);
+    count = s_num_done_tasks;
+    memcpy(done, s_done, count * sizeof(done[0]));
+    s_num_done_tasks = 0U;
+    (void) pthread_mutex_unlock(&s_done_lock);
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        task_t    * p_task = done[i];
+        station_t * p_st   = p_task->p_station;
+
+        switch (p_task->kind)
+        {
+            case TASK_DERIVE:
+                /* Not for a board given up in the meantime. */
+                if ((p_task->board == p_st->boards) &&
+                    ((STATION_RUN == p_st->state) || (STATION_RECONNECT == p_st->state)))
+                {
+                    for (uint32_t s = 0U; s < p_st->script.p_header->num_slots; s++)
+                    {
+                        if (CSCRIPT_SLOT_JAUTH_ID == p_st->script.p_slots[s].kind)
+                        {
+                            cscript_patch(&p_st->script, &p_st->script.p_slots[s], p_task->id);
+                        }
+                    }
+                    p_st->id_ready = true;
+                }
+                sha256_wipe(p_task->id, sizeof(p_task->id));
+                p_st->task_busy = false;
+                break;
+            case TASK_LOOKUP:
+                p_st->task_busy = false;
+                if (p_task->provisioned)
+                {
+                    memcpy(p_st->last_uid, p_st->uid, UID_SIZE);
+                    p_st->have_last = true;
+                    p_st->boards_skipped++;
+                    p_st->state    = STATION_PROBE_WAIT;
+                    p_st->deadline = now_s() + PROBE_INTERVAL_S;
+                }
+                else
+                {
+                    station_start(p_st);
+                }
+                break;
+            default:
+                s_reports_pending--;
+                free(p_task);
+                break;
+        }
+    }
+}
+
+/* Open the line of a station and map its own copy of the script. */
+static int station_open (station_t * p_st, char const * p_path, char const * p_script, uint32_t baud_rate)
+{
+    struct epoll_event ev = {.events = EPOLLIN, .data.ptr = p_st};
+
+    /* Named by the device, as the registry records it: ttyUSB0, pts/3 */
+    p_st->p_path = p_path;
+    snprintf(p_st->name, sizeof(p_st->name), "%s", (0 == strncmp(p_path, "/dev/", 5U)) ? (p_path + 5) : p_path);
+
+    if (0 != cscript_open(&p_st->script, p_script))
+    {
+        perror(p_script);
+
+        return -1;
+    }
+    p_st->p_jobs = calloc(p_st->script.p_header->num_frames, sizeof(station_job_t));
+    p_st->p_tx   = malloc(STATION_TX_SIZE);
+    if ((NULL == p_st->p_jobs) || (NULL == p_st->p_tx))
+    {
+        return -1;
+    }
+    for (uint32_t i = 0U; i < p_st->script.p_header->num_frames; i++)
+    {
+        cscript_template(&p_st->script, i, &p_st->p_jobs[i].tpl);
+    }
+    for (uint32_t i = 0U; i < p_st->script.p_header->num_slots; i++)
+    {
+        cscript_slot_t const * p_slot = &p_st->script.p_slots[i];
+
+        if ((CSCRIPT_SLOT_JAUTH_ID == p_slot->kind) && (JAUTHID_ID_SIZE == p_slot->size))
+        {
+            p_st->p_jobs[p_slot->frame].needs_id = true;
+            p_st->id_wanted                      = true;
+        }
+        else if ((CSCRIPT_SLOT_SESSION != p_slot->kind) || (sizeof(uint32_t) != p_slot->size))
+        {
+            fprintf(stderr, "%s: slot %u is of an unknown kind\n", p_script, (unsigned) i);
+
+            return -1;
+        }
+    }
+    if (p_st->id_wanted && !s_have_key)
+    {
+        fprintf(stderr, "%s: the script derives JTAG IDs, it needs the master key (-k)\n", p_script);
+
+        return -1;
+    }
+
+    if (0 != transport_serial_open(&p_st->line, p_path, baud_rate))
+    {
+        perror(p_path);
+
+        return -1;
+    }
+    if (0 != epoll_ctl(s_epoll_fd, EPOLL_CTL_ADD, p_st->line.fd_in, &ev))
+    {
+        perror("epoll_ctl");
+
+        return -1;
+    }
+
+    frame_cfg_t cfg =
+    {
+        .p_write          = station_write,
+        .p_deliver        = station_deliver,
+        .p_context        = p_st,
+        .retry_timeout_ms = 0U,
+    };
+    frame_init(&p_st->link, &cfg);
+    p_st->link.now_ms = now_ms();
+    station_connect(p_st, STATION_CONNECT);
+
+    return 0;
+}
+
+static void print_report (double elapsed)
+{
+    uint32_t boards  = 0U;
+    uint32_t failed  = 0U;
+    uint32_t tasks   = 0U;
+    uint32_t stolen  = 0U;
+
+    printf("station          boards  failed  skipped  s/board  dropped\n");
+    for (uint32_t i = 0U; i < s_num_stations; i++)
+    {
+        station_t const * p_st = &s_stations[i];
+
+        printf("%-16.16s %6u  %6u  %7u  %7.2f  %7u\n", p_st->name, (unsigned) p_st->boards,
+               (unsigned) p_st->boards_failed, (unsigned) p_st->boards_skipped,
+               (0U != p_st->boards) ? (p_st->run_s / p_st->boards) : 0.0, (unsigned) p_st->tx_dropped);
+        boards += p_st->boards;
+        failed += p_st->boards_failed;
+    }
+    for (uint32_t w = 0U; w < s_num_workers; w++)
+    {
+        tasks  += s_workers[w].run;
+        stolen += s_workers[w].stolen;
+    }
+    printf("farm: %u boards, %u failed, in %.1f s: %.0f boards/hour on %u stations\n", (unsigned) boards,
+           (unsigned) failed, elapsed, (elapsed > 0.0) ? ((boards * 3600.0) / elapsed) : 0.0,
+           (unsigned) s_num_stations);
+    printf("workers: %u, %u tasks, %u stolen\n", (unsigned) s_num_workers, (unsigned) tasks, (unsigned) stolen);
+}
+
+int main (int argc, char ** argv)
+{
+    uint32_t           baud_rate = DEFAULT_BAUD_RATE;
+    char const       * p_script  = NULL;
+    char const       * p_key     = NULL;
+    char const       * p_log     = NULL;
+    char const       * p_devices[MAX_STATIONS];
+    uint32_t           num_devices = 0U;
+    struct epoll_event ev;
+    struct sigaction   sa;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((0 == strcmp(argv[i], "-x")) && ((i + 1) < argc))
+        {
+            p_script = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-k")) && ((i + 1) < argc))
+        {
+            p_key = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-R")) && ((i + 1) < argc))
+        {
+            p_s_registry = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-L")) && ((i + 1) < argc))
+        {
+            p_log = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-w")) && ((i + 1) < argc))
+        {
+            s_num_workers = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-b")) && ((i + 1) < argc))
+        {
+            baud_rate = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-t")) && ((i + 1) < argc))
+        {
+            s_timeout_s = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-r")) && ((i + 1) < argc))
+        {
+            s_retries = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-n")) && ((i + 1) < argc))
+        {
+            s_max_boards = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if (0 == strcmp(argv[i], "-N"))
+        {
+            s_skip_known = true;
+        }
+        else if (0 == strcmp(argv[i], "-s"))
+        {
+            s_same_board = true;
+        }
+        else if (('-' != argv[i][0]) && (num_devices < MAX_STATIONS))
+        {
+            p_devices[num_devices++] = argv[i];
+        }
+        else
+        {
+            p_script = NULL;
+            break;
+        }
+    }
+
+    if ((NULL == p_script) || (0U == num_devices) || (0U == s_num_workers) || (s_num_workers > MAX_WORKERS) ||
+        (s_skip_known && (NULL == p_s_registry)))
+    {
+        fprintf(stderr, "usage: %s -x compiled [-k key] [-R registry] [-N] [-L log] [-w workers] [-b baud]\n"
+                "           [-t timeout_s] [-r retries] [-n boards] [-s] device...\n", argv[0]);
+        return 2;
+    }
+    if (NULL != p_key)
+    {
+        if (0 != parse_hex(p_key, s_key, JAUTH_KEY_SIZE))
+        {
+            fprintf(stderr, "-k needs %u hex digits\n", (unsigned) (JAUTH_KEY_SIZE * 2U));
+            return 2;
+        }
+        s_have_key = true;
+    }
+    if (NULL != p_log)
+    {
+        s_log_fd = open(p_log, O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (s_log_fd < 0)
+        {
+            perror(p_log);
+            return 1;
+        }
+    }
+    if (NULL != p_s_registry)
+    {
+        /* Created here, so that the workers only open it. */
+        uid_registry_t reg;
+        if (0 != uid_registry_open(&reg, p_s_registry, true, 0U))
+        {
+            perror(p_s_registry);
+            return 1;
+        }
+        uid_registry_close(&reg);
+    }
+
+    s_epoll_fd = epoll_create1(0);
+    s_event_fd = eventfd(0U, EFD_NONBLOCK);
+    ev.events   = EPOLLIN;
+    ev.data.ptr = NULL;
+    if ((s_epoll_fd < 0) || (s_event_fd < 0) || (0 != epoll_ctl(s_epoll_fd, EPOLL_CTL_ADD, s_event_fd, &ev)))
+    {
+        perror("epoll");
+        return 1;
+    }
+    srand((unsigned) time(NULL) ^ (unsigned) getpid());
+    for (uint32_t i = 0U; i < num_devices; i++)
+    {
+        s_stations[i].index = i;
+        if (0 != station_open(&s_stations[i], p_devices[i], p_script, baud_rate))
+        {
+            return 1;
+        }
+        s_num_stations++;
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    (void) sigaction(SIGINT, &sa, NULL);
+    (void) sigaction(SIGTERM, &sa, NULL);
+
+    for (uint32_t w = 0U; w < s_num_workers; w++)
+    {
+        (void) pthread_mutex_init(&s_workers[w].lock, NULL);
+        (void) pthread_create(&s_workers[w].thread, NULL, worker_main, &s_workers[w]);
+    }
+
+    /* Every line, the workers' results and the link timers from one thread. */
+    double   t_start = now_s();
+    uint32_t active  = s_num_stations;
+    while ((0U != active) || (0U != s_reports_pending))
+    {
+        struct epoll_event events[64];
+        int                n = epoll_wait(s_epoll_fd, events, 64, POLL_MS);
+
+        for (int e = 0; e < n; e++)
+        {
+            station_t * p_st = (station_t *) events[e].data.ptr;
+
+            if (NULL == p_st)
+            {
+                tasks_collect();
+                continue;
+            }
+            if (0U != (events[e].events & EPOLLOUT))
+            {
+                station_flush(p_st);
+            }
+            if (0U != (events[e].events & (EPOLLIN | EPOLLHUP | EPOLLERR)))
+            {
+                station_read(p_st);
+            }
+        }
+
+        uint32_t now = now_ms();
+        active = 0U;
+        for (uint32_t i = 0U; i < s_num_stations; i++)
+        {
+            station_t * p_st = &s_stations[i];
+
+            frame_poll(&p_st->link, now);
+            station_step(p_st);
+            active += (STATION_DONE != p_st->state) ? 1U : 0U;
+        }
+    }
+    double elapsed = now_s() - t_start;
+
+    (void) pthread_mutex_lock(&s_pool_lock);
+    s_pool_stop = true;
+    (void) pthread_cond_broadcast(&s_pool_cond);
+    (void) pthread_mutex_unlock(&s_pool_lock);
+    for (uint32_t w = 0U; w < s_num_workers; w++)
+    {
+        (void) pthread_join(s_workers[w].thread, NULL);
+    }
+
+    print_report(elapsed);
+
+    for (uint32_t i = 0U; i < s_num_stations; i++)
+    {
+        transport_fd_close(&s_stations[i].line);
+        cscript_close(&s_stations[i].script);
+        free(s_stations[i].p_jobs);
+        free(s_stations[i].p_tx);
+    }
+    if (s_log_fd >= 0)
+    {
+        (void) close(s_log_fd);
+    }
+    sha256_wipe(s_key, sizeof(s_key));
+
+    return 0;
+}
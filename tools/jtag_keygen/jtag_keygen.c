@@ -0,0 +1,785 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Host tool: bulk JTAG ID generator.
+ *
+ * Works out the ID that DERIVE_JAUTH programs on each board (the first 16
+ * bytes of HMAC-SHA256(key, UID), see cmd_derive_jtag_auth()) for a whole
+ * list of UIDs, together with its SHA-256, the value the OTP holds for the
+ * hash type. provision -k -u does the same for one board.
+ *
+ * The key is fixed, so the two HMAC pad blocks are hashed once and every
+ * UID costs three SHA-256 blocks: the inner hash, the outer hash and the
+ * hash of the ID. These run eight UIDs at a time, one per lane of a vector
+ * (GCC vector extensions; AVX2 with -march=native, two SSE halves without).
+ * Threads take chunks of UIDs from their own range and, when it runs out,
+ * from the others' ranges, through an atomic cursor per range: no locks,
+ * and no thread idles while another still has work.
+ *
+ * Input: text, one UID per line in 32 hex digits as get_uid prints it, or
+ * with -r raw 16 byte UIDs. Output: text lines "uid id hash", or with -o a
+ * table file written through a shared mapping: a keygen_header_t, then one
+ * keygen_record_t per UID in input order.
+ *
+ * Usage:
+ *   jtag_keygen -k key [-r] [-t threads] [-o table] uids|-
+ *   jtag_keygen -k key -b [-n count] [-t threads]     Benchmark on random UIDs
+ *
+ * Build:
+ *   gcc -O2 -march=native -pthread -Itools/sim -Isrc/OTP_Example -Irzn/fsp/inc -Irzn/fsp/inc/api \
+ *       -o jtag_keygen tools/jtag_keygen/jtag_keygen.c src/OTP_Example/sha256.c
+ ******************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "hal_data.h"
+#include "cmd_otp.h"
+#include "device_setup.h"
+#include "sha256.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* UIDs per vector */
+#define KEYGEN_LANES            (8U)
+
+/* UIDs a thread takes at a time */
+#define KEYGEN_CHUNK            (4096U)
+
+#define KEYGEN_MAX_THREADS      (256U)
+#define KEYGEN_MAGIC            "JKEY"
+#define KEYGEN_VERSION          (1U)
+#define DEFAULT_BENCH_COUNT     (1000000U)
+
+/* Bit lengths in the padding of the three blocks */
+#define INNER_BITS              ((SHA256_BLOCK_SIZE + UID_SIZE) * 8U)
+#define OUTER_BITS              ((SHA256_BLOCK_SIZE + SHA256_DIGEST_SIZE) * 8U)
+#define ID_BITS                 (JAUTHID_ID_SIZE * 8U)
+
+#define ROTR(x, n)              (((x) >> (n)) | ((x) << (32U - (n))))
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+/* One 32-bit word of each of the eight lanes */
+typedef uint32_t vec_t __attribute__((vector_size(KEYGEN_LANES * sizeof(uint32_t))));
+
+/* Table file header, little endian */
+typedef struct
+{
+    char     magic[4];                      // KEYGEN_MAGIC
+    uint32_t version;                       // KEYGEN_VERSION
+    uint32_t count;                         // Records that follow
+    uint32_t record_size;                   // sizeof(keygen_record_t)
+} keygen_header_t;
+
+/* Table record */
+typedef struct
+{
+    uint8_t uid[UID_SIZE];
+    uint8_t id[JAUTHID_ID_SIZE];            // Plain type ID, what the debugger presents
+    uint8_t hash[SHA256_DIGEST_SIZE];       // SHA-256 of the ID, what the OTP holds for the hash type
+} keygen_record_t;
+
+/* A thread's share of the UIDs. Its owner and thieves both take chunks from
+ * next, so a chunk is handed out once. */
+typedef struct
+{
+    _Atomic uint64_t next;
+    uint64_t         end;
+    char             pad[64 - (2 * sizeof(uint64_t))];  // One cache line per range
+} keygen_range_t;
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static const uint32_t s_k[64] =
+{
+    0x428A2F98UL, 0x71374491UL, 0xB5C0FBCFUL, 0xE9B5DBA5UL, 0x3956C25BUL, 0x59F111F1UL, 0x923F82A4UL, 0xAB1C5ED5UL,
+    0xD807AA98UL, 0x12835B01UL, 0x243185BEUL, 0x550C7DC3UL, 0x72BE5D74UL, 0x80DEB1FEUL, 0x9BDC06A7UL, 0xC19BF174UL,
+    0xE49B69C1UL, 0xEFBE4786UL, 0x0FC19DC6UL, 0x240CA1CCUL, 0x2DE92C6FUL, 0x4A7484AAUL, 0x5CB0A9DCUL, 0x76F988DAUL,
+    0x983E5152UL, 0xA831C66DUL, 0xB00327C8UL, 0xBF597FC7UL, 0xC6E00BF3UL, 0xD5A79147UL, 0x06CA6351UL, 0x14292967UL,
+    0x27B70A85UL, 0x2E1B2138UL, 0x4D2C6DFCUL, 0x53380D13UL, 0x650A7354UL, 0x766A0ABBUL, 0x81C2C92EUL, 0x92722C85UL,
+    0xA2BFE8A1UL, 0xA81A664BUL, 0xC24B8B70UL, 0xC76C51A3UL, 0xD192E819UL, 0xD6990624UL, 0xF40E3585UL, 0x106AA070UL,
+    0x19A4C116UL, 0x1E376C08UL, 0x2748774CUL, 0x34B0BCB5UL, 0x391C0CB3UL, 0x4ED8AA4AUL, 0x5B9CCA4FUL, 0x682E6FF3UL,
+    0x748F82EEUL, 0x78A5636FUL, 0x84C87814UL, 0x8CC70208UL, 0x90BEFFFAUL, 0xA4506CEBUL, 0xBEF9A3F7UL, 0xC67178F2UL,
+};
+
+static const uint32_t s_h0[8] =
+{
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL, 0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL,
+};
+
+static uint8_t          s_key[JAUTH_KEY_SIZE];
+static uint32_t         s_inner[8];                 // Chaining value after (key ^ ipad)
+static uint32_t         s_outer[8];                 // Chaining value after (key ^ opad)
+static uint8_t const  * s_p_uids;
+static keygen_record_t * s_p_records;
+static keygen_range_t   s_ranges[KEYGEN_MAX_THREADS];
+static uint32_t         s_num_threads = 1U;
+
+static double now_s (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+static uint32_t get_be32 (uint8_t const * p)
+{
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | (uint32_t) p[3];
+}
+
+static void put_be32 (uint8_t * p, uint32_t value)
+{
+    p[0] = (uint8_t) (value >> 24);
+    p[1] = (uint8_t) (value >> 16);
+    p[2] = (uint8_t) (value >> 8);
+    p[3] = (uint8_t) value;
+}
+
+static int parse_hex (char const * p_text, uint32_t length, uint8_t * p_out, uint32_t size)
+{
+    if ((size * 2U) != length)
+    {
+        return -1;
+    }
+
+    for (uint32_t i = 0U; i < (size * 2U); i++)
+    {
+        if (!isxdigit((unsigned char) p_text[i]))
+        {
+            return -1;
+        }
+    }
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        char hex[3] = {p_text[i * 2U], p_text[(i * 2U) + 1U], '\0'};
+        p_out[i] = (uint8_t) strtoul(hex, NULL, 16);
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Eight lane SHA-256
+ ******************************************************************************/
+
+/* Compress one block in each lane. p_state holds the lanes' chaining values
+ * and is updated; w is the message block, word t of every lane in w[t]. */
+static void sha256_x8 (vec_t * p_state, vec_t * w)
+{
+    vec_t a = p_state[0];
+    vec_t b = p_state[1];
+    vec_t c = p_state[2];
+    vec_t d = p_state[3];
+    vec_t e = p_state[4];
+    vec_t f = p_state[5];
+    vec_t g = p_state[6];
+    vec_t h = p_state[7];
+
+    for (uint32_t t = 0U; t < 64U; t++)
+    {
+        if (t >= 16U)
+        {
+            vec_t w15 = w[(t - 15U) & 15U];
+            vec_t w2  = w[(t - 2U) & 15U];
+            w[t & 15U] += (ROTR(w2, 17U) ^ ROTR(w2, 19U) ^ (w2 >> 10U)) + w[(t - 7U) & 15U] +
+                          (ROTR(w15, 7U) ^ ROTR(w15, 18U) ^ (w15 >> 3U));
+        }
+
+        vec_t t1 = h + (ROTR(e, 6U) ^ ROTR(e, 11U) ^ ROTR(e, 25U)) + (g ^ (e & (f ^ g))) + s_k[t] + w[t & 15U];
+        vec_t t2 = (ROTR(a, 2U) ^ ROTR(a, 13U) ^ ROTR(a, 22U)) + ((a & b) | (c & (a | b)));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    p_state[0] += a;
+    p_state[1] += b;
+    p_state[2] += c;
+    p_state[3] += d;
+    p_state[4] += e;
+    p_state[5] += f;
+    p_state[6] += g;
+    p_state[7] += h;
+}
+
+/* Set a block to words, then the padding and the bit length. */
+static void pad_block (vec_t * w, uint32_t words, uint32_t bits)
+{
+    w[words] = (vec_t) {0U} + 0x80000000U;
+    for (uint32_t t = words + 1U; t < 15U; t++)
+    {
+        w[t] = (vec_t) {0U};
+    }
+    w[15] = (vec_t) {0U} + bits;
+}
+
+/* IDs and hashes of UIDs [first, first + count), count up to KEYGEN_LANES. */
+static void keygen_x8 (uint64_t first, uint32_t count)
+{
+    vec_t    w[16];
+    vec_t    state[8];
+    vec_t    id[4];
+    uint32_t lane_of[KEYGEN_LANES];
+
+    /* Lanes past count repeat the last UID and are not stored. */
+    for (uint32_t j = 0U; j < KEYGEN_LANES; j++)
+    {
+        lane_of[j] = (j < count) ? j : (count - 1U);
+    }
+
+    /* Inner hash: H((key ^ ipad) || UID), from the saved chaining value. */
+    for (uint32_t t = 0U; t < (UID_SIZE / 4U); t++)
+    {
+        for (uint32_t j = 0U; j < KEYGEN_LANES; j++)
+        {
+            w[t][j] = get_be32(&s_p_uids[((first + lane_of[j]) * UID_SIZE) + (t * 4U)]);
+        }
+    }
+    pad_block(w, UID_SIZE / 4U, INNER_BITS);
+    for (uint32_t i = 0U; i < 8U; i++)
+    {
+        state[i] = (vec_t) {0U} + s_inner[i];
+    }
+    sha256_x8(state, w);
+
+    /* Outer hash: H((key ^ opad) || inner). The ID is its first 16 bytes. */
+    for (uint32_t t = 0U; t < 8U; t++)
+    {
+        w[t] = state[t];
+    }
+    pad_block(w, SHA256_DIGEST_SIZE / 4U, OUTER_BITS);
+    for (uint32_t i = 0U; i < 8U; i++)
+    {
+        state[i] = (vec_t) {0U} + s_outer[i];
+    }
+    sha256_x8(state, w);
+
+    /* Hash of the ID. */
+    for (uint32_t t = 0U; t < (JAUTHID_ID_SIZE / 4U); t++)
+    {
+        id[t] = state[t];
+        w[t]  = state[t];
+    }
+    pad_block(w, JAUTHID_ID_SIZE / 4U, ID_BITS);
+    for (uint32_t i = 0U; i < 8U; i++)
+    {
+        state[i] = (vec_t) {0U} + s_h0[i];
+    }
+    sha256_x8(state, w);
+
+    for (uint32_t j = 0U; j < count; j++)
+    {
+        keygen_record_t * p_rec = &s_p_records[first + j];
+
+        memcpy(p_rec->uid, &s_p_uids[(first + j) * UID_SIZE], UID_SIZE);
+        for (uint32_t t = 0U; t < (JAUTHID_ID_SIZE / 4U); t++)
+        {
+            put_be32(&p_rec->id[t * 4U], id[t][j]);
+        }
+        for (uint32_t t = 0U; t < 8U; t++)
+        {
+            put_be32(&p_rec->hash[t * 4U], state[t][j]);
+        }
+    }
+}
+
+/* Hash the two HMAC pad blocks of the key once. */
+static void keygen_init (void)
+{
+    uint8_t      pad[SHA256_BLOCK_SIZE];
+    sha256_ctx_t ctx;
+
+    memset(pad, 0, sizeof(pad));
+    memcpy(pad, s_key, JAUTH_KEY_SIZE);
+    for (uint32_t i = 0U; i < SHA256_BLOCK_SIZE; i++)
+    {
+        pad[i] ^= 0x36U;
+    }
+    sha256_init(&ctx);
+    sha256_update(&ctx, pad, SHA256_BLOCK_SIZE);
+    memcpy(s_inner, ctx.state, sizeof(s_inner));
+
+    for (uint32_t i = 0U; i < SHA256_BLOCK_SIZE; i++)
+    {
+        pad[i] ^= (uint8_t) (0x36U ^ 0x5CU);
+    }
+    sha256_init(&ctx);
+    sha256_update(&ctx, pad, SHA256_BLOCK_SIZE);
+    memcpy(s_outer, ctx.state, sizeof(s_outer));
+
+    sha256_wipe(pad, sizeof(pad));
+    sha256_wipe(&ctx, sizeof(ctx));
+}
+
+/******************************************************************************
+ * Work stealing thread pool
+ ******************************************************************************/
+
+/* Take the next chunk of a range. Returns false when the range is used up. */
+static bool take_chunk (keygen_range_t * p_range, uint64_t * p_first, uint64_t * p_end)
+{
+    uint64_t first = atomic_fetch_add_explicit(&p_range->next, KEYGEN_CHUNK, memory_order_relaxed);
+
+    if (first >= p_range->end)
+    {
+        return false;
+    }
+
+    *p_first = first;
+    *p_end   = ((first + KEYGEN_CHUNK) < p_range->end) ? (first + KEYGEN_CHUNK) : p_range->end;
+
+    return true;
+}
+
+static void * keygen_worker (void * p_arg)
+{
+    uint32_t self = (uint32_t) (uintptr_t) p_arg;
+    uint64_t first;
+    uint64_t end;
+
+    /* Own range first, then steal from the others in turn. */
+    for (uint32_t i = 0U; i < s_num_threads; i++)
+    {
+        keygen_range_t * p_range = &s_ranges[(self + i) % s_num_threads];
+
+        while (take_chunk(p_range, &first, &end))
+        {
+            for (uint64_t n = first; n < end; n += KEYGEN_LANES)
+            {
+                keygen_x8(n, ((end - n) < KEYGEN_LANES) ? (uint32_t) (end - n) : KEYGEN_LANES);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/* Fill s_p_records for count UIDs. */
+static int keygen_run (uint64_t count)
+{
+    pthread_t threads[KEYGEN_MAX_THREADS];
+    uint64_t  share = (((count / s_num_threads) + KEYGEN_CHUNK - 1U) / KEYGEN_CHUNK) * KEYGEN_CHUNK;
+
+    /* Ranges start on chunk boundaries, so only the last chunk of the list
+     * is short. */
+    for (uint32_t i = 0U; i < s_num_threads; i++)
+    {
+        uint64_t first = (uint64_t) i * share;
+        uint64_t end   = first + share;
+
+        atomic_store(&s_ranges[i].next, (first < count) ? first : count);
+        s_ranges[i].end = ((end < count) && ((i + 1U) < s_num_threads)) ? end : count;
+    }
+
+    for (uint32_t i = 1U; i < s_num_threads; i++)
+    {
+        if (0 != pthread_create(&threads[i], NULL, keygen_worker, (void *) (uintptr_t) i))
+        {
+            perror("pthread_create");
+
+            return -1;
+        }
+    }
+    (void) keygen_worker((void *) 0);
+    for (uint32_t i = 1U; i < s_num_threads; i++)
+    {
+        (void) pthread_join(threads[i], NULL);
+    }
+
+    return 0;
+}
+
+/* Compare records with the firmware's own routines (sha256_hmac()). */
+static uint64_t keygen_check (uint64_t count, uint64_t step)
+{
+    uint64_t bad = 0U;
+
+    for (uint64_t n = 0U; n < count; n += step)
+    {
+        keygen_record_t const * p_rec = &s_p_records[n];
+        uint8_t                 mac[SHA256_DIGEST_SIZE];
+        uint8_t                 hash[SHA256_DIGEST_SIZE];
+
+        sha256_hmac(s_key, JAUTH_KEY_SIZE, &s_p_uids[n * UID_SIZE], UID_SIZE, mac);
+        sha256_calc(mac, JAUTHID_ID_SIZE, hash);
+        if ((0 != memcmp(p_rec->uid, &s_p_uids[n * UID_SIZE], UID_SIZE)) ||
+            (0 != memcmp(p_rec->id, mac, JAUTHID_ID_SIZE)) || (0 != memcmp(p_rec->hash, hash, SHA256_DIGEST_SIZE)))
+        {
+            bad++;
+        }
+    }
+
+    return bad;
+}
+
+/******************************************************************************
+ * Input and output
+ ******************************************************************************/
+
+/* Read the UID list. Text lines are parsed into a packed array. */
+static uint8_t * read_uids (char const * p_path, bool raw, uint64_t * p_count)
+{
+    FILE   * p_file = (0 == strcmp(p_path, "-")) ? stdin : fopen(p_path, "rb");
+    uint8_t * p_data = NULL;
+    size_t   size    = 0U;
+    size_t   cap     = 0U;
+    size_t   got;
+
+    if (NULL == p_file)
+    {
+        perror(p_path);
+
+        return NULL;
+    }
+    do
+    {
+        if ((size + 65536U) > cap)
+        {
+            cap    = (0U == cap) ? (1U << 20) : (cap * 2U);
+            p_data = realloc(p_data, cap);
+            if (NULL == p_data)
+            {
+                perror("realloc");
+
+                return NULL;
+            }
+        }
+        got   = fread(&p_data[size], 1U, cap - size, p_file);
+        size += got;
+    } while (0U != got);
+    if (stdin != p_file)
+    {
+        fclose(p_file);
+    }
+
+    if (raw)
+    {
+        if (0U != (size % UID_SIZE))
+        {
+            fprintf(stderr, "%s: size is not a multiple of %u\n", p_path, (unsigned) UID_SIZE);
+            free(p_data);
+
+            return NULL;
+        }
+        *p_count = size / UID_SIZE;
+
+        return p_data;
+    }
+
+    /* Text: the packed UIDs overwrite the text behind the parse cursor. */
+    uint64_t count = 0U;
+    uint64_t line  = 0U;
+    size_t   pos   = 0U;
+    while (pos < size)
+    {
+        char const * p_line = (char const *) &p_data[pos];
+        char const * p_eol  = memchr(p_line, '\n', size - pos);
+        size_t       length = (NULL != p_eol) ? (size_t) (p_eol - p_line) : (size - pos);
+        size_t       text   = length;
+        uint8_t      uid[UID_SIZE];
+
+        line++;
+        pos += length + 1U;
+        while ((0U != text) && isspace((unsigned char) p_line[text - 1U]))
+        {
+            text--;
+        }
+        if ((0U == text) || ('#' == p_line[0]))
+        {
+            continue;
+        }
+        if (0 != parse_hex(p_line, (uint32_t) text, uid, UID_SIZE))
+        {
+            fprintf(stderr, "%s: line %llu: a UID is %u hex digits\n", p_path, (unsigned long long) line,
+                    (unsigned) (UID_SIZE * 2U));
+            free(p_data);
+
+            return NULL;
+        }
+        memcpy(&p_data[count * UID_SIZE], uid, UID_SIZE);
+        count++;
+    }
+    *p_count = count;
+
+    return p_data;
+}
+
+/* Map the output table; the records are written straight into the file. */
+static keygen_header_t * map_table (char const * p_path, uint64_t count, size_t * p_size)
+{
+    size_t size = sizeof(keygen_header_t) + ((size_t) count * sizeof(keygen_record_t));
+    int    fd   = open(p_path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+
+    if ((fd < 0) || (0 != ftruncate(fd, (off_t) size)))
+    {
+        perror(p_path);
+
+        return NULL;
+    }
+
+    void * p_map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == p_map)
+    {
+        perror("mmap");
+
+        return NULL;
+    }
+    *p_size = size;
+
+    return (keygen_header_t *) p_map;
+}
+
+static void print_hex (FILE * p_out, uint8_t const * p_data, uint32_t size)
+{
+    static char const digits[] = "0123456789abcdef";
+    char              text[(SHA256_DIGEST_SIZE * 2U) + 1U];
+
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        text[i * 2U]        = digits[p_data[i] >> 4];
+        text[(i * 2U) + 1U] = digits[p_data[i] & 0x0FU];
+    }
+    text[size * 2U] = '\0';
+    fputs(text, p_out);
+}
+
+/******************************************************************************
+ * Benchmark
+ ******************************************************************************/
+
+static int run_benchmark (uint64_t count)
+{
+    uint8_t * p_uids = malloc((size_t) count * UID_SIZE);
+    FILE    * p_rand = fopen("/dev/urandom", "rb");
+
+    s_p_records = mmap(NULL, (size_t) count * sizeof(keygen_record_t), PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ((NULL == p_uids) || (NULL == p_rand) || (MAP_FAILED == s_p_records) ||
+        (1U != fread(p_uids, (size_t) count * UID_SIZE, 1U, p_rand)))
+    {
+        perror("benchmark setup");
+
+        return 1;
+    }
+    fclose(p_rand);
+    s_p_uids = p_uids;
+
+    /* Reference: the firmware routine, one UID at a time. */
+    uint64_t sample = (count < 100000U) ? count : 100000U;
+    double   t0     = now_s();
+    for (uint64_t n = 0U; n < sample; n++)
+    {
+        uint8_t mac[SHA256_DIGEST_SIZE];
+        uint8_t hash[SHA256_DIGEST_SIZE];
+        sha256_hmac(s_key, JAUTH_KEY_SIZE, &p_uids[n * UID_SIZE], UID_SIZE, mac);
+        sha256_calc(mac, JAUTHID_ID_SIZE, hash);
+    }
+    double t_ref = (now_s() - t0) / (double) sample;
+
+    t0 = now_s();
+    keygen_init();
+    if (0 != keygen_run(count))
+    {
+        return 1;
+    }
+    double   seconds = now_s() - t0;
+    uint64_t bad     = keygen_check(count, 1U);
+
+    printf("sha256_hmac() per UID, 1 thread: %.0f UIDs/s\n", 1.0 / t_ref);
+    printf("%u lanes, %u thread(s):          %.0f UIDs/s, %llu UIDs in %.3f s (%.1fx)\n", (unsigned) KEYGEN_LANES,
+           (unsigned) s_num_threads, (double) count / seconds, (unsigned long long) count, seconds,
+           (t_ref * (double) count) / seconds);
+    printf("checked against sha256_hmac():   %llu mismatches\n", (unsigned long long) bad);
+
+    return (0U == bad) ? 0 : 1;
+}
+
+int main (int argc, char ** argv)
+{
+    char const * p_key_text = NULL;
+    char const * p_input    = NULL;
+    char const * p_output   = NULL;
+    bool         raw        = false;
+    bool         benchmark  = false;
+    uint64_t     count      = DEFAULT_BENCH_COUNT;
+    long         cpus       = sysconf(_SC_NPROCESSORS_ONLN);
+
+    s_num_threads = (cpus > 0) ? (uint32_t) cpus : 1U;
+    for (int i = 1; i < argc; i++)
+    {
+        if ((0 == strcmp(argv[i], "-k")) && ((i + 1) < argc))
+        {
+            p_key_text = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-o")) && ((i + 1) < argc))
+        {
+            p_output = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-t")) && ((i + 1) < argc))
+        {
+            s_num_threads = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-n")) && ((i + 1) < argc))
+        {
+            count = strtoull(argv[++i], NULL, 0);
+        }
+        else if (0 == strcmp(argv[i], "-r"))
+        {
+            raw = true;
+        }
+        else if (0 == strcmp(argv[i], "-b"))
+        {
+            benchmark = true;
+        }
+        else if ((NULL == p_input) && (('-' != argv[i][0]) || (0 == strcmp(argv[i], "-"))))
+        {
+            p_input = argv[i];
+        }
+        else
+        {
+            p_key_text = NULL;
+            break;
+        }
+    }
+
+    if ((NULL == p_key_text) || ((NULL == p_input) && !benchmark) || (0U == s_num_threads) ||
+        (s_num_threads > KEYGEN_MAX_THREADS) || (0U == count))
+    {
+        fprintf(stderr, "usage: %s -k key [-r] [-t threads] [-o table] uids|-\n", argv[0]);
+        fprintf(stderr, "       %s -k key -b [-n count] [-t threads]\n", argv[0]);
+        return 2;
+    }
+    if (0 != parse_hex(p_key_text, (uint32_t) strlen(p_key_text), s_key, JAUTH_KEY_SIZE))
+    {
+        fprintf(stderr, "-k needs %u hex digits\n", (unsigned) (JAUTH_KEY_SIZE * 2U));
+        return 2;
+    }
+
+    if (benchmark)
+    {
+        return run_benchmark(count);
+    }
+
+    double    t0     = now_s();
+    uint8_t * p_uids = read_uids(p_input, raw, &count);
+    if (NULL == p_uids)
+    {
+        return 1;
+    }
+    if (0U == count)
+    {
+        fprintf(stderr, "%s: no UIDs\n", p_input);
+        return 1;
+    }
+    s_p_uids = p_uids;
+
+    keygen_header_t * p_table    = NULL;
+    size_t            table_size = 0U;
+    if (NULL != p_output)
+    {
+        p_table = map_table(p_output, count, &table_size);
+        if (NULL == p_table)
+        {
+            return 1;
+        }
+        memcpy(p_table->magic, KEYGEN_MAGIC, sizeof(p_table->magic));
+        p_table->version     = KEYGEN_VERSION;
+        p_table->count       = (uint32_t) count;
+        p_table->record_size = (uint32_t) sizeof(keygen_record_t);
+        s_p_records          = (keygen_record_t *) (p_table + 1);
+    }
+    else
+    {
+        s_p_records = malloc((size_t) count * sizeof(keygen_record_t));
+        if (NULL == s_p_records)
+        {
+            perror("malloc");
+            return 1;
+        }
+    }
+
+    double t1 = now_s();
+    keygen_init();
+    if (0 != keygen_run(count))
+    {
+        return 1;
+    }
+    double t2 = now_s();
+
+    /* Spot check: every 1024th UID against the firmware routines. */
+    if (0U != keygen_check(count, 1024U))
+    {
+        fprintf(stderr, "self check failed\n");
+        return 1;
+    }
+
+    if (NULL != p_table)
+    {
+        if (0 != msync(p_table, table_size, MS_SYNC))
+        {
+            perror(p_output);
+            return 1;
+        }
+        (void) munmap(p_table, table_size);
+    }
+    else
+    {
+        for (uint64_t n = 0U; n < count; n++)
+        {
+            print_hex(stdout, s_p_records[n].uid, UID_SIZE);
+            fputc(' ', stdout);
+            print_hex(stdout, s_p_records[n].id, JAUTHID_ID_SIZE);
+            fputc(' ', stdout);
+            print_hex(stdout, s_p_records[n].hash, SHA256_DIGEST_SIZE);
+            fputc('\n', stdout);
+        }
+    }
+
+    fprintf(stderr, "%llu UIDs: read %.3f s, derive %.3f s (%u thread(s)), total %.3f s\n", (unsigned long long) count,
+            t1 - t0, t2 - t1, (unsigned) s_num_threads, now_s() - t0);
+    sha256_wipe(s_key, sizeof(s_key));
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Compiled provisioning script, see compiled_script.h.
+ ******************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "device_setup.h"
+#include "compiled_script.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+#define CSCRIPT_MAX_ENTRIES     (1U << 20)          // Frames or slots, well above any script
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+
+/* Check the tables against the file. Every offset is checked before it is
+ * used. */
+static bool cscript_valid (cscript_t const * p_script)
+{
+    cscript_header_t const * p_header = p_script->p_header;
+    size_t                   size     = p_script->size;
+
+    if ((CSCRIPT_MAGIC != p_header->magic) || (CSCRIPT_VERSION != p_header->version) ||
+        (size != p_header->file_size) || (0U == p_header->num_frames) ||
+        (CSCRIPT_MAX_ENTRIES < p_header->num_frames) || (CSCRIPT_MAX_ENTRIES < p_header->num_slots) ||
+        (FRAME_MAX_SIZE < p_header->num_shifts) || (p_header->frames_offset != sizeof(cscript_header_t)) ||
+        (p_header->slots_offset != (p_header->frames_offset + (p_header->num_frames * sizeof(cscript_frame_t)))) ||
+        (p_header->shifts_offset != (p_header->slots_offset + (p_header->num_slots * sizeof(cscript_slot_t)))) ||
+        (size < (p_header->shifts_offset + (p_header->num_shifts * CRC32_SHIFT_WORDS * sizeof(uint32_t)))))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0U; i < p_header->num_frames; i++)
+    {
+        cscript_frame_t const * p_frame = &p_script->p_frames[i];
+
+        /* Each frame carries its own index as the tag, as provision encodes it. */
+        if ((p_frame->offset > size) || (p_frame->size > (size - p_frame->offset)) ||
+            (p_frame->size < (FRAME_HEADER_SIZE + sizeof(head_t) + FRAME_CRC_SIZE)) ||
+            (p_frame->size > FRAME_MAX_SIZE) || (p_frame->shift >= p_header->num_shifts) ||
+            ((uint8_t) i != ((head_t const *) (p_script->p_map + p_frame->offset + FRAME_HEADER_SIZE))->tag))
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0U; i < p_header->num_slots; i++)
+    {
+        cscript_slot_t const * p_slot = &p_script->p_slots[i];
+
+        if ((p_slot->frame >= p_header->num_frames) || (p_slot->size > CRC32_PATCH_MAX_SIZE) ||
+            (p_slot->shift >= p_header->num_shifts) || (p_slot->offset < (FRAME_HEADER_SIZE + sizeof(head_t))) ||
+            ((p_slot->offset + p_slot->size) > (p_script->p_frames[p_slot->frame].size - FRAME_CRC_SIZE)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int cscript_open (cscript_t * p_script, char const * p_path)
+{
+    struct stat st;
+    int         fd = open(p_path, O_RDONLY);
+
+    memset(p_script, 0, sizeof(*p_script));
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (0 != fstat(fd, &st))
+    {
+        (void) close(fd);
+
+        return -1;
+    }
+    if ((size_t) st.st_size < sizeof(cscript_header_t))
+    {
+        (void) close(fd);
+        errno = EBADMSG;
+
+        return -1;
+    }
+
+    p_script->size  = (size_t) st.st_size;
+    p_script->p_map = mmap(NULL, p_script->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    (void) close(fd);
+    if (MAP_FAILED == p_script->p_map)
+    {
+        p_script->p_map = NULL;
+
+        return -1;
+    }
+
+    p_script->p_header = (cscript_header_t const *) p_script->p_map;
+    p_script->p_frames = (cscript_frame_t const *) (p_script->p_map + p_script->p_header->frames_offset);
+    p_script->p_slots  = (cscript_slot_t const *) (p_script->p_map + p_script->p_header->slots_offset);
+    p_script->p_shifts = (uint32_t const *) (p_script->p_map + p_script->p_header->shifts_offset);
+    if (!cscript_valid(p_script))
+    {
+        cscript_close(p_script);
+        errno = EBADMSG;
+
+        return -1;
+    }
+
+    return 0;
+}
+
+void cscript_close (cscript_t * p_script)
+{
+    if (NULL != p_script->p_map)
+    {
+        (void) munmap(p_script->p_map, p_script->size);
+    }
+    memset(p_script, 0, sizeof(*p_script));
+}
+
+uint32_t const * cscript_shift (cscript_t const * p_script, uint32_t index)
+{
+    return &p_script->p_shifts[index * CRC32_SHIFT_WORDS];
+}
+
+void cscript_template (cscript_t * p_script, uint32_t i, frame_template_t * p_template)
+{
+    cscript_frame_t const * p_frame = &p_script->p_frames[i];
+
+    p_template->p_frame = p_script->p_map + p_frame->offset;
+    p_template->size    = p_frame->size;
+    p_template->p_shift = cscript_shift(p_script, p_frame->shift);
+}
+
+void cscript_patch (cscript_t * p_script, cscript_slot_t const * p_slot, uint8_t const * p_value)
+{
+    cscript_frame_t const * p_frame = &p_script->p_frames[p_slot->frame];
+    uint8_t               * p_data  = p_script->p_map + p_frame->offset;
+    uint8_t               * p_crc   = &p_data[p_frame->size - FRAME_CRC_SIZE];
+    uint32_t                crc;
+
+    /* The frame CRC is big endian. */
+    crc = ((uint32_t) p_crc[0] << 24) | ((uint32_t) p_crc[1] << 16) | ((uint32_t) p_crc[2] << 8) | p_crc[3];
+    crc = crc32_patch(crc, cscript_shift(p_script, p_slot->shift), &p_data[p_slot->offset], p_value, p_slot->size);
+    memcpy(&p_data[p_slot->offset], p_value, p_slot->size);
+    p_crc[0] = (uint8_t) (crc >> 24);
+    p_crc[1] = (uint8_t) (crc >> 16);
+    p_crc[2] = (uint8_t) (crc >> 8);
+    p_crc[3] = (uint8_t) crc;
+}
@@ -0,0 +1,116 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+#ifndef COMPILED_SCRIPT_H_
+#define COMPILED_SCRIPT_H_
+
+/******************************************************************************
+ * Compiled provisioning script (host only), written by provision -c and
+ * run by provision -x.
+ *
+ * The file holds every command of a script as a finished data frame,
+ * CRC included, so a station maps it and writes the frames to the line as
+ * they are. What changes from board to board is patched in place through
+ * slots, each with the CRC shift table of its position (crc32_patch()):
+ * the session ID of OPEN_SESSION, and the JTAG ID of set_jauthid and
+ * setup_jauth lines written with "derive". The link patches seq, ack and
+ * sack itself with the shift table of each frame (frame_send_template()).
+ *
+ * A shift table depends only on the number of bytes after the field, so
+ * frames and slots share them: one for each frame size, in practice.
+ *
+ * Layout: cscript_header_t, the frame table, the slot table, the shift
+ * tables (CRC32_SHIFT_WORDS words each), then the frames. Numbers are in host byte order; a file is for stations of the
+ * same architecture as the one that compiled it.
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "crc.h"
+#include "frame.h"
+
+#define CSCRIPT_MAGIC           (0x52435350UL)      // "PSCR"
+#define CSCRIPT_VERSION         (1U)
+
+/* Slot kinds */
+#define CSCRIPT_SLOT_SESSION    (1U)                // OPEN_SESSION ID, random for each run
+#define CSCRIPT_SLOT_JAUTH_ID   (2U)                // JTAG ID, HMAC-SHA256(-k key, UID) of the board
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t num_frames;
+    uint32_t num_slots;
+    uint32_t num_shifts;
+    uint32_t frames_offset;                         // Frame table
+    uint32_t slots_offset;                          // Slot table
+    uint32_t shifts_offset;                         // Shift tables
+    uint32_t file_size;
+    uint32_t flash_bytes;                           // write_flash data, before compression
+} cscript_header_t;
+
+/* One command */
+typedef struct
+{
+    uint32_t offset;                                // Encoded frame, from the start of the file
+    uint32_t size;
+    uint32_t line;                                  // Script line, for the report
+    uint32_t wait;                                  // Send only when every earlier command is answered
+    uint32_t shift;                                 // Shift table for the link's seq, ack and sack
+    char     name[16];
+} cscript_frame_t;
+
+/* One per-board field */
+typedef struct
+{
+    uint32_t frame;                                 // Index in the frame table
+    uint32_t offset;                                // Of the field in the frame
+    uint32_t size;
+    uint32_t kind;                                  // CSCRIPT_SLOT_*
+    uint32_t shift;                                 // Shift table for the bytes from the field to the CRC
+} cscript_slot_t;
+
+/* A mapped compiled script */
+typedef struct
+{
+    uint8_t                * p_map;
+    size_t                   size;
+    cscript_header_t const * p_header;
+    cscript_frame_t const  * p_frames;
+    cscript_slot_t const   * p_slots;
+    uint32_t const         * p_shifts;
+} cscript_t;
+
+/* Map a compiled script copy on write, so that patches stay in this
+ * mapping, and check every table and offset in it. Returns 0, or -1 with
+ * errno set (EBADMSG for a file that is not a compiled script of this
+ * version, or is damaged). */
+int cscript_open(cscript_t * p_script, char const * p_path);
+void cscript_close(cscript_t * p_script);
+
+/* Shift table number index */
+uint32_t const * cscript_shift(cscript_t const * p_script, uint32_t index);
+
+/* Frame template of command i; the link writes seq, ack and sack into it. */
+void cscript_template(cscript_t * p_script, uint32_t i, frame_template_t * p_template);
+
+/* Write a per-board field into its frame and correct the frame's CRC. */
+void cscript_patch(cscript_t * p_script, cscript_slot_t const * p_slot, uint8_t const * p_value);
+
+#endif /* COMPILED_SCRIPT_H_ */
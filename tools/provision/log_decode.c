@@ -0,0 +1,124 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Board log decoder. See log_decode.h.
+ ******************************************************************************/
+#include <string.h>
+#include "device_setup.h"
+#include "log.h"
+#include "log_decode.h"
+
+/* Format of each token, from the table the firmware is built with */
+typedef struct
+{
+    uint32_t     nargs;
+    char const * p_format;
+} log_format_t;
+
+#define LOG_TOKEN_FORMAT(name, nargs, format)    {(nargs), (format)},
+static log_format_t const s_formats[LOG_TOKEN_COUNT] =
+{
+    LOG_TOKENS(LOG_TOKEN_FORMAT)
+};
+#undef LOG_TOKEN_FORMAT
+
+static uint32_t get_be32 (uint8_t const * p_data)
+{
+    return ((uint32_t) p_data[0] << 24) | ((uint32_t) p_data[1] << 16) | ((uint32_t) p_data[2] << 8) |
+           (uint32_t) p_data[3];
+}
+
+void log_decoder_init (log_decoder_t * p_decoder)
+{
+    memset(p_decoder, 0, sizeof(*p_decoder));
+}
+
+int log_decode (log_decoder_t * p_decoder, FILE * p_out, uint8_t const * p_data, uint32_t size)
+{
+    uint32_t dropped;
+    uint32_t tick_hz;
+    uint32_t offset  = LOG_RESULT_HEAD_SIZE;
+    int      records = 0;
+
+    if (LOG_RESULT_HEAD_SIZE > size)
+    {
+        return -1;
+    }
+    dropped = get_be32(&p_data[0]);
+    tick_hz = get_be32(&p_data[4]);
+    if (0U == tick_hz)
+    {
+        return -1;
+    }
+    if (dropped != p_decoder->dropped)
+    {
+        fprintf(p_out, "log: %u records dropped, the ring was full\n", (unsigned) (dropped - p_decoder->dropped));
+        p_decoder->dropped = dropped;
+    }
+
+    while ((offset + 8U) <= size)
+    {
+        uint32_t header = get_be32(&p_data[offset]);
+        uint32_t stamp  = get_be32(&p_data[offset + 4U]);
+        uint32_t nargs  = LOG_HEADER_NARGS(header);
+        uint32_t token  = LOG_HEADER_TOKEN(header);
+        uint32_t args[LOG_MAX_ARGS] = {0U};
+
+        if ((LOG_RECORD_MARK != (header & 0xFFU)) || (nargs > LOG_MAX_ARGS) ||
+            ((offset + (LOG_RECORD_WORDS(nargs) * 4U)) > size))
+        {
+            return -1;
+        }
+        for (uint32_t i = 0U; i < nargs; i++)
+        {
+            args[i] = get_be32(&p_data[offset + 8U + (i * 4U)]);
+        }
+        offset += LOG_RECORD_WORDS(nargs) * 4U;
+
+        /* Unsigned difference: right across one wrap of the 32-bit stamp. */
+        if (p_decoder->started)
+        {
+            p_decoder->ticks += (uint32_t) (stamp - p_decoder->last_stamp);
+        }
+        p_decoder->started    = true;
+        p_decoder->last_stamp = stamp;
+
+        fprintf(p_out, "[%12.6f] ", (double) p_decoder->ticks / (double) tick_hz);
+        if ((token < LOG_TOKEN_COUNT) && (s_formats[token].nargs == nargs))
+        {
+            fprintf(p_out, s_formats[token].p_format, args[0], args[1], args[2], args[3]);
+        }
+        else
+        {
+            /* Newer firmware, or a table that does not match: the raw record. */
+            fprintf(p_out, "token %u:", (unsigned) token);
+            for (uint32_t i = 0U; i < nargs; i++)
+            {
+                fprintf(p_out, " 0x%08x", (unsigned) args[i]);
+            }
+        }
+        fputc('\n', p_out);
+        p_decoder->records++;
+        records++;
+    }
+
+    return (offset == size) ? records : -1;
+}
@@ -0,0 +1,53 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+#ifndef LOG_DECODE_H_
+#define LOG_DECODE_H_
+
+/******************************************************************************
+ * Decoder of the board log (host only), the counterpart of
+ * src/OTP_Example/log.c.
+ *
+ * The board keeps token numbers and raw arguments; the format strings come
+ * from the token table in src/OTP_Example/log.h, compiled in here. Time
+ * stamps (32 bits, log_tick_hz()) are carried across wraps from one record
+ * to the next, so they read as seconds since the first record decoded.
+ ******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* State kept from one READ_LOG response to the next */
+typedef struct
+{
+    bool     started;
+    uint32_t last_stamp;
+    uint64_t ticks;                  // Since the first record
+    uint32_t dropped;                // As last reported by the board
+    uint32_t records;
+} log_decoder_t;
+
+void log_decoder_init(log_decoder_t * p_decoder);
+
+/* Print the records of one READ_LOG response (its data, after the return
+ * code), one line each. Returns the number of records, or -1 if the data is
+ * malformed (what came before is printed). */
+int log_decode(log_decoder_t * p_decoder, FILE * p_out, uint8_t const * p_data, uint32_t size);
+
+#endif /* LOG_DECODE_H_ */
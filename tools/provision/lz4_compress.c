@@ -0,0 +1,150 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * LZ4 block compressor. See lz4_compress.h.
+ ******************************************************************************/
+#include <string.h>
+#include "lz4_compress.h"
+
+/* Shortest match the format can express */
+#define LZ4_MIN_MATCH          (4U)
+
+/* Format rules: the last 5 bytes are literals, and the last match starts at
+ * least 12 bytes before the end of the block. */
+#define LZ4_LAST_LITERALS      (5U)
+#define LZ4_MATCH_LIMIT        (12U)
+
+/* Largest match offset */
+#define LZ4_MAX_OFFSET         (65535U)
+
+/* Hash table of the positions of recent 4-byte sequences */
+#define LZ4_HASH_BITS          (12U)
+#define LZ4_HASH_SIZE          (1U << LZ4_HASH_BITS)
+
+static uint32_t read32 (uint8_t const * p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+
+    return v;
+}
+
+static uint32_t hash32 (uint32_t v)
+{
+    return (v * 2654435761U) >> (32U - LZ4_HASH_BITS);
+}
+
+/* Write a length that did not fit in its token nibble. */
+static uint8_t * put_length (uint8_t * p_dst, uint32_t length)
+{
+    while (length >= 255U)
+    {
+        *p_dst++ = 255U;
+        length  -= 255U;
+    }
+    *p_dst++ = (uint8_t) length;
+
+    return p_dst;
+}
+
+/* Worst case size of a sequence with this many literals and a match. */
+static uint32_t sequence_bound (uint32_t literals)
+{
+    return 1U + (literals / 255U) + 1U + literals + 2U + 1U;
+}
+
+uint32_t lz4_compress (uint8_t const * p_src, uint32_t size, uint8_t * p_dst, uint32_t dst_size)
+{
+    uint32_t  table[LZ4_HASH_SIZE];
+    uint8_t * p_out    = p_dst;
+    uint8_t * p_end    = p_dst + dst_size;
+    uint32_t  anchor   = 0U;
+    uint32_t  pos      = 0U;
+    uint32_t  limit    = (size > LZ4_MATCH_LIMIT) ? (size - LZ4_MATCH_LIMIT) : 0U;
+    uint32_t  match_end_limit = (size > LZ4_LAST_LITERALS) ? (size - LZ4_LAST_LITERALS) : 0U;
+
+    /* 0 reads as "no entry": a match at offset pos - 0 is checked below. */
+    memset(table, 0, sizeof(table));
+
+    while (pos < limit)
+    {
+        uint32_t seq  = read32(&p_src[pos]);
+        uint32_t h    = hash32(seq);
+        uint32_t cand = table[h];
+
+        table[h] = pos;
+        if ((cand >= pos) || ((pos - cand) > LZ4_MAX_OFFSET) || (read32(&p_src[cand]) != seq))
+        {
+            pos++;
+            continue;
+        }
+
+        /* Extend the match forward, stopping before the last literals. */
+        uint32_t length = LZ4_MIN_MATCH;
+        while (((pos + length) < match_end_limit) && (p_src[cand + length] == p_src[pos + length]))
+        {
+            length++;
+        }
+
+        uint32_t literals = pos - anchor;
+        uint32_t offset   = pos - cand;
+        if ((uint32_t) (p_end - p_out) < (sequence_bound(literals) + ((length - LZ4_MIN_MATCH) / 255U)))
+        {
+            return 0U;
+        }
+
+        uint8_t * p_token = p_out++;
+        uint32_t  ml      = length - LZ4_MIN_MATCH;
+        *p_token = (uint8_t) (((literals < 15U) ? literals : 15U) << 4);
+        if (literals >= 15U)
+        {
+            p_out = put_length(p_out, literals - 15U);
+        }
+        memcpy(p_out, &p_src[anchor], literals);
+        p_out   += literals;
+        *p_out++ = (uint8_t) offset;
+        *p_out++ = (uint8_t) (offset >> 8);
+        *p_token |= (uint8_t) ((ml < 15U) ? ml : 15U);
+        if (ml >= 15U)
+        {
+            p_out = put_length(p_out, ml - 15U);
+        }
+
+        pos   += length;
+        anchor = pos;
+    }
+
+    /* Last sequence: the remaining bytes as literals. */
+    uint32_t literals = size - anchor;
+    if ((uint32_t) (p_end - p_out) < (1U + (literals / 255U) + 1U + literals))
+    {
+        return 0U;
+    }
+    *p_out++ = (uint8_t) (((literals < 15U) ? literals : 15U) << 4);
+    if (literals >= 15U)
+    {
+        p_out = put_length(p_out, literals - 15U);
+    }
+    memcpy(p_out, &p_src[anchor], literals);
+    p_out += literals;
+
+    return (uint32_t) (p_out - p_dst);
+}
@@ -0,0 +1,2166 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Host tool: station provisioner.
+ *
+ * Runs a script of device setup commands against one board (or a virtual
+ * board, tools/sim/virtual_board.c) over a serial device or pty.
+ *
+ * The whole script is parsed and encoded into packet_t commands before the
+ * device is opened, so a bad line never leaves a board half provisioned.
+ * Once connected, up to FRAME_WINDOW_SIZE commands are kept in flight: the
+ * board runs them one after another in script order, and the line never
+ * waits for a response before the next command goes out. Each command is
+ * tagged with its index, since the board answers cached queries ahead of
+ * queued commands. When the board stops answering, the link is reset and
+ * the unanswered commands are sent again with their original tags; the
+ * board answers an OTP write it already ran from its replay cache instead
+ * of writing again. Each run starts with OPEN_SESSION (a random ID), which
+ * clears that cache, so a run never gets the answers of the last one. The report gives
+ * the time of each phase, so the link, not the operator, bounds the time
+ * per board.
+ *
+ * Script (one command per line, '#' starts a comment, numbers in C syntax):
+ *   get_uid
+ *   read_otp    <address>
+ *   write_otp   <address> <data>
+ *   get_jauth
+ *   set_jauth   <mode> <type>       (type 0 plain, 1 hash)
+ *   set_jauthid <mode> <type> <id: 32 hex digits>|derive   (the board writes the SHA-256 of the ID for type 1)
+ *   setup_jauth <mode> <type> <id: 32 hex digits>|derive   (ID, type and mode in one verified OTP session)
+ *   derive_jauth <mode> <type> <key: 64 hex digits> (as setup_jauth, with the ID derived from the UID)
+ *   get_sciusb
+ *   set_sciusb  <mode>
+ *   write_flash <address> <file>   (address at a 4 KB sector boundary)
+ *   profile     <file>             (the writes a profile needs, planned here)
+ *   apply_profile <file> [dry]     (the same, planned and run by the board)
+ *   read_log                       (print the board's log records, src/OTP_Example/log.h)
+ *   read_audit  [<cursor>]         (print the board's OTP writes from write number cursor on, 0 by default)
+ *
+ * write_flash sends the file in page sized WRITE_FLASH commands and ends
+ * with VERIFY_FLASH, which checks the CRC-32 of the file against the flash.
+ * The board erases and programs while the next pages arrive. With -z each
+ * sector goes as one WRITE_FLASH_LZ4 block instead, when it compresses;
+ * the report then gives the compression ratio and the image throughput.
+ * With -D the board first returns the CRC-32 of each sector it holds
+ * (DIGEST_FLASH), and only the sectors that differ from the file are sent,
+ * erased and programmed; the VERIFY_FLASH still covers the whole file.
+ *
+ * derive_jauth sends a master key; the board programs the first 16 bytes
+ * of HMAC-SHA256(key, UID) as its ID and keeps no copy of the key. -k with
+ * -u works out the ID of a board from the key and its UID (get_uid), and
+ * prints it with its SHA-256, the value the OTP holds for the hash type.
+ * The same ID can be worked out here instead, so that the key never goes
+ * to the board: set_jauthid and setup_jauth take "derive" for the ID, and
+ * with -k the line is sent once every command before it is answered, with
+ * the ID of the UID of the first get_uid that succeeded.
+ *
+ * A profile file states what the board should look like instead of the
+ * commands that get it there (one setting per line, '#' starts a comment):
+ *   jauth   <mode> <type> [<id: 32 hex digits>]   (mode 1, 2 or 4; no ID for 4)
+ *   sciusb  <mode>
+ *   counter <bits>                  (anti-rollback counter bits that must be set)
+ *   word    <address> <value>       (user area and boot mode area words)
+ * For a profile line the board's state is read first (get_jauth,
+ * get_sciusb, read_otp), and otp_plan_make() (src/OTP_Example/otp_plan.c)
+ * works out the writes it still needs: values already there cost nothing,
+ * and a target the OTP rules rule out (a locked word, a lower JTAG mode,
+ * SCI/USB boot enabled again) is reported before anything is written.
+ * apply_profile sends the profile to the board instead, which runs the
+ * same planner on its OTP and also checks the JTAG ID area it cannot
+ * read out.
+ *
+ * read_audit fetches the board's own record of its OTP writes
+ * (src/OTP_Example/otp_audit.h): address, value, result and time of each,
+ * numbered from reset. The board keeps the last OTP_AUDIT_ENTRIES; an
+ * answer that does not reach the last write is followed by another
+ * READ_AUDIT from where it stopped, so the OTP is never read back for it.
+ * Writes overwritten before they were fetched, and a board reset since the
+ * cursor, are reported.
+ *
+ * With -R the run is added to a UID registry (tools/registry): the UID of
+ * the first get_uid, the mode and type of the last get_jauth, the bits set
+ * in the anti-rollback counter area by the read_otp lines that cover it,
+ * and the number of failed commands. A board seen before is reported as a
+ * repeat, with its number of runs and the time of its first one. Stations
+ * may share one registry file.
+ *
+ * -c compiles the script instead of running it: the file holds every
+ * command as a finished frame, CRC included (tools/provision/compiled_script.h).
+ * -x runs such a file. It is mapped, not parsed or encoded, and the frames
+ * go to the line as they are: the session ID and derived JTAG IDs are
+ * patched in with their CRC corrections, and the link writes its sequence
+ * numbers in the same way, so the work per board does not grow with the
+ * script or its images. profile lines (planned from the board's answers),
+ * derive_jauth (the key would be stored in the file) and -D are not
+ * compiled.
+ *
+ * Usage:
+ *   provision -d device [-b baud] [-t timeout_s] [-r retries] [-q] [-z] [-D] [-k key] [-R registry [-S station]]
+ *             script|-|-x compiled
+ *   provision -c compiled [-z] script|-
+ *   provision -k key -u uid
+ *
+ * Build:
+ *   gcc -O2 -Itools/sim -Itools/registry -Isrc/OTP_Example -Irzn/fsp/inc -Irzn/fsp/inc/api -o provision \
+ *       tools/provision/provision.c tools/provision/lz4_compress.c tools/sim/transport_host.c \
+ *       src/OTP_Example/frame.c src/OTP_Example/crc.c src/OTP_Example/sha256.c \
+ *       src/OTP_Example/otp_plan.c tools/provision/compiled_script.c tools/provision/log_decode.c \
+ *       tools/registry/uid_registry.c
+ ******************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "hal_data.h"
+#include "common.h"
+#include "cmd_flash.h"
+#include "cmd_otp.h"
+#include "otp_audit.h"
+#include "otp.h"
+#include "otp_plan.h"
+#include "crc.h"
+#include "frame.h"
+#include "log_decode.h"
+#include "lz4_compress.h"
+#include "compiled_script.h"
+#include "sha256.h"
+#include "device_setup.h"
+#include "transport_host.h"
+#include "uid_registry.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+#define DEFAULT_BAUD_RATE       (115200U)
+#define DEFAULT_TIMEOUT_S       (5U)
+#define DEFAULT_RETRIES         (2U)
+#define POLL_MS                 (10U)
+#define MAX_COMMANDS            (65536U)
+#define MAX_COMMAND_SIZE        (FRAME_MAX_PAYLOAD)
+#define LZ4_MAX_PACKED          (MAX_COMMAND_SIZE - sizeof(head_t) - sizeof(cmd_write_flash_lz4_t))
+#define MAX_RESPONSE_DATA       (UID_SIZE)
+#define MAX_LINE                (256U)
+#define MAX_IMAGES              (16U)
+#define MAX_PROFILES            (4U)
+#define COMPILED_HEAD_SIZE      (sizeof(head_t) + 8U)   // Of a compiled command, kept for the report
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+/* One scripted command and its result */
+typedef struct
+{
+    uint8_t  packet[MAX_COMMAND_SIZE];
+    uint32_t size;
+    uint32_t line;                          // Script line, for the report
+    char     name[16];
+    double   sent_s;
+    double   done_s;
+    bool     done;
+    uint8_t  ret;
+    uint8_t  data[MAX_RESPONSE_DATA];
+    uint32_t data_size;
+    bool     wait;                          // Send only when every earlier command is answered
+    bool     skipped;                       // Not sent: the flash sector is unchanged
+    uint32_t image;                         // write_flash image (index + 1), 0 for none
+    uint32_t sector;                        // Sector of the image the command writes or digests
+    uint32_t profile;                       // profile line (index + 1) the command reads for, 0 for none
+    bool     derive;                        // The JTAG ID is still to be derived from the UID
+    frame_template_t       tpl;             // -x: the frame in the compiled script
+    cscript_slot_t const * p_slot;          // -x: the slot of the derived JTAG ID
+} job_t;
+
+/* One write_flash line, for -D */
+typedef struct
+{
+    uint32_t   address;
+    uint32_t   size;
+    uint32_t   sectors;                     // Whole sectors; a partial last one is always sent
+    uint32_t * p_crc;                       // CRC-32 of each whole sector of the file
+    bool     * p_same;                      // The board already holds the sector
+    uint32_t   first_job;                   // First BEGIN_FLASH
+    uint32_t   end_job;                     // After the last data command
+    uint32_t   digests_left;                // DIGEST_FLASH answers still to come
+} flash_image_t;
+
+/* One profile line, planned when the board's state is read */
+typedef struct
+{
+    otp_profile_t profile;
+    uint32_t      line;
+    uint32_t      first_read;               // get_jauth, get_sciusb, counter words, profile words
+    uint32_t      first_step;               // PLAN_MAX_STEPS jobs, filled in by the plan
+    uint32_t      reads_left;
+} profile_run_t;
+
+/* Command table entry */
+typedef struct
+{
+    char const * p_name;
+    uint8_t      code;
+    uint32_t     num_args;                  // Numeric arguments
+    uint32_t     hex_size;                  // Bytes of the hex argument that follows, 0 for none
+} command_def_t;
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static command_def_t const s_commands[] =
+{
+    {"get_uid",      CMD_GET_UID,      0U, 0U             },
+    {"read_otp",     CMD_READ_OTP,     1U, 0U             },
+    {"write_otp",    CMD_WRITE_OTP,    2U, 0U             },
+    {"get_jauth",    CMD_GET_JAUTH,    0U, 0U             },
+    {"set_jauth",    CMD_SET_JAUTH,    2U, 0U             },
+    {"set_jauthid",  CMD_SET_JAUTHID,  2U, JAUTHID_ID_SIZE},
+    {"setup_jauth",  CMD_SETUP_JAUTH,  2U, JAUTHID_ID_SIZE},
+    {"derive_jauth", CMD_DERIVE_JAUTH, 2U, JAUTH_KEY_SIZE },
+    {"get_sciusb",   CMD_GET_SCIUSB,   0U, 0U             },
+    {"set_sciusb",   CMD_SET_SCIUSB,   1U, 0U             },
+    {"read_log",     CMD_READ_LOG,     0U, 0U             },
+};
+
+/* Text of plan_err_t */
+static char const * const s_plan_errors[] =
+{
+    "ok",
+    "word outside the write-once areas",
+    "word listed twice",
+    "word already written with another value",
+    "more counter bits than the area holds",
+    "SCI/USB boot cannot be enabled again",
+    "JTAG mode cannot go down",
+    "JTAG type cannot change",
+    "JTAG ID area holds another ID",
+    "board state could not be read",
+};
+
+static job_t                s_jobs[MAX_COMMANDS];
+static uint32_t             s_num_jobs;
+static uint32_t             s_num_sent;             // Send cursor
+static uint32_t             s_num_issued;           // Commands sent at least once
+static uint32_t             s_num_done;
+static uint32_t             s_num_failed;
+static uint32_t             s_num_resent;
+static bool                 s_quiet;
+static bool                 s_compress;             // -z: write_flash sends LZ4 blocks
+static uint32_t             s_flash_bytes;          // write_flash data, before compression
+static bool                 s_delta;                // -D: write_flash skips unchanged sectors
+static flash_image_t        s_images[MAX_IMAGES];
+static uint32_t             s_num_images;
+static profile_run_t        s_profiles[MAX_PROFILES];
+static uint32_t             s_num_profiles;
+static uint32_t             s_num_answered;         // Commands before this one are all answered
+static uint32_t             s_num_skipped;          // Commands of unchanged sectors
+static uint32_t             s_sectors_same;
+static uint32_t             s_sectors_total;
+static uint8_t              s_key[JAUTH_KEY_SIZE];  // -k: master key of "derive" IDs
+static bool                 s_have_key;
+static bool                 s_compiling;            // -c
+static cscript_t            s_script;               // -x
+static log_decoder_t        s_log;                  // read_log
+static frame_link_t         s_link;
+static transport_instance_t s_transport;
+
+static double now_s (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+static uint32_t now_ms (void)
+{
+    return (uint32_t) (uint64_t) (now_s() * 1000.0);
+}
+
+static void put_be16 (uint8_t * p_data, uint16_t value)
+{
+    p_data[0] = (uint8_t) (value >> 8);
+    p_data[1] = (uint8_t) value;
+}
+
+static uint32_t get_be32 (uint8_t const * p_data)
+{
+    return ((uint32_t) p_data[0] << 24) | ((uint32_t) p_data[1] << 16) | ((uint32_t) p_data[2] << 8) |
+           (uint32_t) p_data[3];
+}
+
+static void put_be32 (uint8_t * p_data, uint32_t value)
+{
+    p_data[0] = (uint8_t) (value >> 24);
+    p_data[1] = (uint8_t) (value >> 16);
+    p_data[2] = (uint8_t) (value >> 8);
+    p_data[3] = (uint8_t) value;
+}
+
+/******************************************************************************
+ * Script parsing and encoding
+ ******************************************************************************/
+
+static int parse_hex (char const * p_text, uint8_t * p_id, uint32_t size)
+{
+    if ((NULL == p_text) || ((size * 2U) != strlen(p_text)))
+    {
+        return -1;
+    }
+
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        char hex[3] = {p_text[i * 2U], p_text[(i * 2U) + 1U], '\0'};
+        if (!isxdigit((unsigned char) hex[0]) || !isxdigit((unsigned char) hex[1]))
+        {
+            return -1;
+        }
+        p_id[i] = (uint8_t) strtoul(hex, NULL, 16);
+    }
+
+    return 0;
+}
+
+/* Fill in the job details and packet header around an encoded payload. */
+static packet_t * encode_job (job_t * p_job, uint32_t line, char const * p_name, uint8_t code, uint32_t payload)
+{
+    packet_t * p_pkt = (packet_t *) p_job->packet;
+
+    p_job->line = line;
+    snprintf(p_job->name, sizeof(p_job->name), "%s", p_name);
+
+    p_pkt->head.type = PACKET_TYPE_COMMAND;
+    p_pkt->head.code = code;
+    p_pkt->head.tag  = (uint8_t) (p_job - s_jobs);
+    put_be32(p_pkt->head.payload_size, payload);
+    p_job->size = (uint32_t) sizeof(head_t) + payload;
+
+    return p_pkt;
+}
+
+/* Clear the next job of s_jobs. Returns its packet, or NULL when the list is full. */
+static packet_t * new_job (uint32_t line)
+{
+    job_t * p_job = &s_jobs[s_num_jobs];
+
+    if (MAX_COMMANDS == s_num_jobs)
+    {
+        fprintf(stderr, "line %u: more than %u commands\n", (unsigned) line, (unsigned) MAX_COMMANDS);
+
+        return NULL;
+    }
+    memset(p_job, 0, sizeof(*p_job));
+
+    return (packet_t *) p_job->packet;
+}
+
+/* Encode "write_flash <address> <file>" as BEGIN_FLASH, WRITE_FLASH (or,
+ * with -z, WRITE_FLASH_LZ4) and VERIFY_FLASH jobs. The jobs are added to
+ * s_jobs.
+ *
+ * With -D, DIGEST_FLASH jobs come first and every sector starts with its
+ * own BEGIN_FLASH. The rest waits for the digests; flash_delta() then drops
+ * the sectors the board already holds, and the BEGIN_FLASH inside runs of
+ * changed sectors. */
+static int encode_flash (char ** pp_save, uint32_t line)
+{
+    char          * p_addr  = strtok_r(NULL, " \t\r\n", pp_save);
+    char          * p_path  = strtok_r(NULL, " \t\r\n", pp_save);
+    char          * p_end   = NULL;
+    flash_image_t * p_image = NULL;
+    uint8_t       * p_data;
+    uint32_t        address;
+    uint32_t        size;
+    long            file_size;
+    FILE          * p_file;
+    packet_t      * p_pkt;
+
+    if ((NULL == p_addr) || (NULL == p_path) || (NULL != strtok_r(NULL, " \t\r\n", pp_save)))
+    {
+        fprintf(stderr, "line %u: write_flash needs an address and a file\n", (unsigned) line);
+
+        return -1;
+    }
+    errno   = 0;
+    address = (uint32_t) strtoul(p_addr, &p_end, 0);
+    if ((0 != errno) || ('\0' != *p_end))
+    {
+        fprintf(stderr, "line %u: bad number '%s'\n", (unsigned) line, p_addr);
+
+        return -1;
+    }
+    if (s_delta && ((0U != (address % FLASH_SECTOR_SIZE)) || (MAX_IMAGES == s_num_images)))
+    {
+        fprintf(stderr, "line %u: -D needs a sector aligned address and at most %u write_flash lines\n",
+                (unsigned) line, (unsigned) MAX_IMAGES);
+
+        return -1;
+    }
+
+    p_file = fopen(p_path, "rb");
+    if ((NULL == p_file) || (0 != fseek(p_file, 0L, SEEK_END)) || ((file_size = ftell(p_file)) < 0) ||
+        (0 != fseek(p_file, 0L, SEEK_SET)))
+    {
+        fprintf(stderr, "line %u: %s: %s\n", (unsigned) line, p_path, strerror(errno));
+        if (NULL != p_file)
+        {
+            fclose(p_file);
+        }
+
+        return -1;
+    }
+    if ((0L == file_size) || (file_size > (long) FLASH_AREA_SIZE))
+    {
+        fprintf(stderr, "line %u: %s is empty or larger than the flash\n", (unsigned) line, p_path);
+        fclose(p_file);
+
+        return -1;
+    }
+    size   = (uint32_t) file_size;
+    p_data = malloc(size);
+    if ((NULL == p_data) || (size != fread(p_data, 1U, size, p_file)))
+    {
+        fprintf(stderr, "line %u: %s: read error\n", (unsigned) line, p_path);
+        free(p_data);
+        fclose(p_file);
+
+        return -1;
+    }
+    fclose(p_file);
+
+    if (s_delta)
+    {
+        p_image          = &s_images[s_num_images++];
+        p_image->address = address;
+        p_image->size    = size;
+        p_image->sectors = size / FLASH_SECTOR_SIZE;
+        p_image->p_crc   = calloc(p_image->sectors + 1U, sizeof(uint32_t));
+        p_image->p_same  = calloc(p_image->sectors + 1U, sizeof(bool));
+        if ((NULL == p_image->p_crc) || (NULL == p_image->p_same))
+        {
+            free(p_data);
+
+            return -1;
+        }
+        s_sectors_total += (size + FLASH_SECTOR_SIZE - 1U) / FLASH_SECTOR_SIZE;
+
+        for (uint32_t sector = 0U; sector < p_image->sectors; sector += FLASH_DIGEST_MAX_SECTORS)
+        {
+            uint32_t count = p_image->sectors - sector;
+            count = (count < FLASH_DIGEST_MAX_SECTORS) ? count : FLASH_DIGEST_MAX_SECTORS;
+            p_pkt = new_job(line);
+            if (NULL == p_pkt)
+            {
+                free(p_data);
+
+                return -1;
+            }
+            put_be32(p_pkt->cmd.dflash.address, address + (sector * FLASH_SECTOR_SIZE));
+            put_be16(p_pkt->cmd.dflash.count, (uint16_t) count);
+            (void) encode_job(&s_jobs[s_num_jobs], line, "digest_flash", CMD_DIGEST_FLASH,
+                              (uint32_t) sizeof(cmd_digest_flash_t));
+            s_jobs[s_num_jobs].image  = s_num_images;
+            s_jobs[s_num_jobs].sector = sector;
+            s_num_jobs++;
+            p_image->digests_left++;
+        }
+        for (uint32_t sector = 0U; sector < p_image->sectors; sector++)
+        {
+            p_image->p_crc[sector] = crc32_calc(0U, &p_data[sector * FLASH_SECTOR_SIZE], FLASH_SECTOR_SIZE);
+        }
+        p_image->first_job = s_num_jobs;
+    }
+
+    for (uint32_t done = 0U; done < size; )
+    {
+        uint32_t offset = address + done;
+        uint32_t chunk;
+
+        /* A new stream for the image, or for each sector with -D. */
+        if ((0U == done) || (s_delta && (0U == (done % FLASH_SECTOR_SIZE))))
+        {
+            p_pkt = new_job(line);
+            if (NULL == p_pkt)
+            {
+                free(p_data);
+
+                return -1;
+            }
+            put_be32(p_pkt->cmd.bflash.address, offset);
+            put_be32(p_pkt->cmd.bflash.size, size - done);
+            (void) encode_job(&s_jobs[s_num_jobs], line, "begin_flash", CMD_BEGIN_FLASH,
+                              (uint32_t) sizeof(cmd_begin_flash_t));
+            s_jobs[s_num_jobs].wait   = (NULL != p_image) && (0U == done) && (0U != p_image->digests_left);
+            s_jobs[s_num_jobs].image  = s_delta ? s_num_images : 0U;
+            s_jobs[s_num_jobs].sector = done / FLASH_SECTOR_SIZE;
+            s_num_jobs++;
+        }
+
+        /* The largest block up to the next sector boundary whose compressed
+         * form fits in a command: a sector, then halves of it. When no block
+         * larger than a page fits, or it does not get smaller, the data goes
+         * as it is, up to the next page boundary, and the next block is tried
+         * from there. */
+        p_pkt = new_job(line);
+        if (NULL == p_pkt)
+        {
+            free(p_data);
+
+            return -1;
+        }
+        if (s_compress)
+        {
+            uint32_t packed = 0U;
+
+            chunk = FLASH_LZ4_MAX_DATA - (offset % FLASH_LZ4_MAX_DATA);
+            chunk = (chunk < (size - done)) ? chunk : (size - done);
+            while (chunk > FLASH_PAGE_SIZE)
+            {
+                packed = lz4_compress(&p_data[done], chunk, p_pkt->cmd.wflz4.data, LZ4_MAX_PACKED);
+                if (0U != packed)
+                {
+                    break;
+                }
+                chunk /= 2U;
+            }
+            if ((0U != packed) && (packed < chunk))
+            {
+                put_be32(p_pkt->cmd.wflz4.address, offset);
+                put_be32(p_pkt->cmd.wflz4.size, chunk);
+                (void) encode_job(&s_jobs[s_num_jobs], line, "write_flash", CMD_WRITE_FLASH_LZ4,
+                                  (uint32_t) sizeof(cmd_write_flash_lz4_t) + packed);
+            }
+            else
+            {
+                chunk = 0U;
+            }
+        }
+        else
+        {
+            chunk = 0U;
+        }
+
+        if (0U == chunk)
+        {
+            chunk = FLASH_WRITE_MAX_DATA - (offset % FLASH_PAGE_SIZE);
+            chunk = (chunk < (size - done)) ? chunk : (size - done);
+            put_be32(p_pkt->cmd.wflash.address, offset);
+            memcpy(p_pkt->cmd.wflash.data, &p_data[done], chunk);
+            (void) encode_job(&s_jobs[s_num_jobs], line, "write_flash", CMD_WRITE_FLASH,
+                              (uint32_t) sizeof(cmd_write_flash_t) + chunk);
+        }
+        s_jobs[s_num_jobs].image  = s_delta ? s_num_images : 0U;
+        s_jobs[s_num_jobs].sector = done / FLASH_SECTOR_SIZE;
+        s_num_jobs++;
+        s_flash_bytes += chunk;
+        done          += chunk;
+    }
+    if (NULL != p_image)
+    {
+        p_image->end_job = s_num_jobs;
+    }
+
+    p_pkt = new_job(line);
+    if (NULL == p_pkt)
+    {
+        free(p_data);
+
+        return -1;
+    }
+    put_be32(p_pkt->cmd.vflash.address, address);
+    put_be32(p_pkt->cmd.vflash.size, size);
+    put_be32(p_pkt->cmd.vflash.digest, crc32_calc(0U, p_data, size));
+    (void) encode_job(&s_jobs[s_num_jobs], line, "verify_flash", CMD_VERIFY_FLASH,
+                      (uint32_t) sizeof(cmd_verify_flash_t));
+    s_num_jobs++;
+    free(p_data);
+
+    return 0;
+}
+
+/* Read a profile file. Returns 0, or -1 after reporting the error. */
+static int parse_profile (char const * p_path, otp_profile_t * p_profile)
+{
+    char     text[MAX_LINE];
+    uint32_t line   = 0U;
+    FILE   * p_file = fopen(p_path, "r");
+
+    if (NULL == p_file)
+    {
+        perror(p_path);
+
+        return -1;
+    }
+
+    memset(p_profile, 0, sizeof(*p_profile));
+    p_profile->jauth_mode  = PLAN_KEEP;
+    p_profile->sciusb_mode = PLAN_KEEP;
+
+    while (NULL != fgets(text, sizeof(text), p_file))
+    {
+        char   * p_save = NULL;
+        char   * p_hash = strchr(text, '#');
+        char   * p_key;
+        char   * p_tok[4];
+        uint32_t num     = 0U;
+        uint32_t args[2] = {0U, 0U};
+        bool     ok      = true;
+
+        line++;
+        if (NULL != p_hash)
+        {
+            *p_hash = '\0';
+        }
+        p_key = strtok_r(text, " \t\r\n", &p_save);
+        if (NULL == p_key)
+        {
+            continue;
+        }
+        while ((num < 4U) && (NULL != (p_tok[num] = strtok_r(NULL, " \t\r\n", &p_save))))
+        {
+            num++;
+        }
+
+        /* Up to two numbers; the ID of jauth follows them in hex. */
+        for (uint32_t i = 0U; (i < num) && (i < 2U); i++)
+        {
+            char * p_end;
+            errno   = 0;
+            args[i] = (uint32_t) strtoul(p_tok[i], &p_end, 0);
+            ok      = ok && (0 == errno) && ('\0' == *p_end) && (args[i] <= 0xFFFFU);
+        }
+
+        if ((0 == strcmp(p_key, "jauth")) && ((2U == num) || (3U == num)) && ok)
+        {
+            p_profile->jauth_mode = (uint8_t) args[0];
+            p_profile->jauth_type = (uint8_t) args[1];
+
+            /* Modes 1 and 2 need an ID, prohibition takes none. */
+            ok = (args[0] <= 0xFFU) && (args[1] <= 0xFFU) &&
+                 ((3U == num) == ((1U == args[0]) || (2U == args[0]))) &&
+                 ((3U != num) || (0 == parse_hex(p_tok[2], p_profile->jauth_id, PLAN_ID_SIZE)));
+        }
+        else if ((0 == strcmp(p_key, "sciusb")) && (1U == num) && ok)
+        {
+            p_profile->sciusb_mode = (uint8_t) args[0];
+        }
+        else if ((0 == strcmp(p_key, "counter")) && (1U == num) && ok)
+        {
+            p_profile->counter_min = (uint16_t) args[0];
+        }
+        else if ((0 == strcmp(p_key, "word")) && (2U == num) && ok && (p_profile->num_words < PLAN_MAX_WORDS))
+        {
+            p_profile->words[p_profile->num_words].addr  = (uint16_t) args[0];
+            p_profile->words[p_profile->num_words].value = (uint16_t) args[1];
+            p_profile->num_words++;
+        }
+        else
+        {
+            ok = false;
+        }
+
+        if (!ok)
+        {
+            fprintf(stderr, "%s:%u: bad profile line '%s'\n", p_path, (unsigned) line, p_key);
+            fclose(p_file);
+
+            return -1;
+        }
+    }
+    fclose(p_file);
+
+    return 0;
+}
+
+/* Encode "profile <file>": the reads of the board's state, then
+ * PLAN_MAX_STEPS jobs that profile_plan() fills in from the answers. The
+ * first of them waits for the reads. */
+static int encode_profile (char ** pp_save, uint32_t line)
+{
+    char          * p_path = strtok_r(NULL, " \t\r\n", pp_save);
+    profile_run_t * p_run;
+    packet_t      * p_pkt;
+
+    if ((NULL == p_path) || (NULL != strtok_r(NULL, " \t\r\n", pp_save)))
+    {
+        fprintf(stderr, "line %u: profile needs a file\n", (unsigned) line);
+
+        return -1;
+    }
+    if (MAX_PROFILES == s_num_profiles)
+    {
+        fprintf(stderr, "line %u: more than %u profile lines\n", (unsigned) line, (unsigned) MAX_PROFILES);
+
+        return -1;
+    }
+    p_run = &s_profiles[s_num_profiles];
+    if (0 != parse_profile(p_path, &p_run->profile))
+    {
+        return -1;
+    }
+    p_run->line       = line;
+    p_run->first_read = s_num_jobs;
+    s_num_profiles++;
+
+    uint32_t counter_words = (0U != p_run->profile.counter_min) ? PLAN_COUNTER_WORDS : 0U;
+    uint32_t reads         = 2U + counter_words + p_run->profile.num_words;
+    for (uint32_t i = 0U; i < (reads + PLAN_MAX_STEPS); i++)
+    {
+        if (NULL == (p_pkt = new_job(line)))
+        {
+            return -1;
+        }
+        job_t * p_job = &s_jobs[s_num_jobs];
+
+        if (0U == i)
+        {
+            (void) encode_job(p_job, line, "get_jauth", CMD_GET_JAUTH, 0U);
+        }
+        else if (1U == i)
+        {
+            (void) encode_job(p_job, line, "get_sciusb", CMD_GET_SCIUSB, 0U);
+        }
+        else if (i < reads)
+        {
+            uint32_t n = i - 2U;
+            put_be16(p_pkt->cmd.rotp.address, (n < counter_words) ? otp_plan_counter_addr(n) :
+                     p_run->profile.words[n - counter_words].addr);
+            (void) encode_job(p_job, line, "read_otp", CMD_READ_OTP, (uint32_t) sizeof(cmd_read_otp_t));
+        }
+        else
+        {
+            (void) encode_job(p_job, line, "profile", CMD_WRITE_OTP, (uint32_t) sizeof(cmd_write_otp_t));
+            p_job->wait = (i == reads);
+        }
+        p_job->profile = s_num_profiles;
+        s_num_jobs++;
+    }
+    p_run->first_step = p_run->first_read + reads;
+    p_run->reads_left = reads;
+
+    return 0;
+}
+
+/* Encode "apply_profile <file> [dry]" as one APPLY_PROFILE. */
+static int encode_apply_profile (char ** pp_save, uint32_t line)
+{
+    char        * p_path = strtok_r(NULL, " \t\r\n", pp_save);
+    char        * p_dry  = strtok_r(NULL, " \t\r\n", pp_save);
+    otp_profile_t profile;
+    packet_t    * p_pkt;
+
+    if ((NULL == p_path) || ((NULL != p_dry) && (0 != strcmp(p_dry, "dry"))) ||
+        (NULL != strtok_r(NULL, " \t\r\n", pp_save)))
+    {
+        fprintf(stderr, "line %u: apply_profile needs a file, and 'dry' to plan only\n", (unsigned) line);
+
+        return -1;
+    }
+    if ((0 != parse_profile(p_path, &profile)) || (NULL == (p_pkt = new_job(line))))
+    {
+        return -1;
+    }
+
+    cmd_apply_profile_t * p_cmd = &p_pkt->cmd.profile;
+    p_cmd->flags       = (NULL != p_dry) ? PROFILE_FLAG_DRY_RUN : 0U;
+    p_cmd->jauth_mode  = profile.jauth_mode;
+    p_cmd->jauth_type  = profile.jauth_type;
+    p_cmd->sciusb_mode = profile.sciusb_mode;
+    put_be16(p_cmd->counter_min, profile.counter_min);
+    p_cmd->num_words = profile.num_words;
+    memcpy(p_cmd->id, profile.jauth_id, JAUTHID_ID_SIZE);
+    for (uint32_t i = 0U; i < profile.num_words; i++)
+    {
+        put_be16(&p_cmd->words[i][0], profile.words[i].addr);
+        put_be16(&p_cmd->words[i][2], profile.words[i].value);
+    }
+    (void) encode_job(&s_jobs[s_num_jobs], line, "apply_profile", CMD_APPLY_PROFILE,
+                      (uint32_t) sizeof(cmd_apply_profile_t));
+    s_num_jobs++;
+
+    return 0;
+}
+
+/* Encode "read_audit [cursor]" as one READ_AUDIT. */
+static int encode_audit (char ** pp_save, uint32_t line)
+{
+    char const * p_arg  = strtok_r(NULL, " \t\r\n", pp_save);
+    uint32_t     cursor = 0U;
+    packet_t   * p_pkt;
+
+    if (NULL != p_arg)
+    {
+        char        * p_end;
+        unsigned long value;
+
+        errno = 0;
+        value = strtoul(p_arg, &p_end, 0);
+        if ((0 != errno) || ('\0' != *p_end) || (value > 0xFFFFFFFFUL))
+        {
+            fprintf(stderr, "line %u: bad number '%s'\n", (unsigned) line, p_arg);
+
+            return -1;
+        }
+        cursor = (uint32_t) value;
+    }
+    if (NULL != strtok_r(NULL, " \t\r\n", pp_save))
+    {
+        fprintf(stderr, "line %u: too many arguments for read_audit\n", (unsigned) line);
+
+        return -1;
+    }
+    if (NULL == (p_pkt = new_job(line)))
+    {
+        return -1;
+    }
+    put_be32(p_pkt->cmd.raudit.cursor, cursor);
+    (void) encode_job(&s_jobs[s_num_jobs], line, "read_audit", CMD_READ_AUDIT, (uint32_t) sizeof(cmd_read_audit_t));
+    s_num_jobs++;
+
+    return 0;
+}
+
+/* Encode one script line into p_job. Returns 0, 1 for a blank line or a
+ * line whose jobs are already added, -1 on error. */
+static int encode_line (char * p_text, uint32_t line, job_t * p_job)
+{
+    command_def_t const * p_def = NULL;
+    packet_t            * p_pkt = (packet_t *) p_job->packet;
+    uint32_t              args[2] = {0U, 0U};
+    uint8_t               hex[JAUTH_KEY_SIZE];
+    uint32_t              payload = 0U;
+    char                * p_save  = NULL;
+    char                * p_hash  = strchr(p_text, '#');
+    char                * p_tok;
+
+    if (NULL != p_hash)
+    {
+        *p_hash = '\0';
+    }
+
+    p_tok = strtok_r(p_text, " \t\r\n", &p_save);
+    if (NULL == p_tok)
+    {
+        return 1;
+    }
+
+    if (0 == strcmp(p_tok, "write_flash"))
+    {
+        return (0 == encode_flash(&p_save, line)) ? 1 : -1;
+    }
+    if (0 == strcmp(p_tok, "profile"))
+    {
+        return (0 == encode_profile(&p_save, line)) ? 1 : -1;
+    }
+    if (0 == strcmp(p_tok, "apply_profile"))
+    {
+        return (0 == encode_apply_profile(&p_save, line)) ? 1 : -1;
+    }
+    if (0 == strcmp(p_tok, "read_audit"))
+    {
+        return (0 == encode_audit(&p_save, line)) ? 1 : -1;
+    }
+
+    for (uint32_t i = 0U; i < (sizeof(s_commands) / sizeof(s_commands[0])); i++)
+    {
+        if (0 == strcmp(p_tok, s_commands[i].p_name))
+        {
+            p_def = &s_commands[i];
+        }
+    }
+    if (NULL == p_def)
+    {
+        fprintf(stderr, "line %u: unknown command '%s'\n", (unsigned) line, p_tok);
+
+        return -1;
+    }
+    if (s_compiling && (CMD_DERIVE_JAUTH == p_def->code))
+    {
+        fprintf(stderr, "line %u: derive_jauth is not compiled, the key would be in the file; "
+                "use setup_jauth with derive and -k\n", (unsigned) line);
+
+        return -1;
+    }
+
+    for (uint32_t i = 0U; i < p_def->num_args; i++)
+    {
+        char * p_end;
+        p_tok = strtok_r(NULL, " \t\r\n", &p_save);
+        if (NULL == p_tok)
+        {
+            fprintf(stderr, "line %u: %s needs %u arguments\n", (unsigned) line, p_def->p_name,
+                    (unsigned) p_def->num_args);
+
+            return -1;
+        }
+        errno   = 0;
+        args[i] = (uint32_t) strtoul(p_tok, &p_end, 0);
+        if ((0 != errno) || ('\0' != *p_end) || (args[i] > 0xFFFFU))
+        {
+            fprintf(stderr, "line %u: bad number '%s'\n", (unsigned) line, p_tok);
+
+            return -1;
+        }
+    }
+
+    memset(p_job, 0, sizeof(*p_job));
+
+    if (0U != p_def->hex_size)
+    {
+        p_tok = strtok_r(NULL, " \t\r\n", &p_save);
+        if ((JAUTHID_ID_SIZE == p_def->hex_size) && (NULL != p_tok) && (0 == strcmp(p_tok, "derive")))
+        {
+            if (!s_have_key && !s_compiling)
+            {
+                fprintf(stderr, "line %u: derive needs the master key (-k)\n", (unsigned) line);
+
+                return -1;
+            }
+            memset(hex, 0, sizeof(hex));
+            p_job->derive = true;
+            p_job->wait   = true;
+        }
+        else if (0 != parse_hex(p_tok, hex, p_def->hex_size))
+        {
+            fprintf(stderr, "line %u: %s needs %u hex digits\n", (unsigned) line, p_def->p_name,
+                    (unsigned) (p_def->hex_size * 2U));
+
+            return -1;
+        }
+    }
+
+    switch (p_def->code)
+    {
+        case CMD_READ_OTP:
+            put_be16(p_pkt->cmd.rotp.address, (uint16_t) args[0]);
+            payload = sizeof(cmd_read_otp_t);
+            break;
+        case CMD_WRITE_OTP:
+            put_be16(p_pkt->cmd.wotp.address, (uint16_t) args[0]);
+            put_be16(p_pkt->cmd.wotp.data, (uint16_t) args[1]);
+            payload = sizeof(cmd_write_otp_t);
+            break;
+        case CMD_SET_JAUTH:
+            p_pkt->cmd.jauth.mode = (uint8_t) args[0];
+            p_pkt->cmd.jauth.type = (uint8_t) args[1];
+            payload = sizeof(cmd_set_jauth_t);
+            break;
+        case CMD_SET_JAUTHID:
+        case CMD_SETUP_JAUTH:
+            p_pkt->cmd.jauthid.mode = (uint8_t) args[0];
+            p_pkt->cmd.jauthid.type = (uint8_t) args[1];
+            memcpy(p_pkt->cmd.jauthid.id, hex, JAUTHID_ID_SIZE);
+            payload = sizeof(cmd_set_jauthid_t) + JAUTHID_ID_SIZE;
+            break;
+        case CMD_DERIVE_JAUTH:
+            p_pkt->cmd.djauth.mode = (uint8_t) args[0];
+            p_pkt->cmd.djauth.type = (uint8_t) args[1];
+            memcpy(p_pkt->cmd.djauth.key, hex, JAUTH_KEY_SIZE);
+            payload = sizeof(cmd_derive_jauth_t);
+            break;
+        case CMD_SET_SCIUSB:
+            p_pkt->cmd.sciusb.mode = (uint8_t) args[0];
+            payload = sizeof(cmd_set_sciusb_t);
+            break;
+        default:
+            break;
+    }
+
+    if (NULL != strtok_r(NULL, " \t\r\n", &p_save))
+    {
+        fprintf(stderr, "line %u: too many arguments for %s\n", (unsigned) line, p_def->p_name);
+
+        return -1;
+    }
+
+    (void) encode_job(p_job, line, p_def->p_name, p_def->code, payload);
+
+    return 0;
+}
+
+/* A new session ID for each run. */
+static uint32_t session_id (void)
+{
+    uint32_t id     = (uint32_t) time(NULL) ^ (uint32_t) (now_s() * 1e6);
+    FILE   * p_rand = fopen("/dev/urandom", "rb");
+
+    if (NULL != p_rand)
+    {
+        (void) fread(&id, sizeof(id), 1U, p_rand);
+        fclose(p_rand);
+    }
+
+    return id;
+}
+
+/* Start the script with OPEN_SESSION, so that the board does not answer
+ * its commands from the replay cache of an earlier run. */
+static void encode_session (void)
+{
+    packet_t * p_pkt = new_job(0U);
+    put_be32(p_pkt->cmd.session.id, session_id());
+    (void) encode_job(&s_jobs[s_num_jobs], 0U, "open_session", CMD_OPEN_SESSION,
+                      (uint32_t) sizeof(cmd_open_session_t));
+    s_num_jobs++;
+}
+
+static int encode_script (FILE * p_file)
+{
+    char     text[MAX_LINE];
+    uint32_t line = 0U;
+
+    encode_session();
+
+    while (NULL != fgets(text, sizeof(text), p_file))
+    {
+        line++;
+        if (MAX_COMMANDS == s_num_jobs)
+        {
+            fprintf(stderr, "line %u: more than %u commands\n", (unsigned) line, (unsigned) MAX_COMMANDS);
+
+            return -1;
+        }
+
+        int ret = encode_line(text, line, &s_jobs[s_num_jobs]);
+        if (ret < 0)
+        {
+            return -1;
+        }
+        if (0 == ret)
+        {
+            s_num_jobs++;
+        }
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Compiled scripts
+ ******************************************************************************/
+
+/* Write the encoded script as a compiled script (-c). Shift tables are
+ * found by the number of bytes they cover, which is less than a frame. */
+static int compiled_write (char const * p_path)
+{
+    static uint32_t  s_shift_of[FRAME_MAX_SIZE];    // Shift table (index + 1) of a number of bytes
+    cscript_header_t header;
+    cscript_frame_t  * p_frames = calloc(s_num_jobs, sizeof(cscript_frame_t));
+    cscript_slot_t   * p_slots  = calloc(s_num_jobs, sizeof(cscript_slot_t));
+    uint32_t         * p_bytes  = calloc(s_num_jobs * 2U, sizeof(uint32_t));  // Of each shift table
+    uint32_t           data     = 0U;
+    FILE             * p_out;
+
+    if ((NULL == p_frames) || (NULL == p_slots) || (NULL == p_bytes))
+    {
+        free(p_frames);
+        free(p_slots);
+        free(p_bytes);
+
+        return -1;
+    }
+    memset(&header, 0, sizeof(header));
+    memset(s_shift_of, 0, sizeof(s_shift_of));
+
+    for (uint32_t i = 0U; i < s_num_jobs; i++)
+    {
+        job_t    * p_job      = &s_jobs[i];
+        packet_t * p_pkt      = (packet_t *) p_job->packet;
+        uint32_t   frame_size = p_job->size + FRAME_HEADER_SIZE + FRAME_CRC_SIZE;
+        uint8_t  * p_field    = NULL;
+        uint32_t   bytes[2]   = {FRAME_TEMPLATE_FOLLOWING(frame_size), 0U};
+        uint32_t   shifts     = 1U;
+
+        p_frames[i].offset = data;
+        p_frames[i].size   = frame_size;
+        p_frames[i].line   = p_job->line;
+        p_frames[i].wait   = p_job->wait ? 1U : 0U;
+        memcpy(p_frames[i].name, p_job->name, sizeof(p_frames[i].name));
+        data += frame_size;
+
+        if (CMD_OPEN_SESSION == p_pkt->head.code)
+        {
+            p_field                          = p_pkt->cmd.session.id;
+            p_slots[header.num_slots].size   = (uint32_t) sizeof(p_pkt->cmd.session.id);
+            p_slots[header.num_slots].kind   = CSCRIPT_SLOT_SESSION;
+        }
+        else if (p_job->derive)
+        {
+            p_field                          = p_pkt->cmd.jauthid.id;
+            p_slots[header.num_slots].size   = JAUTHID_ID_SIZE;
+            p_slots[header.num_slots].kind   = CSCRIPT_SLOT_JAUTH_ID;
+        }
+        if (NULL != p_field)
+        {
+            cscript_slot_t * p_slot = &p_slots[header.num_slots++];
+            p_slot->frame  = i;
+            p_slot->offset = FRAME_HEADER_SIZE + (uint32_t) (p_field - p_job->packet);
+            bytes[1]       = frame_size - FRAME_CRC_SIZE - (p_slot->offset + p_slot->size);
+            shifts         = 2U;
+        }
+
+        for (uint32_t s = 0U; s < shifts; s++)
+        {
+            if (0U == s_shift_of[bytes[s]])
+            {
+                p_bytes[header.num_shifts] = bytes[s];
+                s_shift_of[bytes[s]]       = ++header.num_shifts;
+            }
+        }
+        p_frames[i].shift = s_shift_of[bytes[0]] - 1U;
+        if (2U == shifts)
+        {
+            p_slots[header.num_slots - 1U].shift = s_shift_of[bytes[1]] - 1U;
+        }
+    }
+
+    header.magic         = CSCRIPT_MAGIC;
+    header.version       = CSCRIPT_VERSION;
+    header.num_frames    = s_num_jobs;
+    header.frames_offset = (uint32_t) sizeof(header);
+    header.slots_offset  = header.frames_offset + (s_num_jobs * (uint32_t) sizeof(cscript_frame_t));
+    header.shifts_offset = header.slots_offset + (header.num_slots * (uint32_t) sizeof(cscript_slot_t));
+    header.file_size     = header.shifts_offset + (header.num_shifts * CRC32_SHIFT_WORDS * sizeof(uint32_t)) + data;
+    header.flash_bytes   = s_flash_bytes;
+    for (uint32_t i = 0U; i < s_num_jobs; i++)
+    {
+        p_frames[i].offset += header.file_size - data;
+    }
+
+    p_out = fopen(p_path, "wb");
+    bool ok = (NULL != p_out) && (1U == fwrite(&header, sizeof(header), 1U, p_out)) &&
+              (s_num_jobs == fwrite(p_frames, sizeof(cscript_frame_t), s_num_jobs, p_out)) &&
+              (header.num_slots == fwrite(p_slots, sizeof(cscript_slot_t), header.num_slots, p_out));
+    for (uint32_t s = 0U; ok && (s < header.num_shifts); s++)
+    {
+        uint32_t shift[CRC32_SHIFT_WORDS];
+        crc32_shift_init(shift, p_bytes[s]);
+        ok = (CRC32_SHIFT_WORDS == fwrite(shift, sizeof(uint32_t), CRC32_SHIFT_WORDS, p_out));
+    }
+    for (uint32_t i = 0U; ok && (i < s_num_jobs); i++)
+    {
+        uint8_t frame[FRAME_MAX_SIZE];
+        uint32_t size = frame_template_encode(frame, s_jobs[i].packet, s_jobs[i].size);
+        ok = (size == fwrite(frame, 1U, size, p_out));
+    }
+    if ((NULL == p_out) || (0 != fclose(p_out)) || !ok)
+    {
+        perror(p_path);
+        ok = false;
+    }
+    else
+    {
+        printf("%u commands compiled, %u bytes (%u of frames)\n", (unsigned) s_num_jobs,
+               (unsigned) header.file_size, (unsigned) data);
+    }
+    free(p_frames);
+    free(p_slots);
+    free(p_bytes);
+
+    return ok ? 0 : -1;
+}
+
+/* Map a compiled script (-x) and make its frames the jobs, and patch in a
+ * new session ID. */
+static int compiled_load (char const * p_path)
+{
+    if (0 != cscript_open(&s_script, p_path))
+    {
+        perror(p_path);
+
+        return -1;
+    }
+
+    for (uint32_t i = 0U; i < s_script.p_header->num_frames; i++)
+    {
+        job_t                 * p_job   = &s_jobs[i];
+        cscript_frame_t const * p_frame = &s_script.p_frames[i];
+
+        if (MAX_COMMANDS == i)
+        {
+            fprintf(stderr, "%s: more than %u commands\n", p_path, (unsigned) MAX_COMMANDS);
+
+            return -1;
+        }
+        memset(p_job, 0, sizeof(*p_job));
+        cscript_template(&s_script, i, &p_job->tpl);
+        p_job->size = p_frame->size - FRAME_HEADER_SIZE - FRAME_CRC_SIZE;
+        p_job->line = p_frame->line;
+        p_job->wait = (0U != p_frame->wait);
+        memcpy(p_job->packet, &p_job->tpl.p_frame[FRAME_HEADER_SIZE],
+               (p_job->size < COMPILED_HEAD_SIZE) ? p_job->size : COMPILED_HEAD_SIZE);
+        memcpy(p_job->name, p_frame->name, sizeof(p_job->name) - 1U);
+    }
+    s_num_jobs    = s_script.p_header->num_frames;
+    s_flash_bytes = s_script.p_header->flash_bytes;
+
+    for (uint32_t i = 0U; i < s_script.p_header->num_slots; i++)
+    {
+        cscript_slot_t const * p_slot = &s_script.p_slots[i];
+
+        if ((CSCRIPT_SLOT_SESSION == p_slot->kind) && (sizeof(uint32_t) == p_slot->size))
+        {
+            uint8_t id[sizeof(uint32_t)];
+            put_be32(id, session_id());
+            cscript_patch(&s_script, p_slot, id);
+        }
+        else if ((CSCRIPT_SLOT_JAUTH_ID == p_slot->kind) && (JAUTHID_ID_SIZE == p_slot->size))
+        {
+            if (!s_have_key)
+            {
+                fprintf(stderr, "line %u: derive needs the master key (-k)\n",
+                        (unsigned) s_jobs[p_slot->frame].line);
+
+                return -1;
+            }
+            s_jobs[p_slot->frame].derive = true;
+            s_jobs[p_slot->frame].p_slot = p_slot;
+        }
+        else
+        {
+            fprintf(stderr, "%s: slot %u is of an unknown kind\n", p_path, (unsigned) i);
+
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Link
+ ******************************************************************************/
+
+static void link_write (void * p_context, uint8_t const * p_data, uint32_t size)
+{
+    (void) p_context;
+    (void) s_transport.p_api->send(s_transport.p_ctrl, p_data, size);
+}
+
+/* Mark a job as answered without sending it: the sector is unchanged, or
+ * the profile needs no more writes. */
+static void job_skip (job_t * p_job)
+{
+    p_job->done    = true;
+    p_job->skipped = true;
+    p_job->ret     = RET_SUCCESS;
+    s_num_done++;
+    s_num_skipped++;
+}
+
+/* Mark a job as failed without sending it. */
+static void job_fail (job_t * p_job)
+{
+    p_job->done   = true;
+    p_job->ret    = RET_CMD_FAIL;
+    p_job->sent_s = now_s();
+    p_job->done_s = p_job->sent_s;
+    s_num_done++;
+    s_num_failed++;
+}
+
+/* Fill in the JTAG ID of a "derive" line: the first JAUTHID_ID_SIZE bytes
+ * of HMAC-SHA256(key, UID), with the UID of the first get_uid that
+ * succeeded. Every command before the line is answered (wait). Returns
+ * false when there is no such UID. */
+static bool job_derive (job_t * p_job)
+{
+    job_t const * p_uid = NULL;
+    uint8_t       mac[SHA256_DIGEST_SIZE];
+
+    for (job_t const * p_prev = s_jobs; (p_prev < p_job) && (NULL == p_uid); p_prev++)
+    {
+        if ((true == p_prev->done) && (RET_SUCCESS == p_prev->ret) && (UID_SIZE == p_prev->data_size) &&
+            (CMD_GET_UID == ((packet_t const *) p_prev->packet)->head.code))
+        {
+            p_uid = p_prev;
+        }
+    }
+    if (NULL == p_uid)
+    {
+        return false;
+    }
+
+    sha256_hmac(s_key, JAUTH_KEY_SIZE, p_uid->data, UID_SIZE, mac);
+    if (NULL != p_job->p_slot)
+    {
+        cscript_patch(&s_script, p_job->p_slot, mac);
+    }
+    else
+    {
+        memcpy(((packet_t *) p_job->packet)->cmd.jauthid.id, mac, JAUTHID_ID_SIZE);
+    }
+    sha256_wipe(mac, sizeof(mac));
+    p_job->derive = false;
+
+    return true;
+}
+
+/* Take the sector digests of a DIGEST_FLASH answer. When the image has all
+ * of them, drop the commands of unchanged sectors. A changed sector after an
+ * unchanged one (or the first) keeps its BEGIN_FLASH, which announces the
+ * run of changed sectors that follows so that only they are erased. A
+ * failed DIGEST_FLASH leaves its sectors to be sent. */
+static void flash_delta (job_t const * p_digest, uint8_t const * p_data, uint32_t size)
+{
+    flash_image_t * p_image = &s_images[p_digest->image - 1U];
+
+    if (RET_SUCCESS == p_digest->ret)
+    {
+        for (uint32_t i = 0U; ((i + 1U) * FLASH_DIGEST_SIZE) <= size; i++)
+        {
+            uint32_t sector = p_digest->sector + i;
+            if (sector < p_image->sectors)
+            {
+                p_image->p_same[sector] = (get_be32(&p_data[i * FLASH_DIGEST_SIZE]) == p_image->p_crc[sector]);
+                s_sectors_same         += p_image->p_same[sector] ? 1U : 0U;
+            }
+        }
+    }
+    if (0U != --p_image->digests_left)
+    {
+        return;
+    }
+
+    for (uint32_t i = p_image->first_job; i < p_image->end_job; i++)
+    {
+        job_t    * p_job  = &s_jobs[i];
+        packet_t * p_pkt  = (packet_t *) p_job->packet;
+        uint32_t   sector = p_job->sector;
+
+        if (p_image->p_same[sector])
+        {
+            job_skip(p_job);
+        }
+        else if (CMD_BEGIN_FLASH != p_pkt->head.code)
+        {
+            /* Changed data: send. */
+        }
+        else if ((0U != sector) && !p_image->p_same[sector - 1U])
+        {
+            /* The stream of the previous sector continues. */
+            job_skip(p_job);
+        }
+        else
+        {
+            uint32_t end = sector + 1U;
+            while ((end < p_image->sectors) && !p_image->p_same[end])
+            {
+                end++;
+            }
+            end = (end * FLASH_SECTOR_SIZE < p_image->size) ? (end * FLASH_SECTOR_SIZE) : p_image->size;
+            put_be32(p_pkt->cmd.bflash.size, end - (sector * FLASH_SECTOR_SIZE));
+        }
+    }
+}
+
+/* Plan a profile line once the board's state is read, and turn its step
+ * jobs into the planned commands. The steps that are not needed, or all of
+ * them when the profile cannot be reached, are not sent. */
+static void profile_plan (profile_run_t * p_run)
+{
+    otp_state_t state;
+    otp_plan_t  plan;
+    plan_err_t  err           = PLAN_OK;
+    uint32_t    counter_words = (0U != p_run->profile.counter_min) ? PLAN_COUNTER_WORDS : 0U;
+
+    memset(&state, 0, sizeof(state));
+    for (uint32_t i = p_run->first_read; i < p_run->first_step; i++)
+    {
+        job_t const * p_job = &s_jobs[i];
+        uint32_t      n     = i - p_run->first_read;
+        uint16_t      value = (uint16_t) ((p_job->data[0] << 8) | p_job->data[1]);
+
+        if ((RET_SUCCESS != p_job->ret) || (0U == p_job->data_size))
+        {
+            err = PLAN_ERR_READ;
+        }
+        else if (0U == n)
+        {
+            state.jauth_mode = p_job->data[0];
+            state.jauth_type = p_job->data[1];
+        }
+        else if (1U == n)
+        {
+            state.sciusb_mode = p_job->data[0];
+        }
+        else if ((n - 2U) < counter_words)
+        {
+            state.counter[n - 2U] = value;
+        }
+        else
+        {
+            state.words[n - 2U - counter_words] = value;
+        }
+    }
+
+    /* The JTAG ID area cannot be read out: SETUP_JAUTH verifies the ID
+     * before it sets the mode. */
+    if (PLAN_OK == err)
+    {
+        err = otp_plan_make(&p_run->profile, &state, &plan);
+    }
+    else
+    {
+        plan.num_steps = 0U;
+        plan.err_addr  = 0U;
+    }
+
+    if (PLAN_OK != err)
+    {
+        fprintf(stderr, "line %u: profile cannot be reached: %s (0x%04x), nothing written\n",
+                (unsigned) p_run->line, s_plan_errors[err], (unsigned) plan.err_addr);
+    }
+    else
+    {
+        printf("line %u: profile needs %u writes\n", (unsigned) p_run->line, (unsigned) plan.num_steps);
+    }
+
+    for (uint32_t i = 0U; i < PLAN_MAX_STEPS; i++)
+    {
+        job_t             * p_job  = &s_jobs[p_run->first_step + i];
+        packet_t          * p_pkt  = (packet_t *) p_job->packet;
+        plan_step_t const * p_step = &plan.steps[i];
+
+        if ((PLAN_OK != err) && (0U == i))
+        {
+            /* Reported as the failed profile line. */
+            p_job->done   = true;
+            p_job->done_s = now_s();
+            p_job->sent_s = p_job->done_s;
+            p_job->ret    = RET_DATA_FAIL;
+            s_num_failed++;
+            s_num_done++;
+            continue;
+        }
+        if (i >= plan.num_steps)
+        {
+            job_skip(p_job);
+            continue;
+        }
+
+        switch (p_step->action)
+        {
+            case PLAN_WRITE_OTP:
+                put_be16(p_pkt->cmd.wotp.address, p_step->addr);
+                put_be16(p_pkt->cmd.wotp.data, p_step->value);
+                (void) encode_job(p_job, p_run->line, "write_otp", CMD_WRITE_OTP,
+                                  (uint32_t) sizeof(cmd_write_otp_t));
+                break;
+            case PLAN_SET_SCIUSB:
+                p_pkt->cmd.sciusb.mode = p_step->mode;
+                (void) encode_job(p_job, p_run->line, "set_sciusb", CMD_SET_SCIUSB,
+                                  (uint32_t) sizeof(cmd_set_sciusb_t));
+                break;
+            case PLAN_SET_JAUTH:
+                p_pkt->cmd.jauth.mode = p_step->mode;
+                p_pkt->cmd.jauth.type = p_step->type;
+                (void) encode_job(p_job, p_run->line, "set_jauth", CMD_SET_JAUTH,
+                                  (uint32_t) sizeof(cmd_set_jauth_t));
+                break;
+            default:
+                p_pkt->cmd.jauthid.mode = p_step->mode;
+                p_pkt->cmd.jauthid.type = p_step->type;
+                memcpy(p_pkt->cmd.jauthid.id, p_run->profile.jauth_id, JAUTHID_ID_SIZE);
+                (void) encode_job(p_job, p_run->line, "setup_jauth", CMD_SETUP_JAUTH,
+                                  (uint32_t) (sizeof(cmd_set_jauthid_t) + JAUTHID_ID_SIZE));
+                break;
+        }
+    }
+}
+
+/* Print the entries of a READ_AUDIT answer. While the board holds more
+ * than the answer carried, a READ_AUDIT for the rest is added to the jobs. */
+static void audit_deliver (job_t const * p_job, uint8_t const * p_data, uint32_t size)
+{
+    uint32_t cursor = get_be32(((packet_t const *) p_job->packet)->cmd.raudit.cursor);
+    uint32_t first;
+    uint32_t written;
+    uint32_t tick_hz;
+    uint32_t count;
+
+    if ((AUDIT_RESULT_HEAD_SIZE > size) || (0U != ((size - AUDIT_RESULT_HEAD_SIZE) % OTP_AUDIT_ENTRY_SIZE)) ||
+        (0U == get_be32(&p_data[8])))
+    {
+        fprintf(stderr, "line %u: malformed audit entries\n", (unsigned) p_job->line);
+
+        return;
+    }
+    first   = get_be32(&p_data[0]);
+    written = get_be32(&p_data[4]);
+    tick_hz = get_be32(&p_data[8]);
+    count   = (size - AUDIT_RESULT_HEAD_SIZE) / OTP_AUDIT_ENTRY_SIZE;
+
+    if (first > cursor)
+    {
+        printf("audit: writes %u to %u were overwritten before they were read\n", (unsigned) cursor,
+               (unsigned) (first - 1U));
+    }
+    else if (first < cursor)
+    {
+        printf("audit: no write %u on the board, it was reset since; %u writes recorded\n", (unsigned) cursor,
+               (unsigned) written);
+    }
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        uint8_t const * p_entry = &p_data[AUDIT_RESULT_HEAD_SIZE + (i * OTP_AUDIT_ENTRY_SIZE)];
+        uint64_t        stamp   = ((uint64_t) get_be32(&p_entry[5]) << 32) | get_be32(&p_entry[9]);
+
+        printf("[%12.6f] audit %u: otp write 0x%03x = 0x%04x: %s\n", (double) stamp / (double) tick_hz,
+               (unsigned) (first + i), ((unsigned) p_entry[0] << 8) | p_entry[1],
+               ((unsigned) p_entry[2] << 8) | p_entry[3], (OTP_SUCCESS == p_entry[4]) ? "ok" : "FAIL");
+    }
+
+    if ((0U != count) && ((first + count) < written))
+    {
+        packet_t * p_pkt = new_job(p_job->line);
+        if (NULL != p_pkt)
+        {
+            put_be32(p_pkt->cmd.raudit.cursor, first + count);
+            (void) encode_job(&s_jobs[s_num_jobs], p_job->line, "read_audit", CMD_READ_AUDIT,
+                              (uint32_t) sizeof(cmd_read_audit_t));
+            s_num_jobs++;
+        }
+    }
+}
+
+/* Match a response to its command by tag. The link window and the board's
+ * queue hold far fewer than 256 unanswered commands, so the tag (index
+ * modulo 256) is unique among them. They are all near the newest issued
+ * command, so the search starts there. */
+static void link_deliver (void * p_context, uint8_t const * p_data, uint32_t size)
+{
+    response_t const * p_rsp = (response_t const *) p_data;
+    job_t            * p_job = NULL;
+
+    (void) p_context;
+
+    if (sizeof(response_t) > size)
+    {
+        return;
+    }
+
+    for (uint32_t i = s_num_issued; i-- > 0U; )
+    {
+        if ((false == s_jobs[i].done) && (((packet_t const *) s_jobs[i].packet)->head.tag == p_rsp->head.tag))
+        {
+            p_job = &s_jobs[i];
+            break;
+        }
+    }
+    if (NULL == p_job)
+    {
+        return;
+    }
+
+    p_job->done   = true;
+    p_job->done_s = now_s();
+    if ((PACKET_TYPE_RESPONSE != p_rsp->head.type) ||
+        (((packet_t const *) p_job->packet)->head.code != p_rsp->head.code))
+    {
+        p_job->ret = RET_CMD_FAIL;
+    }
+    else
+    {
+        p_job->ret       = p_rsp->ret;
+        p_job->data_size = size - (uint32_t) sizeof(response_t);
+        if (p_job->data_size > MAX_RESPONSE_DATA)
+        {
+            p_job->data_size = MAX_RESPONSE_DATA;
+        }
+        memcpy(p_job->data, p_rsp->data, p_job->data_size);
+    }
+
+    if (RET_SUCCESS != p_job->ret)
+    {
+        s_num_failed++;
+    }
+    s_num_done++;
+
+    if ((CMD_DIGEST_FLASH == ((packet_t const *) p_job->packet)->head.code) && (0U != p_job->image))
+    {
+        flash_delta(p_job, p_rsp->data, size - (uint32_t) sizeof(response_t));
+    }
+    if ((CMD_READ_LOG == ((packet_t const *) p_job->packet)->head.code) && (RET_SUCCESS == p_job->ret) &&
+        (log_decode(&s_log, stdout, p_rsp->data, size - (uint32_t) sizeof(response_t)) < 0))
+    {
+        fprintf(stderr, "line %u: malformed log records\n", (unsigned) p_job->line);
+    }
+    if ((CMD_READ_AUDIT == ((packet_t const *) p_job->packet)->head.code) && (RET_SUCCESS == p_job->ret))
+    {
+        audit_deliver(p_job, p_rsp->data, size - (uint32_t) sizeof(response_t));
+    }
+
+    profile_run_t * p_run = (0U != p_job->profile) ? &s_profiles[p_job->profile - 1U] : NULL;
+    if ((NULL != p_run) && ((uint32_t) (p_job - s_jobs) < p_run->first_step) && (0U == --p_run->reads_left))
+    {
+        profile_plan(p_run);
+    }
+}
+
+/* Move bytes from the line into the link and run its timers. */
+static void link_pump (uint32_t wait_ms)
+{
+    uint8_t  chunk[1024];
+    uint32_t size;
+
+    (void) s_transport.p_api->poll(s_transport.p_ctrl, wait_ms);
+    do
+    {
+        size = s_transport.p_api->receive(s_transport.p_ctrl, chunk, sizeof(chunk));
+        frame_input(&s_link, chunk, size);
+    } while (sizeof(chunk) == size);
+
+    frame_poll(&s_link, now_ms());
+}
+
+/* Start a new link session and wait until the board acknowledges it. */
+static bool link_connect (uint32_t timeout_s)
+{
+    double deadline = now_s() + timeout_s;
+
+    frame_reset(&s_link);
+    while (!frame_idle(&s_link))
+    {
+        if (now_s() > deadline)
+        {
+            return false;
+        }
+        link_pump(POLL_MS);
+    }
+
+    return true;
+}
+
+/******************************************************************************
+ * Report
+ ******************************************************************************/
+
+static void print_results (void)
+{
+    for (uint32_t i = 0U; i < s_num_jobs; i++)
+    {
+        job_t const * p_job = &s_jobs[i];
+
+        if ((false == p_job->done) || (true == p_job->skipped) || (s_quiet && (RET_SUCCESS == p_job->ret)))
+        {
+            continue;
+        }
+
+        /* A profile line is reported by its writes, not by the reads of the state. */
+        if ((0U != p_job->profile) && (i < s_profiles[p_job->profile - 1U].first_step) &&
+            (RET_SUCCESS == p_job->ret))
+        {
+            continue;
+        }
+
+        /* A write_flash line is reported once, by its VERIFY_FLASH. */
+        uint8_t code = ((packet_t const *) p_job->packet)->head.code;
+        if (((CMD_WRITE_FLASH == code) || (CMD_WRITE_FLASH_LZ4 == code) || (CMD_BEGIN_FLASH == code) ||
+             (CMD_DIGEST_FLASH == code) || (CMD_OPEN_SESSION == code)) && (RET_SUCCESS == p_job->ret))
+        {
+            continue;
+        }
+        printf("line %-4u %-12s ", (unsigned) p_job->line, p_job->name);
+        if ((CMD_APPLY_PROFILE == code) && (PROFILE_RESULT_SIZE == p_job->data_size))
+        {
+            printf((RET_SUCCESS == p_job->ret) ? "OK" : "FAIL 0x%02x", p_job->ret);
+            printf(" %u of %u writes", (unsigned) p_job->data[4], (unsigned) p_job->data[3]);
+            if ((PLAN_OK != p_job->data[0]) && (p_job->data[0] < (sizeof(s_plan_errors) / sizeof(s_plan_errors[0]))))
+            {
+                printf(", %s (0x%02x%02x)", s_plan_errors[p_job->data[0]], p_job->data[1], p_job->data[2]);
+            }
+        }
+        else if ((CMD_READ_LOG == code) && (RET_SUCCESS == p_job->ret) && (LOG_RESULT_HEAD_SIZE <= p_job->data_size))
+        {
+            /* The records are printed as they arrive. */
+            printf("OK, %u bytes left in the ring", (unsigned) get_be32(&p_job->data[8]));
+        }
+        else if ((CMD_READ_AUDIT == code) && (RET_SUCCESS == p_job->ret) &&
+                 (AUDIT_RESULT_HEAD_SIZE <= p_job->data_size))
+        {
+            /* The entries are printed as they arrive. */
+            printf("OK, from write %u, %u recorded", (unsigned) get_be32(&p_job->data[0]),
+                   (unsigned) get_be32(&p_job->data[4]));
+        }
+        else if (RET_SUCCESS == p_job->ret)
+        {
+            printf("OK");
+            if (0U != p_job->data_size)
+            {
+                printf(" ");
+                for (uint32_t b = 0U; b < p_job->data_size; b++)
+                {
+                    printf("%02x", p_job->data[b]);
+                }
+            }
+        }
+        else
+        {
+            printf("FAIL 0x%02x", p_job->ret);
+        }
+        printf("  (%.1f ms)\n", (p_job->done_s - p_job->sent_s) * 1000.0);
+    }
+}
+
+/* Add this run to the registry: what the script read back from the board. */
+static int registry_note (char const * p_path, char const * p_station)
+{
+    registry_record_t rec;
+    uid_registry_t    reg;
+    bool              have_uid = false;
+    bool              repeat;
+    uint32_t          counter     = 0U;
+    uint32_t          counter_set = 0U;
+
+    memset(&rec, 0, sizeof(rec));
+    rec.jauth_mode = REGISTRY_UNKNOWN;
+    rec.jauth_type = REGISTRY_UNKNOWN;
+
+    for (uint32_t i = 0U; i < s_num_jobs; i++)
+    {
+        job_t const    * p_job = &s_jobs[i];
+        packet_t const * p_pkt = (packet_t const *) p_job->packet;
+
+        if ((false == p_job->done) || (RET_SUCCESS != p_job->ret))
+        {
+            continue;
+        }
+        if ((CMD_GET_UID == p_pkt->head.code) && (UID_SIZE == p_job->data_size) && (false == have_uid))
+        {
+            memcpy(rec.uid, p_job->data, UID_SIZE);
+            have_uid = true;
+        }
+        else if ((CMD_GET_JAUTH == p_pkt->head.code) && (2U == p_job->data_size))
+        {
+            rec.jauth_mode = p_job->data[0];
+            rec.jauth_type = p_job->data[1];
+        }
+        else if ((CMD_READ_OTP == p_pkt->head.code) && (2U == p_job->data_size))
+        {
+            uint16_t address = (uint16_t) ((p_pkt->cmd.rotp.address[0] << 8) | p_pkt->cmd.rotp.address[1]);
+            uint32_t bit     = 1U << (address - COUNTER_AREA_START_ADDR);
+
+            /* Count each word of the area once, however often it is read. */
+            if ((address >= COUNTER_AREA_START_ADDR) && (address <= COUNTER_AREA_END_ADDR) &&
+                (0U == (counter_set & bit)))
+            {
+                counter_set |= bit;
+                counter     += (uint32_t) __builtin_popcount(((uint32_t) p_job->data[0] << 8) | p_job->data[1]);
+            }
+        }
+    }
+
+    if (false == have_uid)
+    {
+        fprintf(stderr, "registry: the script has no get_uid that succeeded, the run is not recorded\n");
+
+        return 1;
+    }
+
+    /* The area is only known when every word of it was read. */
+    rec.counter = ((1U << (COUNTER_AREA_END_ADDR - COUNTER_AREA_START_ADDR + 1U)) - 1U == counter_set) ?
+                  (uint16_t) counter : REGISTRY_UNKNOWN_COUNTER;
+    rec.failed = (uint8_t) ((s_num_failed > UINT8_MAX) ? UINT8_MAX : s_num_failed);
+    rec.time_s = (uint64_t) time(NULL);
+    strncpy(rec.station, p_station, sizeof(rec.station));
+
+    if ((0 != uid_registry_open(&reg, p_path, true, 0U)) || (0 != uid_registry_append(&reg, &rec, &repeat)))
+    {
+        perror(p_path);
+        uid_registry_close(&reg);
+
+        return 1;
+    }
+    if (repeat)
+    {
+        char      when[32];
+        time_t    first = (time_t) rec.first_s;
+        struct tm tm;
+        (void) localtime_r(&first, &tm);
+        (void) strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", &tm);
+        printf("registry: repeat, run %u of this board (first %s)\n", (unsigned) rec.runs, when);
+    }
+    else
+    {
+        printf("registry: new board\n");
+    }
+    uid_registry_close(&reg);
+
+    return 0;
+}
+
+/* Print the JTAG ID derive_jauth programs on the board with this UID. */
+static int derive_print (char const * p_key_text, char const * p_uid_text)
+{
+    uint8_t key[JAUTH_KEY_SIZE];
+    uint8_t uid[UID_SIZE];
+    uint8_t mac[SHA256_DIGEST_SIZE];
+    uint8_t hash[SHA256_DIGEST_SIZE];
+
+    if ((0 != parse_hex(p_key_text, key, JAUTH_KEY_SIZE)) || (0 != parse_hex(p_uid_text, uid, UID_SIZE)))
+    {
+        fprintf(stderr, "-k needs %u hex digits, -u %u\n", (unsigned) (JAUTH_KEY_SIZE * 2U),
+                (unsigned) (UID_SIZE * 2U));
+
+        return 2;
+    }
+
+    sha256_hmac(key, JAUTH_KEY_SIZE, uid, UID_SIZE, mac);
+    sha256_calc(mac, JAUTHID_ID_SIZE, hash);
+
+    printf("id   ");
+    for (uint32_t i = 0U; i < JAUTHID_ID_SIZE; i++)
+    {
+        printf("%02x", mac[i]);
+    }
+    printf("\nhash ");
+    for (uint32_t i = 0U; i < SHA256_DIGEST_SIZE; i++)
+    {
+        printf("%02x", hash[i]);
+    }
+    printf("\n");
+
+    sha256_wipe(key, sizeof(key));
+    sha256_wipe(mac, sizeof(mac));
+
+    return 0;
+}
+
+int main (int argc, char ** argv)
+{
+    uint32_t     baud_rate = DEFAULT_BAUD_RATE;
+    uint32_t     timeout_s = DEFAULT_TIMEOUT_S;
+    uint32_t     retries   = DEFAULT_RETRIES;
+    char const * p_device  = NULL;
+    char const * p_script  = NULL;
+    char const * p_key     = NULL;
+    char const * p_uid     = NULL;
+    char const * p_reg     = NULL;
+    char const * p_station = "";
+    char const * p_compile = NULL;
+    char const * p_load    = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((0 == strcmp(argv[i], "-d")) && ((i + 1) < argc))
+        {
+            p_device = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-b")) && ((i + 1) < argc))
+        {
+            baud_rate = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-t")) && ((i + 1) < argc))
+        {
+            timeout_s = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-r")) && ((i + 1) < argc))
+        {
+            retries = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-k")) && ((i + 1) < argc))
+        {
+            p_key = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-u")) && ((i + 1) < argc))
+        {
+            p_uid = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-R")) && ((i + 1) < argc))
+        {
+            p_reg = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-S")) && ((i + 1) < argc))
+        {
+            p_station = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-c")) && ((i + 1) < argc))
+        {
+            p_compile = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-x")) && ((i + 1) < argc))
+        {
+            p_load = argv[++i];
+        }
+        else if (0 == strcmp(argv[i], "-q"))
+        {
+            s_quiet = true;
+        }
+        else if (0 == strcmp(argv[i], "-z"))
+        {
+            s_compress = true;
+        }
+        else if (0 == strcmp(argv[i], "-D"))
+        {
+            s_delta = true;
+        }
+        else if ((NULL == p_script) && (('-' != argv[i][0]) || (0 == strcmp(argv[i], "-"))))
+        {
+            p_script = argv[i];
+        }
+        else
+        {
+            p_script = NULL;
+            p_device = NULL;
+            break;
+        }
+    }
+
+    if ((NULL != p_key) && (NULL != p_uid))
+    {
+        return derive_print(p_key, p_uid);
+    }
+
+    if ((NULL != p_compile) ? ((NULL == p_script) || (NULL != p_load) || s_delta) :
+        ((NULL == p_device) || ((NULL == p_script) == (NULL == p_load))))
+    {
+        fprintf(stderr, "usage: %s -d device [-b baud] [-t timeout_s] [-r retries] [-q] [-z] [-D] [-k key]\n"
+                "                 [-R registry [-S station]] script|-|-x compiled\n", argv[0]);
+        fprintf(stderr, "       %s -c compiled [-z] script|-\n", argv[0]);
+        fprintf(stderr, "       %s -k key -u uid\n", argv[0]);
+        return 2;
+    }
+    if (NULL != p_key)
+    {
+        if (0 != parse_hex(p_key, s_key, JAUTH_KEY_SIZE))
+        {
+            fprintf(stderr, "-k needs %u hex digits\n", (unsigned) (JAUTH_KEY_SIZE * 2U));
+            return 2;
+        }
+        s_have_key = true;
+    }
+    s_compiling = (NULL != p_compile);
+
+    /* Phase 1: the whole command stream, before the board is touched. A
+     * compiled script is already encoded. */
+    double t_start = now_s();
+    if (NULL != p_load)
+    {
+        if (0 != compiled_load(p_load))
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        FILE * p_file = (0 == strcmp(p_script, "-")) ? stdin : fopen(p_script, "r");
+        if (NULL == p_file)
+        {
+            perror(p_script);
+            return 1;
+        }
+        int err = encode_script(p_file);
+        if (stdin != p_file)
+        {
+            fclose(p_file);
+        }
+        if (0 != err)
+        {
+            return 1;
+        }
+    }
+    if (s_compiling)
+    {
+        if (0U != s_num_profiles)
+        {
+            fprintf(stderr, "line %u: profile lines are not compiled, the commands depend on the board\n",
+                    (unsigned) s_profiles[0].line);
+            return 1;
+        }
+        return (0 == compiled_write(p_compile)) ? 0 : 1;
+    }
+
+    /* Phase 2: open the line and start a new link session. */
+    double              t_encoded = now_s();
+    transport_fd_ctrl_t line;
+    if (0 != transport_serial_open(&line, p_device, baud_rate))
+    {
+        perror(p_device);
+        return 1;
+    }
+    s_transport.p_ctrl = &line;
+    s_transport.p_api  = &g_transport_fd_api;
+
+    frame_cfg_t cfg =
+    {
+        .p_write          = link_write,
+        .p_deliver        = link_deliver,
+        .p_context        = NULL,
+        .retry_timeout_ms = 0U,
+    };
+    frame_init(&s_link, &cfg);
+    log_decoder_init(&s_log);
+    s_link.now_ms = now_ms();
+    if (!link_connect(timeout_s))
+    {
+        fprintf(stderr, "%s: no answer from the board\n", p_device);
+        return 1;
+    }
+
+    /* Phase 3: keep the window full until every command has its response. */
+    double   t_connected = now_s();
+    uint32_t last_done   = 0U;
+
+    double   deadline    = t_connected + timeout_s;
+
+    while (s_num_done < s_num_jobs)
+    {
+        while ((s_num_answered < s_num_jobs) && (true == s_jobs[s_num_answered].done))
+        {
+            s_num_answered++;
+        }
+
+        while ((s_num_sent < s_num_jobs) && (0U != frame_send_space(&s_link)))
+        {
+            job_t * p_job = &s_jobs[s_num_sent];
+
+            /* A command that depends on earlier answers (-D) waits for them. */
+            if ((true == p_job->wait) && (s_num_answered < s_num_sent))
+            {
+                break;
+            }
+            s_num_sent++;
+
+            /* After a reconnect, skip the commands already answered. */
+            if (true == p_job->done)
+            {
+                continue;
+            }
+            if ((true == p_job->derive) && (false == job_derive(p_job)))
+            {
+                fprintf(stderr, "line %u: no UID to derive the JTAG ID from\n", (unsigned) p_job->line);
+                job_fail(p_job);
+                continue;
+            }
+            if (s_num_sent <= s_num_issued)
+            {
+                s_num_resent++;
+            }
+            else
+            {
+                p_job->sent_s = now_s();
+                s_num_issued  = s_num_sent;
+            }
+            if (NULL != p_job->tpl.p_frame)
+            {
+                (void) frame_send_template(&s_link, &p_job->tpl);
+            }
+            else
+            {
+                (void) frame_send(&s_link, p_job->packet, p_job->size);
+            }
+        }
+
+        link_pump(POLL_MS);
+
+        /* The timeout runs from the last response, not from the start. */
+        if (last_done != s_num_done)
+        {
+            last_done = s_num_done;
+            deadline  = now_s() + timeout_s;
+        }
+        else if (now_s() > deadline)
+        {
+            fprintf(stderr, "%s: timeout after %u of %u commands\n", p_device, (unsigned) s_num_done,
+                    (unsigned) s_num_jobs);
+            if ((0U == retries) || !link_connect(timeout_s))
+            {
+                break;
+            }
+
+            /* Send every unanswered command again with its original tag. */
+            retries--;
+            s_num_sent = 0U;
+            deadline   = now_s() + timeout_s;
+        }
+    }
+    double t_done = now_s();
+
+    (void) s_transport.p_api->flush(s_transport.p_ctrl);
+    transport_fd_close(&line);
+
+    print_results();
+
+    double latency_sum = 0.0;
+    double latency_max = 0.0;
+    for (uint32_t i = 0U; i < s_num_jobs; i++)
+    {
+        if ((false == s_jobs[i].done) || (true == s_jobs[i].skipped))
+        {
+            continue;
+        }
+        double latency = s_jobs[i].done_s - s_jobs[i].sent_s;
+        latency_sum += latency;
+        latency_max  = (latency > latency_max) ? latency : latency_max;
+    }
+
+    printf("%u commands, %u failed, %u not answered\n", (unsigned) s_num_jobs, (unsigned) s_num_failed,
+           (unsigned) (s_num_jobs - s_num_done));
+    printf("%s %8.1f ms\n", (NULL != p_load) ? "load    " : "encode  ", (t_encoded - t_start) * 1000.0);
+    printf("connect  %8.1f ms\n", (t_connected - t_encoded) * 1000.0);
+    printf("transfer %8.1f ms  (latency avg %.1f ms, max %.1f ms)\n", (t_done - t_connected) * 1000.0,
+           (0U != s_num_done) ? ((latency_sum / s_num_done) * 1000.0) : 0.0, latency_max * 1000.0);
+    printf("total    %8.1f ms\n", (t_done - t_start) * 1000.0);
+    printf("%u commands sent again after a reconnect\n", (unsigned) s_num_resent);
+    if (0U != s_flash_bytes)
+    {
+        uint32_t link_bytes = 0U;
+        for (uint32_t i = 0U; i < s_num_jobs; i++)
+        {
+            uint8_t code = ((packet_t const *) s_jobs[i].packet)->head.code;
+            if (((CMD_WRITE_FLASH == code) || (CMD_WRITE_FLASH_LZ4 == code)) && (false == s_jobs[i].skipped))
+            {
+                link_bytes += s_jobs[i].size;
+            }
+        }
+        if (s_delta)
+        {
+            printf("delta: %u of %u sectors unchanged, %u commands not sent\n", (unsigned) s_sectors_same,
+                   (unsigned) s_sectors_total, (unsigned) s_num_skipped);
+        }
+        printf("flash: %u bytes sent as %u bytes of commands (ratio %.2f), %.1f KB/s of image\n",
+               (unsigned) s_flash_bytes, (unsigned) link_bytes,
+               (0U != link_bytes) ? ((double) s_flash_bytes / (double) link_bytes) : 0.0,
+               ((double) s_flash_bytes / (t_done - t_connected)) / 1024.0);
+    }
+    printf("link: %u frames sent, %u resent, %u CRC errors, %u framing errors\n",
+           (unsigned) s_link.stats.tx_frames, (unsigned) s_link.stats.tx_retransmits,
+           (unsigned) s_link.stats.rx_crc_errors, (unsigned) s_link.stats.rx_framing_errors);
+
+    int ret = ((0U == s_num_failed) && (s_num_done == s_num_jobs)) ? 0 : 1;
+    if ((NULL != p_reg) && (0 != registry_note(p_reg, p_station)))
+    {
+        ret = 1;
+    }
+    sha256_wipe(s_key, sizeof(s_key));
+    cscript_close(&s_script);
+
+    return ret;
+}
@@ -0,0 +1,379 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Host tool: UID registry (uid_registry.c) inspection and benchmark.
+ *
+ * provision -R adds a record for each board it provisions; this tool
+ * reads the file, while stations keep writing to it.
+ *
+ * Usage:
+ *   registry -f file create [-c capacity]   Create an empty registry
+ *   registry -f file find <uid>             History of one board, latest first
+ *   registry -f file dump                   Every record, in the order written
+ *   registry -f file check                  Count records the index does not reach
+ *   registry -b [-n count] [-t readers]     Append and lookup benchmark (temporary file)
+ *
+ * Build:
+ *   gcc -O2 -pthread -Itools/registry -o registry tools/registry/registry.c tools/registry/uid_registry.c
+ ******************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "uid_registry.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+#define DEFAULT_BENCH_COUNT     (1000000U)
+#define DEFAULT_BENCH_READERS   (2U)
+#define MAX_READERS             (64U)
+#define LOOKUPS_PER_READER      (2000000U)
+
+/******************************************************************************
+ * Typedef definitions
+ ******************************************************************************/
+/* Benchmark reader */
+typedef struct
+{
+    uid_registry_t const * p_reg;
+    uint8_t const        * p_uids;                  // UIDs that are in the registry
+    uint32_t               count;
+    uint32_t               seed;
+    uint32_t               missing;                 // Lookups of a known UID that failed
+    double                 ns_per_lookup;
+} reader_t;
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static double now_s (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+static int parse_uid (char const * p_text, uint8_t * p_uid)
+{
+    if ((REGISTRY_UID_SIZE * 2U) != strlen(p_text))
+    {
+        return -1;
+    }
+    for (uint32_t i = 0U; i < REGISTRY_UID_SIZE; i++)
+    {
+        char hex[3] = {p_text[i * 2U], p_text[(i * 2U) + 1U], '\0'};
+        if (!isxdigit((unsigned char) hex[0]) || !isxdigit((unsigned char) hex[1]))
+        {
+            return -1;
+        }
+        p_uid[i] = (uint8_t) strtoul(hex, NULL, 16);
+    }
+
+    return 0;
+}
+
+static void print_record (uid_registry_t const * p_reg, registry_record_t const * p_rec)
+{
+    char      when[32];
+    time_t    t = (time_t) p_rec->time_s;
+    struct tm tm;
+
+    (void) localtime_r(&t, &tm);
+    (void) strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", &tm);
+    printf("#%-8u ", (unsigned) (p_rec - p_reg->p_records) + 1U);
+    for (uint32_t i = 0U; i < REGISTRY_UID_SIZE; i++)
+    {
+        printf("%02x", p_rec->uid[i]);
+    }
+    printf("  %s  %-16.16s run %u", when, p_rec->station, (unsigned) p_rec->runs);
+    if (REGISTRY_UNKNOWN != p_rec->jauth_mode)
+    {
+        printf("  jauth %u/%u", (unsigned) p_rec->jauth_mode, (unsigned) p_rec->jauth_type);
+    }
+    if (REGISTRY_UNKNOWN_COUNTER != p_rec->counter)
+    {
+        printf("  counter %u", (unsigned) p_rec->counter);
+    }
+    if (0U != p_rec->failed)
+    {
+        printf("  %u failed", (unsigned) p_rec->failed);
+    }
+    printf("\n");
+}
+
+/******************************************************************************
+ * Benchmark
+ ******************************************************************************/
+
+static uint32_t xorshift (uint32_t * p_state)
+{
+    uint32_t x = *p_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *p_state = x;
+
+    return x;
+}
+
+/* Look up known UIDs, without a lock, while the writer appends. */
+static void * bench_reader (void * p_arg)
+{
+    reader_t * p_reader = (reader_t *) p_arg;
+    double     t0       = now_s();
+
+    for (uint32_t i = 0U; i < LOOKUPS_PER_READER; i++)
+    {
+        uint32_t n = xorshift(&p_reader->seed) % p_reader->count;
+        if (NULL == uid_registry_find(p_reader->p_reg, &p_reader->p_uids[n * REGISTRY_UID_SIZE]))
+        {
+            p_reader->missing++;
+        }
+    }
+    p_reader->ns_per_lookup = ((now_s() - t0) * 1e9) / LOOKUPS_PER_READER;
+
+    return NULL;
+}
+
+static int run_benchmark (uint32_t count, uint32_t readers)
+{
+    char           path[] = "/tmp/uid_registry_XXXXXX";
+    int            fd     = mkstemp(path);
+    uid_registry_t reg;
+    uint8_t      * p_uids = malloc((size_t) count * 2U * REGISTRY_UID_SIZE);
+    uint32_t       seed   = 0x4E324C31U;
+
+    if ((fd < 0) || (NULL == p_uids))
+    {
+        perror("benchmark setup");
+        return 1;
+    }
+    close(fd);
+    if (0 != uid_registry_open(&reg, path, true, 2U * count))
+    {
+        perror(path);
+        return 1;
+    }
+    (void) unlink(path);
+    for (uint32_t i = 0U; i < (2U * count * (REGISTRY_UID_SIZE / 4U)); i++)
+    {
+        uint32_t word = xorshift(&seed);
+        memcpy(&p_uids[i * 4U], &word, 4U);
+    }
+
+    /* First half: appends alone. */
+    registry_record_t rec;
+    bool              repeat;
+    uint32_t          repeats = 0U;
+    memset(&rec, 0, sizeof(rec));
+    snprintf(rec.station, sizeof(rec.station), "bench");
+    rec.jauth_mode = REGISTRY_UNKNOWN;
+    rec.jauth_type = REGISTRY_UNKNOWN;
+    rec.counter    = REGISTRY_UNKNOWN_COUNTER;
+
+    double t0 = now_s();
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        memcpy(rec.uid, &p_uids[i * REGISTRY_UID_SIZE], REGISTRY_UID_SIZE);
+        rec.time_s = (uint64_t) i;
+        if (0 != uid_registry_append(&reg, &rec, &repeat))
+        {
+            perror("append");
+            return 1;
+        }
+        repeats += repeat ? 1U : 0U;
+    }
+    double t_append = (now_s() - t0) / count;
+
+    /* Second half: appends while the readers look up the first half. */
+    pthread_t threads[MAX_READERS];
+    reader_t  reader[MAX_READERS];
+    for (uint32_t r = 0U; r < readers; r++)
+    {
+        reader[r] = (reader_t) {.p_reg = &reg, .p_uids = p_uids, .count = count, .seed = 0x9E3779B9U * (r + 1U)};
+        (void) pthread_create(&threads[r], NULL, bench_reader, &reader[r]);
+    }
+    t0 = now_s();
+    for (uint32_t i = count; i < (2U * count); i++)
+    {
+        memcpy(rec.uid, &p_uids[i * REGISTRY_UID_SIZE], REGISTRY_UID_SIZE);
+        (void) uid_registry_append(&reg, &rec, &repeat);
+    }
+    double t_append_busy = (now_s() - t0) / count;
+
+    uint32_t missing = 0U;
+    double   ns_sum  = 0.0;
+    for (uint32_t r = 0U; r < readers; r++)
+    {
+        (void) pthread_join(threads[r], NULL);
+        missing += reader[r].missing;
+        ns_sum  += reader[r].ns_per_lookup;
+    }
+
+    /* Duplicate detection: the same UIDs again. */
+    t0 = now_s();
+    uint32_t found = 0U;
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        found += (NULL != uid_registry_find(&reg, &p_uids[i * REGISTRY_UID_SIZE])) ? 1U : 0U;
+    }
+    double t_find = (now_s() - t0) / count;
+
+    printf("%u records appended: %.2f us each, %.2f us with %u readers\n", (unsigned) (2U * count),
+           t_append * 1e6, t_append_busy * 1e6, (unsigned) readers);
+    printf("lookup: %.0f ns alone, %.0f ns per reader during appends\n", t_find * 1e9,
+           (0U != readers) ? (ns_sum / readers) : 0.0);
+    printf("%u of %u known UIDs found, %u lookups missed, %u repeats, check %u\n", (unsigned) found,
+           (unsigned) count, (unsigned) missing, (unsigned) repeats, (unsigned) uid_registry_check(&reg));
+
+    uid_registry_close(&reg);
+    free(p_uids);
+
+    return ((found == count) && (0U == missing)) ? 0 : 1;
+}
+
+int main (int argc, char ** argv)
+{
+    char const   * p_path   = NULL;
+    char const   * p_cmd    = NULL;
+    char const   * p_arg    = NULL;
+    uint32_t       capacity = 0U;
+    uint32_t       count    = DEFAULT_BENCH_COUNT;
+    uint32_t       readers  = DEFAULT_BENCH_READERS;
+    bool           bench    = false;
+    uid_registry_t reg;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((0 == strcmp(argv[i], "-f")) && ((i + 1) < argc))
+        {
+            p_path = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-c")) && ((i + 1) < argc))
+        {
+            capacity = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-n")) && ((i + 1) < argc))
+        {
+            count = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-t")) && ((i + 1) < argc))
+        {
+            readers = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if (0 == strcmp(argv[i], "-b"))
+        {
+            bench = true;
+        }
+        else if (NULL == p_cmd)
+        {
+            p_cmd = argv[i];
+        }
+        else if (NULL == p_arg)
+        {
+            p_arg = argv[i];
+        }
+        else
+        {
+            p_cmd = NULL;
+            break;
+        }
+    }
+
+    if (bench)
+    {
+        return ((0U != count) && (readers <= MAX_READERS)) ? run_benchmark(count, readers) : 2;
+    }
+    if ((NULL == p_path) || (NULL == p_cmd))
+    {
+        fprintf(stderr, "usage: %s -f file create [-c capacity] | find <uid> | dump | check\n", argv[0]);
+        fprintf(stderr, "       %s -b [-n count] [-t readers]\n", argv[0]);
+        return 2;
+    }
+
+    bool create = (0 == strcmp(p_cmd, "create"));
+    if (0 != uid_registry_open(&reg, p_path, create, capacity))
+    {
+        perror(p_path);
+        return 1;
+    }
+
+    int ret = 0;
+    if (create)
+    {
+        printf("%s: room for %u records\n", p_path, (unsigned) reg.p_header->capacity);
+    }
+    else if ((0 == strcmp(p_cmd, "find")) && (NULL != p_arg))
+    {
+        uint8_t uid[REGISTRY_UID_SIZE];
+        if (0 != parse_uid(p_arg, uid))
+        {
+            fprintf(stderr, "a UID is %u hex digits\n", (unsigned) (REGISTRY_UID_SIZE * 2U));
+            ret = 2;
+        }
+        else
+        {
+            registry_record_t const * p_rec = uid_registry_find(&reg, uid);
+            ret = (NULL != p_rec) ? 0 : 1;
+            while (NULL != p_rec)
+            {
+                print_record(&reg, p_rec);
+                p_rec = (0U != p_rec->prev) ? &reg.p_records[p_rec->prev - 1U] : NULL;
+            }
+        }
+    }
+    else if (0 == strcmp(p_cmd, "dump"))
+    {
+        uint32_t n = atomic_load_explicit(&reg.p_header->count, memory_order_acquire);
+        for (uint32_t i = 0U; i < n; i++)
+        {
+            print_record(&reg, &reg.p_records[i]);
+        }
+    }
+    else if (0 == strcmp(p_cmd, "check"))
+    {
+        uint32_t lost = uid_registry_check(&reg);
+        printf("%u records, %u not reached by the index\n",
+               (unsigned) atomic_load(&reg.p_header->count), (unsigned) lost);
+        ret = (0U == lost) ? 0 : 1;
+    }
+    else
+    {
+        fprintf(stderr, "unknown command '%s'\n", p_cmd);
+        ret = 2;
+    }
+
+    uid_registry_close(&reg);
+
+    return ret;
+}
@@ -0,0 +1,278 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * UID registry, see uid_registry.h.
+ ******************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "uid_registry.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+#define REGISTRY_MAGIC          "UIDREG1"
+#define REGISTRY_VERSION        (1U)
+#define REGISTRY_PAGE           (4096U)
+
+/* 64-bit golden ratio, spreads the UID over the slot number */
+#define REGISTRY_HASH_MULT      (0x9E3779B97F4A7C15ULL)
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+
+static uint32_t registry_slot (uid_registry_t const * p_reg, uint8_t const * p_uid)
+{
+    uint64_t lo;
+    uint64_t hi;
+
+    memcpy(&lo, p_uid, sizeof(lo));
+    memcpy(&hi, p_uid + sizeof(lo), sizeof(hi));
+
+    return (uint32_t) (((lo ^ hi) * REGISTRY_HASH_MULT) >> (64U - p_reg->p_header->index_bits));
+}
+
+/* Slot of a UID: the one holding it, or the empty slot where it goes. */
+static _Atomic uint32_t * registry_probe (uid_registry_t const * p_reg, uint8_t const * p_uid, uint32_t * p_entry)
+{
+    uint32_t mask = (1U << p_reg->p_header->index_bits) - 1U;
+    uint32_t slot = registry_slot(p_reg, p_uid);
+
+    while (1)
+    {
+        uint32_t entry = atomic_load_explicit(&p_reg->p_index[slot], memory_order_acquire);
+
+        if ((0U == entry) || (0 == memcmp(p_reg->p_records[entry - 1U].uid, p_uid, REGISTRY_UID_SIZE)))
+        {
+            *p_entry = entry;
+
+            return &p_reg->p_index[slot];
+        }
+        slot = (slot + 1U) & mask;
+    }
+}
+
+static int registry_create (int fd, uint32_t capacity)
+{
+    registry_header_t header;
+    uint32_t          index_bits = 1U;
+    uint64_t          index_offset;
+    uint64_t          size;
+
+    /* At most half of the slots are used. */
+    while ((1ULL << index_bits) < (2ULL * capacity))
+    {
+        index_bits++;
+    }
+    index_offset = REGISTRY_RECORDS_OFFSET + ((uint64_t) capacity * sizeof(registry_record_t));
+    index_offset = (index_offset + REGISTRY_PAGE - 1U) & ~(uint64_t) (REGISTRY_PAGE - 1U);
+    size         = index_offset + ((1ULL << index_bits) * sizeof(uint32_t));
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, REGISTRY_MAGIC, sizeof(REGISTRY_MAGIC));
+    header.version      = REGISTRY_VERSION;
+    header.record_size  = (uint32_t) sizeof(registry_record_t);
+    header.capacity     = capacity;
+    header.index_bits   = index_bits;
+    header.index_offset = index_offset;
+
+    if ((0 != ftruncate(fd, (off_t) size)) || (sizeof(header) != pwrite(fd, &header, sizeof(header), 0)))
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Open and close
+ ******************************************************************************/
+
+int uid_registry_open (uid_registry_t * p_reg, char const * p_path, bool writable, uint32_t capacity)
+{
+    struct stat st;
+
+    memset(p_reg, 0, sizeof(*p_reg));
+    p_reg->fd       = open(p_path, writable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+    p_reg->writable = writable;
+    if (p_reg->fd < 0)
+    {
+        return -1;
+    }
+
+    /* Two stations may create the same file: the lock makes one of them do it. */
+    if (writable)
+    {
+        (void) flock(p_reg->fd, LOCK_EX);
+        if ((0 == fstat(p_reg->fd, &st)) && (0 == st.st_size))
+        {
+            if (0 != registry_create(p_reg->fd, (0U != capacity) ? capacity : REGISTRY_DEFAULT_CAPACITY))
+            {
+                (void) flock(p_reg->fd, LOCK_UN);
+                uid_registry_close(p_reg);
+
+                return -1;
+            }
+        }
+        (void) flock(p_reg->fd, LOCK_UN);
+    }
+
+    if ((0 != fstat(p_reg->fd, &st)) || ((size_t) st.st_size < REGISTRY_RECORDS_OFFSET))
+    {
+        uid_registry_close(p_reg);
+        errno = EINVAL;
+
+        return -1;
+    }
+
+    void * p_map = mmap(NULL, (size_t) st.st_size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED,
+                        p_reg->fd, 0);
+    if (MAP_FAILED == p_map)
+    {
+        uid_registry_close(p_reg);
+
+        return -1;
+    }
+    p_reg->size     = (size_t) st.st_size;
+    p_reg->p_header = (registry_header_t *) p_map;
+
+    registry_header_t const * p_header = p_reg->p_header;
+    if ((0 != memcmp(p_header->magic, REGISTRY_MAGIC, sizeof(REGISTRY_MAGIC))) ||
+        (REGISTRY_VERSION != p_header->version) || (sizeof(registry_record_t) != p_header->record_size) ||
+        ((p_header->index_offset + ((1ULL << p_header->index_bits) * sizeof(uint32_t))) > p_reg->size))
+    {
+        uid_registry_close(p_reg);
+        errno = EINVAL;
+
+        return -1;
+    }
+    p_reg->p_records = (registry_record_t *) ((uint8_t *) p_map + REGISTRY_RECORDS_OFFSET);
+    p_reg->p_index   = (_Atomic uint32_t *) ((uint8_t *) p_map + p_header->index_offset);
+
+    return 0;
+}
+
+void uid_registry_close (uid_registry_t * p_reg)
+{
+    if (NULL != p_reg->p_header)
+    {
+        (void) munmap(p_reg->p_header, p_reg->size);
+    }
+    if (p_reg->fd >= 0)
+    {
+        (void) close(p_reg->fd);
+    }
+    memset(p_reg, 0, sizeof(*p_reg));
+    p_reg->fd = -1;
+}
+
+/******************************************************************************
+ * Lookup and append
+ ******************************************************************************/
+
+registry_record_t const * uid_registry_find (uid_registry_t const * p_reg, uint8_t const * p_uid)
+{
+    uint32_t entry;
+
+    (void) registry_probe(p_reg, p_uid, &entry);
+
+    return (0U != entry) ? &p_reg->p_records[entry - 1U] : NULL;
+}
+
+int uid_registry_append (uid_registry_t * p_reg, registry_record_t * p_rec, bool * p_repeat)
+{
+    registry_header_t * p_header = p_reg->p_header;
+    int                 ret      = 0;
+
+    if (!p_reg->writable)
+    {
+        errno = EBADF;
+
+        return -1;
+    }
+
+    (void) flock(p_reg->fd, LOCK_EX);
+
+    uint32_t           count = atomic_load_explicit(&p_header->count, memory_order_relaxed);
+    uint32_t           entry;
+    _Atomic uint32_t * p_slot = registry_probe(p_reg, p_rec->uid, &entry);
+
+    if (count >= p_header->capacity)
+    {
+        errno = ENOSPC;
+        ret   = -1;
+    }
+    else
+    {
+        if (0U != entry)
+        {
+            registry_record_t const * p_prev = &p_reg->p_records[entry - 1U];
+            p_rec->first_s = p_prev->first_s;
+            p_rec->runs    = p_prev->runs + 1U;
+        }
+        else
+        {
+            p_rec->first_s = p_rec->time_s;
+            p_rec->runs    = 1U;
+        }
+        p_rec->prev = entry;
+        *p_repeat   = (0U != entry);
+
+        /* Record, then count, then the slot: a reader that finds the slot
+         * finds a complete record. */
+        p_reg->p_records[count] = *p_rec;
+        atomic_store_explicit(&p_header->count, count + 1U, memory_order_release);
+        atomic_store_explicit(p_slot, count + 1U, memory_order_release);
+    }
+
+    (void) flock(p_reg->fd, LOCK_UN);
+
+    return ret;
+}
+
+uint32_t uid_registry_check (uid_registry_t const * p_reg)
+{
+    uint32_t count = atomic_load_explicit(&p_reg->p_header->count, memory_order_acquire);
+    uint32_t lost  = 0U;
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        registry_record_t const * p_found = uid_registry_find(p_reg, p_reg->p_records[i].uid);
+
+        if ((NULL == p_found) || (p_found < &p_reg->p_records[i]))
+        {
+            lost++;
+        }
+    }
+
+    return lost;
+}
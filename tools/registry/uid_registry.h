@@ -0,0 +1,114 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+#ifndef UID_REGISTRY_H_
+#define UID_REGISTRY_H_
+
+/******************************************************************************
+ * UID registry: what each provisioned board was given, keyed by its UID.
+ *
+ * One file, mapped by every process that uses it:
+ *   [0]                      registry_header_t (one page)
+ *   [REGISTRY_RECORDS_OFFSET] capacity registry_record_t, appended in order
+ *   [index_offset]           index: 2^index_bits slots, each a record number + 1
+ *
+ * Records are never changed once written. A board provisioned again gets a
+ * new record that links to its previous one, and its index slot moves to
+ * the new record. The index is open addressing with linear probing, at most
+ * half full, so a lookup reads one or two slots and one record.
+ *
+ * Readers take no lock: a writer fills the record, then publishes the
+ * count and the slot with release stores, and a reader follows a slot with
+ * an acquire load, so it sees either the old record or the new one,
+ * complete. Writers (provision stations sharing the file) are serialized
+ * with flock() on the file. The file is created at full size; the parts
+ * not written yet stay sparse.
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#define REGISTRY_UID_SIZE          (16U)
+#define REGISTRY_STATION_SIZE      (16U)
+#define REGISTRY_DEFAULT_CAPACITY  (1U << 22)
+#define REGISTRY_RECORDS_OFFSET    (4096U)
+
+/* Field not known to the run that wrote the record */
+#define REGISTRY_UNKNOWN           (0xFFU)
+#define REGISTRY_UNKNOWN_COUNTER   (0xFFFFU)
+
+/* File header */
+typedef struct
+{
+    char             magic[8];                      // "UIDREG1"
+    uint32_t         version;
+    uint32_t         record_size;                   // sizeof(registry_record_t)
+    uint32_t         capacity;                      // Records the file has room for
+    uint32_t         index_bits;                    // log2 of the index slots
+    uint64_t         index_offset;
+    _Atomic uint32_t count;                         // Records written
+} registry_header_t;
+
+/* One provisioning run of one board */
+typedef struct
+{
+    uint8_t  uid[REGISTRY_UID_SIZE];
+    uint64_t first_s;                               // First run of this UID (Unix time)
+    uint64_t time_s;                                // This run (Unix time)
+    uint32_t prev;                                  // Previous record of this UID + 1, 0 for none
+    uint32_t runs;                                  // Runs of this UID, this one included
+    uint16_t counter;                               // Anti-rollback counter bits set
+    uint8_t  jauth_mode;
+    uint8_t  jauth_type;
+    uint8_t  failed;                                // Commands of the run that failed
+    uint8_t  reserved[3];
+    char     station[REGISTRY_STATION_SIZE];        // Zero padded, not terminated when full
+} registry_record_t;
+
+/* An open registry */
+typedef struct
+{
+    registry_header_t * p_header;
+    registry_record_t * p_records;
+    _Atomic uint32_t  * p_index;
+    size_t              size;
+    int                 fd;
+    bool                writable;
+} uid_registry_t;
+
+/* Open a registry. With writable set, a missing file is created with room
+ * for capacity records (0 for REGISTRY_DEFAULT_CAPACITY). Returns 0, or -1
+ * with errno set. */
+int uid_registry_open(uid_registry_t * p_reg, char const * p_path, bool writable, uint32_t capacity);
+void uid_registry_close(uid_registry_t * p_reg);
+
+/* Latest record of a UID, or NULL. Lock free; safe while writers append. */
+registry_record_t const * uid_registry_find(uid_registry_t const * p_reg, uint8_t const * p_uid);
+
+/* Append a run of a board. first_s, prev and runs are filled in from the
+ * UID's previous record, if any. Returns 0, or -1 with errno set (ENOSPC
+ * when the file is full). p_repeat tells whether the UID was known. */
+int uid_registry_append(uid_registry_t * p_reg, registry_record_t * p_rec, bool * p_repeat);
+
+/* Number of records whose UID is not found at them (latest records only).
+ * Non-zero only after a writer died between appending and indexing. */
+uint32_t uid_registry_check(uid_registry_t const * p_reg);
+
+#endif /* UID_REGISTRY_H_ */
@@ -0,0 +1,278 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Simulated OTP. See otp_sim.h.
+ ******************************************************************************/
+#include <stdio.h>
+#include <time.h>
+#include "hal_data.h"
+#include "log.h"
+#include "otp.h"
+#include "otp_audit.h"
+#include "otp_sim.h"
+
+/* Part number and product version reported by the virtual board */
+#define OTP_SIM_PART_NUM       (0x0001U)
+#define OTP_SIM_PRODUCT_VER    (0x0001U)
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static uint16_t        s_g_otp[OTP_SIM_WORDS];
+static uint8_t         s_g_powered = 0U;
+static FILE          * s_gp_image  = NULL;
+static otp_sim_stats_t s_g_stats;
+static uint32_t        s_g_write_us = 0U;
+static uint32_t        s_g_read_us  = 0U;
+
+static void otp_sim_wait (uint32_t us)
+{
+    struct timespec ts = {.tv_sec = (time_t) (us / 1000000U), .tv_nsec = (long) (us % 1000000U) * 1000L};
+
+    if (0U != us)
+    {
+        (void) nanosleep(&ts, NULL);
+    }
+}
+
+static int otp_sim_write_once (uint16_t addr)
+{
+    if ((USER_AREA_START_ADDR <= addr) && (addr <= USER_AREA_END_ADDR))
+    {
+        return 1;
+    }
+    if ((SHOSTIF_BOOT_AREA_START_ADDR <= addr) && (addr <= SHOSTIF_BOOT_AREA_END_ADDR))
+    {
+        return 1;
+    }
+    if ((PHOSTIF_BOOT_AREA_START_ADDR <= addr) && (addr <= PHOSTIF_BOOT_AREA_END_ADDR))
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+static void otp_sim_save (uint16_t addr)
+{
+    uint8_t bytes[2];
+
+    if (NULL == s_gp_image)
+    {
+        return;
+    }
+
+    /* Little endian image, one word at its address. */
+    bytes[0] = (uint8_t) s_g_otp[addr];
+    bytes[1] = (uint8_t) (s_g_otp[addr] >> 8);
+    (void) fseek(s_gp_image, (long) addr * 2L, SEEK_SET);
+    (void) fwrite(bytes, 1U, sizeof(bytes), s_gp_image);
+    (void) fflush(s_gp_image);
+}
+
+/******************************************************************************
+ * Simulator control
+ ******************************************************************************/
+
+void otp_sim_reset (uint32_t seed)
+{
+    uint32_t x = seed | 1U;
+
+    memset(s_g_otp, 0, sizeof(s_g_otp));
+    memset(&s_g_stats, 0, sizeof(s_g_stats));
+    s_g_powered = 0U;
+
+    /* Unique ID: 8 words from a xorshift sequence. */
+    for (uint16_t i = 0U; i < 8U; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        s_g_otp[UID_ADDR + i] = (uint16_t) x;
+    }
+
+    s_g_otp[PART_NUM_ADDR]    = OTP_SIM_PART_NUM;
+    s_g_otp[PRODUCT_VER_ADDR] = OTP_SIM_PRODUCT_VER;
+}
+
+int otp_sim_attach (char const * p_path)
+{
+    uint8_t bytes[OTP_SIM_WORDS * 2U];
+    size_t  size;
+
+    s_gp_image = fopen(p_path, "r+b");
+    if (NULL == s_gp_image)
+    {
+        /* New board: write the current contents. */
+        s_gp_image = fopen(p_path, "w+b");
+        if (NULL == s_gp_image)
+        {
+            return -1;
+        }
+        for (uint16_t addr = 0U; addr < OTP_SIM_WORDS; addr++)
+        {
+            otp_sim_save(addr);
+        }
+
+        return 0;
+    }
+
+    size = fread(bytes, 1U, sizeof(bytes), s_gp_image);
+    if (sizeof(bytes) != size)
+    {
+        (void) fclose(s_gp_image);
+        s_gp_image = NULL;
+
+        return -1;
+    }
+    for (uint16_t addr = 0U; addr < OTP_SIM_WORDS; addr++)
+    {
+        s_g_otp[addr] = (uint16_t) (bytes[addr * 2U] | (bytes[(addr * 2U) + 1U] << 8));
+    }
+
+    return 0;
+}
+
+uint16_t otp_sim_peek (uint16_t addr)
+{
+    return s_g_otp[addr % OTP_SIM_WORDS];
+}
+
+void otp_sim_poke (uint16_t addr, uint16_t data)
+{
+    s_g_otp[addr % OTP_SIM_WORDS] = data;
+    otp_sim_save(addr % OTP_SIM_WORDS);
+}
+
+void otp_sim_latency (uint32_t write_us, uint32_t read_us)
+{
+    s_g_write_us = write_us;
+    s_g_read_us  = read_us;
+}
+
+otp_sim_stats_t const * otp_sim_stats (void)
+{
+    return &s_g_stats;
+}
+
+/******************************************************************************
+ * otp.h functions
+ ******************************************************************************/
+
+otp_err_t otp_power_on (void)
+{
+    s_g_powered = 1U;
+
+    return OTP_SUCCESS;
+}
+
+void otp_power_off (void)
+{
+    s_g_powered = 0U;
+}
+
+otp_err_t write_otp_data (uint16_t otp_addr, uint16_t data)
+{
+    if ((0U == s_g_powered) || (OTP_SIM_WORDS <= otp_addr))
+    {
+        s_g_stats.write_errors++;
+        LOG3(LOG_OTP_WRITE, otp_addr, data, OTP_ERROR);
+        otp_audit_record(otp_addr, data, (uint8_t) OTP_ERROR);
+
+        return OTP_ERROR;
+    }
+
+    /* Write protection of a write-once word. */
+    if (otp_sim_write_once(otp_addr) && (0U != s_g_otp[otp_addr]))
+    {
+        s_g_stats.write_errors++;
+        LOG3(LOG_OTP_WRITE, otp_addr, data, OTP_ERROR);
+        otp_audit_record(otp_addr, data, (uint8_t) OTP_ERROR);
+
+        return OTP_ERROR;
+    }
+
+    /* Programmed bits stay programmed. */
+    otp_sim_wait(s_g_write_us);
+    s_g_otp[otp_addr] |= data;
+    s_g_stats.writes++;
+    otp_sim_save(otp_addr);
+    LOG3(LOG_OTP_WRITE, otp_addr, data, OTP_SUCCESS);
+    otp_audit_record(otp_addr, data, (uint8_t) OTP_SUCCESS);
+
+    return OTP_SUCCESS;
+}
+
+otp_err_t read_otp_data (uint16_t otp_addr, uint16_t * p_data)
+{
+    if ((0U == s_g_powered) || (OTP_SIM_WORDS <= otp_addr))
+    {
+        LOG1(LOG_OTP_READ_FAIL, otp_addr);
+
+        return OTP_ERROR;
+    }
+
+    otp_sim_wait(s_g_read_us);
+    *p_data = s_g_otp[otp_addr];
+    s_g_stats.reads++;
+
+    return OTP_SUCCESS;
+}
+
+otp_err_t write_otp_multiple_data (uint16_t addr, uint8_t * const p_data, uint8_t data_len)
+{
+    if (0U != (data_len % 2U))
+    {
+        return OTP_ERROR;
+    }
+
+    for (uint8_t i = 0U; i < data_len; i += OTP_WRITE_SIZE)
+    {
+        uint16_t write_data = 0U;
+        memcpy(&write_data, p_data + i, OTP_WRITE_SIZE);
+        if (OTP_SUCCESS != write_otp_data(addr++, write_data))
+        {
+            return OTP_ERROR;
+        }
+    }
+
+    return OTP_SUCCESS;
+}
+
+otp_err_t read_otp_multiple_data (uint16_t addr, uint8_t * p_data, uint8_t data_len)
+{
+    if (0U != (data_len % 2U))
+    {
+        return OTP_ERROR;
+    }
+
+    for (uint8_t i = 0U; i < data_len; i += OTP_WRITE_SIZE)
+    {
+        uint16_t read_data = 0U;
+        if (OTP_SUCCESS != read_otp_data(addr++, &read_data))
+        {
+            return OTP_ERROR;
+        }
+        memcpy(p_data + i, &read_data, OTP_WRITE_SIZE);
+    }
+
+    return OTP_SUCCESS;
+}
@@ -0,0 +1,66 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+#ifndef OTP_SIM_H_
+#define OTP_SIM_H_
+
+/******************************************************************************
+ * Simulated OTP (host only).
+ *
+ * Implements the functions of src/OTP_Example/otp.h on a word array instead
+ * of the R_OTP registers, so the OTP commands run unchanged in a Linux
+ * process. Link otp_sim.c in place of otp.c.
+ *
+ * The model follows the part: a word can only gain bits (programmed bits
+ * stay programmed), words of the write-once areas (user area, SHOSTIF and
+ * PHOSTIF boot areas) refuse a second write, and access is refused while the
+ * OTP is powered off. With an image file attached, every write is saved to
+ * it, so a virtual board keeps its OTP across runs like a real one.
+ ******************************************************************************/
+#include <stdint.h>
+
+/* Number of 16-bit words in the simulated OTP */
+#define OTP_SIM_WORDS    (0x0200U)
+
+/* Statistics */
+typedef struct
+{
+    uint32_t reads;              // Words read
+    uint32_t writes;             // Words written
+    uint32_t write_errors;       // Writes refused (write-once word, power off)
+} otp_sim_stats_t;
+
+/* Start from a blank OTP. The unique ID is derived from seed. */
+void otp_sim_reset(uint32_t seed);
+
+/* Load the OTP from an image file and save every write to it. A missing
+ * file is created from the current contents. Returns 0 on success. */
+int otp_sim_attach(char const * p_path);
+
+/* Access the words directly (no power or write-once checks). */
+uint16_t otp_sim_peek(uint16_t addr);
+void     otp_sim_poke(uint16_t addr, uint16_t data);
+
+/* Time one word write and one word read take, in microseconds (default 0).
+ * The access sleeps for it, as the driver on the board waits for the OTP. */
+void otp_sim_latency(uint32_t write_us, uint32_t read_us);
+
+otp_sim_stats_t const * otp_sim_stats(void);
+
+#endif /* OTP_SIM_H_ */
@@ -0,0 +1,421 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Host mock of the DMAC transfer driver. See r_dmac_sim.h.
+ *
+ * Build (together with the code under test):
+ *   gcc -O2 -D_RENESAS_RZN_ -D_RZN_CORE=CR52_0 -D__ARM_ARCH_8R__=1 -fgnu89-inline \
+ *       -Irzn/arm/CMSIS_5/CMSIS/Core_R/Include -Irzn/fsp/inc -Irzn/fsp/inc/api \
+ *       -Irzn/fsp/inc/instances -Irzn_cfg/fsp_cfg -Irzn_cfg/fsp_cfg/bsp -Irzn_gen \
+ *       -Itools/sim -c tools/sim/r_dmac_sim.c
+ ******************************************************************************/
+
+#include <string.h>
+#include "r_dmac_sim.h"
+
+#define DMAC_SIM_OPEN    (0x444D4153U) /* "DMAS" */
+
+/******************************************************************************
+ * Private functions
+ ******************************************************************************/
+
+static dmac_extended_cfg_t const * sim_extend (dmac_sim_instance_ctrl_t const * p_ctrl)
+{
+    return (dmac_extended_cfg_t const *) p_ctrl->dmac.p_cfg->p_extend;
+}
+
+/* Bytes per transfer unit on the source and destination side. */
+static void sim_unit_sizes (transfer_info_t const * p_info, uint32_t * p_src_unit, uint32_t * p_dest_unit)
+{
+    dmac_extended_info_t const * p_info_extend = (dmac_extended_info_t const *) p_info->p_extend;
+    uint32_t                     src_size      = (uint32_t) p_info->size;
+    uint32_t                     dest_size     = (uint32_t) p_info->size;
+    if (NULL != p_info_extend)
+    {
+        src_size  = (uint32_t) p_info_extend->src_size;
+        dest_size = (uint32_t) p_info_extend->dest_size;
+    }
+
+    *p_src_unit  = 1U << src_size;
+    *p_dest_unit = 1U << dest_size;
+}
+
+/* Load register set set_index into the current registers, as the hardware does at the start of a set. */
+static void sim_set_load (dmac_sim_instance_ctrl_t * p_ctrl, uint32_t set_index)
+{
+    transfer_info_t const * p_info = p_ctrl->dmac.p_info;
+    uintptr_t               src;
+    uintptr_t               dest;
+
+    if (TRANSFER_CHAIN_MODE_DISABLED != p_info->chain_mode)
+    {
+        p_info = &p_info[set_index];
+        src    = (uintptr_t) p_info->p_src;
+        dest   = (uintptr_t) p_info->p_dest;
+    }
+    else
+    {
+        src  = (uintptr_t) p_info->p_src;
+        dest = (uintptr_t) p_info->p_dest;
+
+        /* Repeat and block mode: the repeat area returns to its start for every set, the other side continues. */
+        if (TRANSFER_MODE_NORMAL != p_info->mode)
+        {
+            uintptr_t offset = (uintptr_t) set_index * p_info->length;
+            if (TRANSFER_REPEAT_AREA_SOURCE == p_info->repeat_area)
+            {
+                if (TRANSFER_ADDR_MODE_INCREMENTED == p_info->dest_addr_mode)
+                {
+                    dest += offset;
+                }
+            }
+            else if (TRANSFER_ADDR_MODE_INCREMENTED == p_info->src_addr_mode)
+            {
+                src += offset;
+            }
+            else
+            {
+                /* Fixed source: nothing to advance. */
+            }
+        }
+    }
+
+    p_ctrl->src       = src;
+    p_ctrl->dest      = dest;
+    p_ctrl->remaining = p_info->length;
+}
+
+/* Move one transfer unit. Returns true when the current register set is finished. */
+static bool sim_move_unit (dmac_sim_instance_ctrl_t * p_ctrl)
+{
+    transfer_info_t const * p_info = p_ctrl->dmac.p_info;
+    uint32_t                src_unit;
+    uint32_t                dest_unit;
+    sim_unit_sizes(p_info, &src_unit, &dest_unit);
+
+    /* The DMAC reads and writes in its own unit sizes; one request moves the larger of the two. */
+    uint32_t unit = (src_unit > dest_unit) ? src_unit : dest_unit;
+    if (unit > p_ctrl->remaining)
+    {
+        unit = p_ctrl->remaining;
+    }
+
+    memcpy((void *) p_ctrl->dest, (void const *) p_ctrl->src, unit);
+
+    if (TRANSFER_ADDR_MODE_FIXED != p_info->src_addr_mode)
+    {
+        p_ctrl->src += unit;
+    }
+
+    if (TRANSFER_ADDR_MODE_FIXED != p_info->dest_addr_mode)
+    {
+        p_ctrl->dest += unit;
+    }
+
+    p_ctrl->remaining -= unit;
+
+    return 0U == p_ctrl->remaining;
+}
+
+/* Register set finished: same sequencing as dmac_int_isr(). Returns true when the whole transfer is complete. */
+static bool sim_set_complete (dmac_sim_instance_ctrl_t * p_ctrl)
+{
+    dmac_instance_ctrl_t      * p_dmac   = &p_ctrl->dmac;
+    dmac_extended_cfg_t const * p_extend = sim_extend(p_ctrl);
+
+    p_dmac->sets_done++;
+    bool complete = (0U != p_dmac->sets_total) && (p_dmac->sets_done >= p_dmac->sets_total);
+
+    if (complete)
+    {
+        p_ctrl->enabled = false;
+    }
+    else
+    {
+        sim_set_load(p_ctrl, p_dmac->sets_done);
+    }
+
+    if (complete && (NULL != p_extend->p_peripheral_module_handler))
+    {
+        p_extend->p_peripheral_module_handler((IRQn_Type) p_extend->activation_source);
+    }
+
+    if ((NULL != p_dmac->p_callback) &&
+        (complete || (0U == p_dmac->sets_total) || (TRANSFER_IRQ_EACH == p_dmac->p_info->irq)))
+    {
+        dmac_callback_args_t   args;
+        dmac_callback_args_t * p_args = (NULL != p_dmac->p_callback_memory) ? p_dmac->p_callback_memory : &args;
+        p_args->p_context = p_dmac->p_context;
+        p_dmac->p_callback(p_args);
+    }
+
+    return complete;
+}
+
+/* Move a whole register set. Returns true when the whole transfer is complete. */
+static bool sim_run_set (dmac_sim_instance_ctrl_t * p_ctrl)
+{
+    while (!sim_move_unit(p_ctrl))
+    {
+        ;
+    }
+
+    return sim_set_complete(p_ctrl);
+}
+
+static fsp_err_t sim_prepare (dmac_sim_instance_ctrl_t * p_ctrl, transfer_info_t const * p_info)
+{
+    FSP_ERROR_RETURN((TRANSFER_ADDR_MODE_FIXED == p_info->src_addr_mode) ||
+                     (TRANSFER_ADDR_MODE_INCREMENTED == p_info->src_addr_mode), FSP_ERR_UNSUPPORTED);
+    FSP_ERROR_RETURN((TRANSFER_ADDR_MODE_FIXED == p_info->dest_addr_mode) ||
+                     (TRANSFER_ADDR_MODE_INCREMENTED == p_info->dest_addr_mode), FSP_ERR_UNSUPPORTED);
+    FSP_ERROR_RETURN(TRANSFER_CHAIN_MODE_EACH != p_info->chain_mode, FSP_ERR_UNSUPPORTED);
+    FSP_ASSERT(0U != p_info->length);
+    FSP_ASSERT((TRANSFER_MODE_BLOCK != p_info->mode) || (0U != p_info->num_blocks));
+
+    uint32_t sets_total = 1U;
+    if (TRANSFER_CHAIN_MODE_END == p_info->chain_mode)
+    {
+        FSP_ERROR_RETURN(TRANSFER_MODE_NORMAL == p_info->mode, FSP_ERR_UNSUPPORTED);
+
+        while (TRANSFER_CHAIN_MODE_DISABLED != p_info[sets_total - 1U].chain_mode)
+        {
+            sets_total++;
+        }
+    }
+    else if (TRANSFER_MODE_NORMAL != p_info->mode)
+    {
+        sets_total = p_info->num_blocks;
+    }
+    else
+    {
+        /* Normal mode: one register set. */
+    }
+
+    p_ctrl->dmac.p_info          = p_info;
+    p_ctrl->dmac.sets_total      = sets_total;
+    p_ctrl->dmac.sets_loaded     = sets_total;
+    p_ctrl->dmac.sets_done       = 0U;
+    p_ctrl->dmac.software_repeat = 0U;
+    p_ctrl->enabled              = false;
+    sim_set_load(p_ctrl, 0U);
+
+    return FSP_SUCCESS;
+}
+
+/******************************************************************************
+ * transfer_api_t implementation
+ ******************************************************************************/
+
+static fsp_err_t sim_open (transfer_ctrl_t * const p_api_ctrl, transfer_cfg_t const * const p_cfg)
+{
+    dmac_sim_instance_ctrl_t * p_ctrl = (dmac_sim_instance_ctrl_t *) p_api_ctrl;
+    FSP_ASSERT(NULL != p_ctrl);
+    FSP_ASSERT(NULL != p_cfg);
+    FSP_ASSERT(NULL != p_cfg->p_extend);
+    FSP_ERROR_RETURN(DMAC_SIM_OPEN != p_ctrl->dmac.open, FSP_ERR_ALREADY_OPEN);
+
+    dmac_extended_cfg_t const * p_extend = (dmac_extended_cfg_t const *) p_cfg->p_extend;
+
+    memset(p_ctrl, 0, sizeof(*p_ctrl));
+    p_ctrl->dmac.p_cfg      = p_cfg;
+    p_ctrl->dmac.p_info     = p_cfg->p_info;
+    p_ctrl->dmac.p_callback = p_extend->p_callback;
+    p_ctrl->dmac.p_context  = p_extend->p_context;
+    p_ctrl->dmac.open       = DMAC_SIM_OPEN;
+
+    return FSP_SUCCESS;
+}
+
+static fsp_err_t sim_enable (transfer_ctrl_t * const p_api_ctrl)
+{
+    dmac_sim_instance_ctrl_t * p_ctrl = (dmac_sim_instance_ctrl_t *) p_api_ctrl;
+    FSP_ERROR_RETURN(DMAC_SIM_OPEN == p_ctrl->dmac.open, FSP_ERR_NOT_OPEN);
+
+    if (ELC_EVENT_NONE != sim_extend(p_ctrl)->activation_source)
+    {
+        p_ctrl->enabled = true;
+    }
+
+    return FSP_SUCCESS;
+}
+
+static fsp_err_t sim_reconfigure (transfer_ctrl_t * const p_api_ctrl, transfer_info_t * p_info)
+{
+    dmac_sim_instance_ctrl_t * p_ctrl = (dmac_sim_instance_ctrl_t *) p_api_ctrl;
+    FSP_ERROR_RETURN(DMAC_SIM_OPEN == p_ctrl->dmac.open, FSP_ERR_NOT_OPEN);
+    FSP_ASSERT(NULL != p_info);
+
+    fsp_err_t err = sim_prepare(p_ctrl, p_info);
+    FSP_ERROR_RETURN(FSP_SUCCESS == err, err);
+
+    return sim_enable(p_ctrl);
+}
+
+static fsp_err_t sim_reset (transfer_ctrl_t * const p_api_ctrl,
+                            void const * volatile   p_src,
+                            void * volatile         p_dest,
+                            uint16_t const          num_transfers)
+{
+    dmac_sim_instance_ctrl_t * p_ctrl = (dmac_sim_instance_ctrl_t *) p_api_ctrl;
+    FSP_ERROR_RETURN(DMAC_SIM_OPEN == p_ctrl->dmac.open, FSP_ERR_NOT_OPEN);
+
+    transfer_info_t * p_info = p_ctrl->dmac.p_cfg->p_info;
+    if (NULL != p_src)
+    {
+        p_info->p_src = p_src;
+    }
+
+    if (NULL != p_dest)
+    {
+        p_info->p_dest = p_dest;
+    }
+
+    if (TRANSFER_MODE_NORMAL == p_info->mode)
+    {
+        p_info->length = num_transfers;
+    }
+    else
+    {
+        p_info->num_blocks = num_transfers;
+    }
+
+    return sim_reconfigure(p_ctrl, p_info);
+}
+
+static fsp_err_t sim_software_start (transfer_ctrl_t * const p_api_ctrl, transfer_start_mode_t mode)
+{
+    dmac_sim_instance_ctrl_t * p_ctrl = (dmac_sim_instance_ctrl_t *) p_api_ctrl;
+    FSP_ERROR_RETURN(DMAC_SIM_OPEN == p_ctrl->dmac.open, FSP_ERR_NOT_OPEN);
+    FSP_ERROR_RETURN(ELC_EVENT_NONE == sim_extend(p_ctrl)->activation_source, FSP_ERR_UNSUPPORTED);
+
+    /* Software requests always move a whole register set; a repeat start runs until the transfer is complete.
+     * An endless repeat started in repeat mode would never return, so it runs one set per call. */
+    p_ctrl->enabled = true;
+    bool complete = sim_run_set(p_ctrl);
+    while ((TRANSFER_START_MODE_REPEAT == mode) && !complete && (0U != p_ctrl->dmac.sets_total))
+    {
+        complete = sim_run_set(p_ctrl);
+    }
+
+    return FSP_SUCCESS;
+}
+
+static fsp_err_t sim_software_stop (transfer_ctrl_t * const p_api_ctrl)
+{
+    dmac_sim_instance_ctrl_t * p_ctrl = (dmac_sim_instance_ctrl_t *) p_api_ctrl;
+    FSP_ERROR_RETURN(DMAC_SIM_OPEN == p_ctrl->dmac.open, FSP_ERR_NOT_OPEN);
+
+    p_ctrl->dmac.software_repeat = 0U;
+
+    return FSP_SUCCESS;
+}
+
+static fsp_err_t sim_disable (transfer_ctrl_t * const p_api_ctrl)
+{
+    dmac_sim_instance_ctrl_t * p_ctrl = (dmac_sim_instance_ctrl_t *) p_api_ctrl;
+    FSP_ERROR_RETURN(DMAC_SIM_OPEN == p_ctrl->dmac.open, FSP_ERR_NOT_OPEN);
+
+    p_ctrl->enabled = false;
+
+    return FSP_SUCCESS;
+}
+
+static fsp_err_t sim_info_get (transfer_ctrl_t * const p_api_ctrl, transfer_properties_t * const p_properties)
+{
+    dmac_sim_instance_ctrl_t * p_ctrl = (dmac_sim_instance_ctrl_t *) p_api_ctrl;
+    FSP_ERROR_RETURN(DMAC_SIM_OPEN == p_ctrl->dmac.open, FSP_ERR_NOT_OPEN);
+
+    p_properties->block_count_max           = DMAC_MAX_BLOCK_TRANSFER_NUMBER;
+    p_properties->block_count_remaining     = (0U == p_ctrl->dmac.sets_total) ? DMAC_MAX_BLOCK_TRANSFER_NUMBER :
+                                              (p_ctrl->dmac.sets_total - p_ctrl->dmac.sets_done);
+    p_properties->transfer_length_max       = DMAC_MAX_NORMAL_TRANSFER_LENGTH;
+    p_properties->transfer_length_remaining = p_ctrl->remaining;
+
+    return FSP_SUCCESS;
+}
+
+static fsp_err_t sim_close (transfer_ctrl_t * const p_api_ctrl)
+{
+    dmac_sim_instance_ctrl_t * p_ctrl = (dmac_sim_instance_ctrl_t *) p_api_ctrl;
+    FSP_ERROR_RETURN(DMAC_SIM_OPEN == p_ctrl->dmac.open, FSP_ERR_NOT_OPEN);
+
+    p_ctrl->enabled   = false;
+    p_ctrl->dmac.open = 0U;
+
+    return FSP_SUCCESS;
+}
+
+static fsp_err_t sim_version_get (fsp_version_t * const p_version)
+{
+    p_version->api_version_major  = TRANSFER_API_VERSION_MAJOR;
+    p_version->api_version_minor  = TRANSFER_API_VERSION_MINOR;
+    p_version->code_version_major = DMAC_CODE_VERSION_MAJOR;
+    p_version->code_version_minor = DMAC_CODE_VERSION_MINOR;
+
+    return FSP_SUCCESS;
+}
+
+/******************************************************************************
+ * Public interface
+ ******************************************************************************/
+
+const transfer_api_t g_transfer_on_dmac_sim =
+{
+    .open          = sim_open,
+    .reconfigure   = sim_reconfigure,
+    .reset         = sim_reset,
+    .infoGet       = sim_info_get,
+    .softwareStart = sim_software_start,
+    .softwareStop  = sim_software_stop,
+    .enable        = sim_enable,
+    .disable       = sim_disable,
+    .close         = sim_close,
+    .versionGet    = sim_version_get,
+};
+
+uint32_t R_DMAC_SIM_Request (dmac_sim_instance_ctrl_t * p_ctrl, uint32_t num_requests)
+{
+    uint32_t served = 0U;
+    bool     block  = (TRANSFER_MODE_BLOCK == p_ctrl->dmac.p_info->mode);
+
+    while ((served < num_requests) && p_ctrl->enabled)
+    {
+        served++;
+        p_ctrl->requests++;
+
+        bool set_done = block ? true : sim_move_unit(p_ctrl);
+        if (block)
+        {
+            while (!sim_move_unit(p_ctrl))
+            {
+                ;
+            }
+        }
+
+        if (set_done)
+        {
+            (void) sim_set_complete(p_ctrl);
+        }
+    }
+
+    return served;
+}
@@ -0,0 +1,59 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Host mock of the DMAC transfer driver (r_dmac.c).
+ *
+ * Implements transfer_api_t with plain memory copies so code written against
+ * the DMAC instance (e.g. the SCI UART DMAC path) can run on Linux. The mock
+ * takes the same transfer_cfg_t / dmac_extended_cfg_t as the real driver and
+ * follows the same register set sequence (normal, repeat, block, chain).
+ *
+ * Nothing moves by itself: the test calls R_DMAC_SIM_Request() for every
+ * activation request the peripheral would raise (e.g. one per TXI), or
+ * R_DMAC_SoftwareStart() for software-triggered transfers. When the transfer
+ * completes, the peripheral module handler and the user callback are called
+ * as from dmac_int_isr().
+ ******************************************************************************/
+
+#ifndef R_DMAC_SIM_H
+#define R_DMAC_SIM_H
+
+#include "r_dmac.h"
+
+/* Control block of a simulated DMAC channel. Use it in place of dmac_instance_ctrl_t. */
+typedef struct st_dmac_sim_instance_ctrl
+{
+    dmac_instance_ctrl_t dmac;         /* Same bookkeeping as the real driver */
+    uintptr_t            src;          /* Current source address */
+    uintptr_t            dest;         /* Current destination address */
+    uint32_t             remaining;    /* Bytes left in the current register set (CRTB) */
+    bool                 enabled;      /* Channel enabled (CHSTAT.EN) */
+    uint32_t             requests;     /* Activation requests served, for statistics */
+} dmac_sim_instance_ctrl_t;
+
+extern const transfer_api_t g_transfer_on_dmac_sim;
+
+/* Serve up to num_requests activation requests. Each request moves one
+ * transfer unit, or a whole register set in block mode. Returns the number of
+ * requests that found the channel enabled. */
+uint32_t R_DMAC_SIM_Request(dmac_sim_instance_ctrl_t * p_ctrl, uint32_t num_requests);
+
+#endif /* R_DMAC_SIM_H */
@@ -0,0 +1,663 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Host tool: virtual board swarm.
+ *
+ * Starts a line of virtual boards (virtual_board.c), each a process of its
+ * own with its own pty and OTP image, and runs a host tool against them: the
+ * command after "--" gets the pty paths appended. When it exits, the boards
+ * are stopped and report what they served (virtual_board -S), and the swarm
+ * prints the throughput and the spread of the board sessions. Without a
+ * command the swarm prints the pty paths and serves until SIGINT or SIGTERM.
+ *
+ * Every board runs the firmware's command stack, so a farm or a provision
+ * script meets hundreds of boards without a rack of hardware. -l and -L
+ * give every board the line rate and the OTP word times of the real part
+ * (see virtual_board.c).
+ *
+ * A board session runs from the first byte it received to the last byte it
+ * sent. The host wait is the part of it the board spent with nothing to do
+ * (waiting for the host's next command). A line that is mostly waiting
+ * points at the host: its CPU, its threads or its serial ports keep the
+ * boards idle. -r writes the figures of each board to a CSV file, to find
+ * the stations the host served worst.
+ *
+ * Usage:
+ *   swarm [-n boards] [-l baud] [-L write_us[:read_us]] [-u seed] [-d dir] [-B virtual_board] [-r report.csv]
+ *         [-- command [args...]]
+ *
+ * -u gives the UID seed of the first board; the next boards count up from it
+ * in steps of two (otp_sim_reset() ignores bit 0 of the seed).
+ * -d keeps the OTP of board N in dir/boardN.otp across runs (default: blank
+ * boards); dir is created if it does not exist. -B gives the virtual_board binary (default: the one next to swarm).
+ *
+ * Example:
+ *   swarm -n 200 -l 921600 -L 50 -- farm -x line.cs -k key -n 1 -b 921600
+ *
+ * Build:
+ *   gcc -O2 -o swarm tools/sim/swarm.c
+ ******************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+#define DEFAULT_BOARDS          (16U)
+#define DEFAULT_UID_SEED        (0x4E324C31U)    /* "N2L1", as virtual_board */
+#define MAX_BOARDS              (1024U)
+#define START_TIMEOUT_MS        (5000)              // For a board to print its pty
+#define LINE_SIZE               (256U)
+#define SLOWEST_SHOWN           (5U)
+#define BOTTLENECK_SHARE        (0.5)               // Share of the sessions that names the bottleneck
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+/* One virtual board */
+typedef struct
+{
+    pid_t    pid;
+    int      out_fd;                    // Its stdout: the pty line, then the statistics line
+    uint32_t seed;
+    char     pty[64];
+    char     line[LINE_SIZE];           // Output not yet taken
+    uint32_t line_size;
+    bool     have_stats;
+    uint64_t rx_bytes;
+    uint64_t tx_bytes;
+    double   first_s;                   // First byte received, CLOCK_MONOTONIC
+    double   last_s;                    // Last byte sent
+    double   wait_s;                    // Waiting for the host between the two
+    uint32_t otp_writes;
+    uint32_t otp_reads;
+    uint32_t otp_errors;
+} board_t;
+
+static board_t               s_boards[MAX_BOARDS];
+static uint32_t              s_num_boards;
+static volatile sig_atomic_t s_stop;
+
+static double now_s (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+static void on_signal (int sig)
+{
+    (void) sig;
+    s_stop = 1;
+}
+
+static int compare_double (void const * p_a, void const * p_b)
+{
+    double a = *(double const *) p_a;
+    double b = *(double const *) p_b;
+
+    return (a > b) - (a < b);
+}
+
+static double session_s (board_t const * p_board)
+{
+    return (p_board->last_s > p_board->first_s) ? (p_board->last_s - p_board->first_s) : 0.0;
+}
+
+/******************************************************************************
+ * Boards
+ ******************************************************************************/
+
+/* Read one line of the board's output. timeout_ms < 0 waits for ever.
+ * Returns 0 on success, -1 at end of output or on timeout. */
+static int board_read_line (board_t * p_board, char * p_text, int timeout_ms)
+{
+    double deadline = now_s() + (timeout_ms / 1000.0);
+
+    while (1)
+    {
+        char * p_end = memchr(p_board->line, '\n', p_board->line_size);
+        if (NULL != p_end)
+        {
+            uint32_t size = (uint32_t) (p_end - p_board->line);
+
+            memcpy(p_text, p_board->line, size);
+            p_text[size] = '\0';
+            p_board->line_size -= size + 1U;
+            memmove(p_board->line, p_end + 1, p_board->line_size);
+
+            return 0;
+        }
+        if ((LINE_SIZE - 1U) == p_board->line_size)
+        {
+            p_board->line_size = 0U;                  // Not ours: drop it
+        }
+
+        struct pollfd pfd  = {.fd = p_board->out_fd, .events = POLLIN};
+        int           wait = (timeout_ms < 0) ? -1 : (int) ((deadline - now_s()) * 1000.0);
+        if ((timeout_ms >= 0) && (wait <= 0))
+        {
+            return -1;
+        }
+        if (poll(&pfd, 1, wait) <= 0)
+        {
+            if ((timeout_ms < 0) && (EINTR == errno))
+            {
+                continue;
+            }
+
+            return -1;
+        }
+
+        ssize_t n = read(p_board->out_fd, &p_board->line[p_board->line_size], LINE_SIZE - 1U - p_board->line_size);
+        if (n <= 0)
+        {
+            if ((n < 0) && (EINTR == errno))
+            {
+                continue;
+            }
+
+            return -1;
+        }
+        p_board->line_size += (uint32_t) n;
+    }
+}
+
+static int board_start (board_t * p_board, uint32_t index, char const * p_program, char * const * p_args,
+                        char const * p_dir)
+{
+    char    text[LINE_SIZE];
+    char    image[PATH_MAX];
+    char    seed[16];
+    char  * args[16];
+    int     fds[2];
+    int     n = 0;
+
+    while (NULL != p_args[n])
+    {
+        args[n] = p_args[n];
+        n++;
+    }
+    snprintf(seed, sizeof(seed), "%u", (unsigned) p_board->seed);
+    args[n++] = "-u";
+    args[n++] = seed;
+    if (NULL != p_dir)
+    {
+        snprintf(image, sizeof(image), "%s/board%u.otp", p_dir, (unsigned) index);
+        args[n++] = "-o";
+        args[n++] = image;
+    }
+    args[n] = NULL;
+
+    if (0 != pipe(fds))
+    {
+        return -1;
+    }
+    p_board->pid = fork();
+    if (p_board->pid < 0)
+    {
+        close(fds[0]);
+        close(fds[1]);
+
+        return -1;
+    }
+    if (0 == p_board->pid)
+    {
+        /* The board takes its stop from the swarm, not from the terminal. */
+        (void) setpgid(0, 0);
+        (void) dup2(fds[1], STDOUT_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+        execv(p_program, args);
+        perror(p_program);
+        _exit(127);
+    }
+    close(fds[1]);
+    p_board->out_fd = fds[0];
+    (void) fcntl(p_board->out_fd, F_SETFD, FD_CLOEXEC);
+
+    if (0 != board_read_line(p_board, text, START_TIMEOUT_MS))
+    {
+        errno = ETIMEDOUT;
+
+        return -1;
+    }
+    if (1 != sscanf(text, "virtual board on %63s", p_board->pty))
+    {
+        errno = EPROTO;
+
+        return -1;
+    }
+
+    return 0;
+}
+
+/* Stop every board, then collect the statistics each prints at exit. */
+static void boards_stop (void)
+{
+    char text[LINE_SIZE];
+
+    for (uint32_t i = 0U; i < s_num_boards; i++)
+    {
+        (void) kill(s_boards[i].pid, SIGTERM);
+    }
+    for (uint32_t i = 0U; i < s_num_boards; i++)
+    {
+        board_t * p_board = &s_boards[i];
+
+        while (0 == board_read_line(p_board, text, -1))
+        {
+            unsigned long long rx;
+            unsigned long long tx;
+            unsigned           writes;
+            unsigned           reads;
+            unsigned           errors;
+
+            if (8 == sscanf(text, "stats rx=%llu tx=%llu first=%lf last=%lf wait=%lf otp_writes=%u otp_reads=%u "
+                            "otp_errors=%u", &rx, &tx, &p_board->first_s, &p_board->last_s, &p_board->wait_s,
+                            &writes, &reads, &errors))
+            {
+                p_board->have_stats = true;
+                p_board->rx_bytes   = rx;
+                p_board->tx_bytes   = tx;
+                p_board->otp_writes = writes;
+                p_board->otp_reads  = reads;
+                p_board->otp_errors = errors;
+            }
+        }
+        close(p_board->out_fd);
+        (void) waitpid(p_board->pid, NULL, 0);
+    }
+}
+
+/******************************************************************************
+ * Report
+ ******************************************************************************/
+
+static void print_spread (char const * p_name, double * p_values, uint32_t count, double scale)
+{
+    if (0U == count)
+    {
+        return;
+    }
+
+    qsort(p_values, count, sizeof(double), compare_double);
+    printf("%-16s p50 %8.3f  p90 %8.3f  p99 %8.3f  max %8.3f\n", p_name, p_values[(count - 1U) / 2U] * scale,
+           p_values[((count - 1U) * 90U) / 100U] * scale, p_values[((count - 1U) * 99U) / 100U] * scale,
+           p_values[count - 1U] * scale);
+}
+
+static int write_csv (char const * p_path, uint32_t baud_rate)
+{
+    FILE * p_file = fopen(p_path, "w");
+
+    if (NULL == p_file)
+    {
+        return -1;
+    }
+
+    fprintf(p_file, "board,pty,seed,rx_bytes,tx_bytes,session_s,host_wait_s,line_use,"
+            "otp_writes,otp_reads,otp_errors\n");
+    for (uint32_t i = 0U; i < s_num_boards; i++)
+    {
+        board_t const * p_board = &s_boards[i];
+        double          session = session_s(p_board);
+        double          line    = ((0U != baud_rate) && (session > 0.0)) ?
+                                  ((p_board->rx_bytes * 10.0) / baud_rate) / session : 0.0;
+
+        fprintf(p_file, "%u,%s,%u,%llu,%llu,%.6f,%.6f,%.3f,%u,%u,%u\n", (unsigned) i, p_board->pty,
+                (unsigned) p_board->seed, (unsigned long long) p_board->rx_bytes,
+                (unsigned long long) p_board->tx_bytes, session, p_board->wait_s, line,
+                (unsigned) p_board->otp_writes, (unsigned) p_board->otp_reads, (unsigned) p_board->otp_errors);
+    }
+
+    return fclose(p_file);
+}
+
+static void print_report (double elapsed, uint32_t baud_rate, uint32_t write_us, uint32_t read_us)
+{
+    static double sessions[MAX_BOARDS];
+    static double waits[MAX_BOARDS];
+    static double lines[MAX_BOARDS];
+    uint32_t      served = 0U;
+    uint32_t      lost   = 0U;
+    uint64_t      rx     = 0U;
+    uint64_t      tx     = 0U;
+    uint64_t      writes = 0U;
+    uint64_t      errors = 0U;
+    double        wait_median;
+    double        line_median = 0.0;
+
+    for (uint32_t i = 0U; i < s_num_boards; i++)
+    {
+        board_t const * p_board = &s_boards[i];
+
+        if (!p_board->have_stats)
+        {
+            lost++;
+            continue;
+        }
+        rx     += p_board->rx_bytes;
+        tx     += p_board->tx_bytes;
+        writes += p_board->otp_writes;
+        errors += p_board->otp_errors;
+        if ((0U == p_board->rx_bytes) || (0.0 == session_s(p_board)))
+        {
+            continue;
+        }
+        sessions[served] = session_s(p_board);
+        waits[served]    = p_board->wait_s / sessions[served];
+        lines[served]    = (0U != baud_rate) ? ((p_board->rx_bytes * 10.0) / baud_rate) / sessions[served] : 0.0;
+        served++;
+    }
+
+    printf("swarm: %u boards, ", (unsigned) s_num_boards);
+    if (0U != baud_rate)
+    {
+        printf("line %u baud, ", (unsigned) baud_rate);
+    }
+    else
+    {
+        printf("line unlimited, ");
+    }
+    printf("OTP write %u us, read %u us\n", (unsigned) write_us, (unsigned) read_us);
+    printf("run %.3f s: %u boards served, %u idle, %u without statistics\n", elapsed, (unsigned) served,
+           (unsigned) (s_num_boards - served - lost), (unsigned) lost);
+    printf("traffic: %.3f MB to the boards, %.3f MB back, %llu OTP words written, %llu refused\n", rx / 1e6,
+           tx / 1e6, (unsigned long long) writes, (unsigned long long) errors);
+    if (0U == served)
+    {
+        return;
+    }
+    printf("throughput: %.0f boards/hour (one session each), %.3f MB/s to the boards\n",
+           (elapsed > 0.0) ? ((served * 3600.0) / elapsed) : 0.0, (elapsed > 0.0) ? ((rx / 1e6) / elapsed) : 0.0);
+
+    print_spread("session s", sessions, served, 1.0);
+    print_spread("host wait %", waits, served, 100.0);
+    wait_median = waits[(served - 1U) / 2U];
+    if (0U != baud_rate)
+    {
+        print_spread("line use %", lines, served, 100.0);
+        line_median = lines[(served - 1U) / 2U];
+    }
+
+    /* The slowest sessions, with how long their board waited for the host. */
+    printf("slowest:\n");
+    for (uint32_t shown = 0U; shown < SLOWEST_SHOWN; shown++)
+    {
+        board_t const * p_worst = NULL;
+        double          limit   = (0U == shown) ? 1e300 : sessions[served - shown];
+
+        for (uint32_t i = 0U; i < s_num_boards; i++)
+        {
+            double session = session_s(&s_boards[i]);
+            if ((session < limit) && ((NULL == p_worst) || (session > session_s(p_worst))))
+            {
+                p_worst = &s_boards[i];
+            }
+        }
+        if ((NULL == p_worst) || (0.0 == session_s(p_worst)))
+        {
+            break;
+        }
+        printf("  %-16s %8.3f s, host wait %5.1f %%\n", p_worst->pty, session_s(p_worst),
+               (p_worst->wait_s * 100.0) / session_s(p_worst));
+    }
+
+    if (wait_median >= BOTTLENECK_SHARE)
+    {
+        printf("bottleneck: the host (boards waited for it %.0f %% of a session)\n", wait_median * 100.0);
+    }
+    else if (line_median >= BOTTLENECK_SHARE)
+    {
+        printf("bottleneck: the line rate (lines busy %.0f %% of a session)\n", line_median * 100.0);
+    }
+    else
+    {
+        printf("bottleneck: the boards (OTP and flash times)\n");
+    }
+}
+
+int main (int argc, char ** argv)
+{
+    uint32_t      num_boards = DEFAULT_BOARDS;
+    uint32_t      seed       = DEFAULT_UID_SEED;
+    uint32_t      baud_rate  = 0U;
+    uint32_t      write_us   = 0U;
+    uint32_t      read_us    = 0U;
+    char const  * p_latency  = NULL;
+    char const  * p_rate     = NULL;
+    char const  * p_dir      = NULL;
+    char const  * p_csv      = NULL;
+    char          program[PATH_MAX];
+    char       ** p_command  = NULL;
+    char        * board_args[8];
+    uint32_t      num_args   = 0U;
+    int           status     = 0;
+
+    program[0] = '\0';
+    for (int i = 1; i < argc; i++)
+    {
+        if ((0 == strcmp(argv[i], "-n")) && ((i + 1) < argc))
+        {
+            num_boards = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-l")) && ((i + 1) < argc))
+        {
+            p_rate    = argv[++i];
+            baud_rate = (uint32_t) strtoul(p_rate, NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-L")) && ((i + 1) < argc))
+        {
+            char * p_end;
+            p_latency = argv[++i];
+            write_us  = (uint32_t) strtoul(p_latency, &p_end, 0);
+            read_us   = (':' == *p_end) ? (uint32_t) strtoul(p_end + 1, NULL, 0) : 0U;
+        }
+        else if ((0 == strcmp(argv[i], "-u")) && ((i + 1) < argc))
+        {
+            seed = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-d")) && ((i + 1) < argc))
+        {
+            p_dir = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-B")) && ((i + 1) < argc))
+        {
+            snprintf(program, sizeof(program), "%s", argv[++i]);
+        }
+        else if ((0 == strcmp(argv[i], "-r")) && ((i + 1) < argc))
+        {
+            p_csv = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "--")) && ((i + 1) < argc))
+        {
+            p_command = &argv[i + 1];
+            break;
+        }
+        else
+        {
+            num_boards = 0U;
+            break;
+        }
+    }
+
+    if ((0U == num_boards) || (num_boards > MAX_BOARDS))
+    {
+        fprintf(stderr, "usage: %s [-n boards] [-l baud] [-L write_us[:read_us]] [-u seed] [-d dir]\n"
+                "           [-B virtual_board] [-r report.csv] [-- command [args...]]\n", argv[0]);
+        return 2;
+    }
+    if ('\0' == program[0])
+    {
+        /* virtual_board next to this binary */
+        ssize_t n = readlink("/proc/self/exe", program, sizeof(program) - 1U);
+        char  * p_slash;
+
+        program[(n > 0) ? n : 0] = '\0';
+        p_slash = strrchr(program, '/');
+        snprintf((NULL != p_slash) ? (p_slash + 1) : program,
+                 sizeof(program) - (size_t) ((NULL != p_slash) ? ((p_slash + 1) - program) : 0), "virtual_board");
+    }
+
+    /* The OTP images go in dir, made here so the first run finds it. */
+    if ((NULL != p_dir) && (0 != mkdir(p_dir, 0777)))
+    {
+        struct stat st;
+        int         err = errno;
+
+        if ((EEXIST == err) && ((0 != stat(p_dir, &st)) || !S_ISDIR(st.st_mode)))
+        {
+            err = ENOTDIR;
+        }
+        if (EEXIST != err)
+        {
+            fprintf(stderr, "-d %s: %s\n", p_dir, strerror(err));
+            return 1;
+        }
+    }
+
+    /* A pipe for each board here, a pty for each in the command. */
+    struct rlimit files;
+    if (0 == getrlimit(RLIMIT_NOFILE, &files))
+    {
+        files.rlim_cur = files.rlim_max;
+        (void) setrlimit(RLIMIT_NOFILE, &files);
+    }
+
+    board_args[num_args++] = program;
+    board_args[num_args++] = "-S";
+    if (NULL != p_rate)
+    {
+        board_args[num_args++] = "-l";
+        board_args[num_args++] = (char *) p_rate;
+    }
+    if (NULL != p_latency)
+    {
+        board_args[num_args++] = "-L";
+        board_args[num_args++] = (char *) p_latency;
+    }
+    board_args[num_args] = NULL;
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    (void) sigaction(SIGINT, &sa, NULL);
+    (void) sigaction(SIGTERM, &sa, NULL);
+
+    for (uint32_t i = 0U; (i < num_boards) && (0 == s_stop); i++)
+    {
+        s_boards[i].seed = seed + (i * 2U);
+        if (0 != board_start(&s_boards[i], i, program, board_args, p_dir))
+        {
+            perror(program);
+            if (s_boards[i].pid > 0)
+            {
+                (void) kill(s_boards[i].pid, SIGKILL);
+                (void) waitpid(s_boards[i].pid, NULL, 0);
+            }
+            boards_stop();
+            return 1;
+        }
+        s_num_boards++;
+    }
+
+    double t_start = now_s();
+
+    if (NULL == p_command)
+    {
+        for (uint32_t i = 0U; i < s_num_boards; i++)
+        {
+            printf("%s\n", s_boards[i].pty);
+        }
+        fflush(stdout);
+        while (0 == s_stop)
+        {
+            (void) pause();
+        }
+    }
+    else if (0 == s_stop)
+    {
+        uint32_t count = 0U;
+        while (NULL != p_command[count])
+        {
+            count++;
+        }
+
+        char ** p_argv = calloc(count + s_num_boards + 1U, sizeof(char *));
+        if (NULL == p_argv)
+        {
+            perror("swarm");
+            boards_stop();
+            return 1;
+        }
+        memcpy(p_argv, p_command, count * sizeof(char *));
+        for (uint32_t i = 0U; i < s_num_boards; i++)
+        {
+            p_argv[count + i] = s_boards[i].pty;
+        }
+
+        pid_t pid = fork();
+        if (0 == pid)
+        {
+            execvp(p_argv[0], p_argv);
+            perror(p_argv[0]);
+            _exit(127);
+        }
+        free(p_argv);
+
+        /* SIGINT reaches the command too; wait for it to finish its boards. */
+        while ((pid > 0) && (waitpid(pid, &status, 0) < 0) && (EINTR == errno))
+        {
+        }
+        status = (pid < 0) ? 1 : (WIFEXITED(status) ? WEXITSTATUS(status) : 1);
+    }
+
+    double elapsed = now_s() - t_start;
+
+    boards_stop();
+    print_report(elapsed, baud_rate, write_us, read_us);
+    if ((NULL != p_csv) && (0 != write_csv(p_csv, baud_rate)))
+    {
+        perror(p_csv);
+        return 1;
+    }
+
+    return status;
+}
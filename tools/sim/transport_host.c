@@ -0,0 +1,417 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Host transports. See transport_host.h.
+ ******************************************************************************/
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "transport_host.h"
+
+/******************************************************************************
+ * fd and pty transport
+ ******************************************************************************/
+
+static transport_err_t fd_send (void * const p_ctrl, uint8_t const * const p_data, uint32_t const size)
+{
+    transport_fd_ctrl_t * p_fd   = (transport_fd_ctrl_t *) p_ctrl;
+    uint32_t              offset = 0U;
+
+    while (offset < size)
+    {
+        ssize_t n = write(p_fd->fd_out, p_data + offset, size - offset);
+        if (n < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            if (EAGAIN == errno)
+            {
+                /* Line busy: wait until it takes bytes again. */
+                struct pollfd pfd = {.fd = p_fd->fd_out, .events = POLLOUT};
+                (void) poll(&pfd, 1, -1);
+                continue;
+            }
+
+            return TRANSPORT_ERROR;
+        }
+        offset += (uint32_t) n;
+    }
+
+    return TRANSPORT_SUCCESS;
+}
+
+static uint32_t fd_receive (void * const p_ctrl, uint8_t * const p_data, uint32_t const size)
+{
+    transport_fd_ctrl_t * p_fd = (transport_fd_ctrl_t *) p_ctrl;
+    ssize_t               n    = read(p_fd->fd_in, p_data, size);
+
+    /* Nothing waiting, end of file or a closed pty peer all read as no bytes. */
+    return (n > 0) ? (uint32_t) n : 0U;
+}
+
+static transport_err_t fd_poll (void * const p_ctrl, uint32_t const timeout_ms)
+{
+    transport_fd_ctrl_t * p_fd = (transport_fd_ctrl_t *) p_ctrl;
+    struct pollfd         pfd  = {.fd = p_fd->fd_in, .events = POLLIN};
+    int                   n    = poll(&pfd, 1, (int) timeout_ms);
+
+    if (n < 0)
+    {
+        return (EINTR == errno) ? TRANSPORT_TIMEOUT : TRANSPORT_ERROR;
+    }
+    if (0 == n)
+    {
+        return TRANSPORT_TIMEOUT;
+    }
+    if (0 == (pfd.revents & POLLIN))
+    {
+        /* Hang-up without data: a pty whose slave is not open yet. Do not spin. */
+        (void) usleep(timeout_ms * 1000U);
+
+        return TRANSPORT_TIMEOUT;
+    }
+
+    return TRANSPORT_SUCCESS;
+}
+
+static transport_err_t fd_flush (void * const p_ctrl)
+{
+    transport_fd_ctrl_t * p_fd = (transport_fd_ctrl_t *) p_ctrl;
+
+    if (isatty(p_fd->fd_out))
+    {
+        (void) tcdrain(p_fd->fd_out);
+    }
+
+    return TRANSPORT_SUCCESS;
+}
+
+transport_api_t const g_transport_fd_api =
+{
+    .send    = fd_send,
+    .receive = fd_receive,
+    .poll    = fd_poll,
+    .flush   = fd_flush,
+};
+
+int transport_fd_open (transport_fd_ctrl_t * p_ctrl, int fd_in, int fd_out)
+{
+    int flags = fcntl(fd_in, F_GETFL);
+
+    if ((flags < 0) || (fcntl(fd_in, F_SETFL, flags | O_NONBLOCK) < 0))
+    {
+        return -1;
+    }
+
+    p_ctrl->fd_in  = fd_in;
+    p_ctrl->fd_out = fd_out;
+
+    return 0;
+}
+
+int transport_pty_open (transport_fd_ctrl_t * p_ctrl, char * p_name, size_t name_size)
+{
+    struct termios tio;
+    char         * p_slave;
+    int            fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    p_slave = ((0 == grantpt(fd)) && (0 == unlockpt(fd))) ? ptsname(fd) : NULL;
+    if ((NULL == p_slave) || (0 != tcgetattr(fd, &tio)))
+    {
+        (void) close(fd);
+
+        return -1;
+    }
+
+    /* Raw bytes: no echo, no line editing, no CR/LF translation. */
+    cfmakeraw(&tio);
+    (void) tcsetattr(fd, TCSANOW, &tio);
+
+    (void) strncpy(p_name, p_slave, name_size - 1U);
+    p_name[name_size - 1U] = '\0';
+
+    return transport_fd_open(p_ctrl, fd, fd);
+}
+
+int transport_serial_open (transport_fd_ctrl_t * p_ctrl, char const * p_path, uint32_t baud_rate)
+{
+    static const struct
+    {
+        uint32_t rate;
+        speed_t  speed;
+    } rates[] =
+    {
+        {9600U, B9600}, {19200U, B19200}, {38400U, B38400}, {57600U, B57600}, {115200U, B115200},
+        {230400U, B230400}, {460800U, B460800}, {921600U, B921600},
+    };
+    struct termios tio;
+    speed_t        speed = 0;
+    int            fd;
+
+    for (uint32_t i = 0U; i < (sizeof(rates) / sizeof(rates[0])); i++)
+    {
+        if (rates[i].rate == baud_rate)
+        {
+            speed = rates[i].speed;
+        }
+    }
+    if (0 == speed)
+    {
+        errno = EINVAL;
+
+        return -1;
+    }
+
+    fd = open(p_path, O_RDWR | O_NOCTTY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    /* A pty (virtual board) has no line settings to make; only raw mode matters. */
+    if (0 == tcgetattr(fd, &tio))
+    {
+        cfmakeraw(&tio);
+        tio.c_cflag |= (tcflag_t) (CLOCAL | CREAD);
+        tio.c_cflag &= (tcflag_t) ~(CSTOPB | CRTSCTS);
+        (void) cfsetispeed(&tio, speed);
+        (void) cfsetospeed(&tio, speed);
+        (void) tcsetattr(fd, TCSANOW, &tio);
+        (void) tcflush(fd, TCIOFLUSH);
+    }
+
+    return transport_fd_open(p_ctrl, fd, fd);
+}
+
+void transport_fd_close (transport_fd_ctrl_t * p_ctrl)
+{
+    (void) close(p_ctrl->fd_in);
+    if (p_ctrl->fd_out != p_ctrl->fd_in)
+    {
+        (void) close(p_ctrl->fd_out);
+    }
+}
+
+/******************************************************************************
+ * Loopback transport
+ ******************************************************************************/
+
+static transport_err_t loop_send (void * const p_ctrl, uint8_t const * const p_data, uint32_t const size)
+{
+    transport_loop_ring_t * p_ring = ((transport_loop_ctrl_t *) p_ctrl)->p_tx;
+    uint32_t                space  = TRANSPORT_LOOP_SIZE - (p_ring->head - p_ring->tail);
+
+    /* Like a full line buffer: the bytes are lost and the link resends them. */
+    if (size > space)
+    {
+        p_ring->dropped += size;
+
+        return TRANSPORT_ERROR;
+    }
+
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        p_ring->data[(p_ring->head + i) % TRANSPORT_LOOP_SIZE] = p_data[i];
+    }
+    p_ring->head += size;
+
+    return TRANSPORT_SUCCESS;
+}
+
+static uint32_t loop_receive (void * const p_ctrl, uint8_t * const p_data, uint32_t const size)
+{
+    transport_loop_ring_t * p_ring = ((transport_loop_ctrl_t *) p_ctrl)->p_rx;
+    uint32_t                count  = p_ring->head - p_ring->tail;
+
+    if (count > size)
+    {
+        count = size;
+    }
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        p_data[i] = p_ring->data[(p_ring->tail + i) % TRANSPORT_LOOP_SIZE];
+    }
+    p_ring->tail += count;
+
+    return count;
+}
+
+static transport_err_t loop_poll (void * const p_ctrl, uint32_t const timeout_ms)
+{
+    transport_loop_ring_t * p_ring = ((transport_loop_ctrl_t *) p_ctrl)->p_rx;
+
+    (void) timeout_ms;
+
+    return (p_ring->head != p_ring->tail) ? TRANSPORT_SUCCESS : TRANSPORT_TIMEOUT;
+}
+
+static transport_err_t loop_flush (void * const p_ctrl)
+{
+    (void) p_ctrl;
+
+    return TRANSPORT_SUCCESS;
+}
+
+transport_api_t const g_transport_loop_api =
+{
+    .send    = loop_send,
+    .receive = loop_receive,
+    .poll    = loop_poll,
+    .flush   = loop_flush,
+};
+
+void transport_loop_open (transport_loop_ctrl_t * p_a,
+                          transport_loop_ctrl_t * p_b,
+                          transport_loop_ring_t * p_a_to_b,
+                          transport_loop_ring_t * p_b_to_a)
+{
+    memset(p_a_to_b, 0, sizeof(*p_a_to_b));
+    memset(p_b_to_a, 0, sizeof(*p_b_to_a));
+    p_a->p_tx = p_a_to_b;
+    p_a->p_rx = p_b_to_a;
+    p_b->p_tx = p_b_to_a;
+    p_b->p_rx = p_a_to_b;
+}
+
+/******************************************************************************
+ * Fault injection transport
+ ******************************************************************************/
+
+/* Bytes handed to the lower transport in one send */
+#define FAULT_CHUNK_SIZE    (4096U)
+
+static uint32_t fault_random (transport_fault_ctrl_t * p_fault)
+{
+    uint32_t x = p_fault->state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    p_fault->state = x;
+
+    return x;
+}
+
+/* Apply faults to size bytes in place. Returns the bytes left. */
+static uint32_t fault_apply (transport_fault_ctrl_t * p_fault, uint8_t * p_data, uint32_t size)
+{
+    uint32_t out = 0U;
+
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        uint8_t byte = p_data[i];
+
+        if (fault_random(p_fault) < p_fault->threshold)
+        {
+            uint32_t r = fault_random(p_fault);
+
+            if (0U != (r & 1U))
+            {
+                p_fault->dropped++;
+                continue;
+            }
+            byte ^= (uint8_t) (1U << ((r >> 1) & 7U));
+            p_fault->flipped++;
+        }
+        p_data[out++] = byte;
+    }
+
+    return out;
+}
+
+static transport_err_t fault_send (void * const p_ctrl, uint8_t const * const p_data, uint32_t const size)
+{
+    transport_fault_ctrl_t * p_fault = (transport_fault_ctrl_t *) p_ctrl;
+    uint8_t                  chunk[FAULT_CHUNK_SIZE];
+    transport_err_t          err     = TRANSPORT_SUCCESS;
+
+    for (uint32_t offset = 0U; (offset < size) && (TRANSPORT_SUCCESS == err); offset += FAULT_CHUNK_SIZE)
+    {
+        uint32_t n = ((size - offset) < FAULT_CHUNK_SIZE) ? (size - offset) : FAULT_CHUNK_SIZE;
+
+        memcpy(chunk, p_data + offset, n);
+        n   = fault_apply(p_fault, chunk, n);
+        err = p_fault->p_lower->p_api->send(p_fault->p_lower->p_ctrl, chunk, n);
+    }
+
+    return err;
+}
+
+static uint32_t fault_receive (void * const p_ctrl, uint8_t * const p_data, uint32_t const size)
+{
+    transport_fault_ctrl_t * p_fault = (transport_fault_ctrl_t *) p_ctrl;
+    uint32_t                 n       = p_fault->p_lower->p_api->receive(p_fault->p_lower->p_ctrl, p_data, size);
+
+    return fault_apply(p_fault, p_data, n);
+}
+
+static transport_err_t fault_poll (void * const p_ctrl, uint32_t const timeout_ms)
+{
+    transport_fault_ctrl_t * p_fault = (transport_fault_ctrl_t *) p_ctrl;
+
+    return p_fault->p_lower->p_api->poll(p_fault->p_lower->p_ctrl, timeout_ms);
+}
+
+static transport_err_t fault_flush (void * const p_ctrl)
+{
+    transport_fault_ctrl_t * p_fault = (transport_fault_ctrl_t *) p_ctrl;
+
+    return p_fault->p_lower->p_api->flush(p_fault->p_lower->p_ctrl);
+}
+
+transport_api_t const g_transport_fault_api =
+{
+    .send    = fault_send,
+    .receive = fault_receive,
+    .poll    = fault_poll,
+    .flush   = fault_flush,
+};
+
+void transport_fault_open (transport_fault_ctrl_t     * p_ctrl,
+                           transport_instance_t const * p_lower,
+                           double                       rate,
+                           uint32_t                     seed)
+{
+    memset(p_ctrl, 0, sizeof(*p_ctrl));
+    p_ctrl->p_lower   = p_lower;
+    if (rate <= 0.0)
+    {
+        p_ctrl->threshold = 0U;
+    }
+    else
+    {
+        p_ctrl->threshold = (rate >= 1.0) ? UINT32_MAX : (uint32_t) (rate * 4294967296.0);
+    }
+    p_ctrl->state     = (0U != seed) ? seed : 1U;
+}
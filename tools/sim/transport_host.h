@@ -0,0 +1,111 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+#ifndef TRANSPORT_HOST_H_
+#define TRANSPORT_HOST_H_
+
+/******************************************************************************
+ * Host transports (Linux) for src/OTP_Example/transport.h.
+ *
+ * - fd:       any pair of file descriptors, e.g. stdin/stdout, pipes or a
+ *             serial port connected to a real board (transport_serial_open).
+ * - pty:      a pseudo terminal; host tools open its slave side as if it
+ *             were the board's serial port.
+ * - loopback: two in-memory endpoints in one process, for protocol-level
+ *             throughput tests at memory speed. Nothing blocks: poll only
+ *             reports whether bytes are waiting, so both ends must be run
+ *             from the same loop.
+ * - fault:    wraps another transport and corrupts or drops bytes at a
+ *             given rate in both directions, from a fixed seed, so the
+ *             link's retransmission and CRC checks can be exercised and
+ *             runs repeated.
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include "transport.h"
+
+/* Bytes held by one loopback direction */
+#define TRANSPORT_LOOP_SIZE    (0x00010000U)
+
+/* fd and pty transport state */
+typedef struct
+{
+    int fd_in;                   // Read side, set to non-blocking
+    int fd_out;                  // Write side
+} transport_fd_ctrl_t;
+
+/* One direction of a loopback */
+typedef struct
+{
+    uint32_t head;
+    uint32_t tail;
+    uint32_t dropped;            // Bytes refused because the ring was full
+    uint8_t  data[TRANSPORT_LOOP_SIZE];
+} transport_loop_ring_t;
+
+/* Loopback endpoint */
+typedef struct
+{
+    transport_loop_ring_t * p_rx;
+    transport_loop_ring_t * p_tx;
+} transport_loop_ctrl_t;
+
+/* Fault injection state */
+typedef struct
+{
+    transport_instance_t const * p_lower;    // Transport the bytes go through
+    uint32_t threshold;          // A byte is hit when the next random number is below this
+    uint32_t state;              // xorshift32 state, never 0
+    uint32_t flipped;            // Bytes sent or received with one bit inverted
+    uint32_t dropped;            // Bytes sent or received that were left out
+} transport_fault_ctrl_t;
+
+extern transport_api_t const g_transport_fd_api;
+extern transport_api_t const g_transport_loop_api;
+extern transport_api_t const g_transport_fault_api;
+
+/* Use fd_in and fd_out as the line. Returns 0 on success. */
+int transport_fd_open(transport_fd_ctrl_t * p_ctrl, int fd_in, int fd_out);
+
+/* Create a pseudo terminal in raw mode; its slave path is copied to p_name.
+ * Returns 0 on success. */
+int transport_pty_open(transport_fd_ctrl_t * p_ctrl, char * p_name, size_t name_size);
+
+/* Open a serial device (real board) in raw 8N1 mode at baud_rate.
+ * Returns 0 on success. */
+int transport_serial_open(transport_fd_ctrl_t * p_ctrl, char const * p_path, uint32_t baud_rate);
+
+void transport_fd_close(transport_fd_ctrl_t * p_ctrl);
+
+/* Connect two loopback endpoints through the rings a_to_b and b_to_a. */
+void transport_loop_open(transport_loop_ctrl_t * p_a,
+                         transport_loop_ctrl_t * p_b,
+                         transport_loop_ring_t * p_a_to_b,
+                         transport_loop_ring_t * p_b_to_a);
+
+/* Pass the bytes of p_lower through faults: each byte sent or received is
+ * hit with probability rate (0 to 1); half the hits invert one bit, the
+ * others drop the byte. The same seed gives the same faults for the same
+ * traffic. */
+void transport_fault_open(transport_fault_ctrl_t     * p_ctrl,
+                          transport_instance_t const * p_lower,
+                          double                       rate,
+                          uint32_t                     seed);
+
+#endif /* TRANSPORT_HOST_H_ */
@@ -0,0 +1,1154 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+
+/******************************************************************************
+ * Host tool: virtual board.
+ *
+ * Runs device_setup() (src/OTP_Example) as a Linux process on the simulated
+ * OTP (otp_sim.c) and flash (xspi_sim.c), so host tools can be developed and tested without a
+ * board. The command stack is the firmware's own code; only the transport
+ * the OTP and the flash are replaced.
+ *
+ * Usage:
+ *   virtual_board [-o otp.bin] [-u seed] [-l baud] [-L write_us[:read_us]] [-e rate[:seed]] [-S]
+ *                                                      Serve on a new pty (path printed)
+ *   virtual_board -s [-o otp.bin] [-u seed] [-l baud] [-L write_us[:read_us]] [-e rate[:seed]]
+ *                                                      Serve on stdin/stdout
+ *   virtual_board -b [-n commands] [-e rate[:seed]]    Loopback throughput benchmark
+ *   virtual_board -H [-n KB]                           SHA-256 benchmark (src/OTP_Example/sha256.c)
+ *   virtual_board -T [-n steps]                        Timer wheel check (src/OTP_Example/swtimer.c)
+ *   virtual_board -P                                   Profile planner check (src/OTP_Example/otp_plan.c)
+ *
+ * -l takes the received bytes no faster than a UART at baud (8N1), so link
+ * bound transfers such as write_flash are timed as on the board.
+ * -L makes each OTP word write (and read) take that many microseconds.
+ * -e puts the line through the fault transport (transport_host.h): each
+ * byte in either direction is corrupted or dropped with probability rate,
+ * from a fixed seed, so a run can be repeated. It works for serving and
+ * for -b.
+ *
+ * -b checks that every command reaches the board and every response the
+ * host exactly once and in order: the commands carry consecutive tags and
+ * the responses must come back with the same sequence. With -e the link
+ * timers run on a pass count instead of the clock, so a lost frame is
+ * resent after FRAME_RETRY_TIMEOUT_MS passes, not after a second.
+ *
+ * -S serves until SIGTERM or SIGINT, then prints one line of statistics
+ * (tools/sim/swarm.c collects them): bytes received and sent, the time of
+ * the first byte received and of the last byte sent (CLOCK_MONOTONIC), the
+ * time between them the board spent waiting for the host, and the OTP
+ * accesses.
+ *
+ * -H checks sha256.c against the FIPS 180-4 examples and sha256_hmac()
+ * against RFC 4231 test cases 1 to 4, 6 and 7 (6 and 7 hash a key longer
+ * than the block first), then hashes n KB
+ * (default 16 MB) and prints the rate in cycles per byte (time stamp
+ * counter cycles on x86). The board figure for comparison comes from
+ * debug_control = 7 in hal_entry.c, which uses the Cortex-R52 PMU.
+ *
+ * -T runs SWTIMER_CHECK_TIMERS software timers against a brute-force list
+ * of expiry ticks for n steps (default 2000000). Each step moves time on by
+ * one tick or by up to a few thousand, and may start or cancel a random
+ * timer. The delays include the level boundaries (63, 64, 4095, 4096, ...),
+ * whole turns of a level and the clamped extremes. The callbacks restart,
+ * cancel or start timers themselves, periodic ones included. Every expiry
+ * must be the earliest one the list holds, and none the list holds may be
+ * left after swtimer_advance() returns. Time starts just before the 32-bit
+ * tick count wraps.
+ *
+ * -P runs otp_plan_make() on JTAG authentication cases with a known
+ * answer: the mode going up or staying, the ID area blank, holding the
+ * same ID, a subset of its bits, other bits, or not readable (as on the
+ * host), for the plain and the hash type. With the mode already set the
+ * area must hold the profile's ID exactly.
+ *
+ * Build:
+ *   gcc -O2 -Itools/sim -Isrc/OTP_Example -Irzn/fsp/inc -Irzn/fsp/inc/api -o virtual_board \
+ *       tools/sim/virtual_board.c tools/sim/transport_host.c tools/sim/otp_sim.c tools/sim/xspi_sim.c \
+ *       src/OTP_Example/device_setup.c src/OTP_Example/frame.c src/OTP_Example/crc.c \
+ *       src/OTP_Example/cmd_otp.c src/OTP_Example/cmd_otp_auth.c src/OTP_Example/cmd_otp_plan.c \
+ *       src/OTP_Example/otp_plan.c src/OTP_Example/cmd_flash.c src/OTP_Example/lz4.c src/OTP_Example/sha256.c \
+ *       src/OTP_Example/log.c src/OTP_Example/otp_audit.c \
+ *       src/OTP_Example/swtimer.c
+ ******************************************************************************/
+
+/******************************************************************************
+ * Includes   <System Includes> , "Project Includes"
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "hal_data.h"
+#include "common.h"
+#include "otp.h"
+#include "cmd_flash.h"
+#include "sha256.h"
+#include "otp_plan.h"
+#include "swtimer.h"
+#include "frame.h"
+#include "device_setup.h"
+#include "transport_host.h"
+#include "otp_sim.h"
+#include "xspi_sim.h"
+
+/******************************************************************************
+ * Macro definitions
+ ******************************************************************************/
+/* Wait for host data before running the link timers again */
+#define SERVE_POLL_MS           (10U)
+/* A throttled line hands over bytes in batches of this much line time, not byte by byte */
+#define LINE_BATCH_S            (0.001)
+#define DEFAULT_UID_SEED        (0x4E324C31U)    /* "N2L1" */
+#define DEFAULT_BENCH_COMMANDS  (100000U)
+#define DEFAULT_HASH_KB         (16384U)
+#define HASH_CHUNK_SIZE         (65536U)
+#define DEFAULT_FAULT_SEED      (1U)
+#define DEFAULT_TIMER_STEPS     (2000000U)
+#define SWTIMER_CHECK_TIMERS    (512U)
+/* -T starts this many ticks before the tick count wraps */
+#define SWTIMER_CHECK_START     (0xFFFFFFFFU - 300000U)
+/* -b gives up when no response arrives for this long (clock or passes) */
+#define BENCH_STALL_MS          (30000U)
+/* -P: the ID area of a case, or the last byte of the ID it holds */
+#define PLAN_AREA_UNKNOWN       (0x100U)
+#define PLAN_AREA_BLANK         (0x101U)
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+/* Host end of the benchmark loopback */
+typedef struct
+{
+    frame_link_t            link;
+    transport_instance_t    transport;
+    uint32_t                responses;
+    uint32_t                failures;
+    uint32_t                out_of_order;   // Responses whose tag is not the next one sent
+    uint64_t                response_bytes;
+} bench_host_t;
+
+/* Statistics of the served transport (-S) */
+typedef struct
+{
+    uint64_t rx_bytes;
+    uint64_t tx_bytes;
+    double   first_rx_s;         // 0 until the host sends
+    double   last_tx_s;
+    double   wait_s;             // In poll with nothing received, since the first byte
+    double   wait_last_tx_s;     // wait_s at the last byte sent
+} serve_stats_t;
+
+/* Served transport and its line rate, 0 for no limit */
+static transport_instance_t const * s_p_line;
+static uint32_t                     s_line_rate;
+static double                       s_line_s;       // Time the line has delivered the bytes taken so far
+static serve_stats_t                s_serve;
+static volatile sig_atomic_t        s_stop;
+
+/* Fault injection (-e), rate 0 for a clean line */
+static double                 s_fault_rate;
+static uint32_t               s_fault_seed = DEFAULT_FAULT_SEED;
+static transport_fault_ctrl_t s_fault;
+
+/* Timer wheel check (-T): each timer and what the brute-force list expects of it */
+typedef struct
+{
+    swtimer_t timer;
+    bool      active;
+    uint32_t  expires;
+    uint32_t  period;
+    uint32_t  runs;
+} timer_check_t;
+
+static timer_check_t s_timers[SWTIMER_CHECK_TIMERS];
+static uint32_t      s_timer_now;       // Tick swtimer_advance() was last called with
+static uint32_t      s_timer_target;    // Tick of the swtimer_advance() call running
+static uint32_t      s_timer_random = 0x2545F491U;
+static uint32_t      s_timer_errors;
+static uint64_t      s_timer_runs;
+
+static transport_loop_ring_t s_ring_to_board;
+static transport_loop_ring_t s_ring_to_host;
+static bench_host_t          s_host;
+
+static uint32_t now_ms (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t) ((ts.tv_sec * 1000U) + (ts.tv_nsec / 1000000));
+}
+
+static double now_s (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+/******************************************************************************
+ * Serve a host over a pty or stdin/stdout
+ ******************************************************************************/
+
+static void stop_serving (int sig)
+{
+    (void) sig;
+    s_stop = 1;
+}
+
+static transport_err_t line_send (void * const p_ctrl, uint8_t const * const p_data, uint32_t const size)
+{
+    s_serve.tx_bytes      += size;
+    s_serve.last_tx_s      = now_s();
+    s_serve.wait_last_tx_s = s_serve.wait_s;
+
+    return s_p_line->p_api->send(p_ctrl, p_data, size);
+}
+
+static uint32_t line_count (uint32_t count)
+{
+    if ((0U != count) && (0.0 == s_serve.first_rx_s))
+    {
+        s_serve.first_rx_s = now_s();
+    }
+    s_serve.rx_bytes += count;
+
+    return count;
+}
+
+/* Take no more bytes than the line could have delivered by now. */
+static uint32_t line_receive (void * const p_ctrl, uint8_t * const p_data, uint32_t const size)
+{
+    double   byte_s;
+    double   now;
+    uint32_t count;
+
+    if (0U == s_line_rate)
+    {
+        return line_count(s_p_line->p_api->receive(p_ctrl, p_data, size));
+    }
+
+    byte_s = 10.0 / (double) s_line_rate;
+    now    = now_s();
+
+    /* An idle line does not bank time beyond one receive. */
+    if (s_line_s < (now - (size * byte_s)))
+    {
+        s_line_s = now - (size * byte_s);
+    }
+    count = (uint32_t) ((now - s_line_s) / byte_s);
+    if (0U == count)
+    {
+        return 0U;
+    }
+
+    count     = s_p_line->p_api->receive(p_ctrl, p_data, (count < size) ? count : size);
+    s_line_s += count * byte_s;
+
+    return line_count(count);
+}
+
+static transport_err_t line_poll (void * const p_ctrl, uint32_t const timeout_ms)
+{
+    double          t0  = now_s();
+    transport_err_t err = s_p_line->p_api->poll(p_ctrl, timeout_ms);
+    double          t1  = now_s();
+
+    if (0.0 != s_serve.first_rx_s)
+    {
+        s_serve.wait_s += t1 - t0;
+    }
+
+    /* Bytes are waiting but the line has not delivered a batch yet: sleep until it has, rather than
+     * coming back for each byte. */
+    if ((TRANSPORT_SUCCESS == err) && (0U != s_line_rate) && ((t1 - s_line_s) < LINE_BATCH_S))
+    {
+        double          s  = LINE_BATCH_S - (t1 - s_line_s);
+        struct timespec ts = {.tv_sec = 0, .tv_nsec = (long) (s * 1e9)};
+        (void) nanosleep(&ts, NULL);
+    }
+
+    return err;
+}
+
+static transport_err_t line_flush (void * const p_ctrl)
+{
+    return s_p_line->p_api->flush(p_ctrl);
+}
+
+static transport_api_t const s_line_api =
+{
+    .send    = line_send,
+    .receive = line_receive,
+    .poll    = line_poll,
+    .flush   = line_flush,
+};
+
+static int serve (transport_instance_t const * p_transport)
+{
+    transport_instance_t line = {.p_ctrl = p_transport->p_ctrl, .p_api = &s_line_api};
+
+    s_p_line    = p_transport;
+    s_line_s    = now_s();
+    p_transport = &line;
+
+    cmd_flash_open(&g_xspi_sim, xspi_sim_memory());
+    device_setup(p_transport);
+
+    while (0 == s_stop)
+    {
+        /* Do not sleep while the flash has work. */
+        uint32_t        wait_ms = cmd_flash_busy() ? 0U : SERVE_POLL_MS;
+        transport_err_t err     = p_transport->p_api->poll(p_transport->p_ctrl, wait_ms);
+        if (TRANSPORT_ERROR == err)
+        {
+            return 1;
+        }
+
+        device_setup_poll(now_ms());
+    }
+
+    return 0;
+}
+
+static void print_serve_stats (void)
+{
+    otp_sim_stats_t const * p_otp = otp_sim_stats();
+
+    printf("stats rx=%llu tx=%llu first=%.6f last=%.6f wait=%.6f otp_writes=%u otp_reads=%u otp_errors=%u\n",
+           (unsigned long long) s_serve.rx_bytes, (unsigned long long) s_serve.tx_bytes, s_serve.first_rx_s,
+           s_serve.last_tx_s, s_serve.wait_last_tx_s, (unsigned) p_otp->writes, (unsigned) p_otp->reads,
+           (unsigned) p_otp->write_errors);
+    fflush(stdout);
+}
+
+/******************************************************************************
+ * Loopback benchmark: a host link keeps its window full of READ_OTP commands
+ ******************************************************************************/
+
+static void bench_write (void * p_context, uint8_t const * p_data, uint32_t size)
+{
+    bench_host_t * p_host = (bench_host_t *) p_context;
+
+    (void) p_host->transport.p_api->send(p_host->transport.p_ctrl, p_data, size);
+}
+
+static void bench_deliver (void * p_context, uint8_t const * p_data, uint32_t size)
+{
+    bench_host_t     * p_host = (bench_host_t *) p_context;
+    response_t const * p_rsp  = (response_t const *) p_data;
+
+    p_host->response_bytes += size;
+    if ((sizeof(response_t) > size) || (PACKET_TYPE_RESPONSE != p_rsp->head.type) || (RET_SUCCESS != p_rsp->ret))
+    {
+        p_host->failures++;
+    }
+    else if ((CMD_READ_OTP != p_rsp->head.code) || ((uint8_t) p_host->responses != p_rsp->head.tag))
+    {
+        /* READ_OTP is always queued, so its responses keep the order of the commands. */
+        p_host->out_of_order++;
+    }
+    p_host->responses++;
+}
+
+static int run_benchmark (uint32_t commands)
+{
+    transport_loop_ctrl_t board_end;
+    transport_loop_ctrl_t host_end;
+    transport_instance_t  board_line = {.p_ctrl = &board_end, .p_api = &g_transport_loop_api};
+    transport_instance_t  board      = board_line;
+    frame_cfg_t           cfg   =
+    {
+        .p_write          = bench_write,
+        .p_deliver        = bench_deliver,
+        .p_context        = &s_host,
+        .retry_timeout_ms = FRAME_RETRY_TIMEOUT_MS,
+    };
+    uint8_t  command[sizeof(head_t) + sizeof(cmd_read_otp_t)] =
+    {
+        PACKET_TYPE_COMMAND, CMD_READ_OTP, 0U, 0U, 0U, (uint8_t) sizeof(cmd_read_otp_t), 0U,
+        (uint8_t) (PART_NUM_ADDR >> 8), (uint8_t) PART_NUM_ADDR
+    };
+    uint8_t  chunk[1024];
+    uint32_t sent = 0U;
+    uint32_t pass = 0U;
+    uint32_t last_response_ms;
+    uint32_t last_responses = 0U;
+
+    transport_loop_open(&host_end, &board_end, &s_ring_to_board, &s_ring_to_host);
+    s_host.transport.p_ctrl = &host_end;
+    s_host.transport.p_api  = &g_transport_loop_api;
+    frame_init(&s_host.link, &cfg);
+
+    /* Faults on the board end hit both directions: what it sends and what it receives. */
+    if (0.0 < s_fault_rate)
+    {
+        transport_fault_open(&s_fault, &board_line, s_fault_rate, s_fault_seed);
+        board.p_ctrl = &s_fault;
+        board.p_api  = &g_transport_fault_api;
+    }
+    device_setup(&board);
+
+    double t0 = now_s();
+    last_response_ms = (0.0 < s_fault_rate) ? 0U : now_ms();
+
+    while (s_host.responses < commands)
+    {
+        uint32_t t = (0.0 < s_fault_rate) ? pass++ : now_ms();
+
+        if (last_responses != s_host.responses)
+        {
+            last_responses   = s_host.responses;
+            last_response_ms = t;
+        }
+        else if ((t - last_response_ms) > BENCH_STALL_MS)
+        {
+            fprintf(stderr, "no response for %u ms, %u of %u received\n", (unsigned) BENCH_STALL_MS,
+                    (unsigned) s_host.responses, (unsigned) commands);
+            break;
+        }
+
+        while ((sent < commands) && (0U != frame_send_space(&s_host.link)))
+        {
+            command[6] = (uint8_t) sent;
+            (void) frame_send(&s_host.link, command, sizeof(command));
+            sent++;
+        }
+
+        device_setup_poll(t);
+
+        uint32_t size;
+        do
+        {
+            size = g_transport_loop_api.receive(&host_end, chunk, sizeof(chunk));
+            frame_input(&s_host.link, chunk, size);
+        } while (sizeof(chunk) == size);
+
+        frame_poll(&s_host.link, t);
+    }
+
+    double t1 = now_s();
+    double seconds = t1 - t0;
+
+    printf("%u READ_OTP commands over loopback in %.3f s\n", (unsigned) commands, seconds);
+    printf("%.0f commands/s, %.1f MB/s of responses\n", commands / seconds,
+           ((double) s_host.response_bytes / seconds) / 1e6);
+    printf("host: %u frames sent, %u resent, %u CRC errors, %u duplicates, %u bytes skipped\n",
+           (unsigned) s_host.link.stats.tx_frames, (unsigned) s_host.link.stats.tx_retransmits,
+           (unsigned) s_host.link.stats.rx_crc_errors, (unsigned) s_host.link.stats.rx_duplicates,
+           (unsigned) s_host.link.stats.rx_framing_errors);
+    if (0.0 < s_fault_rate)
+    {
+        printf("line faults (rate %g, seed %u): %u bytes flipped, %u dropped\n", s_fault_rate,
+               (unsigned) s_fault_seed, (unsigned) s_fault.flipped, (unsigned) s_fault.dropped);
+    }
+    printf("responses %u of %u, failures %u, out of order or repeated %u\n", (unsigned) s_host.responses,
+           (unsigned) commands, (unsigned) s_host.failures, (unsigned) s_host.out_of_order);
+
+    return ((commands == s_host.responses) && (0U == s_host.failures) && (0U == s_host.out_of_order)) ? 0 : 1;
+}
+
+/******************************************************************************
+ * Timer wheel check: swtimer.c against a brute-force list of expiry ticks
+ ******************************************************************************/
+
+static uint32_t timer_random (void)
+{
+    uint32_t x = s_timer_random;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_timer_random = x;
+
+    return x;
+}
+
+/* A delay, often on or next to a level boundary or a whole turn of a level. */
+static uint32_t timer_random_delay (uint32_t now)
+{
+    uint32_t level = timer_random() % SWTIMER_LEVELS;
+    uint32_t span  = 1UL << (SWTIMER_SLOT_BITS * level);
+
+    switch (timer_random() % 8U)
+    {
+        case 0U:
+        {
+            /* Last tick of a level, first tick of the next, one past it */
+            return ((span * SWTIMER_SLOTS) - 1U) + (timer_random() % 3U);
+        }
+        case 1U:
+        {
+            /* Whole turns of a level: the same slot, one or more turns later */
+            return span * SWTIMER_SLOTS * (1U + (timer_random() % 2U));
+        }
+        case 2U:
+        {
+            /* Just before, on or after the next slot boundary of a level */
+            return ((span - (now & (span - 1U))) + (timer_random() % 3U)) - 1U;
+        }
+        case 3U:
+        {
+            /* 0 and beyond the longest delay are clamped by swtimer_start() */
+            return (0U == (timer_random() & 1U)) ? 0U : UINT32_MAX;
+        }
+        case 4U:
+        case 5U:
+        {
+            return 1U + (timer_random() % 200U);
+        }
+        default:
+        {
+            return timer_random() % (span * SWTIMER_SLOTS);
+        }
+    }
+}
+
+/* What swtimer_start() should do, in the list. */
+static void timer_list_start (timer_check_t * p_check, uint32_t now, uint32_t delay, uint32_t period)
+{
+    if (0U == delay)
+    {
+        delay = 1U;
+    }
+    if (SWTIMER_MAX_DELAY < delay)
+    {
+        delay = SWTIMER_MAX_DELAY;
+    }
+    p_check->active  = true;
+    p_check->expires = now + delay;
+    p_check->period  = (SWTIMER_MAX_DELAY < period) ? SWTIMER_MAX_DELAY : period;
+}
+
+/* Start a random timer on the wheel and in the list. Periods are kept short or absent, so periodic
+ * timers run often. */
+static void timer_check_start (timer_check_t * p_check, uint32_t now)
+{
+    uint32_t delay  = timer_random_delay(now);
+    uint32_t period = 0U;
+
+    if (0U == (timer_random() % 4U))
+    {
+        period = (0U == (timer_random() % 4U)) ? timer_random_delay(now) % 5000U : 1U + (timer_random() % 70U);
+    }
+
+    swtimer_start(&p_check->timer, delay, period);
+    timer_list_start(p_check, now, delay, period);
+}
+
+static void timer_check_cancel (timer_check_t * p_check)
+{
+    swtimer_cancel(&p_check->timer);
+    p_check->active = false;
+}
+
+/* Earliest expiry in the list, or false if no timer is due by now */
+static bool timer_list_earliest (uint32_t now, uint32_t * p_tick)
+{
+    bool     found = false;
+    uint32_t best  = 0U;
+
+    for (uint32_t i = 0U; i < SWTIMER_CHECK_TIMERS; i++)
+    {
+        /* Ticks are compared relative to the last advance, so they may wrap. */
+        uint32_t due = s_timers[i].expires - s_timer_now;
+
+        if (s_timers[i].active && (0U != due) && (due <= (now - s_timer_now)) && ((!found) || (due < best)))
+        {
+            best  = due;
+            found = true;
+        }
+    }
+    *p_tick = s_timer_now + best;
+
+    return found;
+}
+
+static void timer_check_expired (void * p_context)
+{
+    timer_check_t * p_check = (timer_check_t *) p_context;
+    uint32_t        tick;
+
+    s_timer_runs++;
+    p_check->runs++;
+
+    /* The wheel must run the earliest expiry the list holds, and this timer must be due then. */
+    if ((false == timer_list_earliest(s_timer_target, &tick)) || (false == p_check->active) ||
+        (p_check->expires != tick))
+    {
+        if (s_timer_errors < 10U)
+        {
+            fprintf(stderr, "timer %u ran, its expiry %u (%s), the earliest due %u\n",
+                    (unsigned) (p_check - s_timers), (unsigned) p_check->expires,
+                    p_check->active ? "started" : "not started", (unsigned) tick);
+        }
+        s_timer_errors++;
+        tick = p_check->expires;
+    }
+
+    /* As the wheel does: a periodic timer is due again a period after this run. */
+    if (0U != p_check->period)
+    {
+        p_check->expires = tick + p_check->period;
+    }
+    else
+    {
+        p_check->active = false;
+    }
+    if (swtimer_active(&p_check->timer) != p_check->active)
+    {
+        if (s_timer_errors < 10U)
+        {
+            fprintf(stderr, "timer %u is %s after it ran\n", (unsigned) (p_check - s_timers),
+                    p_check->active ? "not started" : "still started");
+        }
+        s_timer_errors++;
+    }
+
+    /* Callbacks change timers too: this one, or another that may be due in the same tick. */
+    switch (timer_random() % 8U)
+    {
+        case 0U:
+        {
+            timer_check_start(p_check, tick);
+            break;
+        }
+        case 1U:
+        {
+            timer_check_cancel(p_check);
+            break;
+        }
+        case 2U:
+        {
+            timer_check_cancel(&s_timers[timer_random() % SWTIMER_CHECK_TIMERS]);
+            break;
+        }
+        case 3U:
+        {
+            timer_check_start(&s_timers[timer_random() % SWTIMER_CHECK_TIMERS], tick);
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+
+static int run_timer_check (uint32_t steps)
+{
+    uint32_t now     = SWTIMER_CHECK_START;
+    uint32_t tick;
+    uint32_t started = 0U;
+
+    s_timer_now = now;
+    swtimer_open(now);
+    for (uint32_t i = 0U; i < SWTIMER_CHECK_TIMERS; i++)
+    {
+        swtimer_init(&s_timers[i].timer, timer_check_expired, &s_timers[i]);
+        s_timers[i].active = false;
+        if (0U != (i & 1U))
+        {
+            timer_check_start(&s_timers[i], now);
+            started++;
+        }
+    }
+
+    double t0 = now_s();
+
+    for (uint32_t step = 0U; step < steps; step++)
+    {
+        timer_check_t * p_check = &s_timers[timer_random() % SWTIMER_CHECK_TIMERS];
+
+        switch (timer_random() % 4U)
+        {
+            case 0U:
+            {
+                timer_check_start(p_check, now);
+                started++;
+                break;
+            }
+            case 1U:
+            {
+                timer_check_cancel(p_check);
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+
+        now += (0U == (timer_random() % 16U)) ? (timer_random() % 4096U) : 1U;
+        s_timer_target = now;
+        swtimer_advance(now);
+
+        /* Nothing due by now may be left. */
+        if (timer_list_earliest(now, &tick))
+        {
+            if (s_timer_errors < 10U)
+            {
+                fprintf(stderr, "tick %u: an expiry at %u did not run\n", (unsigned) now, (unsigned) tick);
+            }
+            s_timer_errors++;
+            for (uint32_t i = 0U; i < SWTIMER_CHECK_TIMERS; i++)
+            {
+                if (s_timers[i].active && ((s_timers[i].expires - s_timer_now) <= (now - s_timer_now)))
+                {
+                    timer_check_cancel(&s_timers[i]);
+                }
+            }
+        }
+        s_timer_now = now;
+    }
+
+    double seconds = now_s() - t0;
+
+    printf("%u steps over %u ticks, %u timers started, %llu runs in %.3f s\n", (unsigned) steps,
+           (unsigned) (now - SWTIMER_CHECK_START), (unsigned) started, (unsigned long long) s_timer_runs, seconds);
+    printf("mismatches with the brute-force list: %u\n", (unsigned) s_timer_errors);
+
+    return (0U == s_timer_errors) ? 0 : 1;
+}
+
+/******************************************************************************
+ * SHA-256 benchmark
+ ******************************************************************************/
+
+static uint64_t now_cycles (void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0U;
+#endif
+}
+
+static int sha256_check (char const * p_message, char const * p_expected)
+{
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    char    text[(SHA256_DIGEST_SIZE * 2U) + 1U];
+
+    sha256_calc((uint8_t const *) p_message, (uint32_t) strlen(p_message), digest);
+    for (uint32_t i = 0U; i < SHA256_DIGEST_SIZE; i++)
+    {
+        snprintf(&text[i * 2U], 3U, "%02x", digest[i]);
+    }
+
+    if (0 != strcmp(text, p_expected))
+    {
+        fprintf(stderr, "sha256(\"%s\") = %s, expected %s\n", p_message, text, p_expected);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/* RFC 4231 test case. The key is p_key, or if it is NULL key_size bytes of key_byte (1, 2, 3, ... if key_byte
+ * is 0). The data is p_data, or if it is NULL data_size bytes of data_byte. */
+typedef struct
+{
+    uint32_t     number;
+    char const * p_key;
+    uint8_t      key_byte;
+    uint32_t     key_size;
+    char const * p_data;
+    uint8_t      data_byte;
+    uint32_t     data_size;
+    char const * p_expected;
+} hmac_case_t;
+
+static int hmac_check (void)
+{
+    static const hmac_case_t cases[] =
+    {
+        {1U, NULL, 0x0BU, 20U, "Hi There", 0U, 0U,
+         "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7"},
+        {2U, "Jefe", 0U, 0U, "what do ya want for nothing?", 0U, 0U,
+         "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"},
+        {3U, NULL, 0xAAU, 20U, NULL, 0xDDU, 50U,
+         "773ea91e36800e46854db8ebd09181a72959098b3ef8c122d9635514ced565fe"},
+        {4U, NULL, 0U, 25U, NULL, 0xCDU, 50U,
+         "82558a389a443c0ea4cc819899f2083a85f0faa3e578f8077a2e3ff46729665b"},
+        {6U, NULL, 0xAAU, 131U, "Test Using Larger Than Block-Size Key - Hash Key First", 0U, 0U,
+         "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"},
+        {7U, NULL, 0xAAU, 131U,
+         "This is a test using a larger than block-size key and a larger than block-size data. "
+         "The key needs to be hashed before being used by the HMAC algorithm.", 0U, 0U,
+         "9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2"},
+    };
+    uint8_t key[131];
+    uint8_t data[50];
+    uint8_t mac[SHA256_DIGEST_SIZE];
+    char    text[(SHA256_DIGEST_SIZE * 2U) + 1U];
+    int     failed = 0;
+
+    for (uint32_t c = 0U; c < (sizeof(cases) / sizeof(cases[0])); c++)
+    {
+        hmac_case_t const * p_case   = &cases[c];
+        uint8_t const     * p_key    = key;
+        uint32_t            key_size = p_case->key_size;
+        uint8_t const     * p_data   = data;
+        uint32_t            size     = p_case->data_size;
+
+        if (NULL != p_case->p_key)
+        {
+            p_key    = (uint8_t const *) p_case->p_key;
+            key_size = (uint32_t) strlen(p_case->p_key);
+        }
+        for (uint32_t i = 0U; i < p_case->key_size; i++)
+        {
+            key[i] = (0U != p_case->key_byte) ? p_case->key_byte : (uint8_t) (i + 1U);
+        }
+        if (NULL != p_case->p_data)
+        {
+            p_data = (uint8_t const *) p_case->p_data;
+            size   = (uint32_t) strlen(p_case->p_data);
+        }
+        else
+        {
+            memset(data, p_case->data_byte, size);
+        }
+
+        sha256_hmac(p_key, key_size, p_data, size, mac);
+        for (uint32_t i = 0U; i < SHA256_DIGEST_SIZE; i++)
+        {
+            snprintf(&text[i * 2U], 3U, "%02x", mac[i]);
+        }
+        if (0 != strcmp(text, p_case->p_expected))
+        {
+            fprintf(stderr, "HMAC-SHA256 RFC 4231 case %u = %s, expected %s\n", (unsigned) p_case->number, text,
+                    p_case->p_expected);
+            failed = 1;
+        }
+    }
+
+    return failed;
+}
+
+static int run_sha256_benchmark (uint32_t kbytes)
+{
+    static uint8_t chunk[HASH_CHUNK_SIZE];
+    uint64_t       total = (uint64_t) kbytes * 1024U;
+    uint64_t       done  = 0U;
+    sha256_ctx_t   ctx;
+    uint8_t        digest[SHA256_DIGEST_SIZE];
+
+    if ((0 != sha256_check("", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855")) ||
+        (0 != sha256_check("abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad")) ||
+        (0 != sha256_check("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+                           "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1")) ||
+        (0 != hmac_check()))
+    {
+        return 1;
+    }
+
+    for (uint32_t i = 0U; i < HASH_CHUNK_SIZE; i++)
+    {
+        chunk[i] = (uint8_t) (i * 131U);
+    }
+
+    double   t0 = now_s();
+    uint64_t c0 = now_cycles();
+
+    sha256_init(&ctx);
+    while (done < total)
+    {
+        uint32_t size = ((total - done) < HASH_CHUNK_SIZE) ? (uint32_t) (total - done) : HASH_CHUNK_SIZE;
+        sha256_update(&ctx, chunk, size);
+        done += size;
+    }
+    sha256_final(&ctx, digest);
+
+    uint64_t c1      = now_cycles();
+    double   seconds = now_s() - t0;
+
+    printf("SHA-256 of %u KB in %.3f s: %.1f MB/s, %.2f ns/byte\n", (unsigned) kbytes, seconds,
+           ((double) total / seconds) / 1e6, (seconds * 1e9) / (double) total);
+    if (0U != c1)
+    {
+        printf("%.2f cycles/byte (time stamp counter)\n", (double) (c1 - c0) / (double) total);
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * Profile planner check
+ ******************************************************************************/
+
+/* JTAG case: the profile's mode, type and ID (the last byte of PLAN_CHECK_ID), the board's mode and type and
+ * its ID area (PLAN_AREA_..., or the last byte of the ID it holds, hashed for the hash type), and the answer */
+typedef struct
+{
+    char const * p_name;
+    uint8_t      mode;
+    uint8_t      type;
+    uint8_t      id;
+    uint8_t      board_mode;
+    uint8_t      board_type;
+    uint16_t     area;
+    plan_err_t   err;
+    uint32_t     steps;
+} plan_case_t;
+
+static void plan_check_id (uint8_t last, uint8_t type, uint8_t * p_value)
+{
+    static const uint8_t id[PLAN_ID_SIZE] =
+    {
+        0x00U, 0x11U, 0x22U, 0x33U, 0x44U, 0x55U, 0x66U, 0x77U,
+        0x88U, 0x99U, 0xAAU, 0xBBU, 0xCCU, 0xDDU, 0xEEU, 0x00U
+    };
+
+    memcpy(p_value, id, PLAN_ID_SIZE);
+    p_value[PLAN_ID_SIZE - 1U] = last;
+    if (1U == type)
+    {
+        uint8_t plain[PLAN_ID_SIZE];
+        memcpy(plain, p_value, PLAN_ID_SIZE);
+        sha256_calc(plain, PLAN_ID_SIZE, p_value);
+    }
+}
+
+static int run_plan_check (void)
+{
+    /* Mode 0 none, 1 level 1, 2 level 2; type 0 plain, 1 hash */
+    static const plan_case_t cases[] =
+    {
+        {"same mode, same ID",             1U, 0U, 0x01U, 1U, 0U, 0x01U,             PLAN_OK,       0U},
+        {"same mode, ID with more bits",   1U, 0U, 0x03U, 1U, 0U, 0x01U,             PLAN_ERR_ID,   0U},
+        {"same mode, ID with fewer bits",  1U, 0U, 0x01U, 1U, 0U, 0x03U,             PLAN_ERR_ID,   0U},
+        {"same mode, area not read",       1U, 0U, 0x03U, 1U, 0U, PLAN_AREA_UNKNOWN, PLAN_OK,       0U},
+        {"mode up, area blank",            1U, 0U, 0x01U, 0U, 0U, PLAN_AREA_BLANK,   PLAN_OK,       1U},
+        {"mode up, area a subset",         1U, 0U, 0x03U, 0U, 0U, 0x01U,             PLAN_OK,       1U},
+        {"mode up, area other bits",       1U, 0U, 0x01U, 0U, 0U, 0x03U,             PLAN_ERR_ID,   0U},
+        {"level 2 from 1, area blank",     2U, 0U, 0x01U, 1U, 0U, PLAN_AREA_BLANK,   PLAN_OK,       1U},
+        {"hash, same mode, same ID",       2U, 1U, 0x01U, 2U, 1U, 0x01U,             PLAN_OK,       0U},
+        {"hash, same mode, other ID",      2U, 1U, 0x03U, 2U, 1U, 0x01U,             PLAN_ERR_ID,   0U},
+        {"hash, mode up, area blank",      2U, 1U, 0x01U, 0U, 0U, PLAN_AREA_BLANK,   PLAN_OK,       1U},
+        {"mode down",                      1U, 0U, 0x01U, 2U, 0U, PLAN_AREA_BLANK,   PLAN_ERR_MODE, 0U},
+    };
+    otp_profile_t profile;
+    otp_state_t   state;
+    otp_plan_t    plan;
+    uint32_t      failed = 0U;
+
+    for (uint32_t c = 0U; c < (sizeof(cases) / sizeof(cases[0])); c++)
+    {
+        plan_case_t const * p_case = &cases[c];
+
+        memset(&profile, 0, sizeof(profile));
+        profile.jauth_mode  = p_case->mode;
+        profile.jauth_type  = p_case->type;
+        profile.sciusb_mode = PLAN_KEEP;
+        plan_check_id(p_case->id, 0U, profile.jauth_id);
+
+        memset(&state, 0, sizeof(state));
+        state.jauth_mode = p_case->board_mode;
+        state.jauth_type = p_case->board_type;
+        state.id_known   = (PLAN_AREA_UNKNOWN != p_case->area);
+        if (PLAN_AREA_BLANK > p_case->area)
+        {
+            plan_check_id((uint8_t) p_case->area, p_case->type, state.id);
+        }
+
+        plan_err_t err = otp_plan_make(&profile, &state, &plan);
+        if ((p_case->err != err) || (p_case->steps != plan.num_steps))
+        {
+            fprintf(stderr, "plan \"%s\": error %u with %u steps, expected error %u with %u\n", p_case->p_name,
+                    (unsigned) err, (unsigned) plan.num_steps, (unsigned) p_case->err, (unsigned) p_case->steps);
+            failed++;
+        }
+    }
+
+    printf("%u planner cases, %u failed\n", (unsigned) (sizeof(cases) / sizeof(cases[0])), (unsigned) failed);
+
+    return (0U == failed) ? 0 : 1;
+}
+
+int main (int argc, char ** argv)
+{
+    uint32_t     seed      = DEFAULT_UID_SEED;
+    uint32_t     count     = 0U;
+    bool         benchmark = false;
+    bool         hash      = false;
+    bool         timers    = false;
+    bool         plans     = false;
+    bool         use_stdio = false;
+    bool         stats     = false;
+    uint32_t     write_us  = 0U;
+    uint32_t     read_us   = 0U;
+    char const * p_image   = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((0 == strcmp(argv[i], "-o")) && ((i + 1) < argc))
+        {
+            p_image = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-u")) && ((i + 1) < argc))
+        {
+            seed = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-n")) && ((i + 1) < argc))
+        {
+            count = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-l")) && ((i + 1) < argc))
+        {
+            s_line_rate = (uint32_t) strtoul(argv[++i], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[i], "-L")) && ((i + 1) < argc))
+        {
+            char * p_end;
+            write_us = (uint32_t) strtoul(argv[++i], &p_end, 0);
+            read_us  = (':' == *p_end) ? (uint32_t) strtoul(p_end + 1, NULL, 0) : 0U;
+        }
+        else if ((0 == strcmp(argv[i], "-e")) && ((i + 1) < argc))
+        {
+            char * p_end;
+            s_fault_rate = strtod(argv[++i], &p_end);
+            if (':' == *p_end)
+            {
+                s_fault_seed = (uint32_t) strtoul(p_end + 1, NULL, 0);
+            }
+        }
+        else if (0 == strcmp(argv[i], "-S"))
+        {
+            stats = true;
+        }
+        else if (0 == strcmp(argv[i], "-b"))
+        {
+            benchmark = true;
+        }
+        else if (0 == strcmp(argv[i], "-H"))
+        {
+            hash = true;
+        }
+        else if (0 == strcmp(argv[i], "-T"))
+        {
+            timers = true;
+        }
+        else if (0 == strcmp(argv[i], "-P"))
+        {
+            plans = true;
+        }
+        else if (0 == strcmp(argv[i], "-s"))
+        {
+            use_stdio = true;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-s] [-o otp.bin] [-u seed] [-l baud] [-L write_us[:read_us]] [-e rate[:seed]] [-S]"
+                    " | -b [-n commands] [-e rate[:seed]] | -H [-n KB] | -T [-n steps] | -P\n", argv[0]);
+            return 2;
+        }
+    }
+
+    otp_sim_reset(seed);
+    otp_sim_latency(write_us, read_us);
+    xspi_sim_reset();
+    if ((NULL != p_image) && (0 != otp_sim_attach(p_image)))
+    {
+        perror(p_image);
+        return 1;
+    }
+
+    if (timers)
+    {
+        return run_timer_check((0U != count) ? count : DEFAULT_TIMER_STEPS);
+    }
+
+    if (plans)
+    {
+        return run_plan_check();
+    }
+
+    if (hash)
+    {
+        return run_sha256_benchmark((0U != count) ? count : DEFAULT_HASH_KB);
+    }
+
+    if (benchmark)
+    {
+        return run_benchmark((0U != count) ? count : DEFAULT_BENCH_COMMANDS);
+    }
+
+    transport_fd_ctrl_t  line;
+    transport_instance_t transport = {.p_ctrl = &line, .p_api = &g_transport_fd_api};
+
+    if (use_stdio)
+    {
+        if (0 != transport_fd_open(&line, STDIN_FILENO, STDOUT_FILENO))
+        {
+            perror("stdin");
+            return 1;
+        }
+    }
+    else
+    {
+        char name[64];
+        if (0 != transport_pty_open(&line, name, sizeof(name)))
+        {
+            perror("pty");
+            return 1;
+        }
+        printf("virtual board on %s\n", name);
+        fflush(stdout);
+    }
+
+    transport_instance_t const line_clean = transport;
+
+    if (0.0 < s_fault_rate)
+    {
+        transport_fault_open(&s_fault, &line_clean, s_fault_rate, s_fault_seed);
+        transport.p_ctrl = &s_fault;
+        transport.p_api  = &g_transport_fault_api;
+    }
+
+    if (stats && !use_stdio)
+    {
+        struct sigaction sa;
+
+        /* No SA_RESTART: the signal ends the poll at once. */
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = stop_serving;
+        (void) sigaction(SIGTERM, &sa, NULL);
+        (void) sigaction(SIGINT, &sa, NULL);
+    }
+
+    int ret = serve(&transport);
+    if (stats && !use_stdio)
+    {
+        print_serve_stats();
+    }
+
+    return ret;
+}
@@ -0,0 +1,197 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+/******************************************************************************
+ * Simulated xSPI serial flash. See xspi_sim.h.
+ ******************************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#include <time.h>
+#include "xspi_sim.h"
+
+#define XSPI_SIM_SECTOR_SIZE     (4096U)
+#define XSPI_SIM_MAX_WRITE       (64U)
+
+/******************************************************************************
+ * Private global variables and functions
+ ******************************************************************************/
+static uint8_t          s_g_memory[XSPI_SIM_SIZE];
+static uint64_t         s_g_busy_until_us;
+static xspi_sim_stats_t s_g_stats;
+static uint32_t         s_g_ctrl;
+
+static fsp_err_t xspi_sim_open (spi_flash_ctrl_t * p_ctrl, spi_flash_cfg_t const * const p_cfg)
+{
+    (void) p_ctrl;
+    (void) p_cfg;
+
+    return FSP_SUCCESS;
+}
+
+static uint64_t xspi_sim_now_us (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t) ts.tv_sec * 1000000U) + ((uint64_t) ts.tv_nsec / 1000U);
+}
+
+/* Start a program or erase: false (and counted) if the flash is busy. */
+static bool xspi_sim_start (uint32_t busy_us)
+{
+    uint64_t now_us = xspi_sim_now_us();
+
+    if (now_us < s_g_busy_until_us)
+    {
+        s_g_stats.busy_errors++;
+
+        return false;
+    }
+    s_g_busy_until_us = now_us + busy_us;
+
+    return true;
+}
+
+static fsp_err_t xspi_sim_direct_transfer (spi_flash_ctrl_t                  * p_ctrl,
+                                           spi_flash_direct_transfer_t * const p_transfer,
+                                           spi_flash_direct_transfer_dir_t     direction)
+{
+    (void) p_ctrl;
+    (void) p_transfer;
+    (void) direction;
+
+    return FSP_ERR_UNSUPPORTED;
+}
+
+static fsp_err_t xspi_sim_write (spi_flash_ctrl_t    * p_ctrl,
+                                 uint8_t const * const p_src,
+                                 uint8_t * const       p_dest,
+                                 uint32_t              byte_count)
+{
+    uintptr_t offset = (uintptr_t) (p_dest - s_g_memory);
+
+    (void) p_ctrl;
+
+    if ((offset >= XSPI_SIM_SIZE) || (0U == byte_count) || (byte_count > XSPI_SIM_MAX_WRITE) ||
+        (byte_count > (XSPI_SIM_SIZE - offset)))
+    {
+        return FSP_ERR_INVALID_ARGUMENT;
+    }
+
+    if (!xspi_sim_start(XSPI_SIM_PROGRAM_US))
+    {
+        return FSP_SUCCESS;
+    }
+
+    for (uint32_t i = 0U; i < byte_count; i++)
+    {
+        if (0U != (p_src[i] & (uint8_t) ~s_g_memory[offset + i]))
+        {
+            s_g_stats.program_errors++;
+        }
+        s_g_memory[offset + i] &= p_src[i];
+    }
+    s_g_stats.programs++;
+    s_g_stats.program_bytes += byte_count;
+
+    return FSP_SUCCESS;
+}
+
+static fsp_err_t xspi_sim_erase (spi_flash_ctrl_t * p_ctrl, uint8_t * const p_device_address, uint32_t byte_count)
+{
+    uintptr_t offset = (uintptr_t) (p_device_address - s_g_memory);
+
+    (void) p_ctrl;
+
+    if ((XSPI_SIM_SECTOR_SIZE != byte_count) || (offset >= XSPI_SIM_SIZE) || (0U != (offset % XSPI_SIM_SECTOR_SIZE)))
+    {
+        return FSP_ERR_INVALID_SIZE;
+    }
+
+    if (!xspi_sim_start(XSPI_SIM_ERASE_US))
+    {
+        return FSP_SUCCESS;
+    }
+
+    memset(&s_g_memory[offset], 0xFF, XSPI_SIM_SECTOR_SIZE);
+    s_g_stats.erases++;
+
+    return FSP_SUCCESS;
+}
+
+static fsp_err_t xspi_sim_status_get (spi_flash_ctrl_t * p_ctrl, spi_flash_status_t * const p_status)
+{
+    (void) p_ctrl;
+
+    p_status->write_in_progress = (xspi_sim_now_us() < s_g_busy_until_us);
+
+    return FSP_SUCCESS;
+}
+
+static fsp_err_t xspi_sim_close (spi_flash_ctrl_t * p_ctrl)
+{
+    (void) p_ctrl;
+
+    return FSP_SUCCESS;
+}
+
+static fsp_err_t xspi_sim_version_get (fsp_version_t * const p_version)
+{
+    p_version->version_id = 0U;
+
+    return FSP_SUCCESS;
+}
+
+static const spi_flash_api_t s_xspi_sim_api =
+{
+    .open           = xspi_sim_open,
+    .directTransfer = xspi_sim_direct_transfer,
+    .write          = xspi_sim_write,
+    .erase          = xspi_sim_erase,
+    .statusGet      = xspi_sim_status_get,
+    .close          = xspi_sim_close,
+    .versionGet     = xspi_sim_version_get,
+};
+
+const spi_flash_instance_t g_xspi_sim =
+{
+    .p_ctrl = &s_g_ctrl,
+    .p_cfg  = NULL,
+    .p_api  = &s_xspi_sim_api,
+};
+
+/******************************************************************************
+ * Simulator control
+ ******************************************************************************/
+
+void xspi_sim_reset (void)
+{
+    memset(s_g_memory, 0xFF, sizeof(s_g_memory));
+    memset(&s_g_stats, 0, sizeof(s_g_stats));
+    s_g_busy_until_us = 0U;
+}
+
+uint8_t * xspi_sim_memory (void)
+{
+    return s_g_memory;
+}
+
+xspi_sim_stats_t const * xspi_sim_stats (void)
+{
+    return &s_g_stats;
+}
@@ -0,0 +1,65 @@
+/***********************************************************************************************************************
+ * Copyright [2020-2022] Renesas Electronics Corporation and/or its affiliates.  All Rights Reserved.
+ *
+ * This software and documentation are supplied by Renesas Electronics Corporation and/or its affiliates and may only
+ * be used with products of Renesas Electronics Corp. and its affiliates ("Renesas").  No other uses are authorized.
+ * Renesas products are sold pursuant to Renesas terms and conditions of sale.  Purchasers are solely responsible for
+ * the selection and use of Renesas products and Renesas assumes no liability.  No license, express or implied, to any
+ * intellectual property right is granted by Renesas.  This software is protected under all applicable laws, including
+ * copyright laws. Renesas reserves the right to change or discontinue this software and/or this documentation.
+ * THE SOFTWARE AND DOCUMENTATION IS DELIVERED TO YOU "AS IS," AND RENESAS MAKES NO REPRESENTATIONS OR WARRANTIES, AND
+ * TO THE FULLEST EXTENT PERMISSIBLE UNDER APPLICABLE LAW, DISCLAIMS ALL WARRANTIES, WHETHER EXPLICITLY OR IMPLICITLY,
+ * INCLUDING WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND NONINFRINGEMENT, WITH RESPECT TO THE
+ * SOFTWARE OR DOCUMENTATION.  RENESAS SHALL HAVE NO LIABILITY ARISING OUT OF ANY SECURITY VULNERABILITY OR BREACH.
+ * TO THE MAXIMUM EXTENT PERMITTED BY LAW, IN NO EVENT WILL RENESAS BE LIABLE TO YOU IN CONNECTION WITH THE SOFTWARE OR
+ * DOCUMENTATION (OR ANY PERSON OR ENTITY CLAIMING RIGHTS DERIVED FROM YOU) FOR ANY LOSS, DAMAGES, OR CLAIMS WHATSOEVER,
+ * INCLUDING, WITHOUT LIMITATION, ANY DIRECT, CONSEQUENTIAL, SPECIAL, INDIRECT, PUNITIVE, OR INCIDENTAL DAMAGES; ANY
+ * LOST PROFITS, OTHER ECONOMIC DAMAGE, PROPERTY DAMAGE, OR PERSONAL INJURY; AND EVEN IF RENESAS HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH LOSS, DAMAGES, CLAIMS OR COSTS.
+ **********************************************************************************************************************/
+#ifndef XSPI_SIM_H_
+#define XSPI_SIM_H_
+
+/******************************************************************************
+ * Simulated xSPI serial flash (host only).
+ *
+ * Implements spi_flash_api_t (r_spi_flash_api.h) on a byte array instead of
+ * the R_XSPI0 registers, so the flash commands run unchanged in a Linux
+ * process. Use g_xspi_sim in place of g_qspi0, and xspi_sim_memory() in
+ * place of the memory-mapped area.
+ *
+ * The model follows a NOR flash: a program can only clear bits, an erase
+ * sets a whole sector to 0xFF, and program and erase take time like on the
+ * part. statusGet reports the write in progress; a program or erase started
+ * while busy is counted as an error and ignored, as the part would.
+ ******************************************************************************/
+#include "hal_data.h"
+
+/* Size of the simulated flash */
+#define XSPI_SIM_SIZE            (0x00800000U)
+
+/* Busy time of a program (up to 64 bytes) and of a 4 KB sector erase */
+#define XSPI_SIM_PROGRAM_US      (150U)
+#define XSPI_SIM_ERASE_US        (30000U)
+
+/* Statistics */
+typedef struct
+{
+    uint32_t programs;           // Programs started
+    uint32_t program_bytes;      // Bytes programmed
+    uint32_t erases;             // Sectors erased
+    uint32_t busy_errors;        // Program or erase started while busy
+    uint32_t program_errors;     // Bits that a program would have to set
+} xspi_sim_stats_t;
+
+extern const spi_flash_instance_t g_xspi_sim;
+
+/* Start from an erased flash. */
+void xspi_sim_reset(void);
+
+/* Base of the simulated memory-mapped area. */
+uint8_t * xspi_sim_memory(void);
+
+xspi_sim_stats_t const * xspi_sim_stats(void);
+
+#endif /* XSPI_SIM_H_ */